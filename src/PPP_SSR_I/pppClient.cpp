@@ -86,6 +86,9 @@ void t_pppClient::processEpoch(const vector<t_satObs*>& satObs, t_output* output
     const t_satObs* obs     = satObs[ii];
     t_prn prn = obs->_prn;
     if (prn.system() == 'E') {prn.setFlags(1);} // force I/NAV usage
+    if (prn.toIndex() < 0) {
+      continue;
+    }
     t_satData*   satData = new t_satData();
 
     if (_epoData->tt.undef()) {
@@ -93,7 +96,7 @@ void t_pppClient::processEpoch(const vector<t_satObs*>& satObs, t_output* output
     }
 
     satData->tt       = obs->_time;
-    satData->prn      = QString(prn.toInternalString().c_str());
+    satData->prn      = prn;
     satData->slipFlag = false;
     satData->P1       = 0.0;
     satData->P2       = 0.0;
@@ -103,16 +106,16 @@ void t_pppClient::processEpoch(const vector<t_satObs*>& satObs, t_output* output
     satData->L2       = 0.0;
     satData->L5       = 0.0;
     satData->L7       = 0.0;
+    const t_satCodeBias* satCB = _pppUtils->satCodeBias(prn);
     for (unsigned ifrq = 0; ifrq < obs->_obs.size(); ifrq++) {
       t_frqObs* frqObs = obs->_obs[ifrq];
       double cb = 0.0;
-      const t_satCodeBias* satCB = _pppUtils->satCodeBias(prn);
-      if (satCB && satCB->_bias.size()) {
-        for (unsigned ii = 0; ii < satCB->_bias.size(); ii++) {
-
-          const t_frqCodeBias& bias = satCB->_bias[ii];
-          if (frqObs && frqObs->_rnxType2ch == bias._rnxType2ch) {
+      if (satCB) {
+        for (unsigned ii = satCB->_bias.size(); ii > 0; ii--) { // last entry wins
+          const t_frqCodeBias& bias = satCB->_bias[ii-1];
+          if (frqObs->_rnxType2ch == bias._rnxType2ch) {
             cb  = bias._value;
+            break;
           }
         }
       }
@@ -142,18 +145,10 @@ void t_pppClient::processEpoch(const vector<t_satObs*>& satObs, t_output* output
 
   // Data Pre-Processing
   // -------------------
-  QMutableMapIterator<QString, t_satData*> it(_epoData->satData);
-  while (it.hasNext()) {
-    it.next();
-    QString    prn     = it.key();
-    t_satData* satData = it.value();
-
-    if (cmpToT(satData) != success) {
-      delete satData;
-      it.remove();
-      continue;
+  for (int iSat = _epoData->satData.size() - 1; iSat >= 0; iSat--) {
+    if (cmpToT(_epoData->satData.at(iSat)) != success) {
+      delete _epoData->satData.takeAt(iSat);
     }
-
   }
 //++++++++++++++++++++++++++++++++++++++++++++++++++++++++
 /*
@@ -176,6 +171,12 @@ void t_pppClient::processEpoch(const vector<t_satObs*>& satObs, t_output* output
     output->_neu[2]      = _filter->neu()[2];
     output->_numSat      = _filter->numSat();
     output->_hDop        = _filter->HDOP();
+    output->_numResCode  = _filter->numRes(0);
+    output->_rmsResCode  = _filter->rmsRes(0);
+    output->_maxResCode  = _filter->maxRes(0);
+    output->_numResPhase = _filter->numRes(1);
+    output->_rmsResPhase = _filter->rmsRes(1);
+    output->_maxResPhase = _filter->maxRes(1);
     output->_trp0        = _filter->trp0();
     output->_trp         = _filter->trp();
     output->_trpStdev    = _filter->trpStdev();
@@ -215,7 +216,7 @@ void t_pppClient::putNewObs(t_satData* satData) {
       satData->lambda3 = a1 * t_CST::c / f1 + a2 * t_CST::c / f2;
       satData->lkA     = a1;
       satData->lkB     = a2;
-      _epoData->satData[satData->prn] = satData;
+      _epoData->satData.insert(satData);
     }
     else {
       delete satData;
@@ -253,7 +254,7 @@ void t_pppClient::putNewObs(t_satData* satData) {
       satData->lambda3 = a1 * t_CST::c / f1 + a2 * t_CST::c / f2;
       satData->lkA     = a1;
       satData->lkB     = a2;
-      _epoData->satData[satData->prn] = satData;
+      _epoData->satData.insert(satData);
     }
     else {
       delete satData;
@@ -276,7 +277,7 @@ void t_pppClient::putNewObs(t_satData* satData) {
       satData->lambda3 = a1 * t_CST::c / f1 + a5 * t_CST::c / f5;
       satData->lkA     = a1;
       satData->lkB     = a5;
-      _epoData->satData[satData->prn] = satData;
+      _epoData->satData.insert(satData);
     }
     else {
       delete satData;
@@ -299,7 +300,7 @@ void t_pppClient::putNewObs(t_satData* satData) {
       satData->lambda3 = a2 * t_CST::c / f2 + a7 * t_CST::c / f7;
       satData->lkA     = a2;
       satData->lkB     = a7;
-      _epoData->satData[satData->prn] = satData;
+      _epoData->satData.insert(satData);
     }
     else {
       delete satData;
@@ -314,7 +315,7 @@ void t_pppClient::putNewObs(t_satData* satData) {
 ////////////////////////////////////////////////////////////////////////////
 void t_pppClient::putOrbCorrections(const std::vector<t_orbCorr*>& corr) {
   for (unsigned ii = 0; ii < corr.size(); ii++) {
-    QString prn = QString(corr[ii]->_prn.toInternalString().c_str());
+    const t_prn& prn = corr[ii]->_prn;
     t_eph* eLast = _ephUser->ephLast(prn);
     t_eph* ePrev = _ephUser->ephPrev(prn);
     if      (eLast && eLast->IOD() == corr[ii]->_iod) {
@@ -330,7 +331,7 @@ void t_pppClient::putOrbCorrections(const std::vector<t_orbCorr*>& corr) {
 ////////////////////////////////////////////////////////////////////////////
 void t_pppClient::putClkCorrections(const std::vector<t_clkCorr*>& corr) {
   for (unsigned ii = 0; ii < corr.size(); ii++) {
-    QString prn = QString(corr[ii]->_prn.toInternalString().c_str());
+    const t_prn& prn = corr[ii]->_prn;
     t_eph* eLast = _ephUser->ephLast(prn);
     t_eph* ePrev = _ephUser->ephPrev(prn);
     if      (eLast && eLast->IOD() == corr[ii]->_iod) {
@@ -390,7 +391,7 @@ void t_pppClient::putEphemeris(const t_eph* eph) {
 
 // Satellite Position
 ////////////////////////////////////////////////////////////////////////////
-t_irc t_pppClient::getSatPos(const bncTime& tt, const QString& prn,
+t_irc t_pppClient::getSatPos(const bncTime& tt, const t_prn& prn,
                               ColumnVector& xc, ColumnVector& vv) {
 
   t_eph* eLast = _ephUser->ephLast(prn);
@@ -54,7 +54,7 @@ class t_pppClient : public interface_pppClient {
   void                reset();
 
  private:
-  t_irc getSatPos(const bncTime& tt, const QString& prn, ColumnVector& xc, ColumnVector& vv);
+  t_irc getSatPos(const bncTime& tt, const t_prn& prn, ColumnVector& xc, ColumnVector& vv);
   void  putNewObs(t_satData* satData);
   t_irc cmpToT(t_satData* satData);
   bncEphUser*         _ephUser;
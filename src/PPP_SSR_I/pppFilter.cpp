@@ -1992,10 +1992,69 @@ bool t_pppGpt::GPT2w(double dmjd, double dlat, double dlon, double hell){
 	return true;
 }
 //++++++++++++++++++++++++++++++
+// Insert (takes ownership, replaces an existing entry of the satellite)
+////////////////////////////////////////////////////////////////////////////
+bool t_satDataMap::insert(t_satData* satData) {
+  int index = satData->prn.toIndex();
+  if (index < 0) {
+    return false;
+  }
+  const t_prn& prn = satData->prn;
+  if (_byIndex[index]) {
+    int ii = _sats.indexOf(_byIndex[index]);
+    delete _byIndex[index];
+    _byIndex[index] = satData;
+    _sats[ii]       = satData;
+    return true;
+  }
+  int ii = _sats.size();
+  while (ii > 0) {
+    const t_prn& prev = _sats[ii-1]->prn;
+    if (  prev.system() <  prn.system() ||
+         (prev.system() == prn.system() && (prev.number() <  prn.number() ||
+         (prev.number() == prn.number() &&  prev.flags()  <  prn.flags())))) {
+      break;
+    }
+    --ii;
+  }
+  _sats.insert(ii, satData);
+  _byIndex[index] = satData;
+  return true;
+}
+
+// Remove satellite (without deleting it)
+////////////////////////////////////////////////////////////////////////////
+t_satData* t_satDataMap::take(const t_prn& prn) {
+  t_satData* satData = find(prn);
+  if (satData) {
+    _sats.remove(_sats.indexOf(satData));
+    _byIndex[prn.toIndex()] = 0;
+  }
+  return satData;
+}
+
+// Remove satellite at list position (without deleting it)
+////////////////////////////////////////////////////////////////////////////
+t_satData* t_satDataMap::takeAt(int ii) {
+  t_satData* satData = _sats[ii];
+  _sats.remove(ii);
+  _byIndex[satData->prn.toIndex()] = 0;
+  return satData;
+}
+
+// Remove all satellites (without deleting them)
+////////////////////////////////////////////////////////////////////////////
+void t_satDataMap::clear() {
+  for (int ii = 0; ii < _sats.size(); ii++) {
+    _byIndex[_sats[ii]->prn.toIndex()] = 0;
+  }
+  _sats.clear();
+}
+
 // Constructor
 ////////////////////////////////////////////////////////////////////////////
 t_pppParam::t_pppParam(t_pppParam::parType typeIn, int indexIn,
-                   const QString& prnIn) {
+                   const t_prn& prnIn) {
   type      = typeIn;
   index     = indexIn;
   prn       = prnIn;
@@ -2042,7 +2101,7 @@ double t_pppParam::partial(t_satData* satData, bool phase) {
   // Glonass Offset
   // --------------
   else if (type == GLONASS_OFFSET) {
-    if (satData->prn[0] == 'R') {
+    if (satData->system() == 'R') {
       return 1.0;
     }
     else {
@@ -2053,7 +2112,7 @@ double t_pppParam::partial(t_satData* satData, bool phase) {
   // Galileo Offset
   // --------------
   else if (type == GALILEO_OFFSET) {
-    if (satData->prn[0] == 'E') {
+    if (satData->system() == 'E') {
       return 1.0;
     }
     else {
@@ -2064,7 +2123,7 @@ double t_pppParam::partial(t_satData* satData, bool phase) {
   // BDS Offset
   // ----------
   else if (type == BDS_OFFSET) {
-    if (satData->prn[0] == 'C') {
+    if (satData->system() == 'C') {
       return 1.0;
     }
     else {
@@ -2098,8 +2157,10 @@ t_pppFilter::t_pppFilter(t_pppClient* pppClient) {
   // Antenna Name, ANTEX File
   // ------------------------
   _antex = 0;
+  _antIndexRover = -1;
   if (!OPT->_antexFileName.empty()) {
     _antex = new bncAntex(OPT->_antexFileName.c_str());
+    _antIndexRover = _antex->antIndex(OPT->_antNameRover);
   }
 
   // Bancroft Coordinates
@@ -2116,6 +2177,18 @@ t_pppFilter::t_pppFilter(t_pppClient* pppClient) {
   _neu.ReSize(3); _neu = 0.0;
   _numSat = 0;
   _hDop   = 0.0;
+  for (int iPhase = 0; iPhase <= 1; iPhase++) {
+    _numRes[iPhase] = 0;
+    _rmsRes[iPhase] = 0.0;
+    _maxRes[iPhase] = 0.0;
+  }
+
+  // Phase Wind-Up (not yet computed)
+  // --------------------------------
+  for (unsigned ii = 0; ii < t_prn::NUMINDEX; ii++) {
+    _windUpTime[ii] = 0.0;
+    _windUpSum[ii]  = 0.0;
+  }
 }
 
 // Destructor
@@ -2152,18 +2225,18 @@ void t_pppFilter::reset() {
   _params.push_back(new t_pppParam(t_pppParam::CRD_X,  ++nextPar, ""));
   _params.push_back(new t_pppParam(t_pppParam::CRD_Y,  ++nextPar, ""));
   _params.push_back(new t_pppParam(t_pppParam::CRD_Z,  ++nextPar, ""));
-  _params.push_back(new t_pppParam(t_pppParam::RECCLK, ++nextPar, ""));
+  _params.push_back(new t_pppParam(t_pppParam::RECCLK, ++nextPar));
   if (OPT->estTrp()) {
-    _params.push_back(new t_pppParam(t_pppParam::TROPO, ++nextPar, ""));
+    _params.push_back(new t_pppParam(t_pppParam::TROPO, ++nextPar));
   }
   if (OPT->useSystem('R')) {
-    _params.push_back(new t_pppParam(t_pppParam::GLONASS_OFFSET, ++nextPar, ""));
+    _params.push_back(new t_pppParam(t_pppParam::GLONASS_OFFSET, ++nextPar));
   }
   if (OPT->useSystem('E')) {
-    _params.push_back(new t_pppParam(t_pppParam::GALILEO_OFFSET, ++nextPar, ""));
+    _params.push_back(new t_pppParam(t_pppParam::GALILEO_OFFSET, ++nextPar));
   }
   if (OPT->useSystem('C')) {
-    _params.push_back(new t_pppParam(t_pppParam::BDS_OFFSET, ++nextPar, ""));
+    _params.push_back(new t_pppParam(t_pppParam::BDS_OFFSET, ++nextPar));
   }
 
   _QQ.ReSize(_params.size());
@@ -2206,14 +2279,11 @@ t_irc t_pppFilter::cmpBancroft(t_epoData* epoData) {
 
   Matrix BB(epoData->sizeSys('G'), 4);
 
-  QMapIterator<QString, t_satData*> it(epoData->satData);
   int iObsBanc = 0;
-  while (it.hasNext()) {
-    it.next();
-    t_satData* satData = it.value();
+  for (int iSat = 0; iSat < epoData->satData.size(); iSat++) {
+    t_satData* satData = epoData->satData.at(iSat);
     if (satData->system() == 'G') {
       ++iObsBanc;
-      QString    prn     = it.key();
       BB(iObsBanc, 1) = satData->xx(1);
       BB(iObsBanc, 2) = satData->xx(2);
       BB(iObsBanc, 3) = satData->xx(3);
@@ -2235,14 +2305,11 @@ t_irc t_pppFilter::cmpBancroft(t_epoData* epoData) {
 
   // Compute Satellite Elevations
   // ----------------------------
-  QMutableMapIterator<QString, t_satData*> im(epoData->satData);
-  while (im.hasNext()) {
-    im.next();
-    t_satData* satData = im.value();
+  for (int iSat = epoData->satData.size() - 1; iSat >= 0; iSat--) {
+    t_satData* satData = epoData->satData.at(iSat);
     cmpEle(satData);
     if (satData->eleSat < OPT->_minEle) {
-      delete satData;
-      im.remove();
+      delete epoData->satData.takeAt(iSat);
     }
   }
 
@@ -2291,17 +2358,17 @@ double t_pppFilter::cmpValue(t_satData* satData, bool phase) {
   double offset = 0.0;
   t_frequency::type frqA = t_frequency::G1;
   t_frequency::type frqB = t_frequency::G2;
-  if      (satData->prn[0] == 'R') {
+  if      (satData->system() == 'R') {
     offset = Glonass_offset();
     frqA = t_frequency::R1;
     frqB = t_frequency::R2;
   }
-  else if (satData->prn[0] == 'E') {
+  else if (satData->system() == 'E') {
     offset = Galileo_offset();
     //frqA = t_frequency::E1; as soon as available
     //frqB = t_frequency::E5; -"-
   }
-  else if (satData->prn[0] == 'C') {
+  else if (satData->system() == 'C') {
     offset = Bds_offset();
     //frqA = t_frequency::C2; as soon as available
     //frqB = t_frequency::C7; -"-
@@ -2309,10 +2376,10 @@ double t_pppFilter::cmpValue(t_satData* satData, bool phase) {
   double phaseCenter = 0.0;
   if (_antex) {
     bool found;
-    phaseCenter = satData->lkA * _antex->rcvCorr(OPT->_antNameRover, frqA,
+    phaseCenter = satData->lkA * _antex->rcvCorr(_antIndexRover, frqA,
                                                  satData->eleSat, satData->azSat,
                                                  found)
-                + satData->lkB * _antex->rcvCorr(OPT->_antNameRover, frqB,
+                + satData->lkB * _antex->rcvCorr(_antIndexRover, frqB,
                                                  satData->eleSat, satData->azSat,
                                                  found);
     if (!found) {
@@ -2542,7 +2609,7 @@ void t_pppFilter::predict(int iPhase, t_epoData* epoData) {
       t_pppParam* par = im.next();
       bool removed = false;
       if (par->type == t_pppParam::AMB_L3) {
-        if (epoData->satData.find(par->prn) == epoData->satData.end()) {
+        if (!epoData->satData.contains(par->prn)) {
           removed = true;
           delete par;
           im.remove();
@@ -2556,11 +2623,8 @@ void t_pppFilter::predict(int iPhase, t_epoData* epoData) {
 
     // Add new ambiguity parameters
     // ----------------------------
-    QMapIterator<QString, t_satData*> it(epoData->satData);
-    while (it.hasNext()) {
-      it.next();
-      t_satData* satData = it.value();
-      addAmb(satData);
+    for (int iSat = 0; iSat < epoData->satData.size(); iSat++) {
+      addAmb(epoData->satData.at(iSat));
     }
 
     int nPar = _params.size();
@@ -2626,7 +2690,7 @@ t_irc t_pppFilter::update(t_epoData* epoData) {
     else if (par->type == t_pppParam::AMB_L3) {
       ++par->numEpo;
       LOG << "\n" << _time.datestr() << "_" << _time.timestr(3)
-          << " AMB " << par->prn.mid(0,3).toAscii().data() << " "
+          << " AMB " << par->prn.toString() << " "
           << setw(10) << setprecision(3) << par->xx
           << " +- " << setw(6) << setprecision(3)
           << sqrt(_QQ(par->index,par->index))
@@ -2635,7 +2699,7 @@ t_irc t_pppFilter::update(t_epoData* epoData) {
     else if (par->type == t_pppParam::TROPO) {
       double aprTrp = delay_saast(M_PI/2.0);
       LOG << "\n" << _time.datestr() << "_" << _time.timestr(3)
-          << " TRP     " << par->prn.mid(0,3).toAscii().data()
+          << " TRP     "
           << setw(7) << setprecision(3) << aprTrp << " "
           << setw(6) << setprecision(3) << showpos << par->xx << noshowpos
           << " +- " << setw(6) << setprecision(3)
@@ -2722,54 +2786,59 @@ t_irc t_pppFilter::update(t_epoData* epoData) {
 
 // Outlier Detection
 ////////////////////////////////////////////////////////////////////////////
-QString t_pppFilter::outlierDetection(int iPhase, const ColumnVector& vv,
-                                      QMap<QString, t_satData*>& satData) {
+t_prn t_pppFilter::outlierDetection(int iPhase, const ColumnVector& vv,
+                                    t_satDataMap& satData) {
 
   Tracer tracer("t_pppFilter::outlierDetection");
 
-  QString prnGPS;
-  QString prnGlo;
+  t_prn   prnGPS;
+  t_prn   prnGlo;
   double  maxResGPS = 0.0; // GPS + Galileo
   double  maxResGlo = 0.0; // GLONASS + BDS
   findMaxRes(vv, satData, prnGPS, prnGlo, maxResGPS, maxResGlo);
 
   if      (iPhase == 1) {
     if      (maxResGlo > 2.98 * OPT->_maxResL1) {
-      LOG << "Outlier Phase " << prnGlo.mid(0,3).toAscii().data() << ' ' << maxResGlo << endl;
+      LOG << "Outlier Phase " << prnGlo.toString() << ' ' << maxResGlo << endl;
       return prnGlo;
     }
     else if (maxResGPS > MAXRES_PHASE_GPS) {
-      LOG << "Outlier Phase " << prnGPS.mid(0,3).toAscii().data() << ' ' << maxResGPS << endl;
+      LOG << "Outlier Phase " << prnGPS.toString() << ' ' << maxResGPS << endl;
       return prnGPS;
     }
   }
   else if (iPhase == 0 && maxResGPS > 2.98 * OPT->_maxResC1) {
-    LOG << "Outlier Code  " << prnGPS.mid(0,3).toAscii().data() << ' ' << maxResGPS << endl;
+    LOG << "Outlier Code  " << prnGPS.toString() << ' ' << maxResGPS << endl;
     return prnGPS;
   }
 
-  return QString();
+  return t_prn();
 }
 
 // Phase Wind-Up Correction
 ///////////////////////////////////////////////////////////////////////////
-double t_pppFilter::windUp(const QString& prn, const ColumnVector& rSat,
+double t_pppFilter::windUp(const t_prn& prn, const ColumnVector& rSat,
                         const ColumnVector& rRec) {
 
   Tracer tracer("t_pppFilter::windUp");
 
   double Mjd = _time.mjd() + _time.daysec() / 86400.0;
 
+  int iSat = prn.toIndex();
+  if (iSat < 0) {
+    return 0.0;
+  }
+
   // First time - initialize to zero
   // -------------------------------
-  if (!_windUpTime.contains(prn)) {
-    _windUpSum[prn]  = 0.0;
+  if (_windUpTime[iSat] == 0.0) {
+    _windUpSum[iSat]  = 0.0;
   }
 
   // Compute the correction for new time
   // -----------------------------------
-  if (!_windUpTime.contains(prn) || _windUpTime[prn] != Mjd) {
-    _windUpTime[prn] = Mjd;
+  if (_windUpTime[iSat] != Mjd) {
+    _windUpTime[iSat] = Mjd;
 
     // Unit Vector GPS Satellite --> Receiver
     // --------------------------------------
@@ -2828,10 +2897,10 @@ double t_pppFilter::windUp(const QString& prn, const ColumnVector& rSat,
       dphi = -dphi;
     }
 
-    _windUpSum[prn] = floor(_windUpSum[prn] - dphi + 0.5) + dphi;
+    _windUpSum[iSat] = floor(_windUpSum[iSat] - dphi + 0.5) + dphi;
   }
 
-  return _windUpSum[prn];
+  return _windUpSum[iSat];
 }
 
 //
@@ -2930,22 +2999,20 @@ void t_pppFilter::addObs(int iPhase, unsigned& iObs, t_satData* satData,
 //
 ///////////////////////////////////////////////////////////////////////////
 QByteArray t_pppFilter::printRes(int iPhase, const ColumnVector& vv,
-                              const QMap<QString, t_satData*>& satDataMap) {
+                              const t_satDataMap& satDataMap) {
 
   Tracer tracer("t_pppFilter::printRes");
 
   ostringstream str;
   str.setf(ios::fixed);
   bool useObs;
-  QMapIterator<QString, t_satData*> it(satDataMap);
-  while (it.hasNext()) {
-    it.next();
-    t_satData* satData = it.value();
+  for (int iSat = 0; iSat < satDataMap.size(); iSat++) {
+    t_satData* satData = satDataMap.at(iSat);
     (iPhase == 0) ? useObs = OPT->codeLCs(satData->system()).size() :
                     useObs = OPT->ambLCs(satData->system()).size();
     if (satData->obsIndex != 0 && useObs) {
       str << _time.datestr() << "_" << _time.timestr(3)
-          << " RES " << satData->prn.mid(0,3).toAscii().data()
+          << " RES " << satData->prn.toString()
           << (iPhase ? "   L3 " : "   P3 ")
           << setw(9) << setprecision(4) << vv(satData->obsIndex) << endl;
     }
@@ -2957,8 +3024,8 @@ QByteArray t_pppFilter::printRes(int iPhase, const ColumnVector& vv,
 //
 ///////////////////////////////////////////////////////////////////////////
 void t_pppFilter::findMaxRes(const ColumnVector& vv,
-                          const QMap<QString, t_satData*>& satData,
-                          QString& prnGPS, QString& prnGlo,
+                          const t_satDataMap& satData,
+                          t_prn& prnGPS, t_prn& prnGlo,
                           double& maxResGPS, double& maxResGlo) {
 
   Tracer tracer("t_pppFilter::findMaxRes");
@@ -2966,21 +3033,19 @@ void t_pppFilter::findMaxRes(const ColumnVector& vv,
   maxResGPS  = 0.0;
   maxResGlo  = 0.0;
 
-  QMapIterator<QString, t_satData*> it(satData);
-  while (it.hasNext()) {
-    it.next();
-    t_satData* satData = it.value();
-    if (satData->obsIndex != 0) {
-      QString prn = satData->prn;
-      if (prn[0] == 'R' || prn[0] == 'C') {
-        if (fabs(vv(satData->obsIndex)) > maxResGlo) {
-          maxResGlo = fabs(vv(satData->obsIndex));
+  for (int iSat = 0; iSat < satData.size(); iSat++) {
+    const t_satData* sd = satData.at(iSat);
+    if (sd->obsIndex != 0) {
+      const t_prn& prn = sd->prn;
+      if (prn.system() == 'R' || prn.system() == 'C') {
+        if (fabs(vv(sd->obsIndex)) > maxResGlo) {
+          maxResGlo = fabs(vv(sd->obsIndex));
           prnGlo    = prn;
         }
       }
       else {
-        if (fabs(vv(satData->obsIndex)) > maxResGPS) {
-          maxResGPS = fabs(vv(satData->obsIndex));
+        if (fabs(vv(sd->obsIndex)) > maxResGPS) {
+          maxResGPS = fabs(vv(sd->obsIndex));
           prnGPS    = prn;
         }
       }
@@ -2988,6 +3053,29 @@ void t_pppFilter::findMaxRes(const ColumnVector& vv,
   }
 }
 
+// Number, RMS and maximum of the residuals used in the solution
+////////////////////////////////////////////////////////////////////////////
+void t_pppFilter::cmpResSummary(int iPhase, const ColumnVector& vv,
+                                const t_satDataMap& satData) {
+  int    numRes = 0;
+  double sumSqr = 0.0;
+  double maxRes = 0.0;
+  for (int iSat = 0; iSat < satData.size(); iSat++) {
+    const t_satData* sd = satData.at(iSat);
+    if (sd->obsIndex != 0) {
+      double res = vv(sd->obsIndex);
+      ++numRes;
+      sumSqr += res * res;
+      if (fabs(res) > maxRes) {
+        maxRes = fabs(res);
+      }
+    }
+  }
+  _numRes[iPhase] = numRes;
+  _rmsRes[iPhase] = numRes ? sqrt(sumSqr / numRes) : 0.0;
+  _maxRes[iPhase] = maxRes;
+}
+
 // Update Step (private - loop over outliers)
 ////////////////////////////////////////////////////////////////////////////
 t_irc t_pppFilter::update_p(t_epoData* epoData) {
@@ -2998,7 +3086,13 @@ t_irc t_pppFilter::update_p(t_epoData* epoData) {
   // --------------------------------------------------
   rememberState(epoData);
 
-  QString lastOutlierPrn;
+  for (int iPhase = 0; iPhase <= 1; iPhase++) {
+    _numRes[iPhase] = 0;
+    _rmsRes[iPhase] = 0.0;
+    _maxRes[iPhase] = 0.0;
+  }
+
+  t_prn lastOutlierPrn; // number 0: no outlier
 
   // Try with all satellites, then with all minus one, etc.
   // ------------------------------------------------------
@@ -3062,12 +3156,8 @@ t_irc t_pppFilter::update_p(t_epoData* epoData) {
       DiagonalMatrix  PP(nObs); PP = 0.0;
 
       unsigned iObs = 0;
-      QMapIterator<QString, t_satData*> it(epoData->satData);
-
-      while (it.hasNext()) {
-        it.next();
-        t_satData* satData = it.value();
-        QString prn = satData->prn;
+      for (int iSat = 0; iSat < epoData->satData.size(); iSat++) {
+        t_satData* satData = epoData->satData.at(iSat);
         (iPhase == 0) ? useObs = OPT->codeLCs(satData->system()).size() :
                         useObs = OPT->ambLCs(satData->system()).size();
         if (useObs) {
@@ -3080,7 +3170,7 @@ t_irc t_pppFilter::update_p(t_epoData* epoData) {
       // Compute Filter Update
       // ---------------------
       ColumnVector dx(nPar); dx = 0.0;
-      kalman(AA, ll, PP, _QQ, dx);
+      _kalman.update(AA, ll, PP, _QQ, dx);
       ColumnVector vv = ll - AA * dx;
 
       // Print Residuals
@@ -3098,7 +3188,9 @@ t_irc t_pppFilter::update_p(t_epoData* epoData) {
 
       // No Outlier Detected
       // -------------------
-      if (lastOutlierPrn.isEmpty()) {
+      if (lastOutlierPrn.number() == 0) {
+
+        cmpResSummary(iPhase, vv, epoData->satData);
 
         QVectorIterator<t_pppParam*> itPar(_params);
         while (itPar.hasNext()) {
@@ -3110,12 +3202,12 @@ t_irc t_pppFilter::update_p(t_epoData* epoData) {
           if (_outlierGPS.size() > 0 || _outlierGlo.size() > 0) {
             LOG << "Neglected PRNs: ";
             if (!_outlierGPS.isEmpty()) {
-              LOG << _outlierGPS.last().mid(0,3).toAscii().data() << ' ';
+              LOG << _outlierGPS.last().toString() << ' ';
             }
-            QStringListIterator itGlo(_outlierGlo);
+            QListIterator<t_prn> itGlo(_outlierGlo);
             while (itGlo.hasNext()) {
-              QString prn = itGlo.next();
-              LOG << prn.mid(0,3).toAscii().data() << ' ';
+              const t_prn& prn = itGlo.next();
+              LOG << prn.toString() << ' ';
             }
             LOG << endl;
           }
@@ -3186,12 +3278,12 @@ void t_pppFilter::restoreState(t_epoData* epoData) {
 
 //
 ////////////////////////////////////////////////////////////////////////////
-t_irc t_pppFilter::selectSatellites(const QString& lastOutlierPrn,
-                                 QMap<QString, t_satData*>& satData) {
+t_irc t_pppFilter::selectSatellites(const t_prn& lastOutlierPrn,
+                                 t_satDataMap& satData) {
 
   // First Call
   // ----------
-  if (lastOutlierPrn.isEmpty()) {
+  if (lastOutlierPrn.number() == 0) {
     _outlierGPS.clear();
     _outlierGlo.clear();
     return success;
@@ -3201,21 +3293,18 @@ t_irc t_pppFilter::selectSatellites(const QString& lastOutlierPrn,
   // ----------------------
   else {
 
-    if (lastOutlierPrn[0] == 'R' || lastOutlierPrn[0] == 'C') {
+    if (lastOutlierPrn.system() == 'R' || lastOutlierPrn.system() == 'C') {
       _outlierGlo << lastOutlierPrn;
     }
 
     // Remove all Glonass Outliers
     // ---------------------------
-    QStringListIterator it(_outlierGlo);
+    QListIterator<t_prn> it(_outlierGlo);
     while (it.hasNext()) {
-      QString prn = it.next();
-      if (satData.contains(prn)) {
-        delete satData.take(prn);
-      }
+      delete satData.take(it.next());
     }
 
-    if (lastOutlierPrn[0] == 'R' || lastOutlierPrn[0] == 'C') {
+    if (lastOutlierPrn.system() == 'R' || lastOutlierPrn.system() == 'C') {
       _outlierGPS.clear();
       return success;
     }
@@ -3224,9 +3313,7 @@ t_irc t_pppFilter::selectSatellites(const QString& lastOutlierPrn,
     // ----------------------------------------------------------
     if (_outlierGPS.indexOf(lastOutlierPrn) == -1) {
       _outlierGPS << lastOutlierPrn;
-      if (satData.contains(lastOutlierPrn)) {
-        delete satData.take(lastOutlierPrn);
-      }
+      delete satData.take(lastOutlierPrn);
       return success;
     }
 
@@ -3328,10 +3415,8 @@ void t_pppFilter::cmpDOP(t_epoData* epoData) {
 
   const unsigned numPar = 4;
   Matrix AA(epoData->sizeAll(), numPar);
-  QMapIterator<QString, t_satData*> it(epoData->satData);
-  while (it.hasNext()) {
-    it.next();
-    t_satData* satData = it.value();
+  for (int iSat = 0; iSat < epoData->satData.size(); iSat++) {
+    t_satData* satData = epoData->satData.at(iSat);
     _numSat += 1;
     for (unsigned iPar = 0; iPar < numPar; iPar++) {
       AA[_numSat-1][iPar] = _params[iPar]->partial(satData, false);
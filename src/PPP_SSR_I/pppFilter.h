@@ -31,6 +31,8 @@
 
 #include "bncconst.h"
 #include "bnctime.h"
+#include "bnckalman.h"
+#include "t_prn.h"
 
 #include <fstream>// chaiyut read text file
 #include <limits>
@@ -152,7 +154,7 @@ class t_satData {
   }
   ~t_satData() {}
   bncTime      tt;
-  QString      prn;
+  t_prn        prn;
   double       P1;
   double       P2;
   double       P5;
@@ -174,7 +176,32 @@ class t_satData {
   double       lkA;
   double       lkB;
   unsigned     obsIndex;
-  char system() const {return prn.toAscii()[0];}
+  char system() const {return prn.system();}
+};
+
+// Satellites of one epoch, indexed by t_prn::toIndex(); the list is kept
+// sorted by satellite (system, number, flags)
+class t_satDataMap {
+ public:
+  t_satDataMap() {
+    for (unsigned ii = 0; ii < t_prn::NUMINDEX; ii++) {
+      _byIndex[ii] = 0;
+    }
+  }
+  int        size() const {return _sats.size();}
+  t_satData* at(int ii) const {return _sats[ii];}
+  t_satData* find(const t_prn& prn) const {
+    int index = prn.toIndex();
+    return (index >= 0) ? _byIndex[index] : 0;
+  }
+  bool       contains(const t_prn& prn) const {return find(prn) != 0;}
+  bool       insert(t_satData* satData);
+  t_satData* take(const t_prn& prn);
+  t_satData* takeAt(int ii);
+  void       clear();
+ private:
+  t_satData*          _byIndex[t_prn::NUMINDEX];
+  QVector<t_satData*> _sats;
 };
 
 class t_epoData {
@@ -186,10 +213,8 @@ class t_epoData {
   }
 
   void clear() {
-    QMapIterator<QString, t_satData*> it(satData);
-    while (it.hasNext()) {
-      it.next();
-      delete it.value();
+    for (int ii = 0; ii < satData.size(); ii++) {
+      delete satData.at(ii);
     }
     satData.clear();
     tt.reset();
@@ -198,19 +223,15 @@ class t_epoData {
   void deepCopy(const t_epoData* from) {
     clear();
     tt = from->tt;
-    QMapIterator<QString, t_satData*> it(from->satData);
-    while (it.hasNext()) {
-      it.next();
-      satData[it.key()] = new t_satData(*it.value());
+    for (int ii = 0; ii < from->satData.size(); ii++) {
+      satData.insert(new t_satData(*from->satData.at(ii)));
     }
   }
 
   unsigned sizeSys(char system) const {
     unsigned ans = 0;
-    QMapIterator<QString, t_satData*> it(satData);
-    while (it.hasNext()) {
-      it.next();
-      if (it.value()->system() == system) {
+    for (int ii = 0; ii < satData.size(); ii++) {
+      if (satData.at(ii)->system() == system) {
         ++ans;
       }
     }
@@ -218,15 +239,15 @@ class t_epoData {
   }
   unsigned sizeAll() const {return satData.size();}
 
-  bncTime                   tt;
-  QMap<QString, t_satData*> satData;
+  bncTime      tt;
+  t_satDataMap satData;
 };
 
 class t_pppParam {
  public:
   enum parType {CRD_X, CRD_Y, CRD_Z, RECCLK, TROPO, AMB_L3,
                 GLONASS_OFFSET, GALILEO_OFFSET, BDS_OFFSET};
-  t_pppParam(parType typeIn, int indexIn, const QString& prn);
+  t_pppParam(parType typeIn, int indexIn, const t_prn& prn = t_prn());
   ~t_pppParam();
   double partial(t_satData* satData, bool phase);
   bool isCrd() const {
@@ -237,7 +258,7 @@ class t_pppParam {
   int      index;
   int      index_old;
   int      numEpo;
-  QString  prn;
+  t_prn    prn;
 };
 
 class t_pppFilter {
@@ -250,6 +271,9 @@ class t_pppFilter {
   const ColumnVector& neu() const {return _neu;}
   int    numSat() const {return _numSat;}
   double HDOP()   const {return _hDop;}
+  int    numRes(int iPhase) const {return _numRes[iPhase];}
+  double rmsRes(int iPhase) const {return _rmsRes[iPhase];}
+  double maxRes(int iPhase) const {return _maxRes[iPhase];}
   double x()      const {return _params[0]->xx;}
   double y()      const {return _params[1]->xx;}
   double z()      const {return _params[2]->xx;}
@@ -320,10 +344,12 @@ class t_pppFilter {
   void   addObs(int iPhase, unsigned& iObs, t_satData* satData,
                 Matrix& AA, ColumnVector& ll, DiagonalMatrix& PP);
   QByteArray printRes(int iPhase, const ColumnVector& vv,
-                      const QMap<QString, t_satData*>& satDataMap);
+                      const t_satDataMap& satDataMap);
+  void   cmpResSummary(int iPhase, const ColumnVector& vv,
+                       const t_satDataMap& satData);
   void   findMaxRes(const ColumnVector& vv,
-                    const QMap<QString, t_satData*>& satData,
-                    QString& prnGPS, QString& prnGlo,
+                    const t_satDataMap& satData,
+                    t_prn& prnGPS, t_prn& prnGlo,
                     double& maxResGPS, double& maxResGlo);
   double cmpValue(t_satData* satData, bool phase);
   double delay_saast(double Ele);
@@ -336,10 +362,10 @@ class t_pppFilter {
   
   void   predict(int iPhase, t_epoData* epoData);
   t_irc  update_p(t_epoData* epoData);
-  QString outlierDetection(int iPhase, const ColumnVector& vv,
-                           QMap<QString, t_satData*>& satData);
+  t_prn  outlierDetection(int iPhase, const ColumnVector& vv,
+                          t_satDataMap& satData);
 
-  double windUp(const QString& prn, const ColumnVector& rSat,
+  double windUp(const t_prn& prn, const ColumnVector& rSat,
                 const ColumnVector& rRec);
 
   bncTime  _startTime;
@@ -347,8 +373,8 @@ class t_pppFilter {
   void rememberState(t_epoData* epoData);
   void restoreState(t_epoData* epoData);
 
-  t_irc selectSatellites(const QString& lastOutlierPrn,
-                         QMap<QString, t_satData*>& satData);
+  t_irc selectSatellites(const t_prn& lastOutlierPrn,
+                         t_satDataMap& satData);
 
   void bancroft(const Matrix& BBpass, ColumnVector& pos);
 
@@ -359,20 +385,25 @@ class t_pppFilter {
   bncTime               _lastTimeOK;
   QVector<t_pppParam*>  _params;
   SymmetricMatrix       _QQ;
+  bncKalman             _kalman;
   QVector<t_pppParam*>  _params_sav;
   SymmetricMatrix       _QQ_sav;
   t_epoData*            _epoData_sav;
   ColumnVector          _xcBanc;
   ColumnVector          _ellBanc;
-  QMap<QString, double> _windUpTime;
-  QMap<QString, double> _windUpSum;
-  QStringList           _outlierGPS;
-  QStringList           _outlierGlo;
+  double                _windUpTime[t_prn::NUMINDEX]; // 0.0 = not yet computed
+  double                _windUpSum[t_prn::NUMINDEX];
+  QList<t_prn>          _outlierGPS;
+  QList<t_prn>          _outlierGlo;
   bncAntex*             _antex;
+  int                   _antIndexRover;
   t_tides*              _tides;
   ColumnVector          _neu;
   int                   _numSat;
   double                _hDop;
+  int                   _numRes[2];  // code, phase
+  double                _rmsRes[2];
+  double                _maxRes[2];
   
   //++++++++++++++++++++++++
   // Modified by Chaiyut
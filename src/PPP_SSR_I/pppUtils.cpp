@@ -40,6 +40,10 @@ t_pppUtils::~t_pppUtils() {
 //
 //////////////////////////////////////////////////////////////////////////////
 void t_pppUtils::putCodeBias(t_satCodeBias* satCodeBias) {
+  if (satCodeBias->_prn.toIndex() < 0) {
+    delete satCodeBias;
+    return;
+  }
   int iPrn = satCodeBias->_prn.toInt();
   delete _satCodeBiases[iPrn];
   _satCodeBiases[iPrn] = satCodeBias;
@@ -39,9 +39,7 @@
  * -----------------------------------------------------------------------*/
 
 #include <math.h>
-#include <sstream>
-#include <iomanip>
-#include <set>
+#include <stdio.h>
 
 #include "../bncutils.h"
 #include "rtcm_utils.h"
@@ -50,6 +48,11 @@
 using namespace std;
 using namespace rtcm2;
 
+// Activate (1) or deactivate (0) the report of corrections without
+// matching ephemerides (missing IODs) in the error messages
+
+#define DEBUG 0
+
 //
 // Constructor
 //
@@ -262,11 +265,16 @@ void RTCM2Decoder::translateCorr2Obs(vector<string>& errmsg) {
   double GPSWeeks_rcv;
   resolveEpoch(hoursec_rcv, refWeek, refSecs, GPSWeek_rcv, GPSWeeks_rcv);
 
+  bncTime epoTime(GPSWeek_rcv, GPSWeeks_rcv);
+  if (epoTime.mjd() == 0) {
+    return;
+  }
+
   // Loop over all satellites
   // ------------------------
-  for (RTCM2_2021::data_iterator icorr = _msg2021.data.begin();
+  for (RTCM2_2021::c_data_iterator icorr = _msg2021.data.begin();
       icorr != _msg2021.data.end(); icorr++) {
-    const RTCM2_2021::HiResCorr* corr = icorr->second;
+    const RTCM2_2021::HiResCorr* corr = *icorr;
 
     // beg test
     if (corr->PRN >= 200) {
@@ -274,24 +282,60 @@ void RTCM2Decoder::translateCorr2Obs(vector<string>& errmsg) {
     }
     // end test
 
-    QString prn;
-    char sys;
+    t_prn prn;
     if (corr->PRN < 200) {
-      sys = 'G';
-      prn = sys + QString("%1_0").arg(corr->PRN, 2, 10, QChar('0'));
+      prn.set('G', corr->PRN);
     } else {
-      sys = 'R';
-      prn = sys + QString("%1_0").arg(corr->PRN - 200, 2, 10, QChar('0'));
+      prn.set('R', corr->PRN - 200);
+    }
+    char sys = prn.system();
+
+    // Ephemerides matching the IODs of L1, L2, P1, P2
+    // -----------------------------------------------
+    const unsigned IODcorr[4] = {corr->IODp1, corr->IODp2, corr->IODr1, corr->IODr2};
+    const double   corrVal[4] = {corr->phase1 * LAMBDA_1, corr->phase2 * LAMBDA_2,
+                                 corr->range1, corr->range2};
+    const t_eph* ephLast = _ephUser.ephLast(prn);
+    const t_eph* ephPrev = _ephUser.ephPrev(prn);
+    const t_eph* eph[4];
+    bool anyEph = false;
+    for (unsigned ii = 0; ii < 4; ii++) {
+      eph[ii] = 0;
+      if (ephLast && ephLast->IOD() == IODcorr[ii]) {
+        eph[ii] = ephLast;
+      } else if (ephPrev && ephPrev->IOD() == IODcorr[ii]) {
+        eph[ii] = ephPrev;
+      }
+      anyEph = anyEph || eph[ii];
+    }
+
+#if ( DEBUG > 0 )
+    // Error report
+    string missingIOD;
+    for (unsigned ii = 0; ii < 4; ii++) {
+      if (!eph[ii] && IODcorr[ii] != 0) {
+        static const char* const obsT[4] = {"L1", "L2", "P1", "P2"};
+        char msg[16];
+        sprintf(msg, "%s:%3u   ", obsT[ii], IODcorr[ii]);
+        missingIOD += msg;
+      }
+    }
+    if (!missingIOD.empty()) {
+      errmsg.push_back("missing eph for " + prn.toInternalString() + " , IODs "
+                       + missingIOD);
     }
+#endif
 
-    double L1 = 0;
-    double L2 = 0;
-    double P1 = 0;
-    double P2 = 0;
-    string obsT = "";
+    if (!anyEph) {
+      continue;
+    }
 
-    // new observation
-    t_satObs new_obs;
+    // New observation, filled in place
+    // --------------------------------
+    _obsList.append(t_satObs());
+    t_satObs& new_obs = _obsList.last();
+    new_obs._prn = prn;
+    new_obs._time = epoTime;
 
     t_frqObs* frqObs1C = new t_frqObs;
     frqObs1C->_rnxType2ch = "1C";
@@ -305,131 +349,60 @@ void RTCM2Decoder::translateCorr2Obs(vector<string>& errmsg) {
     frqObs2P->_rnxType2ch = (sys == 'G') ? "2W" : "2P";
     new_obs._obs.push_back(frqObs2P);
 
-    // missing IOD
-    vector<string> missingIOD;
-    vector<string> hasIOD;
+    // Geometry once per ephemeris (usually all IODs are equal)
+    // --------------------------------------------------------
+    const t_eph* rhoEph = 0;
+    double rho = 0.0, clkSat = 0.0;
     for (unsigned ii = 0; ii < 4; ii++) {
-      unsigned int IODcorr = 0;
-      double corrVal = 0;
-      const t_eph* eph = 0;
-      double* obsVal = 0;
+      if (!eph[ii]) {
+        continue;
+      }
+      if (eph[ii] != rhoEph) {
+        int GPSWeek_tot;
+        double GPSWeeks_tot;
+        double xSat, ySat, zSat;
+        cmpRho(eph[ii], stax, stay, staz, GPSWeek, GPSWeeks, rho, GPSWeek_tot,
+            GPSWeeks_tot, xSat, ySat, zSat, clkSat);
+        rhoEph = eph[ii];
+      }
 
+      double obsVal = rho - corrVal[ii] + rcv_clk_bias - clkSat;
+
+      if (obsVal == 0)
+        obsVal = ZEROVALUE;
+
+      // Store estimated measurements
+      // ----------------------------
       switch (ii) {
         case 0: // --- L1 ---
-          IODcorr = corr->IODp1;
-          corrVal = corr->phase1 * LAMBDA_1;
-          obsVal = &L1;
-          obsT = "L1";
+          frqObs1P->_phaseValid = true;
+          frqObs1P->_phase = obsVal / LAMBDA_1;
+          //frqObs1P->_slipCounter = corr->lock1;
+          frqObs1P->_slipCounter = -1; // because RTCM2 definition is vice versa to RTCM3
           break;
         case 1: // --- L2 ---
-          IODcorr = corr->IODp2;
-          corrVal = corr->phase2 * LAMBDA_2;
-          obsVal = &L2;
-          obsT = "L2";
+          frqObs2P->_phaseValid = true;
+          frqObs2P->_phase = obsVal / LAMBDA_2;
+          //frqObs2P->_slipCounter = corr->lock2;
+          frqObs2P->_slipCounter = -1; // because RTCM2 definition is vice versa to RTCM3
           break;
-        case 2: // --- P1 ---
-          IODcorr = corr->IODr1;
-          corrVal = corr->range1;
-          obsVal = &P1;
-          obsT = "P1";
+        case 2: // --- C1 / P1 ---
+          if (corr->Pind1) {
+            frqObs1P->_codeValid = true;
+            frqObs1P->_code = obsVal;
+          } else {
+            frqObs1C->_codeValid = true;
+            frqObs1C->_code = obsVal;
+          }
           break;
-        case 3: // --- P2 ---
-          IODcorr = corr->IODr2;
-          corrVal = corr->range2;
-          obsVal = &P2;
-          obsT = "P2";
+        case 3: // --- C2 / P2 ---
+          if (corr->Pind2) {
+            frqObs2P->_codeValid = true;
+            frqObs2P->_code = obsVal;
+          }
           break;
-        default:
-          continue;
-      }
-
-      // Select corresponding ephemerides
-      const t_eph* ephLast = _ephUser.ephLast(prn);
-      const t_eph* ephPrev = _ephUser.ephPrev(prn);
-      if (ephLast && ephLast->IOD() == IODcorr) {
-        eph = ephLast;
-      } else if (ephPrev && ephPrev->IOD() == IODcorr) {
-        eph = ephPrev;
-      }
-
-      if (eph) {
-        ostringstream msg;
-        msg << obsT << ':' << setw(3) << eph->IOD();
-        hasIOD.push_back(msg.str());
-
-        int GPSWeek_tot;
-        double GPSWeeks_tot;
-        double rho, xSat, ySat, zSat, clkSat;
-        cmpRho(eph, stax, stay, staz, GPSWeek, GPSWeeks, rho, GPSWeek_tot,
-            GPSWeeks_tot, xSat, ySat, zSat, clkSat);
-
-        *obsVal = rho - corrVal + rcv_clk_bias - clkSat;
-
-        if (*obsVal == 0)
-          *obsVal = ZEROVALUE;
-
-        if (corr->PRN < 200) {
-          new_obs._prn.set('G', corr->PRN);
-        } else {
-          new_obs._prn.set('R', corr->PRN - 200);
-        }
-        new_obs._time.set(GPSWeek_rcv, GPSWeeks_rcv);
-
-        // Store estimated measurements
-        // ----------------------------
-        switch (ii) {
-          case 0: // --- L1 ---
-            frqObs1P->_phaseValid = true;
-            frqObs1P->_phase = *obsVal / LAMBDA_1;
-            //frqObs1P->_slipCounter = corr->lock1;
-            frqObs1P->_slipCounter = -1; // because RTCM2 definition is vice versa to RTCM3
-            break;
-          case 1: // --- L2 ---
-            frqObs2P->_phaseValid = true;
-            frqObs2P->_phase = *obsVal / LAMBDA_2;
-            //frqObs2P->_slipCounter = corr->lock2;
-            frqObs2P->_slipCounter = -1; // because RTCM2 definition is vice versa to RTCM3
-            break;
-          case 2: // --- C1 / P1 ---
-            if (corr->Pind1) {
-              frqObs1P->_codeValid = true;
-              frqObs1P->_code = *obsVal;
-            } else {
-              frqObs1C->_codeValid = true;
-              frqObs1C->_code = *obsVal;
-            }
-            break;
-          case 3: // --- C2 / P2 ---
-            if (corr->Pind2) {
-              frqObs2P->_codeValid = true;
-              frqObs2P->_code = *obsVal;
-            }
-            break;
-          default:
-            continue;
-        }
-      } else if (IODcorr != 0) {
-        ostringstream msg;
-        msg << obsT << ':' << setw(3) << IODcorr;
-        missingIOD.push_back(msg.str());
       }
-    } // loop over frequencies
-
-    // Error report
-    if (missingIOD.size()) {
-      ostringstream missingIODstr;
-
-      copy(missingIOD.begin(), missingIOD.end(),
-          ostream_iterator<string>(missingIODstr, "   "));
-
-      errmsg.push_back(
-          "missing eph for " + string(prn.toAscii().data()) + " , IODs "
-              + missingIODstr.str());
     }
 
-    // Store new observation
-    if (new_obs._time.mjd() > 0) {
-      _obsList.push_back(new_obs);
-    }
   }
 }
@@ -54,6 +54,8 @@ class RTCM2Decoder: public GPSDecoder {
 
   private:
 
+    // Observations from the corrections of messages 20/21 (one pass over
+    // the satellites, one geometry per ephemeris)
     void translateCorr2Obs(std::vector<std::string>& errmsg);
 
     QMutex             _mutex;
@@ -69,13 +69,16 @@ void RTCM2_2021::extract(const RTCM2packet& P) {
       PRN = 32;
     }
 
-    HiResCorr* corr = 0;
-    if ( !(corr = find_i(PRN)) ) {
-      data_i_[PRN] = HiResCorr();
-      corr = &(data_i_[PRN]);
-    }
-    if ( !find(PRN) ) {
-      data[PRN] = corr;
+    // Slot of the satellite, added to the epoch in PRN order
+    unsigned   iSlot = slot(PRN);
+    HiResCorr* corr  = &slot_[iSlot];
+    if ( !inData_[iSlot] ) {
+      inData_[iSlot] = true;
+      data_iterator pos = data.end();
+      while ( pos != data.begin() && (*(pos-1))->PRN > PRN ) {
+        --pos;
+      }
+      data.insert(pos, corr);
     }
 
     corr->PRN = PRN;
@@ -128,24 +131,13 @@ void RTCM2_2021::extract(const RTCM2packet& P) {
   valid_ = !multipleMsgInd;
 }
 
-const RTCM2_2021::HiResCorr* RTCM2_2021::find(unsigned PRN) {
-  std::map<unsigned, const HiResCorr*>::const_iterator ii = data.find(PRN);
-  return (ii != data.end() ? ii->second : 0);
-}
-
-
-RTCM2_2021::HiResCorr* RTCM2_2021::find_i(unsigned PRN) {
-  std::map<unsigned, HiResCorr>::iterator ii = data_i_.find(PRN);
-  return (ii != data_i_.end() ? &(ii->second) : 0);
-}
-
-
 void RTCM2_2021::clear() {
   tt_    = 0;
   valid_ = false;
-  for (map<unsigned, HiResCorr>::iterator
-	 ii = data_i_.begin(); ii != data_i_.end(); ii++) {
-    ii->second.reset();
+  for (unsigned ii = 0; ii < data.size(); ii++) {
+    unsigned iSlot = slot(data[ii]->PRN);
+    slot_[iSlot].reset();
+    inData_[iSlot] = false;
   }
   data.clear();
 }
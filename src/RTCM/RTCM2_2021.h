@@ -1,5 +1,5 @@
 #include <iostream>
-#include <map>
+#include <vector>
 #include "RTCM2.h"
 
 namespace rtcm2 {
@@ -10,6 +10,9 @@ class RTCM2_2021 {
     RTCM2_2021() {// Constructor
       tt_    = 0.0;
       valid_ = false;
+      for (unsigned ii = 0; ii < NUMSLOT; ii++) {
+        inData_[ii] = false;
+      }
     }
 
     void   extract(const RTCM2packet& P);  // Packet handler
@@ -49,18 +52,21 @@ class RTCM2_2021 {
     };
 
     double hoursec() const { return tt_; }
-    std::map<unsigned, const HiResCorr*> data;
+    std::vector<const HiResCorr*> data;    // satellites of the epoch (PRN order)
 
-    typedef std::map<unsigned, const HiResCorr*>::const_iterator c_data_iterator;
-    typedef std::map<unsigned, const HiResCorr*>::iterator         data_iterator;
+    typedef std::vector<const HiResCorr*>::const_iterator c_data_iterator;
+    typedef std::vector<const HiResCorr*>::iterator         data_iterator;
+
+    // GPS PRN 1-32 and GLONASS slots 200-231
+    static const unsigned NUMSLOT = 64;
 
  private:
-    const HiResCorr* find  (unsigned PRN);
-          HiResCorr* find_i(unsigned PRN);
+    static unsigned slot(unsigned PRN) { return PRN < 200 ? PRN - 1 : PRN - 168; }
 
-    std::map<unsigned, HiResCorr> data_i_;
-    double                        tt_;
-    bool                          valid_;
+    HiResCorr slot_[NUMSLOT];              // kept over epochs (lock indicators)
+    bool      inData_[NUMSLOT];            // slot listed in data
+    double    tt_;
+    bool      valid_;
 };
 
 class RTCM2_22 {
@@ -47,6 +47,7 @@
 #include "bnccore.h"
 #include "bncsettings.h"
 #include "bnctime.h"
+#include "ssrSignals.h"
 
 using namespace std;
 
@@ -125,12 +126,11 @@ void RTCM3coDecoder::reopen() {
 
   if (!_fileNameSkl.isEmpty()) {
 
-    bncSettings settings;
+    const bncSettingsSnapshot* opt = bncSettings::snapshot();
 
     QDateTime datTim = currentDateAndTimeGPS();
 
-    QString hlpStr = bncRinex::nextEpochStr(datTim,
-                                      settings.value("corrIntr").toString(), false);
+    QString hlpStr = bncRinex::nextEpochStr(datTim, opt->corrIntr, false);
 
     QString fileNameHlp = _fileNameSkl
       + QString("%1").arg(datTim.date().dayOfYear(), 3, 10, QChar('0'))
@@ -144,7 +144,7 @@ void RTCM3coDecoder::reopen() {
     }
 
     delete _out;
-    if ( Qt::CheckState(settings.value("rnxAppend").toInt()) == Qt::Checked) {
+    if (opt->rnxAppend) {
       _out = new ofstream( _fileName.toAscii().data(), ios_base::out | ios_base::app );
     }
     else {
@@ -391,7 +391,7 @@ void RTCM3coDecoder::sendResults() {
     for (unsigned jj = 0; jj < _codeBias.Sat[ii].NumberOfCodeBiases; jj++) {
       const CodeBias::BiasSat::CodeBiasEntry& biasEntry = _codeBias.Sat[ii].Biases[jj];
       t_frqCodeBias frqCodeBias;
-      frqCodeBias._rnxType2ch.assign(codeTypeToRnxType(sysCh, biasEntry.Type));
+      frqCodeBias._rnxType2ch.assign(t_ssrSignals::rnxType(sysCh, biasEntry.Type));
       frqCodeBias._value      = biasEntry.Bias;
       if (!frqCodeBias._rnxType2ch.empty()) {
         satCodeBias._bias.push_back(frqCodeBias);
@@ -448,7 +448,7 @@ void RTCM3coDecoder::sendResults() {
     for (unsigned jj = 0; jj < _phaseBias.Sat[ii].NumberOfPhaseBiases; jj++) {
       const PhaseBias::PhaseBiasSat::PhaseBiasEntry& biasEntry = _phaseBias.Sat[ii].Biases[jj];
       t_frqPhaseBias frqPhaseBias;
-      frqPhaseBias._rnxType2ch.assign(codeTypeToRnxType(sysCh, biasEntry.Type));
+      frqPhaseBias._rnxType2ch.assign(t_ssrSignals::rnxType(sysCh, biasEntry.Type));
       frqPhaseBias._value                = biasEntry.Bias;
       frqPhaseBias._fixIndicator         = biasEntry.SignalIntegerIndicator;
       frqPhaseBias._fixWideLaneIndicator = biasEntry.SignalsWideLaneIntegerIndicator;
@@ -678,128 +678,3 @@ void RTCM3coDecoder::setEpochTime() {
   }
 }
 
-//
-////////////////////////////////////////////////////////////////////////////
-string RTCM3coDecoder::codeTypeToRnxType(char system, CodeType type) const {
-  if      (system == 'G') {
-    switch (type) {
-      case CODETYPEGPS_L1_CA:         return "1C";
-      case CODETYPEGPS_L1_P:          return "1P";
-      case CODETYPEGPS_L1_Z:          return "1W";
-      case CODETYPEGPS_L1_Y:          return "1Y";
-      case CODETYPEGPS_L1_M:          return "1M";
-      case CODETYPEGPS_L2_CA:         return "2C";
-      case CODETYPEGPS_SEMI_CODELESS: return "2D";
-      case CODETYPEGPS_L2C_M:         return "2S";
-      case CODETYPEGPS_L2C_L:         return "2L";
-      case CODETYPEGPS_L2C_ML:        return "2X";
-      case CODETYPEGPS_L2_P:          return "2P";
-      case CODETYPEGPS_L2_Z:          return "2W";
-      case CODETYPEGPS_L2_Y:          return "2Y";
-      case CODETYPEGPS_L2_M:          return "2M";
-      case CODETYPEGPS_L5_I:          return "5I";
-      case CODETYPEGPS_L5_Q:          return "5Q";
-      case CODETYPEGPS_L5_IQ:         return "5X";
-      case CODETYPEGPS_L1C_D:         return "1S";
-      case CODETYPEGPS_L1C_P:         return "1L";
-      case CODETYPEGPS_L1C_DP:        return "1X";
-      default: return "";
-    }
-  }
-  else if (system == 'R') {
-    switch (type) {
-      case CODETYPEGLONASS_L1_CA:     return "1C";
-      case CODETYPEGLONASS_L1_P:      return "1P";
-      case CODETYPEGLONASS_L2_CA:     return "2C";
-      case CODETYPEGLONASS_L2_P:      return "2P";
-      case CODETYPEGLONASS_L1a_OCd:   return "4A";
-      case CODETYPEGLONASS_L1a_OCp:   return "4B";
-      case CODETYPEGLONASS_L1a_OCdp:  return "4X";
-      case CODETYPEGLONASS_L2a_CSI:   return "6A";
-      case CODETYPEGLONASS_L2a_OCp:   return "6B";
-      case CODETYPEGLONASS_L2a_CSIOCp:return "6X";
-      case CODETYPEGLONASS_L3_I:      return "3I";
-      case CODETYPEGLONASS_L3_Q:      return "3Q";
-      case CODETYPEGLONASS_L3_IQ:     return "3X";
-      default: return "";
-    }
-  }
-  else if (system == 'E') {
-    switch (type) {
-      case CODETYPEGALILEO_E1_A:      return "1A";
-      case CODETYPEGALILEO_E1_B:      return "1B";
-      case CODETYPEGALILEO_E1_C:      return "1C";
-      case CODETYPEGALILEO_E1_BC:     return "1X";
-      case CODETYPEGALILEO_E1_ABC:    return "1Z";
-      case CODETYPEGALILEO_E5A_I:     return "5I";
-      case CODETYPEGALILEO_E5A_Q:     return "5Q";
-      case CODETYPEGALILEO_E5A_IQ:    return "5X";
-      case CODETYPEGALILEO_E5B_I:     return "7I";
-      case CODETYPEGALILEO_E5B_Q:     return "7Q";
-      case CODETYPEGALILEO_E5B_IQ:    return "7X";
-      case CODETYPEGALILEO_E5_I:      return "8I";
-      case CODETYPEGALILEO_E5_Q:      return "8Q";
-      case CODETYPEGALILEO_E5_IQ:     return "8X";
-      case CODETYPEGALILEO_E6_A:      return "6A";
-      case CODETYPEGALILEO_E6_B:      return "6B";
-      case CODETYPEGALILEO_E6_C:      return "6C";
-      case CODETYPEGALILEO_E6_BC:     return "6X";
-      case CODETYPEGALILEO_E6_ABC:    return "6Z";
-      default: return "";
-    }
-  }
-  else if (system == 'J') {
-    switch (type) {
-      case CODETYPEQZSS_L1_CA:         return "1C";
-      case CODETYPEQZSS_L1C_D:         return "1S";
-      case CODETYPEQZSS_L1C_P:         return "1L";
-      case CODETYPEQZSS_L2C_M:         return "2S";
-      case CODETYPEQZSS_L2C_L:         return "2L";
-      case CODETYPEQZSS_L2C_ML:        return "2X";
-      case CODETYPEQZSS_L5_I:          return "5I";
-      case CODETYPEQZSS_L5_Q:          return "5Q";
-      case CODETYPEQZSS_L5_IQ:         return "5X";
-      case CODETYPEQZSS_L6_D:          return "6S";
-      case CODETYPEQZSS_L6_P:          return "6L";
-      case CODETYPEQZSS_L6_DP:         return "6X";
-      case CODETYPEQZSS_L1C_DP:        return "1X";
-      case CODETYPEQZSS_L1_S:          return "1Z";
-      case CODETYPEQZSS_L5_D:          return "5D";
-      case CODETYPEQZSS_L5_P:          return "5P";
-      case CODETYPEQZSS_L5_DP:         return "5Z";
-      case CODETYPEQZSS_L6_E:          return "6E";
-      case CODETYPEQZSS_L6_DE:         return "6Z";
-      default: return "";
-    }
-  }
-  else if (system == 'S') {
-    switch (type) {
-      case CODETYPE_SBAS_L1_CA:       return "1C";
-      case CODETYPE_SBAS_L5_I:        return "5I";
-      case CODETYPE_SBAS_L5_Q:        return "5Q";
-      case CODETYPE_SBAS_L5_IQ:       return "5X";
-      default: return "";
-    }
-  }
-  else if (system == 'C') {
-    switch (type) {
-      case CODETYPE_BDS_B1_I:         return "2I";
-      case CODETYPE_BDS_B1_Q:         return "2Q";
-      case CODETYPE_BDS_B1_IQ:        return "2X";
-      case CODETYPE_BDS_B3_I:         return "6I";
-      case CODETYPE_BDS_B3_Q:         return "6Q";
-      case CODETYPE_BDS_B3_IQ:        return "6X";
-      case CODETYPE_BDS_B2_I:         return "7I";
-      case CODETYPE_BDS_B2_Q:         return "7Q";
-      case CODETYPE_BDS_B2_IQ:        return "7X";
-      case CODETYPE_BDS_B1a_D:        return "1D";
-      case CODETYPE_BDS_B1a_P:        return "1P";
-      case CODETYPE_BDS_B1a_DP:       return "1X";
-      case CODETYPE_BDS_B2a_D:        return "2D";
-      case CODETYPE_BDS_B2a_P:        return "2P";
-      case CODETYPE_BDS_B2a_DP:       return "2X";
-      default: return "";
-    }
-  }
-  return "";
-};
@@ -57,7 +57,6 @@ Q_OBJECT
   void sendResults();
   void reopen();
   void checkProviderID();
-  std::string codeTypeToRnxType(char system, CodeType type) const;
 
   std::ofstream*                        _out;
   QString                               _staID;
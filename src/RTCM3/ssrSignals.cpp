@@ -0,0 +1,126 @@
+
+#include <string.h>
+
+#include "ssrSignals.h"
+
+using namespace std;
+
+namespace {
+
+  // RINEX attributes, indexed by the SSR signal identifier
+  // ------------------------------------------------------
+  const char* const GPS[] = {
+    "1C", "1P", "1W", "1Y", "1M", "2C", "2D", "2S", "2L", "2X",
+    "2P", "2W", "2Y", "2M", "5I", "5Q", "5X", "1S", "1L", "1X"
+  };
+  const char* const GLONASS[] = {
+    "1C", "1P", "2C", "2P", "4A", "4B", "4X", "6A", "6B", "6X",
+    "3I", "3Q", "3X"
+  };
+  const char* const GALILEO[] = {
+    "1A", "1B", "1C", "1X", "1Z", "5I", "5Q", "5X", "7I", "7Q",
+    "7X", "8I", "8Q", "8X", "6A", "6B", "6C", "6X", "6Z"
+  };
+  const char* const QZSS[] = {
+    "1C", "1S", "1L", "2S", "2L", "2X", "5I", "5Q", "5X", "6S",
+    "6L", "6X", "1X", "1Z", "5D", "5P", "5Z", "6E", "6Z"
+  };
+  const char* const SBAS[] = {
+    "1C", "5I", "5Q", "5X"
+  };
+  const char* const BDS[] = {
+    "2I", "2Q", "2X", "6I", "6Q", "6X", "7I", "7Q", "7X", "1D",
+    "1P", "1X", "5D", "5P", "5X"
+  };
+
+  class t_table {
+   public:
+    t_table() : _rnx(0), _num(0) {}
+    t_table(const char* const* rnx, int num) : _rnx(rnx), _num(num) {}
+    const char* const* _rnx;
+    int                _num;
+  };
+
+  const char SYSTEMS[] = "GREJSC";
+  const int  NUMSYS    = 6;
+  const int  NUMBAND   = 10;
+  const int  NUMATTR   = 26;
+
+  int sysIndex(char system) {
+    const char* pos = strchr(SYSTEMS, system);
+    return (pos && system) ? int(pos - SYSTEMS) : -1;
+  }
+
+  t_table table(int iSys) {
+    switch (iSys) {
+      case 0: return t_table(GPS,     sizeof(GPS)     / sizeof(GPS[0]));
+      case 1: return t_table(GLONASS, sizeof(GLONASS) / sizeof(GLONASS[0]));
+      case 2: return t_table(GALILEO, sizeof(GALILEO) / sizeof(GALILEO[0]));
+      case 3: return t_table(QZSS,    sizeof(QZSS)    / sizeof(QZSS[0]));
+      case 4: return t_table(SBAS,    sizeof(SBAS)    / sizeof(SBAS[0]));
+      case 5: return t_table(BDS,     sizeof(BDS)     / sizeof(BDS[0]));
+    }
+    return t_table();
+  }
+
+  // Inverse tables, built once from the tables above
+  // ------------------------------------------------
+  class t_index {
+   public:
+    t_index() {
+      memset(_type, -1, sizeof(_type));
+      for (int iSys = 0; iSys < NUMSYS; iSys++) {
+        t_table tab = table(iSys);
+        for (int ii = 0; ii < tab._num; ii++) {
+          int iBand = tab._rnx[ii][0] - '0';
+          int iAttr = tab._rnx[ii][1] - 'A';
+          _type[iSys][iBand][iAttr] = ii;
+        }
+      }
+    }
+    signed char _type[NUMSYS][NUMBAND][NUMATTR];
+  };
+
+  const t_index& inverse() {
+    static const t_index index;
+    return index;
+  }
+}
+
+// RINEX attribute of an SSR signal ("" if unknown)
+////////////////////////////////////////////////////////////////////////////
+const char* t_ssrSignals::rnxType(char system, CodeType type) {
+  t_table tab = table(sysIndex(system));
+  if (int(type) < 0 || int(type) >= tab._num) {
+    return "";
+  }
+  return tab._rnx[type];
+}
+
+// SSR signal of a RINEX band and attribute
+////////////////////////////////////////////////////////////////////////////
+bool t_ssrSignals::codeType(char system, char band, char attribute, CodeType& type) {
+  int iSys  = sysIndex(system);
+  int iBand = band - '0';
+  int iAttr = attribute - 'A';
+  if (iSys  < 0 ||
+      iBand < 0 || iBand >= NUMBAND ||
+      iAttr < 0 || iAttr >= NUMATTR) {
+    return false;
+  }
+  signed char hlp = inverse()._type[iSys][iBand][iAttr];
+  if (hlp < 0) {
+    return false;
+  }
+  type = CodeType(hlp);
+  return true;
+}
+
+// SSR signal of a two-character RINEX attribute
+////////////////////////////////////////////////////////////////////////////
+bool t_ssrSignals::codeType(char system, const char* rnxType2ch, CodeType& type) {
+  if (!rnxType2ch || strlen(rnxType2ch) != 2) {
+    return false;
+  }
+  return codeType(system, rnxType2ch[0], rnxType2ch[1], type);
+}
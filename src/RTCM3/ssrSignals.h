@@ -0,0 +1,21 @@
+#ifndef SSRSIGNALS_H
+#define SSRSIGNALS_H
+
+extern "C" {
+#include "clock_orbit_rtcm.h"
+}
+
+// Mapping between RINEX 3 signal attributes (band and attribute, e.g. "1C",
+// "2W") and the SSR signal identifiers of clock_orbit_rtcm.h. Both
+// directions are table look-ups; the identifiers are dense per system, so
+// that the tables are indexed by (system, identifier) and
+// (system, band, attribute), respectively.
+////////////////////////////////////////////////////////////////////////////
+class t_ssrSignals {
+ public:
+  static const char* rnxType(char system, CodeType type);
+  static bool        codeType(char system, char band, char attribute, CodeType& type);
+  static bool        codeType(char system, const char* rnxType2ch, CodeType& type);
+};
+
+#endif
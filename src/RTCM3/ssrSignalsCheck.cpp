@@ -0,0 +1,240 @@
+// Check and benchmark of the SSR signal tables (t_ssrSignals), not part of
+// the BNC build. Compiled stand-alone (no Qt needed) from directory src:
+//
+//   gcc -O2 -c -o /tmp/clock_orbit_rtcm.o RTCM3/clock_and_orbit/clock_orbit_rtcm.c
+//   g++ -O2 -IRTCM3/clock_and_orbit -o /tmp/ssrSignalsCheck
+//       RTCM3/ssrSignalsCheck.cpp RTCM3/ssrSignals.cpp /tmp/clock_orbit_rtcm.o
+//
+//   /tmp/ssrSignalsCheck
+//       round-trip of every table entry (both directions) and comparison
+//       with the signal identifiers of clock_orbit_rtcm.h; exit code 1 on
+//       any mismatch
+//   /tmp/ssrSignalsCheck bench [numEpochs]
+//       code and phase biases of all satellites of all systems (four
+//       signals each) per epoch: signal look-up, filling of the bias structures
+//       and encoding (MakeCodeBias, MakePhaseBias), time per epoch
+
+#include <ctime>
+#include <iostream>
+#include <iomanip>
+#include <stdlib.h>
+#include <string.h>
+
+#include "ssrSignals.h"
+
+using namespace std;
+
+namespace {
+
+  // Expected identifiers (clock_orbit_rtcm.h)
+  // -----------------------------------------
+  struct t_expected {
+    char        system;
+    const char* rnxType;
+    CodeType    type;
+  };
+
+  const t_expected EXPECTED[] = {
+    {'G', "1C", CODETYPEGPS_L1_CA},       {'G', "1P", CODETYPEGPS_L1_P},
+    {'G', "1W", CODETYPEGPS_L1_Z},        {'G', "1Y", CODETYPEGPS_L1_Y},
+    {'G', "1M", CODETYPEGPS_L1_M},        {'G', "2C", CODETYPEGPS_L2_CA},
+    {'G', "2D", CODETYPEGPS_SEMI_CODELESS}, {'G', "2S", CODETYPEGPS_L2C_M},
+    {'G', "2L", CODETYPEGPS_L2C_L},       {'G', "2X", CODETYPEGPS_L2C_ML},
+    {'G', "2P", CODETYPEGPS_L2_P},        {'G', "2W", CODETYPEGPS_L2_Z},
+    {'G', "2Y", CODETYPEGPS_L2_Y},        {'G', "2M", CODETYPEGPS_L2_M},
+    {'G', "5I", CODETYPEGPS_L5_I},        {'G', "5Q", CODETYPEGPS_L5_Q},
+    {'G', "5X", CODETYPEGPS_L5_IQ},       {'G', "1S", CODETYPEGPS_L1C_D},
+    {'G', "1L", CODETYPEGPS_L1C_P},       {'G', "1X", CODETYPEGPS_L1C_DP},
+
+    {'R', "1C", CODETYPEGLONASS_L1_CA},   {'R', "1P", CODETYPEGLONASS_L1_P},
+    {'R', "2C", CODETYPEGLONASS_L2_CA},   {'R', "2P", CODETYPEGLONASS_L2_P},
+    {'R', "4A", CODETYPEGLONASS_L1a_OCd}, {'R', "4B", CODETYPEGLONASS_L1a_OCp},
+    {'R', "4X", CODETYPEGLONASS_L1a_OCdp}, {'R', "6A", CODETYPEGLONASS_L2a_CSI},
+    {'R', "6B", CODETYPEGLONASS_L2a_OCp}, {'R', "6X", CODETYPEGLONASS_L2a_CSIOCp},
+    {'R', "3I", CODETYPEGLONASS_L3_I},    {'R', "3Q", CODETYPEGLONASS_L3_Q},
+    {'R', "3X", CODETYPEGLONASS_L3_IQ},
+
+    {'E', "1A", CODETYPEGALILEO_E1_A},    {'E', "1B", CODETYPEGALILEO_E1_B},
+    {'E', "1C", CODETYPEGALILEO_E1_C},    {'E', "1X", CODETYPEGALILEO_E1_BC},
+    {'E', "1Z", CODETYPEGALILEO_E1_ABC},  {'E', "5I", CODETYPEGALILEO_E5A_I},
+    {'E', "5Q", CODETYPEGALILEO_E5A_Q},   {'E', "5X", CODETYPEGALILEO_E5A_IQ},
+    {'E', "7I", CODETYPEGALILEO_E5B_I},   {'E', "7Q", CODETYPEGALILEO_E5B_Q},
+    {'E', "7X", CODETYPEGALILEO_E5B_IQ},  {'E', "8I", CODETYPEGALILEO_E5_I},
+    {'E', "8Q", CODETYPEGALILEO_E5_Q},    {'E', "8X", CODETYPEGALILEO_E5_IQ},
+    {'E', "6A", CODETYPEGALILEO_E6_A},    {'E', "6B", CODETYPEGALILEO_E6_B},
+    {'E', "6C", CODETYPEGALILEO_E6_C},    {'E', "6X", CODETYPEGALILEO_E6_BC},
+    {'E', "6Z", CODETYPEGALILEO_E6_ABC},
+
+    {'J', "1C", CODETYPEQZSS_L1_CA},      {'J', "1S", CODETYPEQZSS_L1C_D},
+    {'J', "1L", CODETYPEQZSS_L1C_P},      {'J', "2S", CODETYPEQZSS_L2C_M},
+    {'J', "2L", CODETYPEQZSS_L2C_L},      {'J', "2X", CODETYPEQZSS_L2C_ML},
+    {'J', "5I", CODETYPEQZSS_L5_I},       {'J', "5Q", CODETYPEQZSS_L5_Q},
+    {'J', "5X", CODETYPEQZSS_L5_IQ},      {'J', "6S", CODETYPEQZSS_L6_D},
+    {'J', "6L", CODETYPEQZSS_L6_P},       {'J', "6X", CODETYPEQZSS_L6_DP},
+    {'J', "1X", CODETYPEQZSS_L1C_DP},     {'J', "1Z", CODETYPEQZSS_L1_S},
+    {'J', "5D", CODETYPEQZSS_L5_D},       {'J', "5P", CODETYPEQZSS_L5_P},
+    {'J', "5Z", CODETYPEQZSS_L5_DP},      {'J', "6E", CODETYPEQZSS_L6_E},
+    {'J', "6Z", CODETYPEQZSS_L6_DE},
+
+    {'S', "1C", CODETYPE_SBAS_L1_CA},     {'S', "5I", CODETYPE_SBAS_L5_I},
+    {'S', "5Q", CODETYPE_SBAS_L5_Q},      {'S', "5X", CODETYPE_SBAS_L5_IQ},
+
+    {'C', "2I", CODETYPE_BDS_B1_I},       {'C', "2Q", CODETYPE_BDS_B1_Q},
+    {'C', "2X", CODETYPE_BDS_B1_IQ},      {'C', "6I", CODETYPE_BDS_B3_I},
+    {'C', "6Q", CODETYPE_BDS_B3_Q},       {'C', "6X", CODETYPE_BDS_B3_IQ},
+    {'C', "7I", CODETYPE_BDS_B2_I},       {'C', "7Q", CODETYPE_BDS_B2_Q},
+    {'C', "7X", CODETYPE_BDS_B2_IQ},      {'C', "1D", CODETYPE_BDS_B1a_D},
+    {'C', "1P", CODETYPE_BDS_B1a_P},      {'C', "1X", CODETYPE_BDS_B1a_DP},
+    {'C', "5D", CODETYPE_BDS_B2a_D},      {'C', "5P", CODETYPE_BDS_B2a_P},
+    {'C', "5X", CODETYPE_BDS_B2a_DP}
+  };
+  const int NUMEXPECTED = sizeof(EXPECTED) / sizeof(EXPECTED[0]);
+
+  const char SYSTEMS[] = "GREJSC";
+
+  // Number of satellites and index of the first one in the bias structures
+  // ----------------------------------------------------------------------
+  const int NUMSAT[] = {CLOCKORBIT_NUMGPS,  CLOCKORBIT_NUMGLONASS,
+                        CLOCKORBIT_NUMGALILEO, CLOCKORBIT_NUMQZSS,
+                        CLOCKORBIT_NUMSBAS, CLOCKORBIT_NUMBDS};
+  const int OFFSET[] = {CLOCKORBIT_OFFSETGPS,  CLOCKORBIT_OFFSETGLONASS,
+                        CLOCKORBIT_OFFSETGALILEO, CLOCKORBIT_OFFSETQZSS,
+                        CLOCKORBIT_OFFSETSBAS, CLOCKORBIT_OFFSETBDS};
+
+  // Signals per satellite in the benchmark (a message of all satellites
+  // of one system must not exceed 1023 bytes)
+  // -----------------------------------------------------------------
+  const int MAXSIGNALS = 4;
+
+  // Round-trip of all table entries
+  // -------------------------------
+  int check() {
+    int numErr = 0;
+
+    // Tables against clock_orbit_rtcm.h, both directions
+    for (int ii = 0; ii < NUMEXPECTED; ii++) {
+      const t_expected& exp = EXPECTED[ii];
+      CodeType type;
+      if (!t_ssrSignals::codeType(exp.system, exp.rnxType, type) || type != exp.type) {
+        cout << "codeType " << exp.system << exp.rnxType << " wrong" << endl;
+        ++numErr;
+      }
+      if (strcmp(t_ssrSignals::rnxType(exp.system, exp.type), exp.rnxType) != 0) {
+        cout << "rnxType " << exp.system << ' ' << int(exp.type) << " wrong" << endl;
+        ++numErr;
+      }
+    }
+
+    // Every band/attribute combination, no entries beyond the expected ones
+    int numFound = 0;
+    for (const char* sys = SYSTEMS; *sys; sys++) {
+      for (char band = '0'; band <= '9'; band++) {
+        for (char attr = 'A'; attr <= 'Z'; attr++) {
+          CodeType type;
+          if (!t_ssrSignals::codeType(*sys, band, attr, type)) {
+            continue;
+          }
+          ++numFound;
+          const char* rnx = t_ssrSignals::rnxType(*sys, type);
+          if (rnx[0] != band || rnx[1] != attr) {
+            cout << "round-trip " << *sys << band << attr << " wrong" << endl;
+            ++numErr;
+          }
+        }
+      }
+      if (t_ssrSignals::rnxType(*sys, CodeType(-1))[0] != '\0' ||
+          t_ssrSignals::rnxType(*sys, CodeType(100))[0] != '\0') {
+        cout << "rnxType " << *sys << " out of range not rejected" << endl;
+        ++numErr;
+      }
+    }
+    if (numFound != NUMEXPECTED) {
+      cout << numFound << " entries found, " << NUMEXPECTED << " expected" << endl;
+      ++numErr;
+    }
+
+    // Invalid input
+    CodeType type;
+    if (t_ssrSignals::codeType('X', "1C", type) ||
+        t_ssrSignals::codeType('G', "1",  type) ||
+        t_ssrSignals::codeType('G', "1C ", type) ||
+        t_ssrSignals::codeType('G', (const char*)0, type)) {
+      cout << "invalid input not rejected" << endl;
+      ++numErr;
+    }
+
+    cout << NUMEXPECTED << " entries checked, " << numErr << " errors" << endl;
+    return numErr;
+  }
+
+  // Code and phase biases of one epoch, as bncRtnetUploadCaster fills them
+  // ----------------------------------------------------------------------
+  size_t encodeEpoch(unsigned epoch, CodeBias& bias, PhaseBias& phaseBias,
+                     char* buffer, size_t size) {
+    memset(&bias,      0, sizeof(bias));
+    memset(&phaseBias, 0, sizeof(phaseBias));
+    for (int iSys = 0; iSys < CLOCKORBIT_SATNUM; iSys++) {
+      bias.EpochTime[iSys]      = epoch % 604800;
+      phaseBias.EpochTime[iSys] = epoch % 604800;
+      for (int iSat = 0; iSat < NUMSAT[iSys]; iSat++) {
+        CodeBias::BiasSat&       bSat  = bias.Sat[OFFSET[iSys] + iSat];
+        PhaseBias::PhaseBiasSat& pbSat = phaseBias.Sat[OFFSET[iSys] + iSat];
+        bSat.ID  = iSat + 1;
+        pbSat.ID = iSat + 1;
+        for (int ii = 0; ii < NUMEXPECTED &&
+                         bSat.NumberOfCodeBiases < MAXSIGNALS; ii++) {
+          if (EXPECTED[ii].system != SYSTEMS[iSys]) {
+            continue;
+          }
+          CodeType type;
+          if (!t_ssrSignals::codeType(SYSTEMS[iSys], EXPECTED[ii].rnxType, type)) {
+            continue;
+          }
+          float value = 0.001f * ((epoch + iSat * 7 + ii) % 2000) - 1.0f;
+          CodeBias::BiasSat::CodeBiasEntry& cb = bSat.Biases[bSat.NumberOfCodeBiases++];
+          cb.Type = type;
+          cb.Bias = value;
+          PhaseBias::PhaseBiasSat::PhaseBiasEntry& pb =
+              pbSat.Biases[pbSat.NumberOfPhaseBiases++];
+          pb.Type = type;
+          pb.Bias = value;
+          pb.SignalIntegerIndicator = 1;
+        }
+      }
+      bias.NumberOfSat[iSys]      = NUMSAT[iSys];
+      phaseBias.NumberOfSat[iSys] = NUMSAT[iSys];
+    }
+    size_t len = MakeCodeBias(&bias, BTYPE_AUTO, 0, buffer, size);
+    len += MakePhaseBias(&phaseBias, PBTYPE_AUTO, 0, buffer + len, size - len);
+    return len;
+  }
+
+  void bench(int numEpochs) {
+    CodeBias*  bias      = new CodeBias;
+    PhaseBias* phaseBias = new PhaseBias;
+    char*      buffer    = new char[1 << 20];
+    size_t     numBytes  = 0;
+
+    clock_t start = clock();
+    for (int iEpo = 0; iEpo < numEpochs; iEpo++) {
+      numBytes += encodeEpoch(iEpo * 5, *bias, *phaseBias, buffer, 1 << 20);
+    }
+    double sec = double(clock() - start) / CLOCKS_PER_SEC;
+
+    cout << numEpochs << " epochs, " << numBytes / numEpochs
+         << " bytes per epoch, " << fixed << setprecision(1)
+         << sec / numEpochs * 1.e6 << " microsec per epoch" << endl;
+
+    delete bias;
+    delete phaseBias;
+    delete [] buffer;
+  }
+}
+
+int main(int argc, char* argv[]) {
+  if (argc > 1 && strcmp(argv[1], "bench") == 0) {
+    bench(argc > 2 ? atoi(argv[2]) : 10000);
+    return 0;
+  }
+  return check() == 0 ? 0 : 1;
+}
@@ -0,0 +1,175 @@
+#!/usr/bin/perl -w
+
+# Minimal local Ntrip Version 1 caster for load tests of BNC.
+#
+# Serves any number of mountpoints (MP0001, MP0002, ...) on one port and
+# sends the content of a file (in a loop) or dummy bytes to every client.
+#
+#   bench_ntrip_caster.pl port numStreams bytesPerSec [file [restartSec]]
+#       run the caster; reports the time until all streams are connected
+#       (startup time) and, with restartSec, drops all clients every
+#       restartSec seconds to measure the reconnect spread
+#   bench_ntrip_caster.pl -conf port numStreams [format]
+#       print the BNC option to pull all streams, e.g.
+#       bnc --nw --conf /dev/null --key mountPoints "`...`" --key ioThreads 2
+#   bench_ntrip_caster.pl -monitor pid [seconds]
+#       print CPU usage and resident memory of the BNC process
+
+use strict;
+use IO::Socket;
+use IO::Select;
+use Time::HiRes qw(time sleep);
+
+$| = 1;
+
+if (@ARGV && $ARGV[0] eq "-conf") {
+  my(undef, $port, $numStreams, $format) = @ARGV;
+  die "Usage: bench_ntrip_caster.pl -conf port numStreams [format]\n"
+      unless (defined($numStreams));
+  $format = "RTCM_3" unless (defined($format));
+  my @mounts;
+  for (my $ii = 1; $ii <= $numStreams; $ii++) {
+    push @mounts, sprintf("//user:pass\@localhost:%d/MP%04d %s DEU 50.09 8.66 no 1",
+                          $port, $ii, $format);
+  }
+  print join(", ", @mounts), "\n";
+  exit 0;
+}
+
+if (@ARGV && $ARGV[0] eq "-monitor") {
+  my(undef, $pid, $interval) = @ARGV;
+  die "Usage: bench_ntrip_caster.pl -monitor pid [seconds]\n"
+      unless (defined($pid));
+  $interval = 10 unless (defined($interval));
+  my $ticks = 100;
+  my($tLast, $cpuLast);
+  while (open(STAT, "/proc/$pid/stat")) {
+    my @ff = split(/\s+/, <STAT>);
+    close(STAT);
+    my $cpu = ($ff[13] + $ff[14]) / $ticks;
+    my $rss = $ff[23] * 4096 / 1024 / 1024;
+    my $tt  = time();
+    if (defined($tLast)) {
+      printf("%s  CPU %6.1f %%  RSS %8.1f MB  threads %4d\n",
+             scalar(localtime($tt)), 100.0 * ($cpu - $cpuLast) / ($tt - $tLast),
+             $rss, $ff[19]);
+    }
+    ($tLast, $cpuLast) = ($tt, $cpu);
+    sleep($interval);
+  }
+  exit 0;
+}
+
+# List of Parameters
+# ------------------
+my($port, $numStreams, $bytesPerSec, $fileName, $restartSec) = @ARGV;
+
+if (!defined($bytesPerSec)) {
+  die "Usage: bench_ntrip_caster.pl port numStreams bytesPerSec " .
+      "[file [restartSec]]\n";
+}
+
+# Data to be sent
+# ---------------
+my $data;
+if (defined($fileName) && $fileName ne "-") {
+  open(INP, "<$fileName") || die "Cannot open $fileName: $!";
+  binmode(INP);
+  local $/;
+  $data = <INP>;
+  close(INP);
+}
+else {
+  $data = pack("C*", map { $_ % 256 } (0 .. 65535));
+}
+
+my $server = IO::Socket::INET->new( Proto     => "tcp",
+                                    LocalPort => $port,
+                                    Listen    => SOMAXCONN,
+                                    ReuseAddr => 1);
+die "Cannot listen on port $port: $!" unless ($server);
+
+my $select = new IO::Select($server);
+my %clients;   # socket => [socket, mountpoint, streaming, offset in $data]
+
+my $tick = 1.0;
+my $tNext = time() + $tick;
+my $tStart;                 # first request after start or restart
+my $allConnected = 0;
+my $numRequests  = 0;       # requests within the current second
+my $tRestart = defined($restartSec) ? time() + $restartSec : undef;
+while (1) {
+  my $wait = $tNext - time();
+  $wait = 0 if ($wait < 0);
+  foreach my $sock ($select->can_read($wait)) {
+    if ($sock == $server) {
+      my $client = $server->accept();
+      $select->add($client);
+      $clients{$client} = [$client, "", 0, int(rand(length($data)))];
+      next;
+    }
+    my $buffer;
+    if (!sysread($sock, $buffer, 4096)) {
+      $select->remove($sock);
+      delete $clients{$sock};
+      close($sock);
+      next;
+    }
+    my $cl = $clients{$sock};
+    next if ($cl->[2]);
+    if ($buffer =~ /^GET\s+\/(MP(\d+))\s/ && $2 >= 1 && $2 <= $numStreams) {
+      $cl->[1] = $1;
+      $cl->[2] = 1;
+      syswrite($sock, "ICY 200 OK\r\n\r\n");
+      $tStart = time() unless (defined($tStart));
+      ++$numRequests;
+      if (!$allConnected &&
+          scalar(grep { $_->[2] } values %clients) == $numStreams) {
+        $allConnected = 1;
+        printf("%s  all %d streams connected after %.2f s\n",
+               scalar(localtime()), $numStreams, time() - $tStart);
+      }
+    }
+    else {
+      syswrite($sock, "HTTP/1.0 404 Not Found\r\n\r\n");
+      $select->remove($sock);
+      delete $clients{$sock};
+      close($sock);
+    }
+  }
+
+  # Send one second of data to all streaming clients
+  # ------------------------------------------------
+  if (time() >= $tNext) {
+    $tNext += $tick;
+    my $nStreaming = 0;
+    foreach my $cl (values %clients) {
+      next unless ($cl->[2]);
+      ++$nStreaming;
+      my $chunk = substr($data, $cl->[3], $bytesPerSec);
+      $cl->[3] += length($chunk);
+      if (length($chunk) < $bytesPerSec) {
+        $cl->[3] = $bytesPerSec - length($chunk);
+        $chunk  .= substr($data, 0, $cl->[3]);
+      }
+      syswrite($cl->[0], $chunk);
+    }
+    printf("%s  %d streams, %d requests\n", scalar(localtime()),
+           $nStreaming, $numRequests);
+    $numRequests = 0;
+  }
+
+  # Simulated caster restart
+  # ------------------------
+  if (defined($tRestart) && time() >= $tRestart) {
+    $tRestart += $restartSec;
+    foreach my $cl (values %clients) {
+      $select->remove($cl->[0]);
+      close($cl->[0]);
+    }
+    %clients = ();
+    undef $tStart;
+    $allConnected = 0;
+    printf("%s  restart, all clients dropped\n", scalar(localtime()));
+  }
+}
@@ -0,0 +1,65 @@
+#!/usr/bin/perl -w
+
+# Synthetic RINEX 3 navigation files for load tests of BNC's RINEX
+# Editing & Concatenation (merging of broadcast ephemerides).
+#
+# Every station file of a day contains the ephemerides of the same 32 GPS
+# satellites (one set every two hours), a random tenth of them missing,
+# as files of many stations of one day do.
+#
+#   bench_rinex_nav.pl dir numStations numDays
+#       write dir/SSSSDDD0.26P (SSSS = station number, DDD = day of year)
+#       and print the BNC command to merge them, e.g.
+#       time bnc --nw --conf /dev/null --key reqcAction Edit/Concatenate ...
+
+use strict;
+use Time::Local;
+
+my($dir, $numStations, $numDays) = @ARGV;
+if (!defined($numDays)) {
+  die "Usage: bench_rinex_nav.pl dir numStations numDays\n";
+}
+
+srand(1);
+
+my $t0 = timegm(0, 0, 0, 1, 0, 2026);
+my $numRecords = 0;
+
+for (my $iDay = 0; $iDay < $numDays; $iDay++) {
+  for (my $iSta = 1; $iSta <= $numStations; $iSta++) {
+    my $fileName = sprintf("%s/%04d%03d0.26P", $dir, $iSta, $iDay + 1);
+    open(OUT, ">$fileName") || die "Cannot write $fileName: $!";
+    printf OUT "%9.2f%-11s%-20s%-20s%s\n", 3.04, "", "N: GNSS NAV DATA",
+               "G: GPS", "RINEX VERSION / TYPE";
+    printf OUT "%-60s%s\n", "synthetic ephemerides", "COMMENT";
+    printf OUT "%-60s%s\n", "", "END OF HEADER";
+    for (my $hour = 0; $hour < 24; $hour += 2) {
+      my $tt = $t0 + $iDay * 86400 + $hour * 3600;
+      my($sec, $min, $hh, $dd, $mm, $yy) = gmtime($tt);
+      for (my $prn = 1; $prn <= 32; $prn++) {
+        next if (rand() < 0.1);
+        my $seed = $prn * 1000 + $iDay * 12 + $hour / 2;
+        printf OUT "G%02d %04d %02d %02d %02d %02d %02d%19.12E%19.12E%19.12E\n",
+                   $prn, $yy + 1900, $mm + 1, $dd, $hh, $min, $sec,
+                   1e-5 * sin($seed), 1e-12 * cos($seed), 0.0;
+        my @val = ($seed % 256, 10.0 * sin($seed), 4e-9, cos($seed),
+                   1e-6, 0.01, 1e-6, 5153.6,
+                   ($tt - $t0) % 604800, 1e-7, sin(2 * $seed), 1e-7,
+                   0.96, 200.0, cos(2 * $seed), -8e-9,
+                   1e-10, 1.0, 2400, 0.0,
+                   2.0, 0.0, 5e-9, $seed % 256,
+                   ($tt - $t0) % 604800, 4.0, 0.0, 0.0);
+        for (my $ii = 0; $ii < @val; $ii += 4) {
+          printf OUT "    %19.12E%19.12E%19.12E%19.12E\n", @val[$ii .. $ii + 3];
+        }
+        ++$numRecords;
+      }
+    }
+    close(OUT);
+  }
+}
+
+printf("%d files, %d ephemerides written to %s\n",
+       $numStations * $numDays, $numRecords, $dir);
+print "time bnc --nw --conf /dev/null --key reqcAction Edit/Concatenate " .
+      "--key reqcNavFile \"$dir/*.26P\" --key reqcOutNavFile $dir/merged.nav\n";
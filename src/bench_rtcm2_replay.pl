@@ -0,0 +1,69 @@
+#!/usr/bin/perl -w
+
+# Replay load test of BNC's RTCM 2.x decoder (message types 18/19/20/21)
+# with recorded frames.
+#
+# Reads a BNC raw file recorded with the rawOutFile option from legacy
+# RTCM 2.x reference stations (plus a broadcast ephemeris stream, needed
+# for the translation of the corrections of types 20/21) and writes a raw
+# file in which every RTCM_2 chunk is repeated for numCopies stations
+# (station ID followed by _001, _002, ...). All other chunks are written
+# once.
+#
+#   bench_rtcm2_replay.pl rawFile numCopies outFile
+#       write outFile and print the BNC command to decode it as fast as
+#       possible, e.g.
+#       time bnc --nw --conf /dev/null --file outFile --replay 0 --threads 1
+
+use strict;
+
+my($inpFile, $numCopies, $outFile) = @ARGV;
+if (!defined($outFile)) {
+  die "Usage: bench_rtcm2_replay.pl rawFile numCopies outFile\n";
+}
+
+open(INP, "<$inpFile") || die "Cannot read $inpFile: $!";
+binmode(INP);
+open(OUT, ">$outFile") || die "Cannot write $outFile: $!";
+binmode(OUT);
+
+print OUT "1 Version of BNC raw file";
+
+my $numChunks = 0;
+my $numRtcm2  = 0;
+while (my $line = <INP>) {
+  if ($line =~ /Version of BNC raw file/) {
+    next;
+  }
+  my($dateTime, $staID, $format, $numBytes) = split(' ', $line);
+  next unless (defined($numBytes) && $numBytes =~ /^\d+$/);
+
+  my $data = "";
+  if (read(INP, $data, $numBytes) != $numBytes) {
+    last;
+  }
+  read(INP, my $newLine, 1);
+
+  if ($format =~ /RTCM_?2/) {
+    for (my $iCopy = 1; $iCopy <= $numCopies; $iCopy++) {
+      printf OUT "\n%s %s_%03d %s %d\n", $dateTime, $staID, $iCopy, $format,
+                 $numBytes;
+      print OUT $data;
+    }
+    ++$numRtcm2;
+  }
+  else {
+    print OUT "\n$dateTime $staID $format $numBytes\n";
+    print OUT $data;
+  }
+  ++$numChunks;
+}
+close(INP);
+close(OUT);
+
+if ($numRtcm2 == 0) {
+  warn "No RTCM_2 chunks in $inpFile\n";
+}
+printf("%d chunks read, %d RTCM_2 chunks written %d times to %s\n",
+       $numChunks, $numRtcm2, $numCopies, $outFile);
+print "time bnc --nw --conf /dev/null --file $outFile --replay 0 --threads 1\n";
@@ -0,0 +1,207 @@
+// Part of BNC, a utility for retrieving decoding and
+// converting GNSS data streams from NTRIP broadcasters.
+//
+// Copyright (C) 2007
+// German Federal Agency for Cartography and Geodesy (BKG)
+// http://www.bkg.bund.de
+// Czech Technical University Prague, Department of Geodesy
+// http://www.fsv.cvut.cz
+//
+// Email: euref-ip@bkg.bund.de
+//
+// This program is free software; you can redistribute it and/or
+// modify it under the terms of the GNU General Public License
+// as published by the Free Software Foundation, version 2.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program; if not, write to the Free Software
+// Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA 02111-1307, USA.
+
+
+/* -------------------------------------------------------------------------
+ * BKG NTRIP Client
+ * -------------------------------------------------------------------------
+ *
+ * Class:      bncAdviseDispatcher
+ *
+ * Purpose:    Asynchronous calls of the advisory notice script
+ *
+ * Changes:
+ *
+ * -----------------------------------------------------------------------*/
+
+#include <QElapsedTimer>
+#include <QProcess>
+#include <QStringList>
+
+#include "bncadvisedispatcher.h"
+#include "bnccore.h"
+
+using namespace std;
+
+namespace {
+  QMutex               instanceMutex;
+  bncAdviseDispatcher* dispatcher = 0;
+}
+
+// Single instance (started on first use, runs until shutdown)
+////////////////////////////////////////////////////////////////////////////
+bncAdviseDispatcher* bncAdviseDispatcher::instance() {
+  QMutexLocker locker(&instanceMutex);
+  if (!dispatcher) {
+    dispatcher = new bncAdviseDispatcher();
+    dispatcher->start();
+  }
+  return dispatcher;
+}
+
+// Drain the queue and stop the thread; later notices are dropped (the
+// instance is not deleted, a stream thread may still hold the pointer)
+////////////////////////////////////////////////////////////////////////////
+void bncAdviseDispatcher::shutdown() {
+  QMutexLocker locker(&instanceMutex);
+  if (!dispatcher) {
+    return;
+  }
+  {
+    QMutexLocker stopLocker(&dispatcher->_mutex);
+    dispatcher->_stop = true;
+    dispatcher->_newNotice.wakeOne();
+    dispatcher->_stopRequest.wakeOne();
+  }
+  dispatcher->wait();
+}
+
+// Constructor
+////////////////////////////////////////////////////////////////////////////
+bncAdviseDispatcher::bncAdviseDispatcher() {
+  _numDropped = 0;
+  _stop       = false;
+  connect(this, SIGNAL(newMessage(QByteArray,bool)),
+          BNC_CORE, SLOT(slotMessage(const QByteArray,bool)));
+}
+
+// Destructor
+////////////////////////////////////////////////////////////////////////////
+bncAdviseDispatcher::~bncAdviseDispatcher() {
+}
+
+// Queue a notice (called by the stream threads)
+////////////////////////////////////////////////////////////////////////////
+void bncAdviseDispatcher::post(const QString& script, const QByteArray& staID,
+                               const QByteArray& comment) {
+
+  QMutexLocker locker(&_mutex);
+
+  if (_stop) {
+    return;
+  }
+
+  if (_notices.size() >= MAXPENDING) {
+    ++_numDropped;
+    return;
+  }
+
+  t_notice notice;
+  notice._script  = script;
+  notice._staID   = staID;
+  notice._comment = comment;
+  _notices.append(notice);
+
+  _newNotice.wakeOne();
+}
+
+// Collect notices for one second, then call the script (until shutdown
+// and the queue is empty)
+////////////////////////////////////////////////////////////////////////////
+void bncAdviseDispatcher::run() {
+
+  while (true) {
+
+    QList<t_notice> batch;
+    int             numDropped = 0;
+    {
+      QMutexLocker locker(&_mutex);
+      while (_notices.isEmpty() && !_stop) {
+        _newNotice.wait(&_mutex);
+      }
+      if (_notices.isEmpty()) {
+        break;
+      }
+
+      // Batching window, the notices of e.g. a restarted caster arrive here
+      // (cut short by shutdown)
+      // -------------------------------------------------------------------
+      QElapsedTimer window;
+      window.start();
+      while (!_stop && window.elapsed() < 1000) {
+        _stopRequest.wait(&_mutex, 1000 - window.elapsed());
+      }
+
+      batch       = _notices;
+      numDropped  = _numDropped;
+      _notices.clear();
+      _numDropped = 0;
+    }
+
+    // Drop a notice repeating the previous one of the same station
+    // ------------------------------------------------------------
+    QList<t_notice> calls;
+    for (int ii = 0; ii < batch.size(); ii++) {
+      const t_notice& notice = batch[ii];
+      QByteArray type = notice._comment.left(notice._comment.indexOf(' '));
+      bool duplicate = false;
+      for (int jj = calls.size() - 1; jj >= 0; jj--) {
+        if (calls[jj]._staID == notice._staID) {
+          duplicate = calls[jj]._comment.startsWith(type + ' ');
+          break;
+        }
+      }
+      if (!duplicate) {
+        calls.append(notice);
+      }
+    }
+
+    if (numDropped > 0) {
+      emit newMessage(QString("Advisory notice queue full, %1 notices dropped")
+                      .arg(numDropped).toAscii(), true);
+    }
+
+    // Call the script, at most MAXCALLS times a second (no limit when
+    // draining the queue at shutdown)
+    // ----------------------------------------------------------------
+    QElapsedTimer slotTimer;
+    slotTimer.start();
+    int numCalls = 0;
+    for (int ii = 0; ii < calls.size(); ii++) {
+      if (numCalls == MAXCALLS) {
+        QMutexLocker locker(&_mutex);
+        qint64 msec = 1000 - slotTimer.elapsed();
+        if (!_stop && msec > 0) {
+          _stopRequest.wait(&_mutex, msec);
+        }
+        slotTimer.restart();
+        numCalls = 0;
+      }
+      callScript(calls[ii]);
+      ++numCalls;
+    }
+  }
+}
+
+// Start the script (detached)
+////////////////////////////////////////////////////////////////////////////
+void bncAdviseDispatcher::callScript(const t_notice& notice) {
+#ifdef WIN32
+  QProcess::startDetached(notice._script, QStringList() << notice._staID
+                          << notice._comment);
+#else
+  QProcess::startDetached("nohup", QStringList() << notice._script
+                          << notice._staID << notice._comment);
+#endif
+}
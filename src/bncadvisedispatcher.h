@@ -0,0 +1,83 @@
+// Part of BNC, a utility for retrieving decoding and
+// converting GNSS data streams from NTRIP broadcasters.
+//
+// Copyright (C) 2007
+// German Federal Agency for Cartography and Geodesy (BKG)
+// http://www.bkg.bund.de
+// Czech Technical University Prague, Department of Geodesy
+// http://www.fsv.cvut.cz
+//
+// Email: euref-ip@bkg.bund.de
+//
+// This program is free software; you can redistribute it and/or
+// modify it under the terms of the GNU General Public License
+// as published by the Free Software Foundation, version 2.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program; if not, write to the Free Software
+// Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA 02111-1307, USA.
+
+
+#ifndef BNCADVISEDISPATCHER_H
+#define BNCADVISEDISPATCHER_H
+
+#include <QByteArray>
+#include <QList>
+#include <QMutex>
+#include <QThread>
+#include <QWaitCondition>
+
+/**
+ * Calls the advisory notice script (outage, corruption, recovery) in a
+ * thread of its own, so that the decoding of the stream is not blocked.
+ * Notices are collected for one second, identical pending notices are
+ * dropped and the number of script calls per second is limited.
+ */
+class bncAdviseDispatcher : public QThread {
+ Q_OBJECT
+
+ public:
+  static bncAdviseDispatcher* instance();
+
+  /** Call the script for all queued notices and stop the thread (at exit) */
+  static void shutdown();
+
+  /** Queue a notice, returns immediately */
+  void post(const QString& script, const QByteArray& staID,
+            const QByteArray& comment);
+
+ signals:
+  void newMessage(QByteArray msg, bool showOnScreen);
+
+ protected:
+  virtual void run();
+
+ private:
+  class t_notice {
+   public:
+    QString    _script;
+    QByteArray _staID;
+    QByteArray _comment;
+  };
+
+  bncAdviseDispatcher();
+  ~bncAdviseDispatcher();
+  void callScript(const t_notice& notice);
+
+  static const int MAXCALLS   = 10;     // script calls per second
+  static const int MAXPENDING = 1000;   // queued notices
+
+  QMutex          _mutex;
+  QWaitCondition  _newNotice;
+  QWaitCondition  _stopRequest;
+  QList<t_notice> _notices;
+  int             _numDropped;
+  bool            _stop;
+};
+
+#endif
@@ -46,40 +46,53 @@
 
 using namespace std;
 
+// Index of a satellite antenna ("G01") in _satIndex, -1 if invalid
+////////////////////////////////////////////////////////////////////////////
+static int satAntIndex(const QString& prn) {
+  if (prn.length() < 3 || !prn[1].isDigit() || !prn[2].isDigit()) {
+    return -1;
+  }
+  t_prn tPrn(prn[0].toAscii(), prn[1].digitValue() * 10 + prn[2].digitValue());
+  return tPrn.toIndex();
+}
+
 // Constructor
 ////////////////////////////////////////////////////////////////////////////
 bncAntex::bncAntex() {
+  for (unsigned ii = 0; ii < t_prn::NUMINDEX; ii++) {
+    _satIndex[ii] = -1;
+  }
 }
 
 // Constructor
 ////////////////////////////////////////////////////////////////////////////
 bncAntex::bncAntex(const char* fileName) {
+  for (unsigned ii = 0; ii < t_prn::NUMINDEX; ii++) {
+    _satIndex[ii] = -1;
+  }
   readFile(QString(fileName));
 }
 
 // Destructor
 ////////////////////////////////////////////////////////////////////////////
 bncAntex::~bncAntex() {
-  QMapIterator<QString, t_antMap*> it(_maps);
-  while (it.hasNext()) {
-    it.next();
-    delete it.value();
+  for (unsigned ii = 0; ii < _maps.size(); ii++) {
+    delete _maps[ii];
   }
 }
 
 // Print
 ////////////////////////////////////////////////////////////////////////////
 void bncAntex::print() const {
-  QMapIterator<QString, t_antMap*> itAnt(_maps);
-  while (itAnt.hasNext()) {
-    itAnt.next();
-    t_antMap* map = itAnt.value();
+  for (unsigned iAnt = 0; iAnt < _maps.size(); iAnt++) {
+    t_antMap* map = _maps[iAnt];
     cout << map->antName.toAscii().data() << endl;
     cout << "    " << map->zen1 << " " << map->zen2 << " " << map->dZen << endl;
-    QMapIterator<t_frequency::type, t_frqMap*> itFrq(map->frqMap);
-    while (itFrq.hasNext()) {
-      itFrq.next();
-      const t_frqMap* frqMap = itFrq.value();
+    for (int iFrq = 0; iFrq < t_frequency::max; iFrq++) {
+      const t_frqMap* frqMap = map->frqMap[iFrq];
+      if (!frqMap) {
+        continue;
+      }
       cout << "    " << frqMap->neu[0] << " "
                      << frqMap->neu[1] << " "
                      << frqMap->neu[2] << endl;
@@ -93,22 +106,16 @@ void bncAntex::print() const {
 ////////////////////////////////////////////////////////////////////////////
 QString bncAntex::pcoSinexString(const std::string& antName, t_frequency::type frqType) {
 
-  if (antName.find("NULLANTENNA") != string::npos) {
-    return QString(" ------ ------ ------");
-  }
-
-  QString antNameQ = antName.c_str();
-  if (_maps.find(antNameQ) == _maps.end()) {
+  int iAnt = antIndex(antName);
+  if (iAnt < 0) {
     return QString(" ------ ------ ------");
   }
 
-  t_antMap* map = _maps[antNameQ];
-  if (map->frqMap.find(frqType) == map->frqMap.end()) {
+  t_frqMap* frqMap = _maps[iAnt]->frqMap[frqType];
+  if (!frqMap) {
     return QString(" ------ ------ ------");
   }
 
-  t_frqMap* frqMap = map->frqMap[frqType];
-
   QString u, n,e;
   u.sprintf("%+6.4f" ,frqMap->neu[2]); if (u.mid(1,1) == "0") {u.remove(1,1);}
   n.sprintf("%+6.4f" ,frqMap->neu[0]); if (n.mid(1,1) == "0") {n.remove(1,1);}
@@ -149,10 +156,19 @@ t_irc bncAntex::readFile(const QString& fileName) {
     // --------------
     else if (line.indexOf("END OF ANTENNA") == 60) {
       if (newAntMap) {
-        if (_maps.contains(newAntMap->antName)) {
-          delete _maps[newAntMap->antName];
+        QHash<QString, int>::const_iterator it = _mapIndex.find(newAntMap->antName);
+        if (it != _mapIndex.end()) {
+          delete _maps[it.value()];
+          _maps[it.value()] = newAntMap;
+        }
+        else {
+          int iSat = satAntIndex(newAntMap->antName);
+          if (newAntMap->antName.length() == 3 && iSat >= 0) {
+            _satIndex[iSat] = _maps.size();
+          }
+          _mapIndex[newAntMap->antName] = _maps.size();
+          _maps.push_back(newAntMap);
         }
-        _maps[newAntMap->antName] = newAntMap;
         newAntMap = 0;
       }
       else {
@@ -181,6 +197,10 @@ t_irc bncAntex::readFile(const QString& fileName) {
         QTextStream inLine(&line, QIODevice::ReadOnly);
         inLine >> newAntMap->zen1 >> newAntMap->zen2 >> newAntMap->dZen;
       }
+      else if (line.indexOf("DAZI") == 60) {
+        QTextStream inLine(&line, QIODevice::ReadOnly);
+        inLine >> newAntMap->dAzi;
+      }
 
       // Start of Frequency
       // ------------------
@@ -260,9 +280,8 @@ t_irc bncAntex::readFile(const QString& fileName) {
             frqType = t_frequency::C7;
           }
           if (frqType != t_frequency::dummy) {
-            if (newAntMap->frqMap.find(frqType) != newAntMap->frqMap.end()) {
-              delete newAntMap->frqMap[frqType];
-            }
+            compile(newAntMap, newFrqMap);
+            delete newAntMap->frqMap[frqType];
             newAntMap->frqMap[frqType] = newFrqMap;
           }
           else {
@@ -297,6 +316,24 @@ t_irc bncAntex::readFile(const QString& fileName) {
           }
           newFrqMap->pattern *= 1e-3;
         }
+
+        // Azimuth-dependent values (rows of the grid)
+        // -------------------------------------------
+        else if (newAntMap->dAzi > 0.0 && newFrqMap->pattern.Nrows() > 0) {
+          QTextStream inLine(&line, QIODevice::ReadOnly);
+          double azi;
+          inLine >> azi;
+          if (inLine.status() == QTextStream::Ok &&
+              fabs(azi - newFrqMap->nAzi * newAntMap->dAzi) < 1e-6) {
+            int nPat = newFrqMap->pattern.Nrows();
+            for (int ii = 0; ii < nPat; ii++) {
+              double value = 0.0;
+              inLine >> value;
+              newFrqMap->grid.push_back(value * 1e-3);
+            }
+            newFrqMap->nAzi += 1;
+          }
+        }
       }
     }
   }
@@ -321,10 +358,10 @@ t_irc bncAntex::satCoMcorrection(const QString& prn, double Mjd,
     frqType = t_frequency::R1;
   }
 
-  QMap<QString, t_antMap*>::const_iterator it = _maps.find(prn.mid(0,3));
-  if (it != _maps.end()) {
-    t_antMap* map = it.value();
-    if (map->frqMap.find(frqType) != map->frqMap.end()) {
+  int iSat = satAntIndex(prn);
+  if (iSat >= 0 && _satIndex[iSat] >= 0 && frqType != t_frequency::dummy) {
+    t_antMap* map = _maps[_satIndex[iSat]];
+    if (map->frqMap[frqType]) {
 
       double* neu = map->frqMap[frqType]->neu;
 
@@ -352,49 +389,125 @@ t_irc bncAntex::satCoMcorrection(const QString& prn, double Mjd,
   return failure;
 }
 
-//
+// Index of a receiver antenna
+////////////////////////////////////////////////////////////////////////////
+int bncAntex::antIndex(const string& antName) const {
+  if (antName.find("NULLANTENNA") != string::npos) {
+    return NULLANTENNA;
+  }
+  return _mapIndex.value(QString(antName.c_str()), -1);
+}
+
+// Receiver antenna correction (by name)
 ////////////////////////////////////////////////////////////////////////////
 double bncAntex::rcvCorr(const string& antName, t_frequency::type frqType,
                          double eleSat, double azSat, bool& found) const {
+  return rcvCorr(antIndex(antName), frqType, eleSat, azSat, found);
+}
 
-  if (antName.find("NULLANTENNA") != string::npos) {
+// Receiver antenna correction (by index)
+////////////////////////////////////////////////////////////////////////////
+double bncAntex::rcvCorr(int antIndex, t_frequency::type frqType,
+                         double eleSat, double azSat, bool& found) const {
+
+  if (antIndex == NULLANTENNA) {
     found = true;
     return 0.0;
   }
 
-  QString antNameQ = antName.c_str();
-
-  if (_maps.find(antNameQ) == _maps.end()) {
+  if (antIndex < 0 || antIndex >= int(_maps.size())) {
     found = false;
     return 0.0;
   }
 
-  t_antMap* map = _maps[antNameQ];
-  if (map->frqMap.find(frqType) == map->frqMap.end()) {
+  const t_antMap* map    = _maps[antIndex];
+  const t_frqMap* frqMap = map->frqMap[frqType];
+  if (!frqMap) {
     found = false;
     return 0.0;
   }
 
-  t_frqMap* frqMap = map->frqMap[frqType];
-
-  double var = 0.0;
-  if (frqMap->pattern.ncols() > 0) {
-    double zenDiff = 999.999;
-    double zenSat  = 90.0 - eleSat * 180.0 / M_PI;
-    unsigned iZen = 0;
-    for (double zen = map->zen1; zen <= map->zen2; zen += map->dZen) {
-      iZen += 1;
-      double newZenDiff = fabs(zen - zenSat);
-      if (newZenDiff < zenDiff) {
-        zenDiff = newZenDiff;
-        var = frqMap->pattern(iZen);
-      }
-    }
-  }
+  double var = pcv(map, frqMap, 90.0 - eleSat * 180.0 / M_PI,
+                   azSat * 180.0 / M_PI);
 
   found = true;
   return var - frqMap->neu[0] * cos(azSat)*cos(eleSat)
              - frqMap->neu[1] * sin(azSat)*cos(eleSat)
              - frqMap->neu[2] * sin(eleSat);
+}
+
+// Complete the grid of one frequency (when its block is read)
+////////////////////////////////////////////////////////////////////////////
+void bncAntex::compile(const t_antMap* map, t_frqMap* frqMap) {
+
+  frqMap->nZen = frqMap->pattern.Nrows();
+
+  // Azimuth-dependent values complete (0 .. 360 degrees)?
+  // -----------------------------------------------------
+  if (map->dAzi > 0.0 && frqMap->nZen > 0) {
+    int nAzi = int(360.0 / map->dAzi + 0.5) + 1;
+    if (frqMap->nAzi == nAzi) {
+      return;
+    }
+  }
+
+  // Azimuth-independent values only
+  // -------------------------------
+  frqMap->grid.resize(frqMap->nZen);
+  for (int iZen = 0; iZen < frqMap->nZen; iZen++) {
+    frqMap->grid[iZen] = frqMap->pattern[iZen];
+  }
+  frqMap->nAzi = (frqMap->nZen > 0) ? 1 : 0;
+}
+
+// Phase center variation, bilinear interpolation in the grid
+////////////////////////////////////////////////////////////////////////////
+double bncAntex::pcv(const t_antMap* map, const t_frqMap* frqMap,
+                     double zen, double azi) {
+
+  if (frqMap->nAzi == 0 || map->dZen <= 0.0) {
+    return 0.0;
+  }
+
+  // Zenith (values outside the grid are taken from its border)
+  // ----------------------------------------------------------
+  double uZen = (zen - map->zen1) / map->dZen;
+  int    iZen = 0;
+  if (uZen <= 0.0) {
+    uZen = 0.0;
+  }
+  else if (uZen >= frqMap->nZen - 1) {
+    iZen = frqMap->nZen > 1 ? frqMap->nZen - 2 : 0;
+    uZen = frqMap->nZen > 1 ? 1.0 : 0.0;
+  }
+  else {
+    iZen = int(uZen);
+    uZen -= iZen;
+  }
+  int iZen2 = frqMap->nZen > 1 ? iZen + 1 : iZen;
+
+  const double* row = &frqMap->grid[0];
+  if (frqMap->nAzi == 1) {
+    return (1.0 - uZen) * row[iZen] + uZen * row[iZen2];
+  }
+
+  // Azimuth (the grid contains both 0 and 360 degrees)
+  // --------------------------------------------------
+  azi = fmod(azi, 360.0);
+  if (azi < 0.0) {
+    azi += 360.0;
+  }
+  double uAzi = azi / map->dAzi;
+  int    iAzi = int(uAzi);
+  if (iAzi > frqMap->nAzi - 2) {
+    iAzi = frqMap->nAzi - 2;
+  }
+  uAzi -= iAzi;
+
+  const double* row1 = row + iAzi * frqMap->nZen;
+  const double* row2 = row1 + frqMap->nZen;
+  double val1 = (1.0 - uZen) * row1[iZen] + uZen * row1[iZen2];
+  double val2 = (1.0 - uZen) * row2[iZen] + uZen * row2[iZen2];
 
+  return (1.0 - uAzi) * val1 + uAzi * val2;
 }
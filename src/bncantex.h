@@ -27,20 +27,29 @@
 
 #include <QtCore>
 #include <string>
+#include <vector>
 #include <newmat.h>
 #include "bncconst.h"
 #include "bnctime.h"
+#include "t_prn.h"
 
 class bncAntex {
  public:
+  static const int NULLANTENNA = -2;  // antenna index without corrections
+
   bncAntex(const char* fileName);
   bncAntex();
   ~bncAntex();
   t_irc   readFile(const QString& fileName);
   void    print() const;
   QString pcoSinexString(const std::string& antName, t_frequency::type frqType);
+
+  /** Index of a receiver antenna (-1 if not found), valid until readFile */
+  int     antIndex(const std::string& antName) const;
   double  rcvCorr(const std::string& antName, t_frequency::type frqType,
                   double eleSat, double azSat, bool& found) const;
+  double  rcvCorr(int antIndex, t_frequency::type frqType,
+                  double eleSat, double azSat, bool& found) const;
   t_irc   satCoMcorrection(const QString& prn, double Mjd,
                            const ColumnVector& xSat, ColumnVector& dx);
 
@@ -51,9 +60,14 @@ class bncAntex {
       for (unsigned ii = 0; ii < 3; ii++) {
         neu[ii] = 0.0;
       }
+      nZen = 0;
+      nAzi = 0;
     }
-    double       neu[3];
-    ColumnVector pattern;
+    double              neu[3];
+    ColumnVector        pattern;  // azimuth-independent values (NOAZI)
+    int                 nZen;
+    int                 nAzi;     // 1 if azimuth-independent
+    std::vector<double> grid;     // nAzi x nZen values, one azimuth after the other
   };
 
   class t_antMap {
@@ -62,24 +76,33 @@ class bncAntex {
       zen1 = 0.0;
       zen2 = 0.0;
       dZen = 0.0;
+      dAzi = 0.0;
+      for (int ii = 0; ii < t_frequency::max; ii++) {
+        frqMap[ii] = 0;
+      }
     }
     ~t_antMap() {
-      QMapIterator<t_frequency::type, t_frqMap*> it(frqMap);
-      while (it.hasNext()) {
-        it.next();
-        delete it.value();
+      for (int ii = 0; ii < t_frequency::max; ii++) {
+        delete frqMap[ii];
       }
     }
-    QString                            antName;
-    double                             zen1;
-    double                             zen2;
-    double                             dZen;
-    QMap<t_frequency::type, t_frqMap*> frqMap;
-    bncTime                            validFrom;
-    bncTime                            validTo;
+    QString   antName;
+    double    zen1;
+    double    zen2;
+    double    dZen;
+    double    dAzi;
+    t_frqMap* frqMap[t_frequency::max];
+    bncTime   validFrom;
+    bncTime   validTo;
   };
 
-  QMap<QString, t_antMap*> _maps;
+  static void   compile(const t_antMap* map, t_frqMap* frqMap);
+  static double pcv(const t_antMap* map, const t_frqMap* frqMap,
+                    double zen, double azi);
+
+  std::vector<t_antMap*> _maps;
+  QHash<QString, int>    _mapIndex;
+  int                    _satIndex[t_prn::NUMINDEX];  // satellite antennas
 };
 
 #endif
@@ -50,6 +50,8 @@
 #include "bncgetthread.h"
 #include "bncutils.h"
 #include "bncsettings.h"
+#include "bncmetrics.h"
+#include "bncnetreactor.h"
 
 using namespace std;
 
@@ -66,6 +68,11 @@ bncCaster::bncCaster() {
   _out     = 0;
   reopenOutFile();
 
+  _metricEpochs  = BNC_METRICS->gauge("bnc_caster_pending_epochs",
+                     "Epochs waiting for synchronized output");
+  _metricDropped = BNC_METRICS->counter("bnc_caster_dropped_observations_total",
+                     "Observations thrown away because their epoch was already dumped");
+
   int port = settings.value("outPort").toInt();
 
   if (port != 0) {
@@ -119,6 +126,16 @@ bncCaster::bncCaster() {
     _miscServer  = 0;
     _miscSockets = 0;
   }
+
+  // Event-driven input of the streams (instead of one thread per stream)
+  // --------------------------------------------------------------------
+  int ioThreads = settings.value("ioThreads").toInt();
+  if (ioThreads > 0) {
+    _reactor = new bncNetReactor(ioThreads, 0);
+  }
+  else {
+    _reactor = 0;
+  }
 }
 
 // Destructor
@@ -133,8 +150,12 @@ bncCaster::~bncCaster() {
     disconnect(thread, 0, 0, 0);
     _staIDs.removeAll(thread->staID());
     _threads.removeAll(thread);
+    if (_reactor) {
+      _reactor->removeStream(thread);
+    }
     thread->terminate();
   }
+  delete _reactor;
   delete _out;
   delete _outFile;
   delete _server;
@@ -143,6 +164,8 @@ bncCaster::~bncCaster() {
   delete _uSockets;
   delete _miscServer;
   delete _miscSockets;
+  BNC_METRICS->release(_metricEpochs);
+  BNC_METRICS->release(_metricDropped);
 }
 
 // New Observations
@@ -202,10 +225,10 @@ void bncCaster::slotNewObs(const QByteArray staID, QList<t_satObs> obsList) {
     // An old observation - throw it away
     // ----------------------------------
     if (obs._time <= _lastDumpTime) {
+      _metricDropped->add();
       if (index == 1) {
-        bncSettings settings;
-        if ( !settings.value("outFile").toString().isEmpty() ||
-             !settings.value("outPort").toString().isEmpty() ) {
+        const bncSettingsSnapshot* opt = bncSettings::snapshot();
+        if ( !opt->outFile.isEmpty() || opt->outPort != 0 ) {
           emit( newMessage(QString("%1: Old epoch %2 thrown away")
           		   .arg(staID.data()).arg(string(obs._time).c_str())
         		   .toAscii(), true) );
@@ -225,6 +248,7 @@ void bncCaster::slotNewObs(const QByteArray staID, QList<t_satObs> obsList) {
       _lastDumpTime = obs._time - _outWait;
     }
   }
+  _metricEpochs->set(_epochs.size());
 }
 
 // New Connection
@@ -245,6 +269,23 @@ void bncCaster::slotNewUConnection() {
 ////////////////////////////////////////////////////////////////////////////
 void bncCaster::addGetThread(bncGetThread* getThread, bool noNewThread) {
 
+  connectGetThread(getThread);
+
+  if (noNewThread) {
+    getThread->run();
+  }
+  else if (_reactor && bncNetReactor::supports(getThread)) {
+    _reactor->addStream(getThread);
+  }
+  else {
+    getThread->start();
+  }
+}
+
+// Connect a Thread without starting it (driven e.g. by bncRawReplay)
+////////////////////////////////////////////////////////////////////////////
+void bncCaster::connectGetThread(bncGetThread* getThread) {
+
   qRegisterMetaType<t_satObs>("t_satObs");
   qRegisterMetaType< QList<t_satObs> >("QList<t_satObs>");
 
@@ -254,21 +295,15 @@ void bncCaster::addGetThread(bncGetThread* getThread, bool noNewThread) {
   connect(getThread, SIGNAL(newObs(QByteArray, QList<t_satObs>)),
           this,      SIGNAL(newObs(QByteArray, QList<t_satObs>)));
 
-  connect(getThread, SIGNAL(newRawData(QByteArray, QByteArray)),
-          this,      SLOT(slotNewRawData(QByteArray, QByteArray)));
+  if (_miscSockets && !_miscSockets->isEmpty()) {
+    connectMisc(getThread, true);
+  }
 
   connect(getThread, SIGNAL(getThreadFinished(QByteArray)),
           this, SLOT(slotGetThreadFinished(QByteArray)));
 
   _staIDs.push_back(getThread->staID());
   _threads.push_back(getThread);
-
-  if (noNewThread) {
-    getThread->run();
-  }
-  else {
-    getThread->start();
-  }
 }
 
 // Get Thread destroyed
@@ -442,6 +477,9 @@ void bncCaster::readMountPoints() {
       disconnect(thread, 0, 0, 0);
       _staIDs.removeAll(thread->staID());
       _threads.removeAll(thread);
+      if (_reactor) {
+        _reactor->removeStream(thread);
+      }
       thread->terminate();
     }
   }
@@ -509,16 +547,15 @@ int bncCaster::myWrite(QTcpSocket* sock, const char* buf, int bufLen) {
 ////////////////////////////////////////////////////////////////////////////
 void bncCaster::reopenOutFile() {
 
-  bncSettings settings;
+  const bncSettingsSnapshot* opt = bncSettings::snapshot();
 
-  QString outFileName = settings.value("outFile").toString();
+  const QString& outFileName = opt->outFile;
   if ( !outFileName.isEmpty() ) {
-    expandEnvVar(outFileName);
     if (!_outFile || _outFile->fileName() != outFileName) {
       delete _out;
       delete _outFile;
       _outFile = new QFile(outFileName);
-      if ( Qt::CheckState(settings.value("rnxAppend").toInt()) == Qt::Checked) {
+      if (opt->rnxAppend) {
         _outFile->open(QIODevice::WriteOnly | QIODevice::Append);
       }
       else {
@@ -549,13 +586,39 @@ void bncCaster::slotNewRawData(QByteArray staID, QByteArray data) {
         is.remove();
       }
     }
+    if (_miscSockets->isEmpty()) {
+      for (int ii = 0; ii < _threads.size(); ii++) {
+        connectMisc(_threads[ii], false);
+      }
+    }
   }
 }
 
 // New Connection
 ////////////////////////////////////////////////////////////////////////////
 void bncCaster::slotNewMiscConnection() {
+  if (_miscSockets->isEmpty()) {
+    for (int ii = 0; ii < _threads.size(); ii++) {
+      connectMisc(_threads[ii], true);
+    }
+  }
   _miscSockets->push_back( _miscServer->nextPendingConnection() );
   emit( newMessage(QString("New client connection on Miscellaneous Output Port: # %1")
                    .arg(_miscSockets->size()).toAscii(), true) );
 }
+
+// Raw data are passed on only while a client is connected
+////////////////////////////////////////////////////////////////////////////
+void bncCaster::connectMisc(bncGetThread* getThread, bool on) {
+  if (_miscMount != "ALL" && _miscMount != getThread->staID()) {
+    return;
+  }
+  if (on) {
+    connect(getThread, SIGNAL(newRawData(QByteArray, QByteArray)),
+            this,      SLOT(slotNewRawData(QByteArray, QByteArray)));
+  }
+  else {
+    disconnect(getThread, SIGNAL(newRawData(QByteArray, QByteArray)),
+               this,      SLOT(slotNewRawData(QByteArray, QByteArray)));
+  }
+}
@@ -31,6 +31,9 @@
 #include "satObs.h"
 
 class bncGetThread;
+class bncMetricCounter;
+class bncMetricGauge;
+class bncNetReactor;
 
 class bncCaster : public QObject {
  Q_OBJECT
@@ -39,6 +42,7 @@ class bncCaster : public QObject {
    bncCaster();
    ~bncCaster();
    void addGetThread(bncGetThread* getThread, bool noNewThread = false);
+   void connectGetThread(bncGetThread* getThread);
    int  numStations() const {return _staIDs.size();}
    void readMountPoints();
 
@@ -63,6 +67,7 @@ class bncCaster : public QObject {
    void dumpEpochs(const bncTime& maxTime);
    static int myWrite(QTcpSocket* sock, const char* buf, int bufLen);
    void reopenOutFile();
+   void connectMisc(bncGetThread* getThread, bool on);
 
    QFile*                          _outFile;
    QTextStream*                    _out;
@@ -83,6 +88,9 @@ class bncCaster : public QObject {
    int                             _miscPort;
    QTcpServer*                     _miscServer;
    QList<QTcpSocket*>*             _miscSockets;
+   bncMetricGauge*                 _metricEpochs;
+   bncMetricCounter*               _metricDropped;
+   bncNetReactor*                  _reactor;
 };
 
 #endif
@@ -0,0 +1,127 @@
+// Part of BNC, a utility for retrieving decoding and
+// converting GNSS data streams from NTRIP broadcasters.
+//
+// Copyright (C) 2007
+// German Federal Agency for Cartography and Geodesy (BKG)
+// http://www.bkg.bund.de
+// Czech Technical University Prague, Department of Geodesy
+// http://www.fsv.cvut.cz
+//
+// Email: euref-ip@bkg.bund.de
+//
+// This program is free software; you can redistribute it and/or
+// modify it under the terms of the GNU General Public License
+// as published by the Free Software Foundation, version 2.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program; if not, write to the Free Software
+// Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA 02111-1307, USA.
+
+
+/* -------------------------------------------------------------------------
+ * BKG NTRIP Client
+ * -------------------------------------------------------------------------
+ *
+ * Class:      bncConnScheduler
+ *
+ * Purpose:    Reconnect delays and limit of simultaneous connection attempts
+ *
+ * Changes:
+ *
+ * -----------------------------------------------------------------------*/
+
+#include <QCoreApplication>
+#include <QDateTime>
+
+#include "bncconnscheduler.h"
+#include "bncsettings.h"
+
+using namespace std;
+
+// Single instance
+////////////////////////////////////////////////////////////////////////////
+bncConnScheduler* bncConnScheduler::instance() {
+  static bncConnScheduler _scheduler;
+  return &_scheduler;
+}
+
+// Constructor
+////////////////////////////////////////////////////////////////////////////
+bncConnScheduler::bncConnScheduler() {
+
+  bncSettings settings;
+
+  int maxConnects = settings.value("maxConnects").toInt();
+  if (maxConnects <= 0) {
+    maxConnects = 16;
+  }
+  _slots = new QSemaphore(maxConnects);
+
+  _maxDelay = 256;
+#ifdef MLS_SOFTWARE
+  _maxDelay = 4;
+#endif
+
+  // Different sequence in every BNC process
+  // ---------------------------------------
+  _state = unsigned(QDateTime::currentDateTime().toTime_t()) ^
+           unsigned(QCoreApplication::applicationPid() << 16) ^ 0x9e3779b9u;
+  if (_state == 0) {
+    _state = 1;
+  }
+}
+
+// Destructor
+////////////////////////////////////////////////////////////////////////////
+bncConnScheduler::~bncConnScheduler() {
+  delete _slots;
+}
+
+// Uniformly distributed random number in [0,1) (xorshift, thread-safe)
+////////////////////////////////////////////////////////////////////////////
+double bncConnScheduler::random() {
+  QMutexLocker locker(&_mutex);
+  _state ^= _state << 13;
+  _state ^= _state >> 17;
+  _state ^= _state << 5;
+  return (_state & 0xffffff) / double(0x1000000);
+}
+
+// Jittered exponential back-off: first attempt within one second, then
+// between one half and the full value of 2^attempt seconds (max. 256 sec)
+////////////////////////////////////////////////////////////////////////////
+int bncConnScheduler::delay(int attempt) {
+
+  if (attempt <= 0) {
+    return int(1000.0 * random());
+  }
+
+  int ceiling = _maxDelay;
+  if (attempt < 16 && (1 << attempt) < _maxDelay) {
+    ceiling = 1 << attempt;
+  }
+  return int(500.0 * ceiling * (1.0 + random()));
+}
+
+// Wait for a free connection slot
+////////////////////////////////////////////////////////////////////////////
+void bncConnScheduler::acquire() {
+  _slots->acquire();
+}
+
+// Take a connection slot if one is free
+////////////////////////////////////////////////////////////////////////////
+bool bncConnScheduler::tryAcquire() {
+  return _slots->tryAcquire();
+}
+
+// Connection attempt finished
+////////////////////////////////////////////////////////////////////////////
+void bncConnScheduler::release() {
+  _slots->release();
+}
@@ -0,0 +1,73 @@
+// Part of BNC, a utility for retrieving decoding and
+// converting GNSS data streams from NTRIP broadcasters.
+//
+// Copyright (C) 2007
+// German Federal Agency for Cartography and Geodesy (BKG)
+// http://www.bkg.bund.de
+// Czech Technical University Prague, Department of Geodesy
+// http://www.fsv.cvut.cz
+//
+// Email: euref-ip@bkg.bund.de
+//
+// This program is free software; you can redistribute it and/or
+// modify it under the terms of the GNU General Public License
+// as published by the Free Software Foundation, version 2.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program; if not, write to the Free Software
+// Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA 02111-1307, USA.
+
+
+#ifndef BNCCONNSCHEDULER_H
+#define BNCCONNSCHEDULER_H
+
+#include <QMutex>
+#include <QSemaphore>
+
+/**
+ * Common schedule of the connection attempts of all streams. Reconnects
+ * are delayed with jittered exponential back-off (so that the streams of
+ * a restarted caster do not reconnect in lockstep) and the number of
+ * simultaneous connection attempts is limited.
+ */
+class bncConnScheduler {
+ public:
+  static bncConnScheduler* instance();
+
+  /**
+   * Delay before the next connection attempt
+   * @param attempt number of failed attempts so far (0 = first connect)
+   * @return delay in milliseconds
+   */
+  int  delay(int attempt);
+
+  void acquire();
+  bool tryAcquire();
+  void release();
+
+  /** Holds a connection slot while in scope */
+  class t_slot {
+   public:
+    t_slot()  {bncConnScheduler::instance()->acquire();}
+    ~t_slot() {bncConnScheduler::instance()->release();}
+  };
+
+ private:
+  bncConnScheduler();
+  ~bncConnScheduler();
+  double random();
+
+  QMutex      _mutex;
+  unsigned    _state;
+  int         _maxDelay;   // [s]
+  QSemaphore* _slots;
+};
+
+#define BNC_CONNECTS (bncConnScheduler::instance())
+
+#endif
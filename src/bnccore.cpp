@@ -45,8 +45,11 @@
 
 #include "bnccore.h"
 #include "bncutils.h"
+#include "bncadvisedispatcher.h"
 #include "bncrinex.h"
+#include "bncrawrecorder.h"
 #include "bncsettings.h"
+#include "bncmetrics.h"
 #include "bncversion.h"
 #include "ephemeris.h"
 #include "rinex/rnxobsfile.h"
@@ -70,7 +73,7 @@ t_bncCore::t_bncCore() : _ephUser(false) {
   _logFileFlag = 0;
   _logFile     = 0;
   _logStream   = 0;
-  _rawFile     = 0;
+  _rawRecorder = 0;
   _caster      = 0;
   _bncComb     = 0;
 
@@ -94,6 +97,9 @@ t_bncCore::t_bncCore() : _ephUser(false) {
   _serverCorr  = 0;
   _socketsCorr = 0;
 
+  _portMetrics   = 0;
+  _serverMetrics = 0;
+
   _pgmName  = QString(BNCPGMNAME).leftJustified(20, ' ', true);
 #ifdef WIN32
   _userName = QString("${USERNAME}");
@@ -124,6 +130,7 @@ t_bncCore::t_bncCore() : _ephUser(false) {
 // Destructor
 ////////////////////////////////////////////////////////////////////////////
 t_bncCore::~t_bncCore() {
+  bncAdviseDispatcher::shutdown();
   delete _logStream;
   delete _logFile;
   delete _ephStreamGPS;
@@ -132,15 +139,18 @@ t_bncCore::~t_bncCore() {
   delete _socketsEph;
   delete _serverCorr;
   delete _socketsCorr;
+  delete _serverMetrics;
   if (_rinexVers == 2) {
     delete _ephStreamGlonass;
     delete _ephFileGlonass;
   }
 
   delete _dateAndTimeGPS;
-  delete _rawFile;
+  delete _rawRecorder;
   delete _bncComb;
   delete _pppMain;
+
+  bncSettings::deleteSnapshots();
 }
 
 // Write a Program Message
@@ -164,14 +174,13 @@ void t_bncCore::messagePrivate(const QByteArray& msg) {
     delete _logStream; _logStream = 0;
     delete _logFile;   _logFile   = 0;
     _logFileFlag = 1;
-    bncSettings settings;
-    QString logFileName = settings.value("logFile").toString();
+    const bncSettingsSnapshot* opt = bncSettings::snapshot();
+    const QString& logFileName = opt->logFile;
     if ( !logFileName.isEmpty() ) {
-      expandEnvVar(logFileName);
       _logFile = new QFile(logFileName + "_" +
                           currDate.toString("yyMMdd").toAscii().data());
       _fileDate = currDate;
-      if ( Qt::CheckState(settings.value("rnxAppend").toInt()) == Qt::Checked) {
+      if (opt->rnxAppend) {
         _logFile->open(QIODevice::WriteOnly | QIODevice::Append);
       }
       else {
@@ -543,6 +552,20 @@ void t_bncCore::setPortCorr(int port) {
   }
 }
 
+// Set Port Number (metrics, local connections only)
+////////////////////////////////////////////////////////////////////////////
+void t_bncCore::setPortMetrics(int port) {
+  _portMetrics = port;
+  if (_portMetrics != 0) {
+    delete _serverMetrics;
+    _serverMetrics = new QTcpServer;
+    if ( !_serverMetrics->listen(QHostAddress::LocalHost, _portMetrics) ) {
+      slotMessage("t_bncCore: Cannot listen on metrics port", true);
+    }
+    connect(_serverMetrics, SIGNAL(newConnection()), this, SLOT(slotNewConnectionMetrics()));
+  }
+}
+
 // New Connection
 ////////////////////////////////////////////////////////////////////////////
 void t_bncCore::slotNewConnectionEph() {
@@ -555,6 +578,53 @@ void t_bncCore::slotNewConnectionCorr() {
   _socketsCorr->push_back( _serverCorr->nextPendingConnection() );
 }
 
+// New Connection
+////////////////////////////////////////////////////////////////////////////
+void t_bncCore::slotNewConnectionMetrics() {
+  while (_serverMetrics->hasPendingConnections()) {
+    QTcpSocket* sock = _serverMetrics->nextPendingConnection();
+    connect(sock, SIGNAL(readyRead()),    this, SLOT(slotMetricsRequest()));
+    connect(sock, SIGNAL(disconnected()), sock, SLOT(deleteLater()));
+  }
+}
+
+// Answer a (HTTP GET) request with all metrics
+////////////////////////////////////////////////////////////////////////////
+void t_bncCore::slotMetricsRequest() {
+  QTcpSocket* sock = qobject_cast<QTcpSocket*>(sender());
+  if (!sock) {
+    return;
+  }
+
+  // Wait for the complete request header
+  // ------------------------------------
+  QByteArray request = sock->peek(sock->bytesAvailable());
+  if (request.indexOf("\r\n\r\n") == -1 && request.indexOf("\n\n") == -1) {
+    if (request.size() > 8192) {
+      sock->abort();
+      sock->deleteLater();
+    }
+    return;
+  }
+  sock->readAll();
+  disconnect(sock, SIGNAL(readyRead()), this, SLOT(slotMetricsRequest()));
+
+  QByteArray reply;
+  if (request.startsWith("GET ")) {
+    QByteArray body = BNC_METRICS->exposition();
+    reply = "HTTP/1.0 200 OK\r\n"
+            "Content-Type: text/plain; version=0.0.4\r\n"
+            "Content-Length: " + QByteArray::number(body.size()) + "\r\n"
+            "Connection: close\r\n\r\n" + body;
+  }
+  else {
+    reply = "HTTP/1.0 405 Method Not Allowed\r\n"
+            "Connection: close\r\n\r\n";
+  }
+  sock->write(reply);
+  sock->disconnectFromHost();
+}
+
 //
 ////////////////////////////////////////////////////////////////////////////
 void t_bncCore::slotQuit() {
@@ -701,24 +771,24 @@ void t_bncCore::setConfFileName(const QString& confFileName) {
   }
 }
 
-// Raw Output
+// Raw Output (created on first use)
 ////////////////////////////////////////////////////////////////////////////
-void t_bncCore::writeRawData(const QByteArray& data, const QByteArray& staID,
-                          const QByteArray& format) {
+bncRawRecorder* t_bncCore::rawRecorder() {
 
   QMutexLocker locker(&_mutex);
 
-  if (!_rawFile) {
-    bncSettings settings;
-    QByteArray fileName = settings.value("rawOutFile").toByteArray();
+  if (!_rawRecorder) {
+    const QByteArray& fileName = bncSettings::snapshot()->rawOutFile;
     if (!fileName.isEmpty()) {
-      _rawFile = new bncRawFile(fileName, staID, bncRawFile::output);
+      bncSettings settings;
+      bool perStation = Qt::CheckState(settings.value("rawOutSplit").toInt())
+                        == Qt::Checked;
+      _rawRecorder = new bncRawRecorder(fileName, perStation,
+                                        bncSettings::snapshot()->rnxAppend);
     }
   }
 
-  if (_rawFile) {
-    _rawFile->writeRawData(data, staID, format);
-  }
+  return _rawRecorder;
 }
 
 //
@@ -738,6 +808,12 @@ void t_bncCore::stopCombination() {
   _bncComb = 0;
 }
 
+// Is any NMEA server connected to the PPP output?
+////////////////////////////////////////////////////////////////////////////
+bool t_bncCore::nmeaListened() {
+  return receivers(SIGNAL(newNMEAstr(QByteArray, QByteArray))) > 0;
+}
+
 //
 ////////////////////////////////////////////////////////////////////////////
 bool t_bncCore::dateAndTimeGPSSet() const {
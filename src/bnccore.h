@@ -33,6 +33,7 @@
 #include "bncephuser.h"
 
 class bncComb;
+class bncRawRecorder;
 class bncTableItem;
 namespace BNC_PPP {
   class t_pppMain;
@@ -52,15 +53,16 @@ friend class bncSettings;
   void              setMode(e_mode mode) {_mode = mode;}
   void              setPortEph(int port);
   void              setPortCorr(int port);
+  void              setPortMetrics(int port);
   void              setCaster(bncCaster* caster) {_caster = caster;}
   const bncCaster*  caster() const {return _caster;}
   bool              dateAndTimeGPSSet() const;
+  bool              nmeaListened();
   QDateTime         dateAndTimeGPS() const;
   void              setDateAndTimeGPS(QDateTime dateTime);
   void              setConfFileName(const QString& confFileName);
   QString           confFileName() const {return _confFileName;}
-  void              writeRawData(const QByteArray& data, const QByteArray& staID,
-                                const QByteArray& format);
+  bncRawRecorder*   rawRecorder();
   void             initCombination();
   void             stopCombination();
   const QString&   pgmName() {return _pgmName;}
@@ -111,6 +113,8 @@ friend class bncSettings;
  private slots:
   void slotNewConnectionEph();
   void slotNewConnectionCorr();
+  void slotNewConnectionMetrics();
+  void slotMetricsRequest();
 
  private:
   t_irc checkPrintEph(t_eph* eph);
@@ -145,10 +149,12 @@ friend class bncSettings;
   int                    _portCorr;
   QTcpServer*            _serverCorr;
   QList<QTcpSocket*>*    _socketsCorr;
+  int                    _portMetrics;
+  QTcpServer*            _serverMetrics;
   bncCaster*             _caster;
   QString                _confFileName;
   QDate                  _fileDate;
-  bncRawFile*            _rawFile;
+  bncRawRecorder*        _rawRecorder;
   bncComb*               _bncComb;
   e_mode                 _mode;
   QWidget*               _mainWindow;
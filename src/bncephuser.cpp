@@ -48,6 +48,9 @@ using namespace std;
 // Constructor
 ////////////////////////////////////////////////////////////////////////////
 bncEphUser::bncEphUser(bool connectSlots) {
+  for (unsigned ii = 0; ii < t_prn::NUMINDEX; ii++) {
+    _eph[ii] = 0;
+  }
   if (connectSlots) {
     connect(BNC_CORE, SIGNAL(newGPSEph(t_ephGPS)),
             this, SLOT(slotNewGPSEph(t_ephGPS)), Qt::DirectConnection);
@@ -69,7 +72,15 @@ bncEphUser::bncEphUser(bool connectSlots) {
 // Destructor
 ////////////////////////////////////////////////////////////////////////////
 bncEphUser::~bncEphUser() {
-  QMapIterator<QString, deque<t_eph*> > it(_eph);
+  for (unsigned ii = 0; ii < t_prn::NUMINDEX; ii++) {
+    if (_eph[ii]) {
+      for (unsigned jj = 0; jj < _eph[ii]->size(); jj++) {
+        delete _eph[ii]->at(jj);
+      }
+      delete _eph[ii];
+    }
+  }
+  QMapIterator<QString, deque<t_eph*> > it(_ephOther);
   while (it.hasNext()) {
     it.next();
     const deque<t_eph*>& qq = it.value();
@@ -79,6 +90,48 @@ bncEphUser::~bncEphUser() {
   }
 }
 
+// Satellite from internal string (e.g. "G01_0")
+////////////////////////////////////////////////////////////////////////////
+t_prn bncEphUser::toPrn(const QString& prn) {
+  if (prn.isEmpty()) {
+    return t_prn(' ', 0);
+  }
+  int flags = (prn.length() > 4 && prn[3] == '_') ? prn.mid(4).toInt() : 0;
+  return t_prn(prn[0].toAscii(), prn.mid(1,2).toInt(), flags);
+}
+
+// Ephemeris queue of a satellite (optionally created)
+////////////////////////////////////////////////////////////////////////////
+deque<t_eph*>* bncEphUser::queue(const t_prn& prn, bool create) {
+  int index = prn.toIndex();
+  if (index >= 0) {
+    if (!_eph[index] && create) {
+      _eph[index] = new deque<t_eph*>;
+    }
+    return _eph[index];
+  }
+  QString key(prn.toInternalString().c_str());
+  if (create) {
+    return &_ephOther[key];
+  }
+  QMap<QString, deque<t_eph*> >::iterator it = _ephOther.find(key);
+  return (it != _ephOther.end()) ? &it.value() : 0;
+}
+
+// List of satellites with ephemerides
+////////////////////////////////////////////////////////////////////////////
+const QList<QString> bncEphUser::prnList() {
+  QList<QString> prns;
+  for (unsigned ii = 0; ii < t_prn::NUMINDEX; ii++) {
+    if (_eph[ii] && !_eph[ii]->empty()) {
+      prns << QString(_eph[ii]->back()->prn().toInternalString().c_str());
+    }
+  }
+  prns << _ephOther.keys();
+  qSort(prns);
+  return prns;
+}
+
 // New GPS Ephemeris
 ////////////////////////////////////////////////////////////////////////////
 void bncEphUser::slotNewGPSEph(t_ephGPS eph) {
@@ -149,7 +202,7 @@ t_irc bncEphUser::putNewEph(t_eph* eph, bool realTime) {
     return failure;
   }
 
-  QString prn(newEph->prn().toInternalString().c_str());
+  t_prn prn = newEph->prn();
 
   const t_eph* ephOld = ephLast(prn);
 
@@ -162,13 +215,13 @@ t_irc bncEphUser::putNewEph(t_eph* eph, bool realTime) {
   if ((ephOld == 0 || newEph->isNewerThan(ephOld)) &&
       (eph->checkState() != t_eph::bad &&
        eph->checkState() != t_eph::outdated)) {
-    deque<t_eph*>& qq = _eph[prn];
+    deque<t_eph*>& qq = *queue(prn, true);
     qq.push_back(newEph);
     if (qq.size() > _maxQueueSize) {
       delete qq.front();
       qq.pop_front();
     }
-    ephBufferChanged();
+    ephBufferChanged(newEph);
     return success;
   }
   else {
@@ -251,8 +304,7 @@ void bncEphUser::checkEphemeris(t_eph* eph, bool realTime) {
   // Check consistency with older ephemerides
   // ----------------------------------------
   const double MAXDIFF = 1000.0;
-  QString      prn     = QString(eph->prn().toInternalString().c_str());
-  t_eph*       ephL    = ephLast(prn);
+  t_eph*       ephL    = ephLast(eph->prn());
 
   if (ephL) {
     ColumnVector xcL(6);
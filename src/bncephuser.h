@@ -50,33 +50,41 @@ class bncEphUser : public QObject {
 
   t_irc putNewEph(t_eph* newEph, bool check);
 
-  t_eph* ephLast(const QString& prn) {
-    if (_eph.contains(prn)) {
-      return _eph[prn].back();
+  t_eph* ephLast(const t_prn& prn) {
+    const std::deque<t_eph*>* qq = queue(prn);
+    if (qq && !qq->empty()) {
+      return qq->back();
     }
     return 0;
   }
 
-  t_eph* ephPrev(const QString& prn) {
-    if (_eph.contains(prn)) {
-      unsigned nn = _eph[prn].size();
+  t_eph* ephPrev(const t_prn& prn) {
+    const std::deque<t_eph*>* qq = queue(prn);
+    if (qq) {
+      unsigned nn = qq->size();
       if (nn > 1) {
-        return _eph[prn].at(nn-2);
+        return qq->at(nn-2);
       }
     }
     return 0;
   }
 
-  const QList<QString> prnList() {return _eph.keys();}
+  t_eph* ephLast(const QString& prn) {return ephLast(toPrn(prn));}
+  t_eph* ephPrev(const QString& prn) {return ephPrev(toPrn(prn));}
+
+  const QList<QString> prnList();
 
  protected:
-  virtual void ephBufferChanged() {}
+  virtual void ephBufferChanged(const t_eph* /* newEph */) {}
 
  private:
   void checkEphemeris(t_eph* eph, bool realTime);
+  static t_prn toPrn(const QString& prn);
+  std::deque<t_eph*>* queue(const t_prn& prn, bool create = false);
   QMutex                             _mutex;
   static const unsigned              _maxQueueSize = 5;
-  QMap<QString, std::deque<t_eph*> > _eph;
+  std::deque<t_eph*>*                _eph[t_prn::NUMINDEX]; // dense satellite index
+  QMap<QString, std::deque<t_eph*> > _ephOther;            // satellites outside the index
 };
 
 #endif
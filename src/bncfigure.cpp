@@ -49,7 +49,8 @@ using namespace std;
 ////////////////////////////////////////////////////////////////////////////
 bncFigure::bncFigure(QWidget *parent) : QWidget(parent) {
   updateMountPoints();
-  slotNextAnimationFrame();
+  connect(&_timer, SIGNAL(timeout()), this, SLOT(slotNextAnimationFrame()));
+  _timer.setInterval(1000);
   for (int ii = 0; ii <= 1000; ii++) {
     _ran[0][ii] = qrand() % 255;
     _ran[1][ii] = qrand() % 255;
@@ -91,6 +92,9 @@ void bncFigure::updateMountPoints() {
     QByteArray  staID = url.path().mid(1).toAscii();
     _bytes[staID] = new sumAndMean();
   }
+
+  _dirty = true;
+  update();
 }
 
 //
@@ -115,27 +119,93 @@ void bncFigure::slotNextAnimationFrame() {
   // If counter reaches its maximal value, compute the mean rate
   // -----------------------------------------------------------
   if (_counter == MAXCOUNTER) {
-    _maxRate = 0.0;
+    double       maxRate    = 0.0;
+    bool         fullUpdate = false;
+    QVector<int> changed;
+    int          anchor     = 0;
     QMapIterator<QByteArray, sumAndMean*> it(_bytes);
     while (it.hasNext()) {
       it.next();
-      it.value()->_mean = it.value()->_sum / _counter;
+      double mean = it.value()->_sum / _counter;
+      if (mean != it.value()->_mean) {
+        changed << anchor;
+        if ((mean <= 0) != (it.value()->_mean <= 0)) {
+          fullUpdate = true;    // color of the label
+        }
+      }
+      it.value()->_mean = mean;
       it.value()->_sum  = 0.0;
-      if (it.value()->_mean > _maxRate) {
-        _maxRate = it.value()->_mean;
+      if (mean > maxRate) {
+        maxRate = mean;
       }
+      ++anchor;
     }
     _counter = 0;
+
+    // Repaint the changed bars only, everything if the scale changes
+    // --------------------------------------------------------------
+    if (maxRate != _maxRate) {
+      fullUpdate = true;
+    }
+    _maxRate = maxRate;
+    if (fullUpdate) {
+      _dirty = true;
+      update();
+    }
+    else if (!changed.isEmpty()) {
+      _dirty = true;
+      for (int ii = 0; ii < changed.size(); ii++) {
+        update(barRect(changed[ii]));
+      }
+    }
   }
+}
 
-  update();
+// Animation while shown only, the sums restart
+////////////////////////////////////////////////////////////////////////////
+void bncFigure::showEvent(QShowEvent *) {
+  QMutexLocker locker(&_mutex);
+  QMapIterator<QByteArray, sumAndMean*> it(_bytes);
+  while (it.hasNext()) {
+    it.next();
+    it.value()->_sum = 0.0;
+  }
+  _counter = 0;
+  _dirty   = true;
+  _timer.start();
+}
+
+//
+////////////////////////////////////////////////////////////////////////////
+void bncFigure::hideEvent(QHideEvent *) {
+  _timer.stop();
+}
 
-  QTimer::singleShot(1000, this, SLOT(slotNextAnimationFrame()));
+// Area of the bar of a stream
+////////////////////////////////////////////////////////////////////////////
+QRect bncFigure::barRect(int anchor) const {
+  int xx = 80 + anchor*12;
+  return QRect(xx-13, 0, 9, int(140*.60) + 1);
+}
+
+// Render the figure if needed, repaint from the pixmap
+////////////////////////////////////////////////////////////////////////////
+void bncFigure::paintEvent(QPaintEvent *event) {
+  if (_dirty || _pixmap.size() != size()) {
+    render();
+  }
+  QPainter painter(this);
+  painter.drawPixmap(event->rect(), _pixmap, event->rect());
 }
 
 //
 ////////////////////////////////////////////////////////////////////////////
-void bncFigure::paintEvent(QPaintEvent *) {
+void bncFigure::render() {
+  QMutexLocker locker(&_mutex);
+
+  _pixmap = QPixmap(size());
+  _pixmap.fill(this, 0, 0);
+  _dirty  = false;
 
   int xMin =   0;
   int xMax = 640;
@@ -143,7 +213,8 @@ void bncFigure::paintEvent(QPaintEvent *) {
   int yMax = 140;
   float xLine = .60;
 
-  QPainter painter(this);
+  QPainter painter(&_pixmap);
+  painter.initFrom(this);
 
   QFont font;
   font.setPointSize(int(font.QFont::pointSize()*0.8));
@@ -37,9 +37,13 @@ class bncFigure : public QWidget {
   void slotNewData(const QByteArray staID, double nbyte);
  protected:
   void paintEvent(QPaintEvent *event);
+  void showEvent(QShowEvent *event);
+  void hideEvent(QHideEvent *event);
  private slots:
   void slotNextAnimationFrame();
  private:
+  void  render();
+  QRect barRect(int anchor) const;
   class sumAndMean {
    public:
     sumAndMean() {_mean = 0.0; _sum = 0.0;}
@@ -52,6 +56,9 @@ class bncFigure : public QWidget {
   int                           _counter;
   double                        _maxRate;
   int                           _ran[3][1001];
+  QTimer                        _timer;    // runs while shown only
+  QPixmap                       _pixmap;   // figure as last rendered
+  bool                          _dirty;    // pixmap out of date
 };
 
 #endif
@@ -49,7 +49,8 @@ using namespace std;
 ////////////////////////////////////////////////////////////////////////////
 bncFigureLate::bncFigureLate(QWidget *parent) : QWidget(parent) {
   updateMountPoints();
-  slotNextAnimationFrame();
+  connect(&_timer, SIGNAL(timeout()), this, SLOT(slotNextAnimationFrame()));
+  _timer.setInterval(1000);
   for (int ii = 0; ii <= 1000; ii++) {
     _ran[0][ii] = qrand() % 255;
     _ran[1][ii] = qrand() % 255;
@@ -78,28 +79,105 @@ void bncFigureLate::updateMountPoints() {
     QByteArray  staID = url.path().mid(1).toAscii();
     _latency[staID] = 0.0;
   }
+  _changed.clear();
+  _maxLate      = 0.0;
+  _labelChanged = false;
+
+  _dirty = true;
+  update();
 }
 
 // 
 ////////////////////////////////////////////////////////////////////////////
 void bncFigureLate::slotNewLatency(const QByteArray staID, double clate) {
   QMutexLocker locker(&_mutex);
-  if (_latency.find(staID) != _latency.end()) {
-    _latency[staID] = fabs(clate)*1000.0;
+  QMap<QByteArray, double>::iterator it = _latency.find(staID);
+  double late = fabs(clate)*1000.0;
+  if (it != _latency.end() && it.value() != late) {
+    if ((it.value() <= 0) != (late <= 0)) {
+      _labelChanged = true;   // color of the label
+    }
+    it.value() = late;
+    _changed.insert(staID);
   }
 }
 
-// 
+// Repaint the changed bars only, everything if the scale changes
 ////////////////////////////////////////////////////////////////////////////
 void bncFigureLate::slotNextAnimationFrame() {
   QMutexLocker locker(&_mutex);
-  update();
-  QTimer::singleShot(1000, this, SLOT(slotNextAnimationFrame()));
+
+  if (_changed.isEmpty()) {
+    return;
+  }
+
+  double       maxLate = 0.0;
+  QVector<int> changed;
+  int          anchor  = 0;
+  QMapIterator<QByteArray, double> it(_latency);
+  while (it.hasNext()) {
+    it.next();
+    if (it.value() > maxLate) {
+      maxLate = it.value();
+    }
+    if (_changed.contains(it.key())) {
+      changed << anchor;
+    }
+    ++anchor;
+  }
+  _changed.clear();
+
+  _dirty = true;
+  if (maxLate != _maxLate || _labelChanged) {
+    _maxLate      = maxLate;
+    _labelChanged = false;
+    update();
+  }
+  else {
+    for (int ii = 0; ii < changed.size(); ii++) {
+      update(barRect(changed[ii]));
+    }
+  }
+}
+
+// Animation while shown only
+////////////////////////////////////////////////////////////////////////////
+void bncFigureLate::showEvent(QShowEvent *) {
+  _dirty = true;
+  _timer.start();
+}
+
+//
+////////////////////////////////////////////////////////////////////////////
+void bncFigureLate::hideEvent(QHideEvent *) {
+  _timer.stop();
+}
+
+// Area of the bar of a stream
+////////////////////////////////////////////////////////////////////////////
+QRect bncFigureLate::barRect(int anchor) const {
+  int xx = 80 + anchor*12;
+  return QRect(xx-13, 0, 9, int(140*.60) + 1);
+}
+
+// Render the figure if needed, repaint from the pixmap
+////////////////////////////////////////////////////////////////////////////
+void bncFigureLate::paintEvent(QPaintEvent *event) {
+  if (_dirty || _pixmap.size() != size()) {
+    render();
+  }
+  QPainter painter(this);
+  painter.drawPixmap(event->rect(), _pixmap, event->rect());
 }
 
 // 
 ////////////////////////////////////////////////////////////////////////////
-void bncFigureLate::paintEvent(QPaintEvent *) {
+void bncFigureLate::render() {
+  QMutexLocker locker(&_mutex);
+
+  _pixmap = QPixmap(size());
+  _pixmap.fill(this, 0, 0);
+  _dirty  = false;
 
   int xMin =   0;
   int xMax = 640;
@@ -107,7 +185,8 @@ void bncFigureLate::paintEvent(QPaintEvent *) {
   int yMax = 140;
   float xLine = .60;
 
-  QPainter painter(this);
+  QPainter painter(&_pixmap);
+  painter.initFrom(this);
 
   QFont font;
   font.setPointSize(int(font.QFont::pointSize()*0.8));
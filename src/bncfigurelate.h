@@ -37,12 +37,22 @@ class bncFigureLate : public QWidget {
   void slotNewLatency(const QByteArray staID, double clate);
  protected:
   void paintEvent(QPaintEvent *event);
+  void showEvent(QShowEvent *event);
+  void hideEvent(QHideEvent *event);
  private slots:
   void slotNextAnimationFrame();
  private:
+  void  render();
+  QRect barRect(int anchor) const;
   QMap<QByteArray, double> _latency;
+  QSet<QByteArray>         _changed;   // since the last frame
+  bool                     _labelChanged;
   QMutex                   _mutex;
   int                      _ran[3][1001];
+  double                   _maxLate;
+  QTimer                   _timer;     // runs while shown only
+  QPixmap                  _pixmap;    // figure as last rendered
+  bool                     _dirty;     // pixmap out of date
 };
 
 #endif
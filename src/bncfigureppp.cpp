@@ -49,6 +49,9 @@ using namespace std;
 // Constructor
 ////////////////////////////////////////////////////////////////////////////
 bncFigurePPP::bncFigurePPP(QWidget *parent) : QWidget(parent) {
+  _shown = false;
+  _frameTimer.setSingleShot(true);
+  connect(&_frameTimer, SIGNAL(timeout()), this, SLOT(slotNextFrame()));
   reset();
 }
 
@@ -69,14 +72,6 @@ void bncFigurePPP::reset() {
     delete _pos[ii];
   }
   _pos.clear();
-  update();
-}
-
-// 
-////////////////////////////////////////////////////////////////////////////
-void bncFigurePPP::slotNewPosition(QByteArray staID, bncTime time, QVector<double> xx){
-
-  QMutexLocker locker(&_mutex);
 
   bncSettings settings;
 
@@ -87,7 +82,25 @@ void bncFigurePPP::slotNewPosition(QByteArray staID, bncTime time, QVector<doubl
     _audioResponseThreshold = 0.0;
   }
 
-  if (settings.value("PPP/plotCoordinates").toByteArray() != staID) {
+  _plotStaID = settings.value("PPP/plotCoordinates").toByteArray();
+
+  int frameRate = settings.value("PPP/plotFrameRate").toInt();
+  if (frameRate <= 0) {
+    frameRate = 2;
+  }
+  _frameTimer.setInterval(1000 / frameRate);
+
+  _dirty = true;
+  update();
+}
+
+// 
+////////////////////////////////////////////////////////////////////////////
+void bncFigurePPP::slotNewPosition(QByteArray staID, bncTime time, QVector<double> xx){
+
+  QMutexLocker locker(&_mutex);
+
+  if (_plotStaID != staID) {
     return;
   }
 
@@ -113,9 +126,41 @@ void bncFigurePPP::slotNewPosition(QByteArray staID, bncTime time, QVector<doubl
     }
   }
 
+  // Audio response
+  // --------------
+  if ( _audioResponseThreshold > 0.0 &&
+       (fabs(newPos->neu[0]) > _audioResponseThreshold ||
+        fabs(newPos->neu[1]) > _audioResponseThreshold) ) {
+    QApplication::beep();
+  }
+
+  // Positions arriving within a frame are shown together
+  // ----------------------------------------------------
+  _dirty = true;
+  if (_shown && !_frameTimer.isActive()) {
+    _frameTimer.start();
+  }
+}
+
+// 
+////////////////////////////////////////////////////////////////////////////
+void bncFigurePPP::slotNextFrame() {
   update();
 }
 
+// No frames while hidden
+////////////////////////////////////////////////////////////////////////////
+void bncFigurePPP::showEvent(QShowEvent *) {
+  _shown = true;
+}
+
+// 
+////////////////////////////////////////////////////////////////////////////
+void bncFigurePPP::hideEvent(QHideEvent *) {
+  _shown = false;
+  _frameTimer.stop();
+}
+
 // Coordinate Transformation
 ////////////////////////////////////////////////////////////////////////////
 QPoint bncFigurePPP::pltPoint(double tt, double yy) {
@@ -133,9 +178,25 @@ QPoint bncFigurePPP::pltPoint(double tt, double yy) {
 
 // 
 ////////////////////////////////////////////////////////////////////////////
-void bncFigurePPP::paintEvent(QPaintEvent *) {
-
+void bncFigurePPP::paintEvent(QPaintEvent *event) {
+  if (_dirty || _pixmap.size() != size()) {
+    render();
+  }
   QPainter painter(this);
+  painter.drawPixmap(event->rect(), _pixmap, event->rect());
+}
+
+// Render the plot into the pixmap
+////////////////////////////////////////////////////////////////////////////
+void bncFigurePPP::render() {
+  QMutexLocker locker(&_mutex);
+
+  _pixmap = QPixmap(size());
+  _pixmap.fill(this, 0, 0);
+  _dirty  = false;
+
+  QPainter painter(&_pixmap);
+  painter.initFrom(this);
 
   _width  = painter.viewport().width();
   _height = painter.viewport().height();
@@ -178,16 +239,6 @@ void bncFigurePPP::paintEvent(QPaintEvent *) {
         double t1 = _tMin + (_pos[ii-1]->time - _pos[0]->time);
         double t2 = _tMin + (_pos[ii]->time   - _pos[0]->time);
 
-        // Audio response
-        // --------------
-        if ( ii == _pos.size()-1) {
-          if ( _audioResponseThreshold > 0.0 &&
-               (fabs(neu[ii-1][0]) > _audioResponseThreshold ||
-                fabs(neu[ii-1][1]) > _audioResponseThreshold) ) {
-            QApplication::beep();
-          }
-        }
-
         // dots
         // ----
         painter.setPen(QColor(Qt::gray));
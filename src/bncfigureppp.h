@@ -40,6 +40,11 @@ class bncFigurePPP : public QWidget {
 
  protected:
   void paintEvent(QPaintEvent *event);
+  void showEvent(QShowEvent *event);
+  void hideEvent(QHideEvent *event);
+
+ private slots:
+  void slotNextFrame();
 
  private:
   enum {_tRange = 300};
@@ -51,6 +56,7 @@ class bncFigurePPP : public QWidget {
   };
 
   QPoint pltPoint(double tt, double yy);
+  void   render();
 
   QMutex           _mutex;
   QVector<pppPos*> _pos;
@@ -58,8 +64,13 @@ class bncFigurePPP : public QWidget {
   double           _neuMax;
   double           _tMin;
   double           _audioResponseThreshold;
+  QByteArray       _plotStaID;
   int              _width;
   int              _height;
+  QTimer           _frameTimer;   // new positions are shown with this delay
+  QPixmap          _pixmap;       // plot as last rendered
+  bool             _dirty;        // pixmap out of date
+  bool             _shown;
 };
 
 #endif
@@ -47,6 +47,7 @@
 #include <QMutex>
 #include <QtNetwork>
 #include <QTime>
+#include <QElapsedTimer>
 
 #include "bncgetthread.h"
 #include "bnctabledlg.h"
@@ -62,6 +63,8 @@
 #include "bncnetqueryudp0.h"
 #include "bncnetquerys.h"
 #include "bncsettings.h"
+#include "bncmetrics.h"
+#include "bncconnscheduler.h"
 #include "latencychecker.h"
 #include "upload/bncrtnetdecoder.h"
 #include "RTCM/RTCM2Decoder.h"
@@ -78,6 +81,7 @@ bncGetThread::bncGetThread(bncRawFile* rawFile) {
   _format = rawFile->format();
   _staID = rawFile->staID();
   _rawOutput = false;
+  _latencycheck = false;
   _ntripVersion = "N";
 
   initialize();
@@ -126,11 +130,26 @@ void bncGetThread::initialize() {
   BNC_CORE, SLOT(slotMessage(const QByteArray,bool)));
 
   _isToBeDeleted = false;
+  _reactorInput = false;
   _query = 0;
-  _nextSleep = 0;
+  _rawStation = 0;
+  _connAttempt = 0;
   _miscMount = settings.value("miscMount").toString();
   _decoder = 0;
 
+  // Metrics
+  // -------
+  QString mountLabel = bncMetrics::label("mountpoint", _staID);
+  _metricBytes   = BNC_METRICS->counter("bnc_stream_bytes_total",
+                     "Bytes received per stream", mountLabel);
+  _metricObs     = BNC_METRICS->counter("bnc_stream_observations_total",
+                     "Satellite observations passed on per stream", mountLabel);
+  _metricDecode  = BNC_METRICS->histogram("bnc_stream_decode_seconds",
+                     "Time spent decoding a received data block", mountLabel);
+  _metricLatency = BNC_METRICS->histogram("bnc_stream_latency_seconds",
+                     "Observation epoch latency with respect to GPS time",
+                     mountLabel, bncMetrics::latencies);
+
   // NMEA Port
   // -----------
   QListIterator<QString> iSta(settings.value("PPP/staTable").toStringList());
@@ -334,8 +353,6 @@ t_irc bncGetThread::initDecoder() {
     return failure;
   }
 
-  msleep(100); //sleep 0.1 sec
-
   _decoder->initRinex(_staID, _mountPoint, _latitude, _longitude, _nmea,
       _ntripVersion);
 
@@ -382,6 +399,14 @@ bncGetThread::~bncGetThread() {
   delete _serialOutFile;
   delete _serialPort;
   delete _latencyChecker;
+  BNC_METRICS->release(_metricBytes);
+  BNC_METRICS->release(_metricObs);
+  BNC_METRICS->release(_metricDecode);
+  BNC_METRICS->release(_metricLatency);
+  QMapIterator<int, bncMetricCounter*> itMsg(_metricMessages);
+  while (itMsg.hasNext()) {
+    BNC_METRICS->release(itMsg.next().value());
+  }
   emit getThreadFinished(_staID);
 }
 
@@ -400,6 +425,14 @@ void bncGetThread::terminate() {
     delete _nmeaSockets;
   }
 
+  // Streams of the reactor are never started as a thread; the reactor has
+  // stopped reading them (bncNetReactor::removeStream)
+  // ----------------------------------------------------------------------
+  if (_reactorInput) {
+    delete this;
+    return;
+  }
+
 #ifdef BNC_DEBUG
   if (BNC_CORE->mode() != t_bncCore::interactive) {
     while (!isFinished()) {
@@ -436,19 +469,6 @@ void bncGetThread::run() {
         continue;
       }
 
-      // Delete old observations
-      // -----------------------
-      if (_rawFile) {
-        QMapIterator<QString, GPSDecoder*> itDec(_decodersRaw);
-        while (itDec.hasNext()) {
-          itDec.next();
-          GPSDecoder* decoder = itDec.value();
-          decoder->_obsList.clear();
-        }
-      } else {
-        _decoder->_obsList.clear();
-      }
-
       // Read Data
       // ---------
       QByteArray data;
@@ -477,189 +497,285 @@ void bncGetThread::run() {
           _latencyChecker->checkReconnect();
         }
         emit(newMessage(_staID + ": Data timeout, reconnecting", true));
-        msleep(10000); //sleep 10 sec, G. Weber
+        if (_query) {
+          _query->stop();
+        }
         continue;
-      } else {
-        emit newBytes(_staID, nBytes);
-        emit newRawData(_staID, data);
       }
 
-      // Output Data
-      // -----------
-      if (_rawOutput) {
-        BNC_CORE->writeRawData(data, _staID, _format);
-      }
+      processData(data);
 
-      if (_serialPort) {
-        slotSerialReadyRead();
-        _serialPort->write(data);
-      }
+    } catch (Exception& exc) {
+      emit(newMessage(_staID + " " + exc.what(), true));
+      _isToBeDeleted = true;
+    } catch (...) {
+      emit(newMessage(_staID + " bncGetThread exception", true));
+      _isToBeDeleted = true;
+    }
+  }
+}
 
-      // Decode Data
-      // -----------
-      vector<string> errmsg;
-      if (!decoder()) {
-        _isToBeDeleted = true;
-        continue;
-      }
+// Process one chunk of data (output, decoding, checks, observations)
+////////////////////////////////////////////////////////////////////////////
+void bncGetThread::processData(QByteArray& data) {
+
+  // Delete old observations
+  // -----------------------
+  if (_rawFile) {
+    QMapIterator<QString, GPSDecoder*> itDec(_decodersRaw);
+    while (itDec.hasNext()) {
+      itDec.next();
+      GPSDecoder* decoder = itDec.value();
+      decoder->_obsList.clear();
+    }
+  } else {
+    _decoder->_obsList.clear();
+  }
 
-      t_irc irc = decoder()->Decode(data.data(), data.size(), errmsg);
+  emit newBytes(_staID, data.size());
+  if (receivers(SIGNAL(newRawData(QByteArray, QByteArray))) > 0) {
+    emit newRawData(_staID, data);
+  }
+  _metricBytes->add(data.size());
 
-      if (irc != success) {
-        continue;
+  // Output Data
+  // -----------
+  if (_rawOutput) {
+    if (!_rawStation || _rawStation->staID() != _staID) {
+      bncRawRecorder* recorder = BNC_CORE->rawRecorder();
+      _rawStation = recorder ? recorder->station(_staID) : 0;
+    }
+    if (_rawStation) {
+      _rawStation->append(data, _format);
+    }
+  }
+
+  if (_serialPort) {
+    slotSerialReadyRead();
+    _serialPort->write(data);
+  }
+
+  // Decode Data
+  // -----------
+  vector<string> errmsg;
+  if (!decoder()) {
+    _isToBeDeleted = true;
+    return;
+  }
+
+  QElapsedTimer decodeTimer;
+  decodeTimer.start();
+  t_irc irc = decoder()->Decode(data.data(), data.size(), errmsg);
+  double decodeSec = decodeTimer.nsecsElapsed() * 1.e-9;
+
+  if (irc != success) {
+    _metricDecode->observe(decodeSec);
+    return;
+  }
+  recordMetrics(decodeSec);
+
+  // Perform various scans and checks
+  // --------------------------------
+  if (_latencyChecker) {
+    _latencyChecker->checkOutage(irc);
+    QListIterator<int> it(decoder()->_typeList);
+    _ssrEpoch = static_cast<int>(decoder()->corrGPSEpochTime());
+    if (_oldSsrEpoch != -1  && _ssrEpoch != _oldSsrEpoch) {
+      if (ssrOrb) {
+        _latencyChecker->checkCorrLatency(_oldSsrEpoch, 1057);
+        ssrOrb = false;
       }
-      // Perform various scans and checks
-      // --------------------------------
-      if (_latencyChecker) {
-        _latencyChecker->checkOutage(irc);
-        QListIterator<int> it(decoder()->_typeList);
-        _ssrEpoch = static_cast<int>(decoder()->corrGPSEpochTime());
-        if (_oldSsrEpoch != -1  && _ssrEpoch != _oldSsrEpoch) {
-          if (ssrOrb) {
-            _latencyChecker->checkCorrLatency(_oldSsrEpoch, 1057);
-            ssrOrb = false;
-          }
-          if (ssrClk) {
-            _latencyChecker->checkCorrLatency(_oldSsrEpoch, 1058);
-            ssrClk = false;
-          }
-          if (ssrOrbClk) {
-            _latencyChecker->checkCorrLatency(_oldSsrEpoch, 1060);
-            ssrOrbClk = false;
-          }
-          if (ssrCbi) {
-            _latencyChecker->checkCorrLatency(_oldSsrEpoch, 1059);
-            ssrCbi = false;
-          }
-          if (ssrPbi) {
-            _latencyChecker->checkCorrLatency(_oldSsrEpoch, 1265);
-            ssrPbi = false;
-          }
-          if (ssrVtec) {
-            _latencyChecker->checkCorrLatency(_oldSsrEpoch, 1264);
-            ssrVtec = false;
-          }
-          if (ssrUra) {
-            _latencyChecker->checkCorrLatency(_oldSsrEpoch, 1061);
-            ssrUra = false;
-          }
-          if (ssrHr) {
-            _latencyChecker->checkCorrLatency(_oldSsrEpoch, 1062);
-            ssrHr = false;
-          }
-        }
-        while (it.hasNext()) {
-          int rtcmType = it.next();
-          if ((rtcmType >= 1001 && rtcmType <= 1004) || // legacy RTCM OBS
-              (rtcmType >= 1009 && rtcmType <= 1012) || // legacy RTCM OBS
-              (rtcmType >= 1071 && rtcmType <= 1127)) { // MSM RTCM OBS
-            obs = true;
-          } else if ((rtcmType >= 1057 && rtcmType <= 1068) ||
-                     (rtcmType >= 1240 && rtcmType <= 1270)) {
-            switch (rtcmType) {
-              case 1057: case 1063: case 1240: case 1246: case 1252: case 1258:
-                ssrOrb = true;
-                break;
-              case 1058: case 1064: case 1241: case 1247: case 1253: case 1259:
-                ssrClk = true;
-                break;
-              case 1060: case 1066: case 1243: case 1249: case 1255: case 1261:
-                ssrOrbClk = true;
-                break;
-              case 1059: case 1065: case 1242:   case 1248: case 1254: case 1260:
-                ssrCbi = true;
-                break;
-              case 1265: case 1266: case 1267: case 1268: case 1269: case 1270:
-                ssrPbi = true;
-                break;
-              case 1264:
-                ssrVtec = true;
-                break;
-              case 1061: case 1067: case 1244: case 1250: case 1256: case 1262:
-                ssrUra = true;
-                break;
-              case 1062: case 1068: case 1245: case 1251: case 1257: case 1263:
-                ssrHr = true;
-                break;
-            }
-          }
-        }
-        if (obs) {
-          _latencyChecker->checkObsLatency(decoder()->_obsList);
-        }
-        if (_ssrEpoch != -1) {
-          _oldSsrEpoch = _ssrEpoch;
-        }
-        emit newLatency(_staID, _latencyChecker->currentLatency());
+      if (ssrClk) {
+        _latencyChecker->checkCorrLatency(_oldSsrEpoch, 1058);
+        ssrClk = false;
       }
-      miscScanRTCM();
-
-      // Loop over all observations (observations output)
-      // ------------------------------------------------
-      QListIterator<t_satObs> it(decoder()->_obsList);
-
-      QList<t_satObs> obsListHlp;
-
-      while (it.hasNext()) {
-        const t_satObs& obs = it.next();
-
-        // Check observation epoch
-        // -----------------------
-        if (!_rawFile) {
-          bool wrongObservationEpoch = checkForWrongObsEpoch(obs._time);
-          if (wrongObservationEpoch) {
-            QString prn(obs._prn.toString().c_str());
-            emit(newMessage(
-                _staID + " (" + prn.toAscii() + ")"
-                    + ": Wrong observation epoch(s)", false));
-            continue;
-          }
+      if (ssrOrbClk) {
+        _latencyChecker->checkCorrLatency(_oldSsrEpoch, 1060);
+        ssrOrbClk = false;
+      }
+      if (ssrCbi) {
+        _latencyChecker->checkCorrLatency(_oldSsrEpoch, 1059);
+        ssrCbi = false;
+      }
+      if (ssrPbi) {
+        _latencyChecker->checkCorrLatency(_oldSsrEpoch, 1265);
+        ssrPbi = false;
+      }
+      if (ssrVtec) {
+        _latencyChecker->checkCorrLatency(_oldSsrEpoch, 1264);
+        ssrVtec = false;
+      }
+      if (ssrUra) {
+        _latencyChecker->checkCorrLatency(_oldSsrEpoch, 1061);
+        ssrUra = false;
+      }
+      if (ssrHr) {
+        _latencyChecker->checkCorrLatency(_oldSsrEpoch, 1062);
+        ssrHr = false;
+      }
+    }
+    while (it.hasNext()) {
+      int rtcmType = it.next();
+      if ((rtcmType >= 1001 && rtcmType <= 1004) || // legacy RTCM OBS
+          (rtcmType >= 1009 && rtcmType <= 1012) || // legacy RTCM OBS
+          (rtcmType >= 1071 && rtcmType <= 1127)) { // MSM RTCM OBS
+        obs = true;
+      } else if ((rtcmType >= 1057 && rtcmType <= 1068) ||
+                 (rtcmType >= 1240 && rtcmType <= 1270)) {
+        switch (rtcmType) {
+          case 1057: case 1063: case 1240: case 1246: case 1252: case 1258:
+            ssrOrb = true;
+            break;
+          case 1058: case 1064: case 1241: case 1247: case 1253: case 1259:
+            ssrClk = true;
+            break;
+          case 1060: case 1066: case 1243: case 1249: case 1255: case 1261:
+            ssrOrbClk = true;
+            break;
+          case 1059: case 1065: case 1242:   case 1248: case 1254: case 1260:
+            ssrCbi = true;
+            break;
+          case 1265: case 1266: case 1267: case 1268: case 1269: case 1270:
+            ssrPbi = true;
+            break;
+          case 1264:
+            ssrVtec = true;
+            break;
+          case 1061: case 1067: case 1244: case 1250: case 1256: case 1262:
+            ssrUra = true;
+            break;
+          case 1062: case 1068: case 1245: case 1251: case 1257: case 1263:
+            ssrHr = true;
+            break;
         }
+      }
+    }
+    if (obs) {
+      _latencyChecker->checkObsLatency(decoder()->_obsList);
+    }
+    if (_ssrEpoch != -1) {
+      _oldSsrEpoch = _ssrEpoch;
+    }
+    emit newLatency(_staID, _latencyChecker->currentLatency());
+  }
+  miscScanRTCM();
+
+  // Loop over all observations (observations output)
+  // ------------------------------------------------
+  QListIterator<t_satObs> it(decoder()->_obsList);
+
+  QList<t_satObs> obsListHlp;
+
+  while (it.hasNext()) {
+    const t_satObs& obs = it.next();
+
+    // Check observation epoch
+    // -----------------------
+    if (!_rawFile) {
+      bool wrongObservationEpoch = checkForWrongObsEpoch(obs._time);
+      if (wrongObservationEpoch) {
+        QString prn(obs._prn.toString().c_str());
+        emit(newMessage(
+            _staID + " (" + prn.toAscii() + ")"
+                + ": Wrong observation epoch(s)", false));
+        continue;
+      }
+    }
 
-        // Check observations coming twice (e.g. KOUR0 Problem)
-        // ----------------------------------------------------
-        if (!_rawFile) {
-          QString prn(obs._prn.toString().c_str());
-          bncTime obsTime = obs._time;
-          QMap<QString, bncTime>::const_iterator it = _prnLastEpo.find(prn);
-          if (it != _prnLastEpo.end()) {
-            bncTime oldTime = it.value();
-            if (obsTime < oldTime) {
-              emit(newMessage(_staID + ": old observation " + prn.toLatin1(), false));
-              continue;
-            } else if (obsTime == oldTime) {
-              emit(newMessage(_staID + ": observation coming more than once "
-                              + prn.toLatin1(), false));
-              continue;
-            }
-          }
-          _prnLastEpo[prn] = obsTime;
+    // Check observations coming twice (e.g. KOUR0 Problem)
+    // ----------------------------------------------------
+    if (!_rawFile) {
+      QString prn(obs._prn.toString().c_str());
+      bncTime obsTime = obs._time;
+      QMap<QString, bncTime>::const_iterator it = _prnLastEpo.find(prn);
+      if (it != _prnLastEpo.end()) {
+        bncTime oldTime = it.value();
+        if (obsTime < oldTime) {
+          emit(newMessage(_staID + ": old observation " + prn.toLatin1(), false));
+          continue;
+        } else if (obsTime == oldTime) {
+          emit(newMessage(_staID + ": observation coming more than once "
+                          + prn.toLatin1(), false));
+          continue;
         }
+      }
+      _prnLastEpo[prn] = obsTime;
+    }
 
 
-        decoder()->dumpRinexEpoch(obs, _format);
+    decoder()->dumpRinexEpoch(obs, _format);
 
-        // Save observations
-        // -----------------
-        obsListHlp.append(obs);
-      }
+    // Save observations
+    // -----------------
+    obsListHlp.append(obs);
+  }
 
-      // Emit signal
-      // -----------
-      if (!_isToBeDeleted && obsListHlp.size() > 0) {
-        emit newObs(_staID, obsListHlp);
-      }
+  _metricObs->add(obsListHlp.size());
 
-    } catch (Exception& exc) {
-      emit(newMessage(_staID + " " + exc.what(), true));
-      _isToBeDeleted = true;
-    } catch (...) {
-      emit(newMessage(_staID + " bncGetThread exception", true));
-      _isToBeDeleted = true;
+  // Emit signal
+  // -----------
+  if (!_isToBeDeleted && obsListHlp.size() > 0) {
+    emit newObs(_staID, obsListHlp);
+  }
+}
+
+// Decoding time, message types and latency of new epochs
+////////////////////////////////////////////////////////////////////////////
+void bncGetThread::recordMetrics(double decodeSec) {
+
+  _metricDecode->observe(decodeSec);
+
+  for (int ii = 0; ii < decoder()->_typeList.size(); ii++) {
+    int type = decoder()->_typeList[ii];
+    bncMetricCounter* counter = _metricMessages.value(type, 0);
+    if (!counter) {
+      counter = BNC_METRICS->counter("bnc_stream_messages_total",
+                  "Decoded messages per stream and message type",
+                  bncMetrics::label("mountpoint", _staID,
+                                    "type", QString::number(type)));
+      _metricMessages[type] = counter;
+    }
+    counter->add();
+  }
+
+  // Latencies make no sense for data replayed from file
+  // ---------------------------------------------------
+  if (_rawFile) {
+    return;
+  }
+  for (int ii = 0; ii < decoder()->_obsList.size(); ii++) {
+    const bncTime& obsTime = decoder()->_obsList[ii]._time;
+    if (!_metricLastEpo.valid() || _metricLastEpo < obsTime) {
+      _metricLastEpo = obsTime;
+      int    week;
+      double sec;
+      currentGPSWeeks(week, sec);
+      _metricLatency->observe(bncTime(week, sec) - obsTime);
     }
   }
 }
 
+// Can the stream be read by the event-driven reactor (bncNetReactor)?
+////////////////////////////////////////////////////////////////////////////
+bool bncGetThread::nonBlockingInput() const {
+  return !_rawFile && !_serialPort && _nmea != "yes" && _decoder &&
+         _ntripVersion != "S";
+}
+
+// Stream (re-)connected by the reactor
+////////////////////////////////////////////////////////////////////////////
+void bncGetThread::streamConnected() {
+  _decoder->setRinexReconnectFlag(false);
+}
+
+// Stream connection lost, the reactor reconnects
+////////////////////////////////////////////////////////////////////////////
+void bncGetThread::streamDisconnected() {
+  if (_latencyChecker) {
+    _latencyChecker->checkReconnect();
+  }
+}
+
 // Try Re-Connect
 ////////////////////////////////////////////////////////////////////////////
 t_irc bncGetThread::tryReconnect() {
@@ -667,7 +783,7 @@ t_irc bncGetThread::tryReconnect() {
   // Easy Return
   // -----------
   if (_query && _query->status() == bncNetQuery::running) {
-    _nextSleep = 0;
+    _connAttempt = 0;
     if (_rawFile) {
       QMapIterator<QString, GPSDecoder*> itDec(_decodersRaw);
       while (itDec.hasNext()) {
@@ -685,20 +801,13 @@ t_irc bncGetThread::tryReconnect() {
   // -----------------
   if (!_rawFile) {
 
-    sleep(_nextSleep);
-    if (_nextSleep == 0) {
-      _nextSleep = 1;
-    } else {
-      _nextSleep = 2 * _nextSleep;
-      if (_nextSleep > 256) {
-        _nextSleep = 256;
-      }
-#ifdef MLS_SOFTWARE
-      if (_nextSleep > 4) {
-        _nextSleep = 4;
-      }
-#endif
-    }
+    msleep(BNC_CONNECTS->delay(_connAttempt));
+    ++_connAttempt;
+
+    // At most maxConnects connection attempts at a time
+    // -------------------------------------------------
+    bncConnScheduler::t_slot connSlot;
+
     delete _query;
     if (_ntripVersion == "U") {
       _query = new bncNetQueryUdp();
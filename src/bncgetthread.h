@@ -34,12 +34,15 @@
 #include "bncnetquery.h"
 #include "bnctime.h"
 #include "bncrawfile.h"
+#include "bncrawrecorder.h"
 #include "satObs.h"
 #include "rinex/rnxobsfile.h"
 
 class GPSDecoder;
 class QextSerialPort;
 class latencyChecker;
+class bncMetricCounter;
+class bncMetricHistogram;
 
 class bncGetThread : public QThread {
  Q_OBJECT
@@ -87,6 +90,12 @@ class bncGetThread : public QThread {
 
  public:
    virtual void run();
+   void processData(QByteArray& data);
+   bool isToBeDeleted() const {return _isToBeDeleted;}
+   bool nonBlockingInput() const;
+   void setReactorInput() {_reactorInput = true;}
+   void streamConnected();
+   void streamDisconnected();
 
  public slots:
    void slotNewNMEAstr(QByteArray staID, QByteArray str);
@@ -103,6 +112,7 @@ class bncGetThread : public QThread {
    void  initialize();
    t_irc tryReconnect();
    void  miscScanRTCM();
+   void  recordMetrics(double decodeSec);
 
    QMap<QString, GPSDecoder*> _decodersRaw;
    GPSDecoder*                _decoder;
@@ -118,13 +128,14 @@ class bncGetThread : public QThread {
    QByteArray                 _manualNMEAString;
    QDateTime                  _lastManualNMEA;
    int                        _manualNMEASampl;
-   int                        _nextSleep;
+   int                        _connAttempt;
    int                        _iMount;
    int                        _ssrEpoch;
    int                        _oldSsrEpoch;
    bncRawFile*                _rawFile;
    QextSerialPort*            _serialPort;
    bool                       _isToBeDeleted;
+   bool                       _reactorInput;   // read by bncNetReactor, no thread
    bool obs;
    bool ssrOrb, ssrClk, ssrOrbClk;
    bool ssrCbi, ssrPbi;
@@ -136,6 +147,7 @@ class bncGetThread : public QThread {
    QFile*                     _serialOutFile;
    t_serialNMEA               _serialNMEA;
    bool                       _rawOutput;
+   bncRawRecorder::t_station* _rawStation;
    bool                       _latencycheck;
    QMap<QString, bncTime>     _prnLastEpo;
    QMap<char, QVector<QString> > _rnxTypes;
@@ -143,6 +155,12 @@ class bncGetThread : public QThread {
    QList<QTcpSocket*>*        _nmeaSockets;
    QMap<QByteArray, int>      _nmeaPortsMap;
    QTcpServer*                _nmeaServer;
+   bncMetricCounter*          _metricBytes;
+   bncMetricCounter*          _metricObs;
+   bncMetricHistogram*        _metricDecode;
+   bncMetricHistogram*        _metricLatency;
+   QMap<int, bncMetricCounter*> _metricMessages;
+   bncTime                    _metricLastEpo;
 };
 
 #endif
@@ -0,0 +1,311 @@
+// Part of BNC, a utility for retrieving decoding and
+// converting GNSS data streams from NTRIP broadcasters.
+//
+// Copyright (C) 2007
+// German Federal Agency for Cartography and Geodesy (BKG)
+// http://www.bkg.bund.de
+// Czech Technical University Prague, Department of Geodesy
+// http://www.fsv.cvut.cz
+//
+// Email: euref-ip@bkg.bund.de
+//
+// This program is free software; you can redistribute it and/or
+// modify it under the terms of the GNU General Public License
+// as published by the Free Software Foundation, version 2.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program; if not, write to the Free Software
+// Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA 02111-1307, USA.
+
+/* -------------------------------------------------------------------------
+ * BKG NTRIP Client
+ * -------------------------------------------------------------------------
+ *
+ * Class:      bncKalman
+ *
+ * Purpose:    Square-root Kalman filter update with reusable workspaces
+ *
+ * Changes:
+ *
+ * -----------------------------------------------------------------------*/
+
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string>
+#include <newmatap.h>
+
+#include "bnckalman.h"
+
+using namespace std;
+
+// Constructor
+////////////////////////////////////////////////////////////////////////////
+bncKalman::bncKalman() {
+  _size = 0;
+}
+
+// Destructor
+////////////////////////////////////////////////////////////////////////////
+bncKalman::~bncKalman() {
+}
+
+// Make sure the workspaces are large enough (they never shrink)
+////////////////////////////////////////////////////////////////////////////
+void bncKalman::reserve(int nPar) {
+  if (nPar > _size) {
+    _size = nPar;
+    _SS.resize(_size * _size);
+    _SA.resize(_size);
+    _gg.resize(_size);
+    _nz.resize(_size);
+  }
+}
+
+// Upper triangular factor SS with QQ = SS' * SS (row-oriented Cholesky)
+////////////////////////////////////////////////////////////////////////////
+void bncKalman::cholesky(const SymmetricMatrix& QQ, int nPar) {
+
+  const double* qq = QQ.Store();     // lower triangle stored row-wise
+  double*       SS = &_SS[0];
+
+  for (int ii = 0; ii < nPar; ii++) {
+    double* Si = SS + ii * nPar;
+    for (int jj = ii; jj < nPar; jj++) {
+      Si[jj] = qq[jj * (jj + 1) / 2 + ii];
+    }
+  }
+
+  for (int kk = 0; kk < nPar; kk++) {
+    double* Sk = SS + kk * nPar;
+    if (Sk[kk] <= 0.0) {
+      Throw(NPDException(QQ));
+    }
+    double diag = sqrt(Sk[kk]);
+    double rdiag = 1.0 / diag;
+    Sk[kk] = diag;
+    for (int jj = kk + 1; jj < nPar; jj++) {
+      Sk[jj] *= rdiag;
+    }
+    for (int ii = kk + 1; ii < nPar; ii++) {
+      double  ski = Sk[ii];
+      if (ski == 0.0) {
+        continue;
+      }
+      double* Si  = SS + ii * nPar;
+      for (int jj = ii; jj < nPar; jj++) {
+        Si[jj] -= ski * Sk[jj];
+      }
+    }
+  }
+}
+
+// Process a single observation
+//
+// The pre-array  | 1/sqrt(p)   0  |  is triangularized by Givens rotations
+//                |   SS*a'     SS |
+// working from the bottom up, so that SS stays upper triangular. The first
+// row becomes | sqrt(h)  g' | with h = 1/p + a*QQ*a' and g = QQ*a'/sqrt(h).
+////////////////////////////////////////////////////////////////////////////
+void bncKalman::updateObs(const double* aRow, double ll, double pp,
+                          double* xx, int nPar) {
+
+  double* SS = &_SS[0];
+  double* SA = &_SA[0];
+  double* gg = &_gg[0];
+  int*    nz = &_nz[0];
+
+  // Non-zero elements and innovation
+  // --------------------------------
+  int    nNz  = 0;
+  double innov = ll;
+  for (int jj = 0; jj < nPar; jj++) {
+    if (aRow[jj] != 0.0) {
+      nz[nNz++] = jj;
+      innov -= aRow[jj] * xx[jj];
+    }
+  }
+  if (nNz == 0) {
+    return;
+  }
+
+  // SS * a' (rows below the last non-zero element vanish)
+  // -----------------------------------------------------
+  int jMax = nz[nNz-1];
+  for (int kk = 0; kk <= jMax; kk++) {
+    const double* Sk = SS + kk * nPar;
+    double sum = 0.0;
+    for (int in = 0; in < nNz; in++) {
+      int jj = nz[in];
+      if (jj >= kk) {
+        sum += Sk[jj] * aRow[jj];
+      }
+    }
+    SA[kk] = sum;
+  }
+
+  // Givens rotations
+  // ----------------
+  for (int jj = 0; jj < nPar; jj++) {
+    gg[jj] = 0.0;
+  }
+  double alpha = 1.0 / sqrt(pp);
+  for (int kk = jMax; kk >= 0; kk--) {
+    double beta = SA[kk];
+    if (beta == 0.0) {
+      continue;
+    }
+    double rr = sqrt(alpha * alpha + beta * beta);
+    double cc = alpha / rr;
+    double ss = beta  / rr;
+    double* Sk = SS + kk * nPar;
+    for (int jj = kk; jj < nPar; jj++) {
+      double gj = gg[jj];
+      double sj = Sk[jj];
+      gg[jj] = cc * gj + ss * sj;
+      Sk[jj] = cc * sj - ss * gj;
+    }
+    alpha = rr;
+  }
+
+  // State update, gain = g / sqrt(h)
+  // --------------------------------
+  double fac = innov / alpha;
+  for (int jj = 0; jj < nPar; jj++) {
+    xx[jj] += gg[jj] * fac;
+  }
+}
+
+// QQ = SS' * SS
+////////////////////////////////////////////////////////////////////////////
+void bncKalman::covariance(SymmetricMatrix& QQ, int nPar) const {
+
+  double*       qq = QQ.Store();
+  const double* SS = &_SS[0];
+
+  int nEl = nPar * (nPar + 1) / 2;
+  for (int ii = 0; ii < nEl; ii++) {
+    qq[ii] = 0.0;
+  }
+
+  for (int kk = 0; kk < nPar; kk++) {
+    const double* Sk = SS + kk * nPar;
+    for (int ii = kk; ii < nPar; ii++) {
+      double  ski = Sk[ii];
+      if (ski == 0.0) {
+        continue;
+      }
+      double* qi  = qq + ii * (ii + 1) / 2;
+      for (int jj = kk; jj <= ii; jj++) {
+        qi[jj] += ski * Sk[jj];
+      }
+    }
+  }
+}
+
+// Filter update
+////////////////////////////////////////////////////////////////////////////
+void bncKalman::update(const Matrix& AA, const ColumnVector& ll,
+                       const DiagonalMatrix& PP, SymmetricMatrix& QQ,
+                       ColumnVector& xx) {
+
+  int nPar = AA.Ncols();
+  int nObs = AA.Nrows();
+  if (nPar == 0) {
+    return;
+  }
+
+#ifdef BNC_KALMAN_RECORD
+  record(AA, ll, PP, QQ, xx);
+#endif
+
+  reserve(nPar);
+  cholesky(QQ, nPar);
+
+  const double* aa = AA.Store();
+  const double* pp = PP.Store();
+  const double* lv = ll.Store();
+  double*       xv = xx.Store();
+
+  for (int iObs = 0; iObs < nObs; iObs++) {
+    updateObs(aa + iObs * nPar, lv[iObs], pp[iObs], xv, nPar);
+  }
+
+  covariance(QQ, nPar);
+}
+
+// Dense reference implementation
+////////////////////////////////////////////////////////////////////////////
+void bncKalman::reference(const Matrix& AA, const ColumnVector& ll,
+                          const DiagonalMatrix& PP, SymmetricMatrix& QQ,
+                          ColumnVector& xx) {
+
+  Tracer tracer("bncKalman::reference");
+
+  int nPar = AA.Ncols();
+  int nObs = AA.Nrows();
+  UpperTriangularMatrix SS = Cholesky(QQ).t();
+
+  Matrix SA = SS*AA.t();
+  Matrix SRF(nObs+nPar, nObs+nPar); SRF = 0;
+  for (int ii = 1; ii <= nObs; ++ii) {
+    SRF(ii,ii) = 1.0 / sqrt(PP(ii,ii));
+  }
+
+  SRF.SubMatrix   (nObs+1, nObs+nPar, 1, nObs) = SA;
+  SRF.SymSubMatrix(nObs+1, nObs+nPar)          = SS;
+
+  UpperTriangularMatrix UU;
+  QRZ(SRF, UU);
+
+  SS = UU.SymSubMatrix(nObs+1, nObs+nPar);
+  UpperTriangularMatrix SH_rt = UU.SymSubMatrix(1, nObs);
+  Matrix YY  = UU.SubMatrix(1, nObs, nObs+1, nObs+nPar);
+
+  UpperTriangularMatrix SHi = SH_rt.i();
+
+  Matrix KT  = SHi * YY;
+
+  xx += KT.t() * (ll - AA * xx);
+  QQ << (SS.t() * SS);
+}
+
+#ifdef BNC_KALMAN_RECORD
+// Append the filter problem to the file named by the environment variable
+// BNC_KALMAN_RECORD (input of bnckalmanbench.cpp). One write per problem,
+// so that the problems of several threads do not interleave.
+////////////////////////////////////////////////////////////////////////////
+void bncKalman::record(const Matrix& AA, const ColumnVector& ll,
+                       const DiagonalMatrix& PP, const SymmetricMatrix& QQ,
+                       const ColumnVector& xx) {
+
+  static const char* fileName = getenv("BNC_KALMAN_RECORD");
+  static FILE*       outFile  = fileName ? fopen(fileName, "a") : 0;
+  if (!outFile) {
+    return;
+  }
+
+  int nPar = AA.Ncols();
+  int nObs = AA.Nrows();
+
+  std::string str;
+  char buf[32];
+  sprintf(buf, "%d %d\n", nObs, nPar);
+  str += buf;
+  const double* vals[] = {AA.Store(), ll.Store(), PP.Store(), QQ.Store(), xx.Store()};
+  int           nVals[] = {nObs * nPar, nObs, nObs, nPar * (nPar + 1) / 2, nPar};
+  for (int iv = 0; iv < 5; iv++) {
+    for (int ii = 0; ii < nVals[iv]; ii++) {
+      sprintf(buf, "%.17g\n", vals[iv][ii]);
+      str += buf;
+    }
+  }
+  fwrite(str.data(), 1, str.size(), outFile);
+  fflush(outFile);
+}
+#endif
@@ -0,0 +1,84 @@
+// Part of BNC, a utility for retrieving decoding and
+// converting GNSS data streams from NTRIP broadcasters.
+//
+// Copyright (C) 2007
+// German Federal Agency for Cartography and Geodesy (BKG)
+// http://www.bkg.bund.de
+// Czech Technical University Prague, Department of Geodesy
+// http://www.fsv.cvut.cz
+//
+// Email: euref-ip@bkg.bund.de
+//
+// This program is free software; you can redistribute it and/or
+// modify it under the terms of the GNU General Public License
+// as published by the Free Software Foundation, version 2.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program; if not, write to the Free Software
+// Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA 02111-1307, USA.
+
+#ifndef BNCKALMAN_H
+#define BNCKALMAN_H
+
+#include <vector>
+#include <newmat.h>
+
+/**
+ * Square-root Kalman filter measurement update with reusable workspaces.
+ *
+ * Numerically equivalent to kalman() in bncutils for uncorrelated
+ * observations (diagonal weight matrix). The observations are processed
+ * one by one with Givens rotations applied to the upper triangular
+ * Cholesky factor of the covariance matrix. Zero elements of the design
+ * matrix rows are skipped. The workspaces only grow, so that in steady
+ * state no heap allocation takes place.
+ */
+class bncKalman {
+ public:
+  bncKalman();
+  ~bncKalman();
+
+  /**
+   * Filter update
+   * @param AA first design matrix (nObs x nPar)
+   * @param ll observed minus computed (nObs)
+   * @param PP observation weights (nObs)
+   * @param QQ a priori covariance matrix, replaced by the a posteriori one
+   * @param xx state vector, updated in place
+   */
+  void update(const Matrix& AA, const ColumnVector& ll,
+              const DiagonalMatrix& PP, SymmetricMatrix& QQ, ColumnVector& xx);
+
+  /**
+   * Former dense implementation (QR decomposition of the full pre-array),
+   * same arguments as update(). Not used by BNC itself; kept as the
+   * reference of the benchmark bnckalmanbench.cpp.
+   */
+  static void reference(const Matrix& AA, const ColumnVector& ll,
+                        const DiagonalMatrix& PP, SymmetricMatrix& QQ,
+                        ColumnVector& xx);
+
+ private:
+  void reserve(int nPar);
+  void cholesky(const SymmetricMatrix& QQ, int nPar);
+  void updateObs(const double* aRow, double ll, double pp, double* xx, int nPar);
+  void covariance(SymmetricMatrix& QQ, int nPar) const;
+#ifdef BNC_KALMAN_RECORD
+  static void record(const Matrix& AA, const ColumnVector& ll,
+                     const DiagonalMatrix& PP, const SymmetricMatrix& QQ,
+                     const ColumnVector& xx);
+#endif
+
+  std::vector<double> _SS;   // upper triangular factor, QQ = SS' * SS, row-wise
+  std::vector<double> _SA;   // SS * a'
+  std::vector<double> _gg;   // first row of the rotated pre-array
+  std::vector<int>    _nz;   // indices of non-zero design matrix elements
+  int                 _size;
+};
+
+#endif
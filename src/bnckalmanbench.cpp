@@ -0,0 +1,239 @@
+// Benchmark of bncKalman::update against the former dense implementation
+// bncKalman::reference, not part of the BNC build. Compiled stand-alone
+// (no Qt needed) from directory src:
+//
+//   g++ -O2 -I../newmat -o /tmp/bnckalmanbench bnckalmanbench.cpp
+//       bnckalman.cpp -L../newmat -lnewmat
+//
+//   /tmp/bnckalmanbench
+//       synthetic problems shaped like a PPP epoch (coordinates, clock,
+//       troposphere and one ambiguity per satellite; code and phase
+//       observations) and like a combination epoch (analysis center
+//       offsets, satellite specific offsets and satellite clocks)
+//   /tmp/bnckalmanbench recordFile
+//       problems recorded by BNC built with DEFINES += BNC_KALMAN_RECORD
+//       and run with the environment variable BNC_KALMAN_RECORD=recordFile
+//       (record PPP and combination in separate runs)
+//
+// Every problem is solved by both implementations; the maximum difference
+// of state vector and covariance matrix and the time per update are
+// printed.
+
+#include <ctime>
+#include <iostream>
+#include <iomanip>
+#include <vector>
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "bnckalman.h"
+
+using namespace std;
+
+namespace {
+
+  struct t_problem {
+    Matrix          AA;
+    ColumnVector    ll;
+    DiagonalMatrix  PP;
+    SymmetricMatrix QQ;
+    ColumnVector    xx;
+  };
+
+  double uniform() {
+    return double(rand()) / RAND_MAX - 0.5;
+  }
+
+  // A priori covariance with correlations, as after a previous epoch
+  // ----------------------------------------------------------------
+  void aPriori(t_problem& pb) {
+    int nPar = pb.AA.Ncols();
+    pb.QQ.ReSize(nPar); pb.QQ = 0.0;
+    pb.xx.ReSize(nPar); pb.xx = 0.0;
+    for (int ii = 1; ii <= nPar; ii++) {
+      pb.QQ(ii,ii) = 100.0;
+    }
+    bncKalman::reference(pb.AA, pb.ll, pb.PP, pb.QQ, pb.xx);
+    for (int ii = 1; ii <= nPar; ii++) {
+      pb.QQ(ii,ii) += 0.01;
+      pb.xx(ii)    += 0.1 * uniform();
+    }
+  }
+
+  // PPP epoch
+  // ---------
+  t_problem ppp(int nSat) {
+    t_problem pb;
+    int nPar = 5 + nSat;
+    int nObs = 2 * nSat;
+    pb.AA.ReSize(nObs, nPar); pb.AA = 0.0;
+    pb.ll.ReSize(nObs);
+    pb.PP.ReSize(nObs);
+    for (int iSat = 0; iSat < nSat; iSat++) {
+      double ele = 0.2 + 1.3 * (uniform() + 0.5);
+      double azi = 6.28 * (uniform() + 0.5);
+      double rho[] = {cos(ele) * cos(azi), cos(ele) * sin(azi), sin(ele)};
+      for (int iObs = 2 * iSat + 1; iObs <= 2 * iSat + 2; iObs++) {
+        for (int ic = 1; ic <= 3; ic++) {
+          pb.AA(iObs,ic) = rho[ic-1];
+        }
+        pb.AA(iObs,4) = 1.0;
+        pb.AA(iObs,5) = 1.0 / sin(ele);
+        pb.ll(iObs)   = uniform();
+      }
+      pb.AA(2 * iSat + 2, 6 + iSat) = 1.0;
+      pb.PP(2 * iSat + 1) = 1.0 / (1.0 * 1.0);
+      pb.PP(2 * iSat + 2) = 1.0 / (0.01 * 0.01);
+    }
+    aPriori(pb);
+    return pb;
+  }
+
+  // Combination epoch
+  // -----------------
+  t_problem comb(int nAC, int nSat) {
+    t_problem pb;
+    int nPar = nAC + nAC * nSat + nSat;
+    int nObs = nAC * nSat + nSat;
+    pb.AA.ReSize(nObs, nPar); pb.AA = 0.0;
+    pb.ll.ReSize(nObs);
+    pb.PP.ReSize(nObs);
+    int iObs = 0;
+    for (int iAC = 0; iAC < nAC; iAC++) {
+      for (int iSat = 0; iSat < nSat; iSat++) {
+        ++iObs;
+        pb.AA(iObs, 1 + iAC)                    = 1.0;
+        pb.AA(iObs, 1 + nAC + iAC * nSat + iSat) = 1.0;
+        pb.AA(iObs, 1 + nAC + nAC * nSat + iSat) = 1.0;
+        pb.ll(iObs) = uniform();
+        pb.PP(iObs) = 1.0 / (0.05 * 0.05);
+      }
+    }
+    for (int iSat = 0; iSat < nSat; iSat++) {  // zero mean of the offsets
+      ++iObs;
+      for (int iAC = 0; iAC < nAC; iAC++) {
+        pb.AA(iObs, 1 + nAC + iAC * nSat + iSat) = 1.0;
+      }
+      pb.ll(iObs) = 0.0;
+      pb.PP(iObs) = 1.0 / (1e-5 * 1e-5);
+    }
+    aPriori(pb);
+    return pb;
+  }
+
+  // Problems recorded by bncKalman::record
+  // --------------------------------------
+  bool readProblem(FILE* inpFile, t_problem& pb) {
+    int nObs, nPar;
+    if (fscanf(inpFile, "%d %d", &nObs, &nPar) != 2) {
+      return false;
+    }
+    pb.AA.ReSize(nObs, nPar);
+    pb.ll.ReSize(nObs);
+    pb.PP.ReSize(nObs);
+    pb.QQ.ReSize(nPar);
+    pb.xx.ReSize(nPar);
+    double* vals[]  = {pb.AA.Store(), pb.ll.Store(), pb.PP.Store(),
+                       pb.QQ.Store(), pb.xx.Store()};
+    int     nVals[] = {nObs * nPar, nObs, nObs, nPar * (nPar + 1) / 2, nPar};
+    for (int iv = 0; iv < 5; iv++) {
+      for (int ii = 0; ii < nVals[iv]; ii++) {
+        if (fscanf(inpFile, "%lf", &vals[iv][ii]) != 1) {
+          return false;
+        }
+      }
+    }
+    return true;
+  }
+
+  // Time per update [microsec] of both implementations
+  // --------------------------------------------------
+  void bench(const string& name, const vector<t_problem>& problems) {
+    if (problems.empty()) {
+      return;
+    }
+    int numRep = 1;
+    int maxPar = 0;
+    for (unsigned ip = 0; ip < problems.size(); ip++) {
+      maxPar = max(maxPar, problems[ip].AA.Ncols());
+    }
+    numRep = max(1, int(2e7 / (double(maxPar) * maxPar * maxPar) / problems.size()));
+
+    bncKalman    kalman;
+    double       maxDiffX = 0.0;
+    double       maxDiffQ = 0.0;
+    double       secRef   = 0.0;
+    double       secNew   = 0.0;
+    for (unsigned ip = 0; ip < problems.size(); ip++) {
+      const t_problem& pb = problems[ip];
+      SymmetricMatrix QRef, QNew;
+      ColumnVector    xRef, xNew;
+
+      clock_t start = clock();
+      for (int iRep = 0; iRep < numRep; iRep++) {
+        QRef = pb.QQ; xRef = pb.xx;
+        bncKalman::reference(pb.AA, pb.ll, pb.PP, QRef, xRef);
+      }
+      secRef += double(clock() - start) / CLOCKS_PER_SEC;
+
+      start = clock();
+      for (int iRep = 0; iRep < numRep; iRep++) {
+        QNew = pb.QQ; xNew = pb.xx;
+        kalman.update(pb.AA, pb.ll, pb.PP, QNew, xNew);
+      }
+      secNew += double(clock() - start) / CLOCKS_PER_SEC;
+
+      maxDiffX = max(maxDiffX, (xNew - xRef).MaximumAbsoluteValue());
+      maxDiffQ = max(maxDiffQ, (QNew - QRef).MaximumAbsoluteValue());
+    }
+
+    double numUpd = double(numRep) * problems.size();
+    cout << setw(24) << left << name << right
+         << setw(6) << problems.size() << " problems"
+         << fixed << setprecision(1)
+         << setw(10) << secRef / numUpd * 1.e6
+         << setw(10) << secNew / numUpd * 1.e6 << " microsec"
+         << scientific << setprecision(1)
+         << "  max diff x " << maxDiffX << " Q " << maxDiffQ << endl;
+  }
+}
+
+int main(int argc, char* argv[]) {
+
+  cout << setw(24) << left << "" << right << setw(15) << ""
+       << setw(10) << "reference" << setw(10) << "update" << endl;
+
+  if (argc > 1) {
+    FILE* inpFile = fopen(argv[1], "r");
+    if (!inpFile) {
+      cerr << "Cannot read " << argv[1] << endl;
+      return 1;
+    }
+    vector<t_problem> problems;
+    t_problem pb;
+    while (readProblem(inpFile, pb)) {
+      problems.push_back(pb);
+    }
+    fclose(inpFile);
+    bench(argv[1], problems);
+    return 0;
+  }
+
+  srand(1);
+  int nSat[] = {10, 20, 40};
+  for (int ii = 0; ii < 3; ii++) {
+    vector<t_problem> problems(1, ppp(nSat[ii]));
+    char name[32];
+    sprintf(name, "PPP %d sat", nSat[ii]);
+    bench(name, problems);
+  }
+  int nAC[] = {3, 5, 8};
+  for (int ii = 0; ii < 3; ii++) {
+    vector<t_problem> problems(1, comb(nAC[ii], 30));
+    char name[32];
+    sprintf(name, "comb %d AC 30 sat", nAC[ii]);
+    bench(name, problems);
+  }
+  return 0;
+}
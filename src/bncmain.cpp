@@ -49,6 +49,7 @@
 #include "bncwindow.h"
 #include "bncsettings.h"
 #include "bncversion.h"
+#include "bncrawreplay.h"
 #include "upload/bncephuploadcaster.h"
 #include "rinex/reqcedit.h"
 #include "rinex/reqcanalyze.h"
@@ -75,6 +76,9 @@ int main(int argc, char* argv[]) {
 #endif
   QByteArray rawFileName;
   QString    confFileName;
+  bool       rawReplay     = false;
+  double     replaySpeed   = 0.0;
+  int        replayThreads = 0;
 
   QByteArray printHelp =
       "Usage:\n"
@@ -84,6 +88,8 @@ int main(int argc, char* argv[]) {
       "       --display {name}\n"
       "       --conf {confFileName}\n"
       "       --file {rawFileName}\n"
+      "       --replay {speedFactor, 0 = as fast as possible}\n"
+      "       --threads {number of decoding threads for --replay}\n"
       "       --key  {keyName} {keyValue}\n"
       "\n"
       "Network Panel keys:\n"
@@ -91,6 +97,8 @@ int main(int argc, char* argv[]) {
       "   proxyPort       {Proxy port [integer number]}\n"
       "   sslCaCertPath   {Full path to SSL certificates [character string]}\n"
       "   sslIgnoreErrors {Ignore SSL authorization errors [integer number: 0=no,2=yes]}\n"
+      "   ioThreads       {Number of I/O threads for event-driven stream input, blank = one thread per stream [integer number]}\n"
+      "   maxConnects     {Maximum number of simultaneous connection attempts [integer number]}\n"
       "\n"
       "General Panel keys:\n"
       "   logFile          {Logfile, full path [character string]}\n"
@@ -98,6 +106,7 @@ int main(int argc, char* argv[]) {
       "   onTheFlyInterval {Configuration reload interval [character string: no|1 day|1 hour|5 min|1 min]}\n"
       "   autoStart        {Auto start [integer number: 0=no,2=yes]}\n"
       "   rawOutFile       {Raw output file, full path [character string]}\n"
+      "   rawOutSplit      {Raw output file per stream [integer number: 0=no,2=yes]}\n"
       "\n"
       "RINEX Observations Panel keys:\n"
       "   rnxPath        {Directory [character string]}\n"
@@ -191,6 +200,7 @@ int main(int argc, char* argv[]) {
       "   miscIntr     {Interval for logging latency [character string: Blank|2 sec|10 sec|1 min|5 min|15 min|1 hour|6 hours|1 day]}\n"
       "   miscScanRTCM {Scan for RTCM message numbers [integer number: 0=no,2=yes]}\n"
       "   miscPort     {Output port [integer number]}\n"
+      "   metricsPort  {Metrics port, Prometheus text format [integer number]}\n"
       "\n"
       "PPP Client Panel 1 keys:\n"
       "   PPP/dataSource  {Data source [character string: Blank|Real-Time Streams|RINEX Files]}\n"
@@ -208,6 +218,7 @@ int main(int argc, char* argv[]) {
       "   PPP/snxtroSampl {SINEX troposphere file sampling rate [character string: 1 sec|5 sec|10 sec|30 sec|60 sec|300 sec]}\n"
       "   PPP/snxtroAc    {SINEX troposphere Analysis Center [character string]}\n"
       "   PPP/snxtroSol   {SINEX troposphere solution ID [character string]}\n"
+      "   PPP/resultPath  {Directory for binary PPP result files [character string]}\n"
       "\n"
       "PPP Client Panel 2 keys:\n"
       "   PPP/staTable {Station specifications table [character string, semicolon separated list, each element in quotaion marks, example:\n"
@@ -232,6 +243,7 @@ int main(int argc, char* argv[]) {
       "PPP Client Panel 4 keys:\n"
       "   PPP/plotCoordinates  {Mountpoint for time series plot [character string]}\n"
       "   PPP/audioResponse    {Audio response threshold in meters [floating-point number]}\n"
+      "   PPP/plotFrameRate    {Maximum redraws of the PPP plot per second [integer number: 1-25]}\n"
       "   PPP/useOpenStreetMap {OSM track map [character string: true|false]}\n"
       "   PPP/useGoogleMap     {Google track map [character string: true|false]}\n"
       "   PPP/mapWinDotSize    {Size of dots on map [integer number: 0-10]}\n"
@@ -278,6 +290,7 @@ int main(int argc, char* argv[]) {
       "   uploadEphMountpoint {Mountpoint [character string]}\n"
       "   uploadEphPassword   {Stream upload password [character string]}\n"
       "   uploadEphSample     {Stream upload sampling rate [integer number of seconds: 5|10|15|20|25|30|35|40|45|50|55|60]}\n"
+      "   uploadEphPaced      {Spread upload over the sampling interval [integer number: 0=no,2=yes]}\n"
       "\n"
       "Add Stream keys:\n"
       "   mountPoints   {Mountpoints [character string, semicolon separated list, example:\n"
@@ -337,6 +350,13 @@ int main(int argc, char* argv[]) {
         interactive = false;
         rawFileName = QByteArray(argv[ii+1]);
       }
+      if (QRegExp("--?replay").exactMatch(argv[ii])) {
+        rawReplay   = true;
+        replaySpeed = QString(argv[ii+1]).toDouble();
+      }
+      if (QRegExp("--?threads").exactMatch(argv[ii])) {
+        replayThreads = QString(argv[ii+1]).toInt();
+      }
     }
   }
 
@@ -391,6 +411,7 @@ int main(int argc, char* argv[]) {
   bncEphUploadCaster* casterEph = 0;
   bncCaster*          caster = 0;
   bncRawFile*         rawFile =  0;
+  bncRawReplay*       rawReplayer = 0;
   bncGetThread*       getThread = 0;
 
   // Interactive Mode - open the main window
@@ -460,6 +481,7 @@ int main(int argc, char* argv[]) {
     BNC_CORE->setCaster(caster);
     BNC_CORE->setPortEph(settings.value("ephOutPort").toInt());
     BNC_CORE->setPortCorr(settings.value("corrPort").toInt());
+    BNC_CORE->setPortMetrics(settings.value("metricsPort").toInt());
     BNC_CORE->initCombination();
 
     BNC_CORE->connect(caster, SIGNAL(getThreadsFinished()), &app, SLOT(quit()));
@@ -485,15 +507,33 @@ int main(int argc, char* argv[]) {
       BNC_CORE->setMode(t_bncCore::batchPostProcessing);
       BNC_CORE->startPPP();
 
-      rawFile   = new bncRawFile(rawFileName, "", bncRawFile::input);
-      getThread = new bncGetThread(rawFile);
-      caster->addGetThread(getThread, true);
+      // Indexed, parallel replay
+      // ------------------------
+      if (rawReplay) {
+        rawReplayer = new bncRawReplay(rawFileName, replaySpeed, replayThreads);
+        if (rawReplayer->numStations() == 0) {
+          exit(0);
+        }
+        QListIterator<bncGetThread*> it(rawReplayer->getThreads());
+        while (it.hasNext()) {
+          caster->connectGetThread(it.next());
+        }
+        rawReplayer->start();
+      }
+      else {
+        rawFile   = new bncRawFile(rawFileName, "", bncRawFile::input);
+        getThread = new bncGetThread(rawFile);
+        caster->addGetThread(getThread, true);
+      }
     }
   }
 
   // Start the application
   // ---------------------
   app.exec();
+  if (rawReplayer) {
+    rawReplayer->wait();
+  }
   if (interactive) {
     delete bncWin;
   }
@@ -510,5 +550,8 @@ int main(int argc, char* argv[]) {
   if (rawFile) {
     delete rawFile;
   }
+  if (rawReplayer) {
+    delete rawReplayer;
+  }
   return 0;
 }
@@ -0,0 +1,304 @@
+// Part of BNC, a utility for retrieving decoding and
+// converting GNSS data streams from NTRIP broadcasters.
+//
+// Copyright (C) 2007
+// German Federal Agency for Cartography and Geodesy (BKG)
+// http://www.bkg.bund.de
+// Czech Technical University Prague, Department of Geodesy
+// http://www.fsv.cvut.cz
+//
+// Email: euref-ip@bkg.bund.de
+//
+// This program is free software; you can redistribute it and/or
+// modify it under the terms of the GNU General Public License
+// as published by the Free Software Foundation, version 2.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program; if not, write to the Free Software
+// Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA 02111-1307, USA.
+
+/* -------------------------------------------------------------------------
+ * BKG NTRIP Client
+ * -------------------------------------------------------------------------
+ *
+ * Class:      bncMetrics
+ *
+ * Purpose:    Registry of counters, gauges and histograms (Prometheus)
+ *
+ * Changes:
+ *
+ * -----------------------------------------------------------------------*/
+
+#include <math.h>
+
+#include "bncmetrics.h"
+
+using namespace std;
+
+namespace {
+
+  // Bucket bounds in seconds
+  // ------------------------
+  const double DURATION_BOUNDS[] = {0.0001, 0.00025, 0.0005, 0.001, 0.0025,
+                                    0.005,  0.01,    0.025,  0.05,  0.1,
+                                    0.25,   0.5,     1.0};
+  const double LATENCY_BOUNDS[]  = {0.1, 0.25, 0.5, 1.0, 2.0, 5.0,
+                                    10.0, 30.0, 60.0, 300.0};
+
+  QByteArray number(double value) {
+    return QByteArray::number(value, 'g', 12);
+  }
+
+  // Append an additional label to an existing (possibly empty) label set
+  // --------------------------------------------------------------------
+  QByteArray withLabel(const QByteArray& labels, const QByteArray& label) {
+    if (labels.isEmpty()) {
+      return "{" + label + "}";
+    }
+    return labels.left(labels.size() - 1) + "," + label + "}";
+  }
+}
+
+// Counter
+////////////////////////////////////////////////////////////////////////////
+void bncMetricCounter::expose(QByteArray& out, const QByteArray& name,
+                              const QByteArray& labels) const {
+  out += name + labels + " " + QByteArray::number(value()) + "\n";
+}
+
+// Gauge
+////////////////////////////////////////////////////////////////////////////
+void bncMetricGauge::expose(QByteArray& out, const QByteArray& name,
+                            const QByteArray& labels) const {
+  out += name + labels + " " + QByteArray::number(value()) + "\n";
+}
+
+// Histogram Constructor
+////////////////////////////////////////////////////////////////////////////
+bncMetricHistogram::bncMetricHistogram(const double* bounds, int nBounds) :
+  _bounds(bounds, bounds + nBounds), _counts(nBounds + 1, 0), _sumMicro(0) {
+}
+
+// Add a single observation
+////////////////////////////////////////////////////////////////////////////
+void bncMetricHistogram::observe(double value) {
+  unsigned iBucket = 0;
+  while (iBucket < _bounds.size() && value > _bounds[iBucket]) {
+    ++iBucket;
+  }
+  qint64 micro = qint64(floor(value * 1.e6 + 0.5));
+  QMutexLocker locker(&_valueMutex);
+  ++_counts[iBucket];
+  _sumMicro += micro;
+}
+
+// Histogram (buckets are cumulative in the exposition)
+////////////////////////////////////////////////////////////////////////////
+void bncMetricHistogram::expose(QByteArray& out, const QByteArray& name,
+                                const QByteArray& labels) const {
+  vector<qint64> counts;
+  qint64         sumMicro;
+  {
+    QMutexLocker locker(&_valueMutex);
+    counts   = _counts;
+    sumMicro = _sumMicro;
+  }
+  qint64 cumulative = 0;
+  for (unsigned ii = 0; ii < counts.size(); ii++) {
+    cumulative += counts[ii];
+    QByteArray le = (ii < _bounds.size()) ? number(_bounds[ii]) : QByteArray("+Inf");
+    out += name + "_bucket" + withLabel(labels, "le=\"" + le + "\"") + " "
+         + QByteArray::number(cumulative) + "\n";
+  }
+  out += name + "_sum"   + labels + " " + number(sumMicro * 1.e-6) + "\n";
+  out += name + "_count" + labels + " " + QByteArray::number(cumulative) + "\n";
+}
+
+// Single Instance (never deleted, metrics are released from destructors
+// that run during the static destruction, e.g. ~t_bncCore)
+////////////////////////////////////////////////////////////////////////////
+bncMetrics* bncMetrics::instance() {
+  static bncMetrics* _metrics = new bncMetrics;
+  return _metrics;
+}
+
+// Constructor
+////////////////////////////////////////////////////////////////////////////
+bncMetrics::bncMetrics() {
+}
+
+// Destructor
+////////////////////////////////////////////////////////////////////////////
+bncMetrics::~bncMetrics() {
+  qDeleteAll(_families);
+  qDeleteAll(_unlisted);
+}
+
+// Label set with a single label (value escaped)
+////////////////////////////////////////////////////////////////////////////
+QString bncMetrics::label(const QString& key, const QString& value) {
+  QString hlp = value;
+  hlp.replace('\\', "\\\\").replace('"', "\\\"").replace('\n', "\\n");
+  return key + "=\"" + hlp + "\"";
+}
+
+// Label set with two labels
+////////////////////////////////////////////////////////////////////////////
+QString bncMetrics::label(const QString& key1, const QString& value1,
+                          const QString& key2, const QString& value2) {
+  return label(key1, value1) + "," + label(key2, value2);
+}
+
+// Find or create a metric family (mutex must be locked)
+////////////////////////////////////////////////////////////////////////////
+bncMetrics::t_family* bncMetrics::family(const QString& name,
+                                         const QString& help,
+                                         const char* type) {
+  t_family* fam = _families.value(name, 0);
+  if (!fam) {
+    fam = new t_family;
+    fam->_type = type;
+    fam->_help = help.toAscii();
+    _families[name] = fam;
+  }
+  return fam;
+}
+
+// Find a metric within a family (mutex must be locked)
+////////////////////////////////////////////////////////////////////////////
+bncMetric* bncMetrics::find(t_family* fam, const QString& labels) const {
+  return fam->_metrics.value(labels, 0);
+}
+
+// Register (or retrieve) a counter
+////////////////////////////////////////////////////////////////////////////
+bncMetricCounter* bncMetrics::counter(const QString& name, const QString& help,
+                                      const QString& labels) {
+  QMutexLocker locker(&_mutex);
+  t_family* fam = family(name, help, "counter");
+  bncMetricCounter* metric = dynamic_cast<bncMetricCounter*>(find(fam, labels));
+  if (!metric) {
+    metric = new bncMetricCounter;
+    reference(metric, fam, labels, fam->_type == "counter" && !find(fam, labels));
+  }
+  else {
+    reference(metric, fam, labels, true);
+  }
+  return metric;
+}
+
+// Register (or retrieve) a gauge
+////////////////////////////////////////////////////////////////////////////
+bncMetricGauge* bncMetrics::gauge(const QString& name, const QString& help,
+                                  const QString& labels) {
+  QMutexLocker locker(&_mutex);
+  t_family* fam = family(name, help, "gauge");
+  bncMetricGauge* metric = dynamic_cast<bncMetricGauge*>(find(fam, labels));
+  if (!metric) {
+    metric = new bncMetricGauge;
+    reference(metric, fam, labels, fam->_type == "gauge" && !find(fam, labels));
+  }
+  else {
+    reference(metric, fam, labels, true);
+  }
+  return metric;
+}
+
+// Register (or retrieve) a histogram
+////////////////////////////////////////////////////////////////////////////
+bncMetricHistogram* bncMetrics::histogram(const QString& name,
+                                          const QString& help,
+                                          const QString& labels,
+                                          e_buckets buckets) {
+  QMutexLocker locker(&_mutex);
+  t_family* fam = family(name, help, "histogram");
+  bncMetricHistogram* metric = dynamic_cast<bncMetricHistogram*>(find(fam, labels));
+  if (!metric) {
+    if (buckets == latencies) {
+      metric = new bncMetricHistogram(LATENCY_BOUNDS,
+                     sizeof(LATENCY_BOUNDS) / sizeof(LATENCY_BOUNDS[0]));
+    }
+    else {
+      metric = new bncMetricHistogram(DURATION_BOUNDS,
+                     sizeof(DURATION_BOUNDS) / sizeof(DURATION_BOUNDS[0]));
+    }
+    reference(metric, fam, labels, fam->_type == "histogram" && !find(fam, labels));
+  }
+  else {
+    reference(metric, fam, labels, true);
+  }
+  return metric;
+}
+
+// Count a user of a metric, list a new one (mutex must be locked)
+////////////////////////////////////////////////////////////////////////////
+void bncMetrics::reference(bncMetric* metric, t_family* fam,
+                           const QString& labels, bool listed) {
+  if (metric->_refCount++ == 0) {
+    if (listed) {
+      fam->_metrics[labels] = metric;
+    }
+    else {
+      _unlisted.append(metric);
+    }
+  }
+}
+
+// Give up a metric, delete it with its last user
+////////////////////////////////////////////////////////////////////////////
+void bncMetrics::release(bncMetric* metric) {
+  if (!metric) {
+    return;
+  }
+  QMutexLocker locker(&_mutex);
+  if (--metric->_refCount > 0) {
+    return;
+  }
+  if (!_unlisted.removeOne(metric)) {
+    QMutableMapIterator<QString, t_family*> itFam(_families);
+    while (itFam.hasNext()) {
+      itFam.next();
+      t_family* fam = itFam.value();
+      QString labels = fam->_metrics.key(metric);
+      if (fam->_metrics.value(labels, 0) == metric) {
+        fam->_metrics.remove(labels);
+        if (fam->_metrics.isEmpty()) {
+          delete fam;
+          itFam.remove();
+        }
+        break;
+      }
+    }
+  }
+  delete metric;
+}
+
+// All metrics in Prometheus text exposition format (version 0.0.4)
+////////////////////////////////////////////////////////////////////////////
+QByteArray bncMetrics::exposition() const {
+  QMutexLocker locker(&_mutex);
+  QByteArray out;
+  QMapIterator<QString, t_family*> itFam(_families);
+  while (itFam.hasNext()) {
+    itFam.next();
+    QByteArray name = itFam.key().toAscii();
+    const t_family* fam = itFam.value();
+    out += "# HELP " + name + " " + fam->_help + "\n";
+    out += "# TYPE " + name + " " + fam->_type + "\n";
+    QMapIterator<QString, bncMetric*> itMet(fam->_metrics);
+    while (itMet.hasNext()) {
+      itMet.next();
+      QByteArray labels;
+      if (!itMet.key().isEmpty()) {
+        labels = "{" + itMet.key().toAscii() + "}";
+      }
+      itMet.value()->expose(out, name, labels);
+    }
+  }
+  return out;
+}
@@ -0,0 +1,143 @@
+// Part of BNC, a utility for retrieving decoding and
+// converting GNSS data streams from NTRIP broadcasters.
+//
+// Copyright (C) 2007
+// German Federal Agency for Cartography and Geodesy (BKG)
+// http://www.bkg.bund.de
+// Czech Technical University Prague, Department of Geodesy
+// http://www.fsv.cvut.cz
+//
+// Email: euref-ip@bkg.bund.de
+//
+// This program is free software; you can redistribute it and/or
+// modify it under the terms of the GNU General Public License
+// as published by the Free Software Foundation, version 2.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program; if not, write to the Free Software
+// Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA 02111-1307, USA.
+
+#ifndef BNCMETRICS_H
+#define BNCMETRICS_H
+
+#include <vector>
+#include <QByteArray>
+#include <QList>
+#include <QMap>
+#include <QMutex>
+#include <QString>
+
+// Metrics are registered under the registry mutex and afterwards updated
+// through the returned pointers, each under a short mutex of its own (Qt4
+// has no 64-bit atomic integer). Each registration is balanced by a call
+// of bncMetrics::release once the pointer is no longer used; a metric is
+// deleted (and no longer exposed) when its last user releases it.
+////////////////////////////////////////////////////////////////////////////
+class bncMetric {
+ public:
+  bncMetric() : _refCount(0) {}
+  virtual ~bncMetric() {}
+  virtual void expose(QByteArray& out, const QByteArray& name,
+                      const QByteArray& labels) const = 0;
+ protected:
+  mutable QMutex _valueMutex;
+ private:
+  friend class bncMetrics;
+  int            _refCount;     // guarded by the registry mutex
+};
+
+// Monotonically increasing counter
+////////////////////////////////////////////////////////////////////////////
+class bncMetricCounter : public bncMetric {
+ public:
+  bncMetricCounter() : _value(0) {}
+  void   add(qint64 inc = 1) {QMutexLocker locker(&_valueMutex); _value += inc;}
+  qint64 value() const {QMutexLocker locker(&_valueMutex); return _value;}
+  virtual void expose(QByteArray& out, const QByteArray& name,
+                      const QByteArray& labels) const;
+ private:
+  qint64 _value;
+};
+
+// Value that may go up and down (e.g. queue depth)
+////////////////////////////////////////////////////////////////////////////
+class bncMetricGauge : public bncMetric {
+ public:
+  bncMetricGauge() : _value(0) {}
+  void   set(qint64 value) {QMutexLocker locker(&_valueMutex); _value = value;}
+  void   add(qint64 inc) {QMutexLocker locker(&_valueMutex); _value += inc;}
+  qint64 value() const {QMutexLocker locker(&_valueMutex); return _value;}
+  virtual void expose(QByteArray& out, const QByteArray& name,
+                      const QByteArray& labels) const;
+ private:
+  qint64 _value;
+};
+
+// Histogram with fixed bucket bounds, the sum is kept in micro-units
+////////////////////////////////////////////////////////////////////////////
+class bncMetricHistogram : public bncMetric {
+ public:
+  bncMetricHistogram(const double* bounds, int nBounds);
+  void observe(double value);
+  virtual void expose(QByteArray& out, const QByteArray& name,
+                      const QByteArray& labels) const;
+ private:
+  std::vector<double> _bounds;
+  std::vector<qint64> _counts;    // per bucket, last one is +Inf
+  qint64              _sumMicro;
+};
+
+// Registry, exposition in Prometheus text format
+////////////////////////////////////////////////////////////////////////////
+class bncMetrics {
+ public:
+  enum e_buckets {durations, latencies};
+
+  static bncMetrics* instance();
+
+  bncMetricCounter*   counter(const QString& name, const QString& help,
+                              const QString& labels = QString());
+  bncMetricGauge*     gauge(const QString& name, const QString& help,
+                            const QString& labels = QString());
+  bncMetricHistogram* histogram(const QString& name, const QString& help,
+                                const QString& labels = QString(),
+                                e_buckets buckets = durations);
+
+  /** Give up a registered metric (the pointer must not be used afterwards) */
+  void release(bncMetric* metric);
+
+  QByteArray exposition() const;
+
+  static QString label(const QString& key, const QString& value);
+  static QString label(const QString& key1, const QString& value1,
+                       const QString& key2, const QString& value2);
+
+ private:
+  class t_family {
+   public:
+    ~t_family() {qDeleteAll(_metrics);}
+    QByteArray                 _type;
+    QByteArray                 _help;
+    QMap<QString, bncMetric*>  _metrics;   // labels -> metric
+  };
+
+  bncMetrics();
+  ~bncMetrics();
+  t_family*  family(const QString& name, const QString& help, const char* type);
+  bncMetric* find(t_family* fam, const QString& labels) const;
+  void       reference(bncMetric* metric, t_family* fam, const QString& labels,
+                       bool listed);
+
+  mutable QMutex             _mutex;
+  QMap<QString, t_family*>   _families;
+  QList<bncMetric*>          _unlisted;   // registered with conflicting type
+};
+
+#define BNC_METRICS (bncMetrics::instance())
+
+#endif
@@ -25,7 +25,7 @@ using namespace std;
 
 // Constructor
 ////////////////////////////////////////////////////////////////////////////
-bncNetQueryRtp::bncNetQueryRtp() {
+bncNetQueryRtp::bncNetQueryRtp() : _receiver(true) {
   _socket    = 0;
   _udpSocket = 0;
   _CSeq      = 0;
@@ -82,14 +82,14 @@ void bncNetQueryRtp::waitForReadyRead(QByteArray& outData) {
     _eventLoop->exec();
   }
 
-  // Append Data
-  // -----------
-  QByteArray datagram;
-  datagram.resize(_udpSocket->pendingDatagramSize());
-  _udpSocket->readDatagram(datagram.data(), datagram.size());
+  // Append Data (datagrams without payload are skipped)
+  // ----------------------------------------------------
+  _receiver.read(_udpSocket, outData);
 
-  if (datagram.size() > 12) {
-    outData.append(datagram.mid(12));
+  int numLost = _receiver.takeNumLost();
+  if (numLost > 0) {
+    emit newMessage(_url.encodedPath().replace(0,1,"")
+                    + QString(": %1 datagrams lost").arg(numLost).toAscii(), false);
   }
 }
 
@@ -139,6 +139,7 @@ void bncNetQueryRtp::startRequest(const QUrl& url, const QByteArray& gga) {
     delete _udpSocket;
     _udpSocket = new QUdpSocket();
     _udpSocket->bind(0);
+    _receiver.reset();
     connect(_udpSocket, SIGNAL(readyRead()), _eventLoop, SLOT(quit()));
     QByteArray clientPort = QString("%1").arg(_udpSocket->localPort()).toAscii();
 
@@ -2,6 +2,7 @@
 #define BNCNETQUERYRTP_H
 
 #include "bncnetquery.h"
+#include "bncudpreceiver.h"
 
 class bncNetQueryRtp : public bncNetQuery {
  Q_OBJECT
@@ -19,11 +20,12 @@ class bncNetQueryRtp : public bncNetQuery {
   void slotKeepAlive();
 
  private:
-  QTcpSocket* _socket;
-  QUdpSocket* _udpSocket;
-  QEventLoop* _eventLoop;
-  QByteArray  _session;
-  int         _CSeq;
+  bncUdpReceiver _receiver;
+  QTcpSocket*    _socket;
+  QUdpSocket*    _udpSocket;
+  QEventLoop*    _eventLoop;
+  QByteArray     _session;
+  int            _CSeq;
 };
 
 #endif
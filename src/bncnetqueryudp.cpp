@@ -28,7 +28,7 @@ using namespace std;
 
 // Constructor
 ////////////////////////////////////////////////////////////////////////////
-bncNetQueryUdp::bncNetQueryUdp() {
+bncNetQueryUdp::bncNetQueryUdp() : _receiver(true) {
   _port      = 0;
   _udpSocket = 0;
   _eventLoop = new QEventLoop(this);
@@ -71,6 +71,12 @@ void bncNetQueryUdp::waitForRequestResult(const QUrl&, QByteArray&) {
 // 
 ////////////////////////////////////////////////////////////////////////////
 void bncNetQueryUdp::waitForReadyRead(QByteArray& outData) {
+  waitForDatagrams(outData, bncUdpReceiver::MAXBATCH);
+}
+
+// Wait for datagrams, append the payload of maxNum at most
+////////////////////////////////////////////////////////////////////////////
+void bncNetQueryUdp::waitForDatagrams(QByteArray& outData, int maxNum) {
 
   // Wait Loop
   // ---------
@@ -80,16 +86,15 @@ void bncNetQueryUdp::waitForReadyRead(QByteArray& outData) {
 
   // Append Data
   // -----------
-  QByteArray datagram;
-  datagram.resize(_udpSocket->pendingDatagramSize());
-  _udpSocket->readDatagram(datagram.data(), datagram.size());
-
-  if (datagram.size() > 12) {
-    outData.append(datagram.mid(12));
-  }
-  else {
+  if (_receiver.read(_udpSocket, outData, maxNum) != success) {
     _status = error;
   }
+
+  int numLost = _receiver.takeNumLost();
+  if (numLost > 0) {
+    emit newMessage(_url.encodedPath().replace(0,1,"")
+                    + QString(": %1 datagrams lost").arg(numLost).toAscii(), false);
+  }
 }
 
 // Connect to Caster, send the Request
@@ -113,6 +118,7 @@ void bncNetQueryUdp::startRequest(const QUrl& url, const QByteArray& gga) {
   delete _udpSocket;
   _udpSocket = new QUdpSocket();
   _udpSocket->bind(0);
+  _receiver.reset();
   connect(_udpSocket, SIGNAL(readyRead()), _eventLoop, SLOT(quit()));
 
   QHostInfo hInfo = QHostInfo::fromName(url.host());
@@ -156,7 +162,7 @@ void bncNetQueryUdp::startRequest(const QUrl& url, const QByteArray& gga) {
     // Wait for Reply, read Session Number
     // -----------------------------------
     QByteArray repl;
-    waitForReadyRead(repl);
+    waitForDatagrams(repl, 1);
 
     QTextStream in(repl);
     QString line = in.readLine();
@@ -2,6 +2,7 @@
 #define BNCNETQUERYUDP_H
 
 #include "bncnetquery.h"
+#include "bncudpreceiver.h"
 
 class bncNetQueryUdp : public bncNetQuery {
  Q_OBJECT
@@ -19,12 +20,15 @@ class bncNetQueryUdp : public bncNetQuery {
   void slotKeepAlive();
 
  private:
-  QUdpSocket*  _udpSocket;
-  QEventLoop*  _eventLoop;
-  QHostAddress _address;
-  int          _port;
-  char         _keepAlive[12];
-  unsigned     _session;
+  void waitForDatagrams(QByteArray& outData, int maxNum);
+
+  bncUdpReceiver _receiver;
+  QUdpSocket*    _udpSocket;
+  QEventLoop*    _eventLoop;
+  QHostAddress   _address;
+  int            _port;
+  char           _keepAlive[12];
+  unsigned       _session;
 };
 
 #endif
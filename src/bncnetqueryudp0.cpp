@@ -18,7 +18,7 @@
 
 // Constructor
 ////////////////////////////////////////////////////////////////////////////
-bncNetQueryUdp0::bncNetQueryUdp0() {
+bncNetQueryUdp0::bncNetQueryUdp0() : _receiver(false) {
   _udpSocket = 0;
   _eventLoop = new QEventLoop(this);
 }
@@ -54,11 +54,13 @@ void bncNetQueryUdp0::waitForReadyRead(QByteArray& outData) {
 
   // Append Data
   // -----------
-  QByteArray datagram;
-  datagram.resize(_udpSocket->pendingDatagramSize());
-  _udpSocket->readDatagram(datagram.data(), datagram.size());
+  _receiver.read(_udpSocket, outData);
 
-  outData.append(datagram);
+  int numLost = _receiver.takeNumLost();
+  if (numLost > 0) {
+    emit newMessage(_url.encodedPath().replace(0,1,"")
+                    + QString(": %1 datagrams lost").arg(numLost).toAscii(), false);
+  }
 }
 
 // Connect to Caster, send the Request
@@ -66,10 +68,12 @@ void bncNetQueryUdp0::waitForReadyRead(QByteArray& outData) {
 void bncNetQueryUdp0::startRequest(const QUrl& url, const QByteArray& /* gga */) {
 
   _status = running;
+  _url    = url;
 
   delete _udpSocket;
   _udpSocket = new QUdpSocket();
   _udpSocket->bind(url.port());
+  _receiver.reset();
 
   connect(_udpSocket, SIGNAL(readyRead()), _eventLoop, SLOT(quit()));
 }
@@ -2,6 +2,7 @@
 #define BNCNETQUERYUDP0_H
 
 #include "bncnetquery.h"
+#include "bncudpreceiver.h"
 
 class bncNetQueryUdp0 : public bncNetQuery {
  Q_OBJECT
@@ -15,8 +16,9 @@ class bncNetQueryUdp0 : public bncNetQuery {
   virtual void keepAliveRequest(const QUrl& url, const QByteArray& gga);
   virtual void waitForReadyRead(QByteArray& outData);
  private:
-  QUdpSocket*  _udpSocket;
-  QEventLoop*  _eventLoop;
+  bncUdpReceiver _receiver;
+  QUdpSocket*    _udpSocket;
+  QEventLoop*    _eventLoop;
 };
 
 #endif
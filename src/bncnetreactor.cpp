@@ -0,0 +1,1093 @@
+// Part of BNC, a utility for retrieving decoding and
+// converting GNSS data streams from NTRIP broadcasters.
+//
+// Copyright (C) 2007
+// German Federal Agency for Cartography and Geodesy (BKG)
+// http://www.bkg.bund.de
+// Czech Technical University Prague, Department of Geodesy
+// http://www.fsv.cvut.cz
+//
+// Email: euref-ip@bkg.bund.de
+//
+// This program is free software; you can redistribute it and/or
+// modify it under the terms of the GNU General Public License
+// as published by the Free Software Foundation, version 2.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program; if not, write to the Free Software
+// Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA 02111-1307, USA.
+
+/* -------------------------------------------------------------------------
+ * BKG NTRIP Client
+ * -------------------------------------------------------------------------
+ *
+ * Class:      bncNetReactor, bncNetStream
+ *
+ * Purpose:    Event-driven input of many streams (few I/O threads, pool
+ *             of decoding threads)
+ *
+ * Changes:
+ *
+ * -----------------------------------------------------------------------*/
+
+#include "bncnetreactor.h"
+#include "bncgetthread.h"
+#include "bnccore.h"
+#include "bncsettings.h"
+#include "bncversion.h"
+#include "bncconnscheduler.h"
+#include "bncsslconfig.h"
+
+using namespace std;
+
+// Constructor
+////////////////////////////////////////////////////////////////////////////
+bncNetStream::bncNetStream(bncNetReactor* reactor, bncGetThread* getThread,
+                           int iDecoder) :
+  _receiver(getThread->ntripVersion() != "UN") {
+
+  connect(this, SIGNAL(newMessage(QByteArray,bool)),
+          BNC_CORE, SLOT(slotMessage(const QByteArray,bool)));
+
+  _reactor       = reactor;
+  _getThread     = getThread;
+  _iDecoder      = iDecoder;
+  _socket        = 0;
+  _udpSocket     = 0;
+  _lookupId      = -1;
+  _state         = idle;
+  _proxy         = false;
+  _proxyResponse = false;
+  _chunked       = false;
+  _chunkLeft     = 0;
+  _chunkEnd      = false;
+  _CSeq          = 0;
+  _connAttempt   = 0;
+  _connSlot      = false;
+
+  QByteArray ntripVersion = getThread->ntripVersion();
+  _secure = (ntripVersion == "2s");
+  if      (ntripVersion == "2" || ntripVersion == "2s") {
+    _proto = ntrip2;
+  }
+  else if (ntripVersion == "U") {
+    _proto = udp;
+  }
+  else if (ntripVersion == "R") {
+    _proto = rtsp;
+  }
+  else if (ntripVersion == "N") {
+    _proto = tcp;
+  }
+  else if (ntripVersion == "UN") {
+    _proto = udp0;
+  }
+  else {
+    _proto = ntrip1;
+  }
+  _timeOut = (_proto == tcp) ? 120000 : 20000;
+
+  bncSettings settings;
+  _sslIgnoreErrors =
+     (Qt::CheckState(settings.value("sslIgnoreErrors").toInt()) == Qt::Checked);
+
+  // Default scheme and path
+  // -----------------------
+  _url = getThread->mountPoint();
+  if (_url.scheme().isEmpty()) {
+    _url.setScheme(_secure ? "https" : "http");
+  }
+  if (_url.path().isEmpty()) {
+    _url.setPath("/");
+  }
+  if (_proto == ntrip2 && _url.port() == -1) {
+    _url.setPort(_secure ? 443 : 80);
+  }
+  if (_proto == rtsp) {
+    _url.setScheme("rtsp");
+  }
+
+  // Single timer for connect/read timeouts and reconnect delays
+  // -----------------------------------------------------------
+  _timer = new QTimer(this);
+  _timer->setSingleShot(true);
+  connect(_timer, SIGNAL(timeout()), this, SLOT(slotTimeout()));
+
+  // Session keep-alive (NTRIP over UDP, RTSP)
+  // -----------------------------------------
+  _keepAliveTimer = new QTimer(this);
+  _keepAliveTimer->setInterval(_proto == rtsp ? 30000 : 15000);
+  connect(_keepAliveTimer, SIGNAL(timeout()), this, SLOT(slotKeepAlive()));
+}
+
+// Destructor
+////////////////////////////////////////////////////////////////////////////
+bncNetStream::~bncNetStream() {
+}
+
+// Connect to Caster (I/O thread)
+////////////////////////////////////////////////////////////////////////////
+void bncNetStream::slotStart() {
+
+  if (_state != idle) {
+    return;
+  }
+
+  // Plain UDP: listen on the local port, nothing to connect
+  // -------------------------------------------------------
+  if (_proto == udp0) {
+    _udpSocket = new QUdpSocket(this);
+    connect(_udpSocket, SIGNAL(readyRead()), this, SLOT(slotDatagrams()));
+    if (!_udpSocket->bind(_url.port())) {
+      failure("Cannot bind UDP port " + QByteArray::number(_url.port()));
+      return;
+    }
+    _receiver.reset();
+    startStreaming();
+    return;
+  }
+
+  if (_secure && !QSslSocket::supportsSsl()) {
+    emit newMessage(_getThread->staID() +
+                    ": No SSL support, install OpenSSL run-time libraries", true);
+    return;
+  }
+
+  // At most maxConnects connection attempts at a time
+  // -------------------------------------------------
+  if (!BNC_CONNECTS->tryAcquire()) {
+    _timer->start(100 + BNC_CONNECTS->delay(0) / 10);
+    return;
+  }
+  _connSlot = true;
+
+  _state = connecting;
+  _timer->start(_timeOut);
+
+  // NTRIP over UDP: resolve the caster address first
+  // ------------------------------------------------
+  if (_proto == udp) {
+    _lookupId = QHostInfo::lookupHost(_url.host(), this,
+                                      SLOT(slotHostFound(const QHostInfo&)));
+    return;
+  }
+
+  if (_secure) {
+    QSslSocket* sslSocket = new QSslSocket(this);
+    sslSocket->setSslConfiguration(bncSslConfig());
+    connect(sslSocket, SIGNAL(encrypted()), this, SLOT(slotEncrypted()));
+    connect(sslSocket, SIGNAL(sslErrors(const QList<QSslError>&)),
+            this,      SLOT(slotSslErrors(const QList<QSslError>&)));
+    _socket = sslSocket;
+  }
+  else {
+    _socket = new QTcpSocket(this);
+  }
+  connect(_socket, SIGNAL(connected()),    this, SLOT(slotConnected()));
+  connect(_socket, SIGNAL(readyRead()),    this, SLOT(slotReadyRead()));
+  connect(_socket, SIGNAL(disconnected()), this, SLOT(slotDisconnected()));
+  connect(_socket, SIGNAL(error(QAbstractSocket::SocketError)),
+          this,    SLOT(slotDisconnected()));
+
+  bncSettings settings;
+  QString proxyHost = settings.value("proxyHost").toString();
+  int     proxyPort = settings.value("proxyPort").toInt();
+
+  _proxy = (_proto != tcp && !proxyHost.isEmpty());
+
+  if      (_proxy) {
+    _socket->connectToHost(proxyHost, proxyPort);
+  }
+  else if (_secure) {
+    static_cast<QSslSocket*>(_socket)->connectToHostEncrypted(_url.host(),
+                                                               _url.port());
+  }
+  else {
+    _socket->connectToHost(_url.host(), _url.port());
+  }
+}
+
+// Close the connection for good (I/O thread)
+////////////////////////////////////////////////////////////////////////////
+void bncNetStream::slotStop() {
+  _timer->stop();
+  if (_proto == rtsp && _state == streaming && _socket) {
+    QByteArray reqStr = "TEARDOWN " + _url.toEncoded() + " RTSP/1.0\r\n"
+                      + "CSeq: " + QByteArray::number(++_CSeq) + "\r\n"
+                      + "Session: " + _session + "\r\n"
+                      + "\r\n";
+    _socket->write(reqStr);
+    _socket->flush();
+  }
+  closeConnection();
+  _state = idle;
+  releaseSlot();
+}
+
+// Connected (to the caster or to the proxy)
+////////////////////////////////////////////////////////////////////////////
+void bncNetStream::slotConnected() {
+
+  _timer->start(_timeOut);
+
+  if (_proto == tcp) {
+    _state = header;
+    _response.clear();
+    return;
+  }
+
+  // TLS through the proxy: open a tunnel first, the request is sent when
+  // the connection is encrypted
+  // --------------------------------------------------------------------
+  if (_secure) {
+    if (_proxy) {
+      QByteArray hostPort = _url.host().toAscii() + ":"
+                          + QByteArray::number(_url.port());
+      _state = tunnel;
+      _response.clear();
+      _socket->write("CONNECT " + hostPort + " HTTP/1.1\r\n"
+                     + "Host: " + hostPort + "\r\n\r\n");
+    }
+    return;
+  }
+
+  sendRequest();
+}
+
+// TLS handshake finished
+////////////////////////////////////////////////////////////////////////////
+void bncNetStream::slotEncrypted() {
+  sendRequest();
+}
+
+// TLS/SSL
+////////////////////////////////////////////////////////////////////////////
+void bncNetStream::slotSslErrors(const QList<QSslError>& errors) {
+
+  QSslSocket* sslSocket = qobject_cast<QSslSocket*>(_socket);
+  if (!sslSocket) {
+    return;
+  }
+
+  QString msg = "SSL Error\n";
+  QSslCertificate cert = sslSocket->peerCertificate();
+  if (!cert.isNull()) {
+    msg += QString("Server Certificate Issued by:\n"
+                   "%1\n%2\nCannot be verified\n")
+           .arg(cert.issuerInfo(QSslCertificate::OrganizationalUnitName))
+           .arg(cert.issuerInfo(QSslCertificate::Organization));
+  }
+  QListIterator<QSslError> it(errors);
+  while (it.hasNext()) {
+    const QSslError& err = it.next();
+    msg += "\n" + err.errorString();
+  }
+
+  emit newMessage(_getThread->staID() + ": " + msg.toAscii(), true);
+
+  if (_sslIgnoreErrors) {
+    sslSocket->ignoreSslErrors();
+  }
+  else {
+    failure("SSL handshake failed");
+  }
+}
+
+// Caster address resolved (NTRIP over UDP)
+////////////////////////////////////////////////////////////////////////////
+void bncNetStream::slotHostFound(const QHostInfo& hostInfo) {
+
+  _lookupId = -1;
+  if (_state != connecting) {
+    return;
+  }
+  if (hostInfo.addresses().isEmpty()) {
+    failure("Host not found");
+    return;
+  }
+  _address = hostInfo.addresses().first();
+
+  _udpSocket = new QUdpSocket(this);
+  connect(_udpSocket, SIGNAL(readyRead()), this, SLOT(slotDatagrams()));
+  _udpSocket->bind(0);
+  _receiver.reset();
+
+  sendRequest();
+}
+
+// Send the Request
+////////////////////////////////////////////////////////////////////////////
+void bncNetStream::sendRequest() {
+
+  _state = header;
+  _proxyResponse = false;
+  _response.clear();
+  _chunked   = false;
+  _chunkLeft = 0;
+  _chunkEnd  = false;
+  _timer->start(_timeOut);
+
+  QByteArray reqStr;
+
+  // NTRIP Version 1
+  // ---------------
+  if      (_proto == ntrip1) {
+    if (!_proxy) {
+      if (_url.path().indexOf("/") != 0) _url.setPath("/");
+      reqStr = "GET " + _url.path().toAscii() + " HTTP/1.0\r\n"
+               + "User-Agent: NTRIP BNC/" BNCVERSION " (" BNC_OS ")\r\n"
+               + "Host: " + _url.host().toAscii() + "\r\n"
+               + authorization() + "\r\n";
+    } else {
+      reqStr = "GET " + _url.toEncoded() + " HTTP/1.0\r\n"
+               + "User-Agent: NTRIP BNC/" BNCVERSION " (" BNC_OS ")\r\n"
+               + "Host: " + _url.host().toAscii() + "\r\n"
+               + authorization() + "\r\n";
+    }
+    _socket->write(reqStr);
+  }
+
+  // NTRIP Version 2 (absolute URL when talking HTTP to the proxy)
+  // -------------------------------------------------------------
+  else if (_proto == ntrip2) {
+    QByteArray path = (_proxy && !_secure)
+                    ? _url.toEncoded(QUrl::RemoveUserInfo)
+                    : _url.path().toAscii();
+    reqStr = "GET " + path + " HTTP/1.1\r\n"
+           + "Host: " + _url.host().toAscii() + "\r\n"
+           + "Ntrip-Version: Ntrip/2.0\r\n"
+           + "User-Agent: NTRIP BNC/" BNCVERSION " (" BNC_OS ")\r\n"
+           + authorization()
+           + "Connection: close\r\n\r\n";
+    _socket->write(reqStr);
+  }
+
+  // NTRIP Version 2 over UDP, request in an RTP packet
+  // --------------------------------------------------
+  else if (_proto == udp) {
+    _keepAlive[0] = char(128);
+    _keepAlive[1] = 96;
+    for (int ii = 2; ii <= 11; ii++) {
+      _keepAlive[ii] = 0;
+    }
+    reqStr = "GET " + _url.path().toAscii() + " HTTP/1.1\r\n"
+           + "Host: " + _url.host().toAscii() + "\r\n"
+           + "Ntrip-Version: Ntrip/2.0\r\n"
+           + "User-Agent: NTRIP BNC/" BNCVERSION " (" BNC_OS ")\r\n"
+           + authorization()
+           + "Connection: close\r\n\r\n";
+    QByteArray packet(_keepAlive, 12);
+    packet[1] = 97;
+    _udpSocket->writeDatagram(packet + reqStr, _address, _url.port());
+  }
+
+  // RTSP: SETUP with the local port of the data socket
+  // --------------------------------------------------
+  else if (_proto == rtsp) {
+    _udpSocket = new QUdpSocket(this);
+    connect(_udpSocket, SIGNAL(readyRead()), this, SLOT(slotDatagrams()));
+    _udpSocket->bind(0);
+    _receiver.reset();
+    _session.clear();
+    reqStr = "SETUP " + _url.toEncoded() + " RTSP/1.0\r\n"
+           + "CSeq: " + QByteArray::number(++_CSeq) + "\r\n"
+           + "Ntrip-Version: Ntrip/2.0\r\n"
+           + "Ntrip-Component: Ntripclient\r\n"
+           + "User-Agent: NTRIP BNC/" BNCVERSION " (" BNC_OS ")\r\n"
+           + "Transport: RTP/GNSS;unicast;client_port="
+           + QByteArray::number(_udpSocket->localPort()) + "\r\n"
+           + authorization()
+           + "\r\n";
+    _socket->write(reqStr);
+  }
+}
+
+// Authorization header line (if user and password are given)
+////////////////////////////////////////////////////////////////////////////
+QByteArray bncNetStream::authorization() const {
+  QString uName = QUrl::fromPercentEncoding(_url.userName().toAscii());
+  QString passW = QUrl::fromPercentEncoding(_url.password().toAscii());
+  if (uName.isEmpty() && passW.isEmpty()) {
+    return QByteArray();
+  }
+  return "Authorization: Basic " + (uName.toAscii() + ":" +
+         passW.toAscii()).toBase64() + "\r\n";
+}
+
+// New data available (TCP socket)
+////////////////////////////////////////////////////////////////////////////
+void bncNetStream::slotReadyRead() {
+
+  if (!_socket) {
+    return;
+  }
+
+  // RTSP: the data come by UDP, replies to keep-alives are skipped
+  // --------------------------------------------------------------
+  if (_proto == rtsp) {
+    if (_state == streaming) {
+      _socket->readAll();
+    }
+    else {
+      _timer->start(_timeOut);
+      readRtspResponse();
+    }
+    return;
+  }
+
+  _timer->start(_timeOut);
+
+  if (_state == tunnel) {
+    readTunnel();
+    return;
+  }
+
+  if (_state == header) {
+    if (_proto == ntrip2) {
+      readHeaderV2();
+    }
+    else {
+      readHeader();
+    }
+  }
+
+  if (_state == streaming && _socket && _socket->bytesAvailable() > 0) {
+    QByteArray data;
+    QByteArray errStr;
+    if (_chunked) {
+      errStr = readChunks(data);
+    }
+    else {
+      data = _socket->readAll();
+    }
+    if (!data.isEmpty()) {
+      _connAttempt = 0;
+      _reactor->enqueue(_iDecoder, _getThread, bncNetReactor::data, data);
+    }
+    if (!errStr.isEmpty()) {
+      failure(errStr);
+    }
+  }
+}
+
+// New datagrams available (UDP socket)
+////////////////////////////////////////////////////////////////////////////
+void bncNetStream::slotDatagrams() {
+
+  if (_proto == udp && _state == header) {
+    readUdpResponse();
+  }
+  if (_state != streaming) {
+    return;
+  }
+
+  while (_udpSocket && _udpSocket->hasPendingDatagrams()) {
+    QByteArray data;
+    t_irc irc = _receiver.read(_udpSocket, data);
+
+    int numLost = _receiver.takeNumLost();
+    if (numLost > 0) {
+      emit newMessage(_getThread->staID() +
+                      QString(": %1 datagrams lost").arg(numLost).toAscii(), false);
+    }
+
+    if (!data.isEmpty()) {
+      _connAttempt = 0;
+      _reactor->enqueue(_iDecoder, _getThread, bncNetReactor::data, data);
+    }
+    if (_proto != udp0) {
+      _timer->start(_timeOut);
+    }
+
+    if (irc != success && _proto == udp) {
+      failure("Datagram without RTP payload");
+      return;
+    }
+  }
+}
+
+// Read Caster Response (as far as available)
+////////////////////////////////////////////////////////////////////////////
+void bncNetStream::readHeader() {
+
+  if (_proto == tcp) {
+    if (_socket->canReadLine()) {
+      _socket->readLine();
+      startStreaming();
+    }
+    return;
+  }
+
+  bool done = false;
+  while (!done && _socket->canReadLine()) {
+    QString line = _socket->readLine();
+
+    if (line.indexOf("ICY 200 OK") == -1 &&
+        line.indexOf("HTTP")       != -1 &&
+        line.indexOf("200 OK")     != -1 ) {
+      _proxyResponse = true;
+    }
+
+    if (!_proxyResponse && !line.trimmed().isEmpty()) {
+      _response.push_back(line);
+    }
+
+    if (line.trimmed().isEmpty()) {
+      if (_proxyResponse) {
+        _proxyResponse = false;
+      }
+      else {
+        done = true;
+      }
+    }
+
+    if (!done && line.indexOf("Unauthorized") != -1) {
+      done = true;
+    }
+
+    if (!done                             &&
+        !_proxyResponse                   &&
+        line.indexOf("200 OK")      != -1 &&
+        line.indexOf("SOURCETABLE") == -1) {
+      _response.clear();
+      if (_socket->canReadLine()) {
+        _socket->readLine();
+      }
+      done = true;
+    }
+  }
+
+  if (!done) {
+    return;
+  }
+
+  if (_response.size() > 0) {
+    failure("Wrong caster response\n" + _response.join("").toAscii());
+    return;
+  }
+
+  startStreaming();
+}
+
+// Read NTRIP Version 2 Response Header (as far as available)
+////////////////////////////////////////////////////////////////////////////
+void bncNetStream::readHeaderV2() {
+
+  while (_socket->canReadLine()) {
+    QByteArray line = _socket->readLine().trimmed();
+
+    // Status line, 200 expected
+    // -------------------------
+    if (_response.isEmpty()) {
+      _response.push_back(line);
+      if (!line.startsWith("HTTP/") || line.split(' ').value(1) != "200") {
+        failure("Wrong caster response\n" + line);
+        return;
+      }
+      continue;
+    }
+
+    if (line.isEmpty()) {
+      startStreaming();
+      return;
+    }
+
+    QByteArray field = line.toLower();
+    if (field.startsWith("transfer-encoding:") && field.contains("chunked")) {
+      _chunked = true;
+    }
+    if (field.startsWith("content-type:") && field.contains("sourcetable")) {
+      failure("Wrong caster response\nMountpoint not available");
+      return;
+    }
+  }
+}
+
+// Read the Proxy Response to CONNECT, start TLS
+////////////////////////////////////////////////////////////////////////////
+void bncNetStream::readTunnel() {
+
+  while (_socket->canReadLine()) {
+    QByteArray line = _socket->readLine().trimmed();
+    if (_response.isEmpty()) {
+      _response.push_back(line);
+      if (line.split(' ').value(1) != "200") {
+        failure("Wrong proxy response\n" + line);
+        return;
+      }
+    }
+    else if (line.isEmpty()) {
+      _state = header;
+      _response.clear();
+      static_cast<QSslSocket*>(_socket)->startClientEncryption();
+      return;
+    }
+  }
+}
+
+// Decode the chunked transfer coding (as far as available), returns an
+// error message if the stream is finished
+////////////////////////////////////////////////////////////////////////////
+QByteArray bncNetStream::readChunks(QByteArray& data) {
+
+  while (true) {
+    if (_chunkLeft > 0) {
+      QByteArray chunk = _socket->read(_chunkLeft);
+      if (chunk.isEmpty()) {
+        return QByteArray();
+      }
+      data.append(chunk);
+      _chunkLeft -= chunk.size();
+      _chunkEnd   = (_chunkLeft == 0);
+      continue;
+    }
+
+    if (!_socket->canReadLine()) {
+      return QByteArray();
+    }
+    QByteArray line = _socket->readLine().trimmed();
+
+    if (_chunkEnd) {
+      _chunkEnd = false;
+      continue;
+    }
+
+    int iExt = line.indexOf(';');
+    if (iExt != -1) {
+      line.truncate(iExt);
+    }
+    bool ok;
+    _chunkLeft = line.trimmed().toInt(&ok, 16);
+    if (!ok || _chunkLeft < 0) {
+      _chunkLeft = 0;
+      return "Wrong chunk size";
+    }
+    if (_chunkLeft == 0) {
+      return "End of stream";
+    }
+  }
+}
+
+// Read the RTSP Responses to SETUP and PLAY (as far as available)
+////////////////////////////////////////////////////////////////////////////
+void bncNetStream::readRtspResponse() {
+
+  while (_socket && _socket->canReadLine()) {
+    QByteArray line = _socket->readLine().trimmed();
+    if (!line.isEmpty()) {
+      _response.push_back(line);
+      continue;
+    }
+
+    // SETUP answered: session and server port
+    // ---------------------------------------
+    if (_state == header) {
+      QByteArray serverPort;
+      for (int ii = 0; ii < _response.size(); ii++) {
+        QByteArray respLine = _response[ii].toAscii();
+        if (respLine.indexOf("Session:") == 0) {
+          _session = respLine.mid(9);
+        }
+        int iSrv = respLine.indexOf("server_port=");
+        if (iSrv != -1) {
+          serverPort = respLine.mid(iSrv+12);
+        }
+      }
+      if (_session.isEmpty()) {
+        failure("Wrong caster response\n" + _response.join("\n").toAscii());
+        return;
+      }
+
+      // Send initial RTP packet for firewall handling
+      // ---------------------------------------------
+      if (!serverPort.isEmpty()) {
+        unsigned sessInt = _session.toInt();
+        char rtpbuffer[12];
+        rtpbuffer[0]  = char(128);
+        rtpbuffer[1]  =  96;
+        for (int jj = 2; jj <= 7; jj++) {
+          rtpbuffer[jj] = 0;
+        }
+        rtpbuffer[8]  = (sessInt >> 24) & 0xFF;
+        rtpbuffer[9]  = (sessInt >> 16) & 0xFF;
+        rtpbuffer[10] = (sessInt >>  8) & 0xFF;
+        rtpbuffer[11] = (sessInt      ) & 0xFF;
+        _udpSocket->writeDatagram(rtpbuffer, 12, _socket->peerAddress(),
+                                  serverPort.toInt());
+      }
+
+      QByteArray reqStr = "PLAY " + _url.toEncoded() + " RTSP/1.0\r\n"
+                        + "CSeq: " + QByteArray::number(++_CSeq) + "\r\n"
+                        + "Session: " + _session + "\r\n"
+                        + "\r\n";
+      _socket->write(reqStr);
+      _state = play;
+      _response.clear();
+    }
+
+    // PLAY answered
+    // -------------
+    else if (_state == play) {
+      if (_response.filter("200 OK").isEmpty()) {
+        failure("Wrong caster response\n" + _response.join("\n").toAscii());
+        return;
+      }
+      emit newMessage(_getThread->staID() + ": UDP connection established", true);
+      _response.clear();
+      startStreaming();
+      slotDatagrams();
+      return;
+    }
+  }
+}
+
+// First datagram: caster response with the session number (NTRIP over UDP)
+////////////////////////////////////////////////////////////////////////////
+void bncNetStream::readUdpResponse() {
+
+  QByteArray repl;
+  _receiver.read(_udpSocket, repl, 1);
+
+  QList<QByteArray> lines = repl.split('\n');
+  for (int ii = 0; ii < lines.size(); ii++) {
+    QByteArray line = lines[ii].trimmed();
+    if (line.isEmpty()) {
+      break;
+    }
+    if (line.indexOf("Session:") == 0) {
+      _session = line.mid(9).trimmed();
+      unsigned session = _session.toUInt();
+      _keepAlive[ 8] = (session >> 24) & 0xFF;
+      _keepAlive[ 9] = (session >> 16) & 0xFF;
+      _keepAlive[10] = (session >>  8) & 0xFF;
+      _keepAlive[11] = (session)       & 0xFF;
+      break;
+    }
+  }
+
+  startStreaming();
+}
+
+// Caster response accepted
+////////////////////////////////////////////////////////////////////////////
+void bncNetStream::startStreaming() {
+  _state = streaming;
+  releaseSlot();
+  if (_proto == udp || _proto == rtsp) {
+    _keepAliveTimer->start();
+  }
+  _reactor->enqueue(_iDecoder, _getThread, bncNetReactor::connected);
+}
+
+// Keep the session alive (NTRIP over UDP, RTSP)
+////////////////////////////////////////////////////////////////////////////
+void bncNetStream::slotKeepAlive() {
+  if      (_proto == udp && _udpSocket) {
+    _udpSocket->writeDatagram(_keepAlive, 12, _address, _url.port());
+  }
+  else if (_proto == rtsp && _socket) {
+    QByteArray reqStr = "GET_PARAMETER " + _url.toEncoded() + " RTSP/1.0\r\n"
+                      + "CSeq: " + QByteArray::number(++_CSeq) + "\r\n"
+                      + "Session: " + _session + "\r\n"
+                      + "\r\n";
+    _socket->write(reqStr);
+  }
+}
+
+// Connection attempt finished, give the slot to other streams
+////////////////////////////////////////////////////////////////////////////
+void bncNetStream::releaseSlot() {
+  if (_connSlot) {
+    BNC_CONNECTS->release();
+    _connSlot = false;
+  }
+}
+
+// Abort pending lookups, close and delete the sockets
+////////////////////////////////////////////////////////////////////////////
+void bncNetStream::closeConnection() {
+  _keepAliveTimer->stop();
+  if (_lookupId != -1) {
+    QHostInfo::abortHostLookup(_lookupId);
+    _lookupId = -1;
+  }
+  if (_socket) {
+    _socket->disconnect(this);
+    _socket->abort();
+    _socket->deleteLater();
+    _socket = 0;
+  }
+  if (_udpSocket) {
+    _udpSocket->disconnect(this);
+    _udpSocket->close();
+    _udpSocket->deleteLater();
+    _udpSocket = 0;
+  }
+}
+
+// Connection closed by the caster or socket error
+////////////////////////////////////////////////////////////////////////////
+void bncNetStream::slotDisconnected() {
+  if (_state == idle || !_socket) {
+    return;
+  }
+  QByteArray errStr = _socket->errorString().toAscii();
+  if (errStr.isEmpty()) {
+    errStr = "Connection closed";
+  }
+  failure(errStr);
+}
+
+// Timeout or end of the reconnect delay
+////////////////////////////////////////////////////////////////////////////
+void bncNetStream::slotTimeout() {
+  if      (_state == idle) {
+    slotStart();
+  }
+  else if (_state == connecting || _state == tunnel) {
+    failure("Connect timeout");
+  }
+  else if (_state == header || _state == play) {
+    failure("Response timeout");
+  }
+  else {
+    failure("Data timeout");
+  }
+}
+
+// Close the connection and schedule a reconnect (jittered back-off)
+////////////////////////////////////////////////////////////////////////////
+void bncNetStream::failure(const QByteArray& msg) {
+
+  _timer->stop();
+  closeConnection();
+  _state = idle;
+  releaseSlot();
+
+  emit newMessage(_getThread->staID() + ": " + msg + ", reconnecting", true);
+  _reactor->enqueue(_iDecoder, _getThread, bncNetReactor::disconnected);
+
+  _timer->start(BNC_CONNECTS->delay(_connAttempt));
+  ++_connAttempt;
+}
+
+// Constructor
+////////////////////////////////////////////////////////////////////////////
+bncNetReactor::bncNetReactor(int numIOThreads, int numDecoders) {
+
+  _nextIOThread = 0;
+
+  if (numIOThreads < 1) {
+    numIOThreads = 1;
+  }
+  for (int ii = 0; ii < numIOThreads; ii++) {
+    QThread* ioThread = new QThread;
+    ioThread->start();
+    _ioThreads.push_back(ioThread);
+  }
+
+  if (numDecoders < 1) {
+    numDecoders = QThread::idealThreadCount();
+  }
+  for (int ii = 0; ii < numDecoders; ii++) {
+    t_decoder* decoder = new t_decoder(this);
+    decoder->start();
+    _decoders.push_back(decoder);
+  }
+}
+
+// Destructor
+////////////////////////////////////////////////////////////////////////////
+bncNetReactor::~bncNetReactor() {
+
+  _mutex.lock();
+  QList<bncGetThread*> getThreads = _streams.keys();
+  _mutex.unlock();
+
+  for (int ii = 0; ii < getThreads.size(); ii++) {
+    removeStream(getThreads[ii]);
+  }
+  for (int ii = 0; ii < _ioThreads.size(); ii++) {
+    _ioThreads[ii]->quit();
+    _ioThreads[ii]->wait();
+    delete _ioThreads[ii];
+  }
+  for (int ii = 0; ii < _decoders.size(); ii++) {
+    _decoders[ii]->stop();
+    _decoders[ii]->wait();
+    delete _decoders[ii];
+  }
+}
+
+// Can the stream be read without a thread of its own?
+////////////////////////////////////////////////////////////////////////////
+bool bncNetReactor::supports(const bncGetThread* getThread) {
+  return getThread->nonBlockingInput();
+}
+
+// Start reading a stream
+////////////////////////////////////////////////////////////////////////////
+void bncNetReactor::addStream(bncGetThread* getThread) {
+
+  QMutexLocker locker(&_mutex);
+
+  if (_streams.contains(getThread)) {
+    return;
+  }
+
+  // All data of one station are decoded by the same thread
+  // ------------------------------------------------------
+  int iDecoder = qHash(getThread->staID()) % _decoders.size();
+
+  getThread->setReactorInput();
+  bncNetStream* stream = new bncNetStream(this, getThread, iDecoder);
+  stream->moveToThread(_ioThreads[_nextIOThread]);
+  _nextIOThread = (_nextIOThread + 1) % _ioThreads.size();
+  _streams[getThread] = stream;
+
+  QMetaObject::invokeMethod(stream, "slotStart", Qt::QueuedConnection);
+}
+
+// Stop reading a stream, returns when its data are no longer processed
+////////////////////////////////////////////////////////////////////////////
+void bncNetReactor::removeStream(bncGetThread* getThread) {
+
+  _mutex.lock();
+  bncNetStream* stream = _streams.take(getThread);
+  _mutex.unlock();
+
+  if (!stream) {
+    return;
+  }
+
+  QMetaObject::invokeMethod(stream, "slotStop", Qt::BlockingQueuedConnection);
+  stream->deleteLater();
+
+  for (int ii = 0; ii < _decoders.size(); ii++) {
+    _decoders[ii]->remove(getThread);
+  }
+}
+
+// Stream to be deleted (decoder failure), behaves like a finished thread
+////////////////////////////////////////////////////////////////////////////
+void bncNetReactor::slotStreamFinished(QObject* object) {
+
+  bncGetThread* getThread = static_cast<bncGetThread*>(object);
+
+  _mutex.lock();
+  bool known = _streams.contains(getThread);
+  _mutex.unlock();
+
+  if (known) {
+    removeStream(getThread);
+    getThread->deleteLater();
+  }
+}
+
+// Pass a job to the decoding thread
+////////////////////////////////////////////////////////////////////////////
+void bncNetReactor::enqueue(int iDecoder, bncGetThread* getThread,
+                            e_jobType type, const QByteArray& data) {
+  t_job job;
+  job.getThread = getThread;
+  job.type      = type;
+  job.data      = data;
+  _decoders[iDecoder]->append(job);
+}
+
+// Decoding thread: append a job
+////////////////////////////////////////////////////////////////////////////
+void bncNetReactor::t_decoder::append(const t_job& job) {
+  QMutexLocker locker(&_mutex);
+  if (!_stop) {
+    _jobs.enqueue(job);
+    _newJob.wakeOne();
+  }
+}
+
+// Decoding thread: drop the jobs of a station, wait for the running one
+////////////////////////////////////////////////////////////////////////////
+void bncNetReactor::t_decoder::remove(bncGetThread* getThread) {
+  QMutexLocker locker(&_mutex);
+  for (int ii = _jobs.size() - 1; ii >= 0; ii--) {
+    if (_jobs[ii].getThread == getThread) {
+      _jobs.removeAt(ii);
+    }
+  }
+  while (_busy == getThread) {
+    _jobDone.wait(&_mutex);
+  }
+}
+
+// Decoding thread: stop
+////////////////////////////////////////////////////////////////////////////
+void bncNetReactor::t_decoder::stop() {
+  QMutexLocker locker(&_mutex);
+  _stop = true;
+  _jobs.clear();
+  _newJob.wakeAll();
+}
+
+// Decoding thread: process the jobs in order of arrival
+////////////////////////////////////////////////////////////////////////////
+void bncNetReactor::t_decoder::run() {
+
+  while (true) {
+    t_job job;
+    {
+      QMutexLocker locker(&_mutex);
+      while (_jobs.isEmpty() && !_stop) {
+        _newJob.wait(&_mutex);
+      }
+      if (_stop) {
+        return;
+      }
+      job   = _jobs.dequeue();
+      _busy = job.getThread;
+    }
+
+    bool finished = false;
+    try {
+      if      (job.type == data) {
+        if (!job.getThread->isToBeDeleted()) {
+          job.getThread->processData(job.data);
+          finished = job.getThread->isToBeDeleted();
+        }
+      }
+      else if (job.type == connected) {
+        job.getThread->streamConnected();
+      }
+      else if (job.type == disconnected) {
+        job.getThread->streamDisconnected();
+      }
+    }
+    catch (Exception& exc) {
+      QMetaObject::invokeMethod(BNC_CORE, "slotMessage", Qt::QueuedConnection,
+                                Q_ARG(QByteArray, job.getThread->staID() + " " + exc.what()),
+                                Q_ARG(bool, true));
+      finished = true;
+    }
+    catch (...) {
+      QMetaObject::invokeMethod(BNC_CORE, "slotMessage", Qt::QueuedConnection,
+                                Q_ARG(QByteArray, job.getThread->staID() + " bncNetReactor exception"),
+                                Q_ARG(bool, true));
+      finished = true;
+    }
+
+    {
+      QMutexLocker locker(&_mutex);
+      _busy = 0;
+      _jobDone.wakeAll();
+    }
+
+    if (finished) {
+      QMetaObject::invokeMethod(_reactor, "slotStreamFinished", Qt::QueuedConnection,
+                                Q_ARG(QObject*, job.getThread));
+    }
+  }
+}
@@ -0,0 +1,181 @@
+// Part of BNC, a utility for retrieving decoding and
+// converting GNSS data streams from NTRIP broadcasters.
+//
+// Copyright (C) 2007
+// German Federal Agency for Cartography and Geodesy (BKG)
+// http://www.bkg.bund.de
+// Czech Technical University Prague, Department of Geodesy
+// http://www.fsv.cvut.cz
+//
+// Email: euref-ip@bkg.bund.de
+//
+// This program is free software; you can redistribute it and/or
+// modify it under the terms of the GNU General Public License
+// as published by the Free Software Foundation, version 2.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program; if not, write to the Free Software
+// Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA 02111-1307, USA.
+
+#ifndef BNCNETREACTOR_H
+#define BNCNETREACTOR_H
+
+#include <QMap>
+#include <QMutex>
+#include <QQueue>
+#include <QThread>
+#include <QTimer>
+#include <QUrl>
+#include <QVector>
+#include <QWaitCondition>
+#include <QtNetwork>
+
+#include "bncudpreceiver.h"
+
+class bncGetThread;
+class bncNetReactor;
+
+/**
+ * One input stream handled by the reactor. The object lives in one of the
+ * I/O threads, all socket operations are non-blocking. Supported are
+ * NTRIP Version 1, NTRIP Version 2 over HTTP and HTTPS (chunked transfer
+ * coding included), NTRIP Version 2 over UDP, RTSP/RTP and plain TCP and
+ * UDP streams.
+ */
+class bncNetStream : public QObject {
+ Q_OBJECT
+
+ public:
+  bncNetStream(bncNetReactor* reactor, bncGetThread* getThread, int iDecoder);
+  ~bncNetStream();
+
+ signals:
+  void newMessage(QByteArray msg, bool showOnScreen);
+
+ public slots:
+  void slotStart();
+  void slotStop();
+
+ private slots:
+  void slotConnected();
+  void slotEncrypted();
+  void slotSslErrors(const QList<QSslError>& errors);
+  void slotHostFound(const QHostInfo& hostInfo);
+  void slotReadyRead();
+  void slotDatagrams();
+  void slotDisconnected();
+  void slotTimeout();
+  void slotKeepAlive();
+
+ private:
+  enum e_proto {ntrip1, ntrip2, udp, rtsp, tcp, udp0};
+  enum e_state {idle, connecting, tunnel, header, play, streaming};
+  void sendRequest();
+  void readHeader();
+  void readHeaderV2();
+  void readTunnel();
+  void readRtspResponse();
+  void readUdpResponse();
+  QByteArray readChunks(QByteArray& data);
+  void startStreaming();
+  void releaseSlot();
+  void closeConnection();
+  void failure(const QByteArray& msg);
+  QByteArray authorization() const;
+
+  bncNetReactor* _reactor;
+  bncGetThread*  _getThread;
+  int            _iDecoder;
+  QUrl           _url;
+  e_proto        _proto;
+  bool           _secure;
+  bool           _sslIgnoreErrors;
+  bool           _proxy;
+  QTcpSocket*    _socket;
+  QUdpSocket*    _udpSocket;
+  bncUdpReceiver _receiver;
+  QHostAddress   _address;
+  int            _lookupId;
+  QTimer*        _timer;
+  QTimer*        _keepAliveTimer;
+  e_state        _state;
+  bool           _proxyResponse;
+  QStringList    _response;
+  bool           _chunked;
+  int            _chunkLeft;      // bytes of the current chunk still to read
+  bool           _chunkEnd;       // CRLF after the chunk data expected
+  QByteArray     _session;
+  int            _CSeq;
+  char           _keepAlive[12];
+  int            _timeOut;
+  int            _connAttempt;
+  bool           _connSlot;
+};
+
+/**
+ * Event-driven input of many streams. A small number of I/O threads
+ * multiplexes all sockets, received data blocks are decoded by a pool of
+ * decoding threads. All blocks of one station go to the same decoding
+ * thread, so that they are processed in the order of reception.
+ */
+class bncNetReactor : public QObject {
+ Q_OBJECT
+ friend class bncNetStream;
+
+ public:
+  /**
+   * @param numIOThreads number of I/O threads
+   * @param numDecoders number of decoding threads, 0 = number of CPU cores
+   */
+  bncNetReactor(int numIOThreads, int numDecoders);
+  ~bncNetReactor();
+  static bool supports(const bncGetThread* getThread);
+  void addStream(bncGetThread* getThread);
+  void removeStream(bncGetThread* getThread);
+
+ private slots:
+  void slotStreamFinished(QObject* getThread);
+
+ private:
+  enum e_jobType {data, connected, disconnected};
+
+  class t_job {
+   public:
+    bncGetThread* getThread;
+    e_jobType     type;
+    QByteArray    data;
+  };
+
+  class t_decoder : public QThread {
+   public:
+    t_decoder(bncNetReactor* reactor) : _reactor(reactor), _busy(0), _stop(false) {}
+    virtual void run();
+    void append(const t_job& job);
+    void remove(bncGetThread* getThread);
+    void stop();
+   private:
+    bncNetReactor*  _reactor;
+    QMutex          _mutex;
+    QWaitCondition  _newJob;
+    QWaitCondition  _jobDone;
+    QQueue<t_job>   _jobs;
+    bncGetThread*   _busy;
+    bool            _stop;
+  };
+
+  void enqueue(int iDecoder, bncGetThread* getThread, e_jobType type,
+               const QByteArray& data = QByteArray());
+
+  QVector<QThread*>                   _ioThreads;
+  QVector<t_decoder*>                 _decoders;
+  QMap<bncGetThread*, bncNetStream*>  _streams;
+  QMutex                              _mutex;
+  int                                 _nextIOThread;
+};
+
+#endif
@@ -33,6 +33,9 @@ bncoutf::bncoutf(const QString& sklFileName, const QString& intr, int sampl) {
   _sampl         = sampl;
   _intr          = intr;
   _numSec        = 0;
+  _binary        = false;
+  _autoFlush     = true;
+  _period        = -1;
 
   if (! sklFileName.isEmpty()) {
     QFileInfo fileInfo(sklFileName);
@@ -156,6 +159,16 @@ QString bncoutf::resolveFileName(int GPSweek, const QDateTime& datTim) {
   return _path + baseName + epoStr + _extension;
 }
 
+// Index of the file period (periods dividing an hour, an hour or a day),
+// -1 for other periods
+////////////////////////////////////////////////////////////////////////////
+qint64 bncoutf::periodIndex(int GPSweek, double GPSweeks) const {
+  if (_numSec <= 0 || (3600 % _numSec != 0 && _numSec != 86400)) {
+    return -1;
+  }
+  return qint64(GPSweek) * (604800 / _numSec) + qint64(floor(GPSweeks / _numSec));
+}
+
 // Re-Open Output File
 ////////////////////////////////////////////////////////////////////////////
 t_irc bncoutf::reopen(int GPSweek, double GPSweeks) {
@@ -164,6 +177,13 @@ t_irc bncoutf::reopen(int GPSweek, double GPSweeks) {
     return failure;
   }
 
+  // Still the period of the open file
+  // ---------------------------------
+  if (_headerWritten && _period != -1 &&
+      periodIndex(GPSweek, GPSweeks) == _period) {
+    return success;
+  }
+
   QDateTime datTim = dateAndTimeFromGPSweek(GPSweek, GPSweeks);
 
   QString newFileName = resolveFileName(GPSweek, datTim);
@@ -180,17 +200,19 @@ t_irc bncoutf::reopen(int GPSweek, double GPSweeks) {
   // --------------------------
   if (!_headerWritten) {
     _out.setf(ios::showpoint | ios::fixed);
+    ios::openmode mode = _binary ? ios::out | ios::binary : ios::out;
     if (_append && QFile::exists(_fName)) {
-      _out.open(_fName.toAscii().data(), ios::out | ios::app);
+      _out.open(_fName.toAscii().data(), mode | ios::app);
     }
     else {
-      _out.open(_fName.toAscii().data());
+      _out.open(_fName.toAscii().data(), mode);
       writeHeader(datTim);
     }
     if (_out.is_open()) {
       _headerWritten = true;
     }
   }
+  _period = periodIndex(GPSweek, GPSweeks);
 
   return success;
 }
@@ -200,6 +222,28 @@ t_irc bncoutf::reopen(int GPSweek, double GPSweeks) {
 t_irc bncoutf::write(int GPSweek, double GPSweeks, const QString& str) {
   reopen(GPSweek, GPSweeks);
   _out << str.toAscii().data();
-  _out.flush();
+  if (_autoFlush) {
+    _out.flush();
+  }
   return success;
 }
+
+// Write Binary Data
+////////////////////////////////////////////////////////////////////////////
+t_irc bncoutf::write(int GPSweek, double GPSweeks, const char* data,
+                     unsigned len) {
+  reopen(GPSweek, GPSweeks);
+  _out.write(data, len);
+  if (_autoFlush) {
+    _out.flush();
+  }
+  return success;
+}
+
+// Flush the output (auto flush off)
+////////////////////////////////////////////////////////////////////////////
+void bncoutf::flush() {
+  if (_out.is_open()) {
+    _out.flush();
+  }
+}
@@ -12,6 +12,11 @@ class bncoutf {
   bncoutf(const QString& sklFileName, const QString& intr, int sampl);
   virtual ~bncoutf();
   t_irc write(int GPSweek, double GPSweeks, const QString& str);
+  t_irc write(int GPSweek, double GPSweeks, const char* data, unsigned len);
+
+  /** Leave the flushing to the caller (no flush after each write) */
+  void  setAutoFlush(bool autoFlush) {_autoFlush = autoFlush;}
+  void  flush();
 
  protected:
   virtual t_irc reopen(int GPSweek, double GPSweeks);
@@ -20,13 +25,18 @@ class bncoutf {
   std::ofstream _out;
   int           _sampl;
   int           _numSec;
+  bool          _binary;
+  bool          _autoFlush;
 
  private:
   QString epochStr(const QDateTime& datTim, const QString& intStr,
       int sampl);
   QString resolveFileName(int GPSweek, const QDateTime& datTim);
 
+  qint64  periodIndex(int GPSweek, double GPSweeks) const;
+
   bool    _headerWritten;
+  qint64  _period;        // file period of the open file, -1 if not regular
   QString _path;
   QString _sklBaseName;
   QString _extension;
@@ -45,8 +45,6 @@
 
 using namespace std;
 
-#define RAW_FILE_VERSION "1"
-
 // Constructor
 ////////////////////////////////////////////////////////////////////////////
 bncRawFile::bncRawFile(const QByteArray& fileName, const QByteArray& staID,
@@ -56,7 +54,6 @@ bncRawFile::bncRawFile(const QByteArray& fileName, const QByteArray& staID,
   _format     = "unset";
   _staID      = staID;
   _inpFile    = 0;
-  _outFile    = 0;
   _version    = 0;
 
   // Initialize for Input
@@ -68,59 +65,23 @@ bncRawFile::bncRawFile(const QByteArray& fileName, const QByteArray& staID,
     QStringList lst  = line.split(' ');
     _version = lst.value(0).toInt();
   }
+}
 
-  // Initialize for Output
-  // ---------------------
-  else {    
-    QDate currDate = currentDateAndTimeGPS().date();
-    _currentFileName = _fileName + "_" + currDate.toString("yyMMdd");
-    _outFile = new QFile(_currentFileName);     
-    bncSettings settings;
-    if ( Qt::CheckState(settings.value("rnxAppend").toInt()) == Qt::Checked &&
-         QFile::exists(_currentFileName) ) {
-      _outFile->open(QIODevice::WriteOnly | QIODevice::Append);
-    }
-    else {
-      _outFile->open(QIODevice::WriteOnly);
-      _outFile->write(RAW_FILE_VERSION " Version of BNC raw file");
-    }
-  }
+// Constructor (single station handle)
+////////////////////////////////////////////////////////////////////////////
+bncRawFile::bncRawFile(const QByteArray& staID, const QByteArray& format) {
+  _format  = format;
+  _staID   = staID;
+  _inpFile = 0;
+  _version = 0;
 }
 
 // Destructor
 ////////////////////////////////////////////////////////////////////////////
 bncRawFile::~bncRawFile() {
   delete _inpFile;
-  delete _outFile;
-}
-
-// Raw Output
-////////////////////////////////////////////////////////////////////////////
-void bncRawFile::writeRawData(const QByteArray& data, const QByteArray& staID,
-                              const QByteArray& format) {
-  if (_outFile) {
-    QDate currDate = currentDateAndTimeGPS().date();
-    QString hlp = _fileName + "_" + currDate.toString("yyMMdd");
-    if (hlp != _currentFileName) {
-      _currentFileName = hlp;
-      delete _outFile;
-      _outFile = new QFile(_currentFileName);
-      _outFile->open(QIODevice::WriteOnly);
-      _outFile->write(RAW_FILE_VERSION " Version of BNC raw file");
-    }
-
-    QString chunkHeader = QString("\n%1 %2 %3 %4\n")
-                 .arg(currentDateAndTimeGPS().toString(Qt::ISODate))
-                 .arg(QString(staID))
-                 .arg(QString(format))
-                 .arg(data.size());
-    _outFile->write(chunkHeader.toAscii());
-    _outFile->write(data);
-    _outFile->flush();
-  }
 }
 
-
 // Raw Input
 ////////////////////////////////////////////////////////////////////////////
 QByteArray bncRawFile::readChunk(){
@@ -128,21 +89,20 @@ QByteArray bncRawFile::readChunk(){
   QByteArray data;
 
   if (_inpFile) {
-    QString     line = _inpFile->readLine();
+    QByteArray line = _inpFile->readLine();
     if (line.indexOf("Version of BNC raw file") != -1) {
       line = _inpFile->readLine();
     }
-    if (!line.isEmpty()) {
-      QStringList lst  = line.split(' ');
-      
-      BNC_CORE->setDateAndTimeGPS(QDateTime(QDateTime::fromString(lst.value(0), Qt::ISODate)));
-      
-      _staID  = lst.value(1).toAscii();
-      _format = lst.value(2).toAscii();
-      int nBytes = lst.value(3).toInt();
-      
-      data = _inpFile->read(nBytes);
-      
+    t_rawChunkHeader header;
+    if (header.parse(line.constData(), line.size())) {
+
+      BNC_CORE->setDateAndTimeGPS(header.dateTime());
+
+      _staID  = QByteArray(header.staID.constData(), header.staID.size());
+      _format = QByteArray(header.format.constData(), header.format.size());
+
+      data = _inpFile->read(header.nBytes);
+
       _inpFile->read(1); // read '\n' character
     }
   }
@@ -150,3 +110,82 @@ QByteArray bncRawFile::readChunk(){
   return data;
 }
 
+// Parse the chunk header line (without QString conversion and splitting)
+////////////////////////////////////////////////////////////////////////////
+bool t_rawChunkHeader::parse(const char* line, int len) {
+
+  while (len > 0 && (line[len-1] == '\n' || line[len-1] == '\r')) {
+    --len;
+  }
+
+  // Date and time yyyy-MM-ddThh:mm:ss
+  // ---------------------------------
+  static const int dtLen = 19;
+  if (len < dtLen || line[4] != '-' || line[7] != '-' || line[10] != 'T' ||
+      line[13] != ':' || line[16] != ':') {
+    return false;
+  }
+  int val[6];
+  const int pos[6] = {0, 5, 8, 11, 14, 17};
+  const int wid[6] = {4, 2, 2,  2,  2,  2};
+  for (int ii = 0; ii < 6; ii++) {
+    val[ii] = 0;
+    for (int jj = pos[ii]; jj < pos[ii] + wid[ii]; jj++) {
+      if (line[jj] < '0' || line[jj] > '9') {
+        return false;
+      }
+      val[ii] = 10 * val[ii] + (line[jj] - '0');
+    }
+  }
+  QDate date(val[0], val[1], val[2]);
+  if (!date.isValid()) {
+    return false;
+  }
+  epoch = qint64(date.toJulianDay()) * 86400 + val[3] * 3600 + val[4] * 60 + val[5];
+
+  // Station, format, number of bytes
+  // --------------------------------
+  const char* fields[3];
+  int         lens[3];
+  int         nFld = 0;
+  int         ii   = dtLen;
+  while (ii < len && line[ii] != ' ') {  // e.g. time zone designator
+    ++ii;
+  }
+  while (ii < len && nFld < 3) {
+    while (ii < len && line[ii] == ' ') {
+      ++ii;
+    }
+    int i0 = ii;
+    while (ii < len && line[ii] != ' ') {
+      ++ii;
+    }
+    if (ii > i0) {
+      fields[nFld] = line + i0;
+      lens[nFld]   = ii - i0;
+      ++nFld;
+    }
+  }
+  if (nFld < 3) {
+    return false;
+  }
+  staID  = QByteArray::fromRawData(fields[0], lens[0]);
+  format = QByteArray::fromRawData(fields[1], lens[1]);
+  nBytes = 0;
+  for (int jj = 0; jj < lens[2]; jj++) {
+    char cc = fields[2][jj];
+    if (cc < '0' || cc > '9') {
+      return false;
+    }
+    nBytes = 10 * nBytes + (cc - '0');
+  }
+
+  return true;
+}
+
+// Date and time from seconds since julian day 0
+////////////////////////////////////////////////////////////////////////////
+QDateTime t_rawChunkHeader::toDateTime(qint64 epoch) {
+  return QDateTime(QDate::fromJulianDay(int(epoch / 86400)),
+                   QTime(0, 0, 0).addSecs(int(epoch % 86400)));
+}
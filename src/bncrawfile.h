@@ -27,9 +27,24 @@
 
 #include <QFile>
 #include <QTextStream>
+#include <QDateTime>
 
 #include "bnccaster.h"
 
+// Header line of a raw file chunk ("dateTime staID format nBytes")
+////////////////////////////////////////////////////////////////////////////
+class t_rawChunkHeader {
+ public:
+  t_rawChunkHeader() : epoch(0), nBytes(0) {}
+  bool             parse(const char* line, int len);
+  QDateTime        dateTime() const {return toDateTime(epoch);}
+  static QDateTime toDateTime(qint64 epoch);
+  qint64           epoch;    // seconds since julian day 0
+  QByteArray       staID;    // no deep copy, valid as long as the parsed line
+  QByteArray       format;   // no deep copy, valid as long as the parsed line
+  int              nBytes;
+};
+
 class bncRawFile {
  public:
 
@@ -38,19 +53,18 @@ class bncRawFile {
   bncRawFile(const QByteArray& fileName, const QByteArray& staID,
              inpOutFlag ioflg);
 
+  // Single station handle without file (used by bncRawReplay)
+  bncRawFile(const QByteArray& staID, const QByteArray& format);
+
   ~bncRawFile();  
   QByteArray format() const {return _format;}
   QByteArray staID() const {return _staID;}
   QByteArray readChunk();
-  void writeRawData(const QByteArray& data, const QByteArray& staID,
-                    const QByteArray& format);
  private:
   QString    _fileName;
-  QString    _currentFileName;
   QByteArray _format;
   QByteArray _staID;
   QFile*     _inpFile;
-  QFile*     _outFile;
   int        _version;
 };
 #endif
@@ -0,0 +1,298 @@
+// Part of BNC, a utility for retrieving decoding and
+// converting GNSS data streams from NTRIP broadcasters.
+//
+// Copyright (C) 2007
+// German Federal Agency for Cartography and Geodesy (BKG)
+// http://www.bkg.bund.de
+// Czech Technical University Prague, Department of Geodesy
+// http://www.fsv.cvut.cz
+//
+// Email: euref-ip@bkg.bund.de
+//
+// This program is free software; you can redistribute it and/or
+// modify it under the terms of the GNU General Public License
+// as published by the Free Software Foundation, version 2.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program; if not, write to the Free Software
+// Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA 02111-1307, USA.
+
+
+/* -------------------------------------------------------------------------
+ * BKG NTRIP Client
+ * -------------------------------------------------------------------------
+ *
+ * Class:      bncRawRecorder
+ *
+ * Purpose:    Buffered output of the raw data into file(s)
+ *
+ * Changes:
+ *
+ * -----------------------------------------------------------------------*/
+
+#include <functional>
+#include <queue>
+#include <vector>
+#include <QDateTime>
+
+#include "bncrawrecorder.h"
+#include "bnccore.h"
+#include "bncutils.h"
+
+using namespace std;
+
+#define RAW_FILE_VERSION "1"
+
+// Constructor (station buffer)
+////////////////////////////////////////////////////////////////////////////
+bncRawRecorder::t_station::t_station(bncRawRecorder* recorder,
+                                     const QByteArray& staID) {
+  _recorder   = recorder;
+  _staID      = staID;
+  _numDropped = 0;
+  _buffer.reserve(BUFSIZE);
+  if (_recorder->_perStation) {
+    _file._fileName = _recorder->_fileName + "_" + _staID;
+  }
+}
+
+// Append one chunk (called by the stream threads)
+////////////////////////////////////////////////////////////////////////////
+void bncRawRecorder::t_station::append(const QByteArray& data,
+                                       const QByteArray& format) {
+
+  QDateTime  dateTime    = currentDateAndTimeGPS();
+  QByteArray chunkHeader = "\n"
+                 + dateTime.toString(Qt::ISODate).toAscii()
+                 + ' ' + _staID + ' ' + format + ' '
+                 + QByteArray::number(data.size()) + '\n';
+
+  bool full = false;
+  {
+    QMutexLocker locker(&_mutex);
+    if (_buffer.size() + chunkHeader.size() + data.size() > MAXBUFFER) {
+      ++_numDropped;
+      return;
+    }
+    _buffer.append(chunkHeader);
+    _buffer.append(data);
+    t_chunk chunk;
+    chunk._msec = dateTime.toMSecsSinceEpoch();
+    chunk._end  = _buffer.size();
+    _chunks.append(chunk);
+    full = _buffer.size() >= BUFSIZE;
+  }
+
+  // A missed wake-up delays the output by FLUSHMSEC at most
+  // -------------------------------------------------------
+  if (full) {
+    _recorder->_newData.wakeOne();
+  }
+}
+
+// Constructor
+////////////////////////////////////////////////////////////////////////////
+bncRawRecorder::bncRawRecorder(const QString& fileName, bool perStation,
+                               bool append) {
+  _fileName   = fileName; expandEnvVar(_fileName);
+  _perStation = perStation;
+  _append     = append;
+  _stop       = false;
+  _file._fileName = _fileName;
+
+  connect(this, SIGNAL(newMessage(QByteArray,bool)),
+          BNC_CORE, SLOT(slotMessage(const QByteArray,bool)));
+
+  start();
+}
+
+// Destructor
+////////////////////////////////////////////////////////////////////////////
+bncRawRecorder::~bncRawRecorder() {
+  stop();
+  delete _file._file;
+  for (int ii = 0; ii < _stations.size(); ii++) {
+    delete _stations[ii]->_file._file;
+    delete _stations[ii];
+  }
+}
+
+// Buffer of a station (the stream threads keep the pointer)
+////////////////////////////////////////////////////////////////////////////
+bncRawRecorder::t_station* bncRawRecorder::station(const QByteArray& staID) {
+  QMutexLocker locker(&_mutex);
+  QMap<QByteArray, int>::const_iterator it = _stationIndex.find(staID);
+  if (it != _stationIndex.end()) {
+    return _stations[it.value()];
+  }
+  t_station* sta = new t_station(this, staID);
+  _stationIndex[staID] = _stations.size();
+  _stations.append(sta);
+  return sta;
+}
+
+// Write all buffers and finish the thread
+////////////////////////////////////////////////////////////////////////////
+void bncRawRecorder::stop() {
+  _mutex.lock();
+  _stop = true;
+  _newData.wakeOne();
+  _mutex.unlock();
+  wait();
+}
+
+// Thread loop
+////////////////////////////////////////////////////////////////////////////
+void bncRawRecorder::run() {
+  while (true) {
+    bool stopped;
+    {
+      QMutexLocker locker(&_mutex);
+      if (!_stop) {
+        _newData.wait(&_mutex, FLUSHMSEC);
+      }
+      stopped = _stop;
+    }
+    flush(stopped);
+    if (stopped) {
+      break;
+    }
+  }
+}
+
+// Swap the station buffers and write them
+////////////////////////////////////////////////////////////////////////////
+void bncRawRecorder::flush(bool all) {
+
+  // Chunks appended after this time stamp may still be missing in the
+  // swapped buffers, the merge stops here
+  // -------------------------------------------------------------------
+  qint64 cutoff = currentDateAndTimeGPS().toMSecsSinceEpoch();
+
+  QList<t_station*> stations;
+  {
+    QMutexLocker locker(&_mutex);
+    stations = _stations;
+  }
+
+  for (int ii = 0; ii < stations.size(); ii++) {
+    t_station* sta = stations[ii];
+
+    QByteArray       data;
+    QVector<t_chunk> chunks;
+    int              numDropped;
+    {
+      QMutexLocker locker(&sta->_mutex);
+      qSwap(data, sta->_buffer);
+      qSwap(chunks, sta->_chunks);
+      sta->_buffer.reserve(BUFSIZE);
+      numDropped = sta->_numDropped;
+      sta->_numDropped = 0;
+    }
+
+    if (numDropped > 0) {
+      emit newMessage(QString("%1: Raw output too slow, %2 chunks dropped")
+                      .arg(QString(sta->_staID)).arg(numDropped).toAscii(), true);
+    }
+
+    if (data.isEmpty()) {
+      continue;
+    }
+    if (_perStation) {
+      write(sta->_file, data);
+    }
+    else {
+      int offset = sta->_pending.size();
+      sta->_pending.append(data);
+      for (int ic = 0; ic < chunks.size(); ic++) {
+        chunks[ic]._end += offset;
+        sta->_pendingChunks.append(chunks[ic]);
+      }
+    }
+  }
+
+  if (!_perStation) {
+    writeMerged(stations, all ? Q_INT64_C(0x7fffffffffffffff) : cutoff);
+  }
+}
+
+// Merge the pending chunks of all stations up to cutoff by time stamp
+////////////////////////////////////////////////////////////////////////////
+void bncRawRecorder::writeMerged(const QList<t_station*>& stations,
+                                 qint64 cutoff) {
+
+  // Next chunk of each station, smallest time stamp first (stable)
+  // ---------------------------------------------------------------
+  typedef pair<qint64, int> t_next;
+  priority_queue<t_next, vector<t_next>, greater<t_next> > next;
+  vector<int> iChunk(stations.size(), 0);
+  for (int ii = 0; ii < stations.size(); ii++) {
+    const QVector<t_chunk>& chunks = stations[ii]->_pendingChunks;
+    if (!chunks.isEmpty() && chunks[0]._msec <= cutoff) {
+      next.push(make_pair(chunks[0]._msec, ii));
+    }
+  }
+
+  QByteArray data;
+  while (!next.empty()) {
+    int ii = next.top().second;
+    next.pop();
+    const t_station*        sta    = stations[ii];
+    const QVector<t_chunk>& chunks = sta->_pendingChunks;
+    int beg = (iChunk[ii] == 0) ? 0 : chunks[iChunk[ii]-1]._end;
+    data.append(sta->_pending.constData() + beg, chunks[iChunk[ii]]._end - beg);
+    ++iChunk[ii];
+    if (iChunk[ii] < chunks.size() && chunks[iChunk[ii]]._msec <= cutoff) {
+      next.push(make_pair(chunks[iChunk[ii]]._msec, ii));
+    }
+  }
+
+  // Keep the chunks after cutoff for the next merge
+  // -----------------------------------------------
+  for (int ii = 0; ii < stations.size(); ii++) {
+    t_station* sta = stations[ii];
+    int nn = iChunk[ii];
+    if (nn == 0) {
+      continue;
+    }
+    int written = sta->_pendingChunks[nn-1]._end;
+    sta->_pending.remove(0, written);
+    sta->_pendingChunks.remove(0, nn);
+    for (int ic = 0; ic < sta->_pendingChunks.size(); ic++) {
+      sta->_pendingChunks[ic]._end -= written;
+    }
+  }
+
+  if (!data.isEmpty()) {
+    write(_file, data);
+  }
+}
+
+// Write a block of chunks, new file every day
+////////////////////////////////////////////////////////////////////////////
+void bncRawRecorder::write(t_file& file, const QByteArray& data) {
+
+  QDate   currDate = currentDateAndTimeGPS().date();
+  QString fileName = file._fileName + "_" + currDate.toString("yyMMdd");
+
+  if (fileName != file._currentFileName) {
+    delete file._file;
+    file._currentFileName = fileName;
+    file._file = new QFile(fileName);
+    if (_append && QFile::exists(fileName)) {
+      file._file->open(QIODevice::WriteOnly | QIODevice::Append |
+                       QIODevice::Unbuffered);
+    }
+    else {
+      file._file->open(QIODevice::WriteOnly | QIODevice::Unbuffered);
+      file._file->write(RAW_FILE_VERSION " Version of BNC raw file");
+    }
+  }
+
+  file._file->write(data);
+}
@@ -0,0 +1,134 @@
+// Part of BNC, a utility for retrieving decoding and
+// converting GNSS data streams from NTRIP broadcasters.
+//
+// Copyright (C) 2007
+// German Federal Agency for Cartography and Geodesy (BKG)
+// http://www.bkg.bund.de
+// Czech Technical University Prague, Department of Geodesy
+// http://www.fsv.cvut.cz
+//
+// Email: euref-ip@bkg.bund.de
+//
+// This program is free software; you can redistribute it and/or
+// modify it under the terms of the GNU General Public License
+// as published by the Free Software Foundation, version 2.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program; if not, write to the Free Software
+// Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA 02111-1307, USA.
+
+
+#ifndef BNCRAWRECORDER_H
+#define BNCRAWRECORDER_H
+
+#include <QByteArray>
+#include <QFile>
+#include <QList>
+#include <QMap>
+#include <QMutex>
+#include <QThread>
+#include <QVector>
+#include <QWaitCondition>
+
+/**
+ * Raw output file(s) written in a thread of its own. Each station appends
+ * its chunks to a buffer of its own (the station mutex is shared with the
+ * writer only), the writer swaps the buffers once a second or when a
+ * buffer is full and writes them in one piece. Either one file for all
+ * stations or one file per station is written, the format is the one
+ * read by bncRawFile. In the file for all stations the chunks of the
+ * stations are merged in the order of their time stamps.
+ */
+class bncRawRecorder : public QThread {
+ Q_OBJECT
+
+ public:
+  class t_station;
+
+  /**
+   * @param fileName raw output file name (without date)
+   * @param perStation one file per station (station ID added to the name)
+   * @param append append to existing files
+   */
+  bncRawRecorder(const QString& fileName, bool perStation, bool append);
+  ~bncRawRecorder();
+
+  /** Buffer of a station, created on first use */
+  t_station* station(const QByteArray& staID);
+
+  /** Write all buffers and finish the thread */
+  void stop();
+
+ signals:
+  void newMessage(QByteArray msg, bool showOnScreen);
+
+ protected:
+  virtual void run();
+
+ private:
+  friend class t_station;
+
+  class t_file {
+   public:
+    t_file() : _file(0) {}
+    QString _fileName;
+    QString _currentFileName;
+    QFile*  _file;
+  };
+
+  class t_chunk {
+   public:
+    qint64 _msec;   // time stamp [ms since 1970]
+    int    _end;    // end of the chunk in the buffer
+  };
+
+  void flush(bool all);
+  void writeMerged(const QList<t_station*>& stations, qint64 cutoff);
+  void write(t_file& file, const QByteArray& data);
+
+  static const int BUFSIZE   = 1 << 16;   // buffer size that wakes the writer
+  static const int MAXBUFFER = 1 << 24;   // chunks are dropped beyond this
+  static const int FLUSHMSEC = 1000;      // maximum delay of the output
+
+  QString               _fileName;
+  bool                  _perStation;
+  bool                  _append;
+  QMutex                _mutex;
+  QWaitCondition        _newData;
+  QList<t_station*>     _stations;
+  QMap<QByteArray, int> _stationIndex;
+  t_file                _file;            // file for all stations
+  bool                  _stop;
+};
+
+class bncRawRecorder::t_station {
+ public:
+  const QByteArray& staID() const {return _staID;}
+
+  /** Append one chunk, returns immediately */
+  void append(const QByteArray& data, const QByteArray& format);
+
+ private:
+  friend class bncRawRecorder;
+  t_station(bncRawRecorder* recorder, const QByteArray& staID);
+  bncRawRecorder*                  _recorder;
+  QByteArray                       _staID;
+
+  // shared with the stream thread
+  QMutex                           _mutex;
+  QByteArray                       _buffer;
+  QVector<bncRawRecorder::t_chunk> _chunks;
+  int                              _numDropped;
+
+  // writer only
+  QByteArray                       _pending;       // chunks not yet merged
+  QVector<bncRawRecorder::t_chunk> _pendingChunks;
+  bncRawRecorder::t_file           _file;          // file of the station
+};
+
+#endif
@@ -0,0 +1,260 @@
+// Part of BNC, a utility for retrieving decoding and
+// converting GNSS data streams from NTRIP broadcasters.
+//
+// Copyright (C) 2007
+// German Federal Agency for Cartography and Geodesy (BKG)
+// http://www.bkg.bund.de
+// Czech Technical University Prague, Department of Geodesy
+// http://www.fsv.cvut.cz
+//
+// Email: euref-ip@bkg.bund.de
+//
+// This program is free software; you can redistribute it and/or
+// modify it under the terms of the GNU General Public License
+// as published by the Free Software Foundation, version 2.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program; if not, write to the Free Software
+// Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA 02111-1307, USA.
+
+/* -------------------------------------------------------------------------
+ * BKG NTRIP Client
+ * -------------------------------------------------------------------------
+ *
+ * Class:      bncRawReplay
+ *
+ * Purpose:    Indexed, parallel replay of a BNC raw file
+ *
+ * Changes:
+ *
+ * -----------------------------------------------------------------------*/
+
+#include <algorithm>
+#include <string.h>
+#include <QElapsedTimer>
+
+#include "bncrawreplay.h"
+#include "bncrawfile.h"
+#include "bncgetthread.h"
+#include "bnccore.h"
+#include "bncutils.h"
+
+using namespace std;
+
+// Sort chunks by epoch, keep the file order within an epoch
+////////////////////////////////////////////////////////////////////////////
+namespace {
+struct t_chunkLess {
+  template<class T> bool operator()(const T& c1, const T& c2) const {
+    if (c1.epoch != c2.epoch) {
+      return c1.epoch < c2.epoch;
+    }
+    return c1.offset < c2.offset;
+  }
+};
+}
+
+// Constructor
+////////////////////////////////////////////////////////////////////////////
+bncRawReplay::bncRawReplay(const QByteArray& fileName, double speed,
+                           int numThreads) {
+
+  connect(this, SIGNAL(newMessage(QByteArray,bool)),
+          BNC_CORE, SLOT(slotMessage(const QByteArray,bool)));
+
+  connect(this, SIGNAL(finished()), this, SLOT(slotFinished()));
+
+  _data  = 0;
+  _speed = speed;
+  _pool.setMaxThreadCount(numThreads > 0 ? numThreads
+                                         : QThread::idealThreadCount());
+
+  QString fName(fileName); expandEnvVar(fName);
+  _file.setFileName(fName);
+  if (!_file.open(QIODevice::ReadOnly)) {
+    emit newMessage("bncRawReplay: cannot open " + fileName, true);
+    return;
+  }
+  _data = _file.map(0, _file.size());
+  if (!_data) {
+    emit newMessage("bncRawReplay: cannot map " + fileName, true);
+    return;
+  }
+
+  if (buildIndex()) {
+    emit newMessage(QString("bncRawReplay: %1 chunks of %2 stream(s) indexed")
+                    .arg(_index.size()).arg(_stations.size()).toAscii(), true);
+  }
+}
+
+// Destructor
+////////////////////////////////////////////////////////////////////////////
+bncRawReplay::~bncRawReplay() {
+  if (isRunning()) {
+    wait();
+  }
+  for (int ii = 0; ii < _stations.size(); ii++) {
+    delete _stations[ii];
+  }
+  if (_data) {
+    _file.unmap(const_cast<uchar*>(_data));
+  }
+}
+
+// Build the (epoch, station, offset) index in one pass
+////////////////////////////////////////////////////////////////////////////
+bool bncRawReplay::buildIndex() {
+
+  const char* beg = reinterpret_cast<const char*>(_data);
+  const char* end = beg + _file.size();
+  const char* pos = beg;
+
+  QHash<QByteArray, int> staIndex;
+  t_rawChunkHeader       header;
+
+  while (pos < end) {
+    const char* eol = static_cast<const char*>(memchr(pos, '\n', end - pos));
+    if (!eol) {
+      break;
+    }
+    int lineLen = eol - pos;
+    if (lineLen == 0 ||
+        QByteArray::fromRawData(pos, lineLen).indexOf("Version of BNC raw file") != -1) {
+      pos = eol + 1;
+      continue;
+    }
+    if (!header.parse(pos, lineLen) || eol + 1 + header.nBytes > end) {
+      emit newMessage(QString("bncRawReplay: corrupted chunk header at offset %1")
+                      .arg(pos - beg).toAscii(), true);
+      break;
+    }
+
+    QHash<QByteArray, int>::const_iterator it = staIndex.constFind(header.staID);
+    int iSta;
+    if (it == staIndex.constEnd()) {
+      iSta = _stations.size();
+      t_station* sta = new t_station;
+      sta->staID     = QByteArray(header.staID.constData(), header.staID.size());
+      sta->getThread = new bncGetThread(new bncRawFile(sta->staID,
+                                          QByteArray(header.format.constData(),
+                                                     header.format.size())));
+      _stations.push_back(sta);
+      staIndex.insert(sta->staID, iSta);
+    }
+    else {
+      iSta = it.value();
+    }
+
+    t_chunk chunk;
+    chunk.epoch  = header.epoch;
+    chunk.offset = (eol + 1) - beg;
+    chunk.nBytes = header.nBytes;
+    chunk.iSta   = iSta;
+    _index.push_back(chunk);
+
+    pos = eol + 1 + header.nBytes;
+  }
+
+  stable_sort(_index.begin(), _index.end(), t_chunkLess());
+
+  return !_index.empty();
+}
+
+// Get Threads of all stations (to be connected to the caster)
+////////////////////////////////////////////////////////////////////////////
+QList<bncGetThread*> bncRawReplay::getThreads() const {
+  QList<bncGetThread*> threads;
+  for (int ii = 0; ii < _stations.size(); ii++) {
+    threads.append(_stations[ii]->getThread);
+  }
+  return threads;
+}
+
+// Decode all chunks of one station and one epoch
+////////////////////////////////////////////////////////////////////////////
+void bncRawReplay::t_task::run() {
+  for (unsigned ii = 0; ii < _sta->pending.size(); ii++) {
+    const t_chunk& chunk = _replay->_index[_sta->pending[ii]];
+    QByteArray data(reinterpret_cast<const char*>(_replay->_data) + chunk.offset,
+                    chunk.nBytes);
+    try {
+      _sta->getThread->processData(data);
+    }
+    catch (Exception& exc) {
+      emit _replay->newMessage(_sta->staID + " " + exc.what(), true);
+    }
+    catch (...) {
+      emit _replay->newMessage(_sta->staID + " bncRawReplay exception", true);
+    }
+  }
+}
+
+// Replay loop (one step per epoch)
+////////////////////////////////////////////////////////////////////////////
+void bncRawReplay::run() {
+
+  if (_index.empty()) {
+    return;
+  }
+
+  QElapsedTimer wallClock;
+  wallClock.start();
+  const qint64 epoch0 = _index[0].epoch;
+
+  unsigned i0 = 0;
+  while (i0 < _index.size() && !BNC_CORE->sigintReceived) {
+
+    const qint64 epoch = _index[i0].epoch;
+    unsigned     i1    = i0;
+    while (i1 < _index.size() && _index[i1].epoch == epoch) {
+      _stations[_index[i1].iSta]->pending.push_back(i1);
+      ++i1;
+    }
+
+    // Pacing
+    // ------
+    if (_speed > 0.0) {
+      qint64 waitMs = qint64((epoch - epoch0) * 1000.0 / _speed) - wallClock.elapsed();
+      if (waitMs > 0) {
+        msleep(waitMs);
+      }
+    }
+
+    // Simulated clock
+    // ---------------
+    BNC_CORE->setDateAndTimeGPS(t_rawChunkHeader::toDateTime(epoch));
+
+    // Decode in parallel, one task per station
+    // ----------------------------------------
+    for (int iSta = 0; iSta < _stations.size(); iSta++) {
+      if (!_stations[iSta]->pending.empty()) {
+        _pool.start(new t_task(this, _stations[iSta]));
+      }
+    }
+    _pool.waitForDone();
+
+    for (int iSta = 0; iSta < _stations.size(); iSta++) {
+      _stations[iSta]->pending.clear();
+    }
+
+    i0 = i1;
+  }
+
+  emit newMessage(QString("bncRawReplay: %1 chunks replayed in %2 s")
+                  .arg(i0).arg(wallClock.elapsed() / 1000.0, 0, 'f', 1)
+                  .toAscii(), true);
+}
+
+// Replay finished (main thread) - remove the stations
+////////////////////////////////////////////////////////////////////////////
+void bncRawReplay::slotFinished() {
+  for (int ii = 0; ii < _stations.size(); ii++) {
+    _stations[ii]->getThread->deleteLater();
+    _stations[ii]->getThread = 0;
+  }
+}
@@ -0,0 +1,98 @@
+// Part of BNC, a utility for retrieving decoding and
+// converting GNSS data streams from NTRIP broadcasters.
+//
+// Copyright (C) 2007
+// German Federal Agency for Cartography and Geodesy (BKG)
+// http://www.bkg.bund.de
+// Czech Technical University Prague, Department of Geodesy
+// http://www.fsv.cvut.cz
+//
+// Email: euref-ip@bkg.bund.de
+//
+// This program is free software; you can redistribute it and/or
+// modify it under the terms of the GNU General Public License
+// as published by the Free Software Foundation, version 2.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program; if not, write to the Free Software
+// Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA 02111-1307, USA.
+
+#ifndef BNCRAWREPLAY_H
+#define BNCRAWREPLAY_H
+
+#include <vector>
+#include <QThread>
+#include <QThreadPool>
+#include <QFile>
+
+class bncGetThread;
+
+/**
+ * Indexed replay of a BNC raw file. The file is indexed in one pass, each
+ * station is decoded by its own bncGetThread object (not started as a
+ * thread) and the chunks of one epoch are decoded in parallel on a worker
+ * pool. The simulated clock advances epoch by epoch, so that the output of
+ * each station does not depend on the number of worker threads.
+ */
+class bncRawReplay : public QThread {
+ Q_OBJECT
+
+ public:
+  /**
+   * @param fileName raw file name
+   * @param speed replay speed as multiple of real time, 0 = no pacing
+   * @param numThreads number of decoding threads, 0 = number of CPU cores
+   */
+  bncRawReplay(const QByteArray& fileName, double speed, int numThreads);
+  ~bncRawReplay();
+  int                  numStations() const {return _stations.size();}
+  QList<bncGetThread*> getThreads() const;
+  virtual void         run();
+
+ signals:
+  void newMessage(QByteArray msg, bool showOnScreen);
+
+ private slots:
+  void slotFinished();
+
+ private:
+  class t_chunk {
+   public:
+    qint64 epoch;
+    qint64 offset;
+    int    nBytes;
+    int    iSta;
+  };
+
+  class t_station {
+   public:
+    QByteArray          staID;
+    bncGetThread*       getThread;
+    std::vector<int>    pending;    // chunks of the current epoch
+  };
+
+  class t_task : public QRunnable {
+   public:
+    t_task(bncRawReplay* replay, t_station* sta) : _replay(replay), _sta(sta) {}
+    virtual void run();
+   private:
+    bncRawReplay* _replay;
+    t_station*    _sta;
+  };
+
+  bool buildIndex();
+
+  QFile                  _file;
+  const uchar*           _data;
+  double                 _speed;
+  QThreadPool            _pool;
+  std::vector<t_chunk>   _index;
+  QVector<t_station*>    _stations;
+};
+
+#endif
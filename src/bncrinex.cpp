@@ -116,6 +116,9 @@ bncRinex::bncRinex(const QByteArray& statID, const QUrl& mountPoint,
   _writeRinexFileOnlyWithSkl = settings.value("rnxOnlyWithSKL").toBool();
 
   _rnxV3 = (Qt::CheckState(settings.value("rnxV3").toInt()) == Qt::Checked) ? true : false;
+
+  _sklName = sklFileName();
+  prefetchSkeleton();
 }
 
 // Destructor
@@ -129,15 +132,134 @@ bncRinex::~bncRinex() {
   _out.close();
 }
 
+namespace {
+
+  // Skeleton files downloaded today, shared by all streams
+  // ------------------------------------------------------
+  class t_sklEntry {
+   public:
+    t_sklEntry() : _busy(false) {}
+    QDate      _date;
+    QByteArray _data;
+    bool       _busy;
+  };
+
+  QMutex                     sklMutex;
+  QWaitCondition             sklDone;
+  QMap<QString, t_sklEntry>  sklCache;
+
+  // Prefetch of skeleton files in parallel
+  // --------------------------------------
+  class t_sklPrefetch : public QRunnable {
+   public:
+    t_sklPrefetch(const QUrl& mountPoint, const QByteArray& ntripVersion)
+      : _mountPoint(mountPoint), _ntripVersion(ntripVersion) {}
+    void run() {
+      QByteArray sklData;
+      bncRinex::skeletonData(_mountPoint, _ntripVersion, sklData);
+    }
+   private:
+    QUrl       _mountPoint;
+    QByteArray _ntripVersion;
+  };
+
+  QThreadPool* sklPool() {
+    static QThreadPool* pool = 0;
+    QMutexLocker locker(&sklMutex);
+    if (!pool) {
+      pool = new QThreadPool;
+      pool->setMaxThreadCount(8);
+    }
+    return pool;
+  }
+
+  // Date of the last source-table download per caster
+  // -------------------------------------------------
+  QMutex                     tableMutex;
+  QMap<QString, QDate>       tableDate;
+}
+
 // Download Skeleton Header File
 ////////////////////////////////////////////////////////////////////////////
 t_irc bncRinex::downloadSkeleton() {
+  QByteArray sklData;
+  if (skeletonData(_mountPoint, _ntripVersion, sklData) == success) {
+    QTextStream in(sklData);
+    return _sklHeader.read(&in);
+  }
+  return failure;
+}
+
+// Skeleton file of a mountpoint, downloaded at most once a day (static)
+////////////////////////////////////////////////////////////////////////////
+t_irc bncRinex::skeletonData(const QUrl& mountPoint,
+                             const QByteArray& ntripVersion,
+                             QByteArray& sklData) {
+
+  QDate   currDate = currentDateAndTimeGPS().date();
+  QString key      = mountPoint.host() + ":" + QString::number(mountPoint.port())
+                   + mountPoint.path();
+
+  // Already downloaded (or being downloaded by another stream)
+  // ----------------------------------------------------------
+  QMutexLocker locker(&sklMutex);
+  while (sklCache[key]._busy) {
+    sklDone.wait(&sklMutex);
+  }
+  if (sklCache[key]._date == currDate) {
+    sklData = sklCache[key]._data;
+    return success;
+  }
+  sklCache[key]._busy = true;
+  locker.unlock();
+
+  t_irc irc = fetchSkeleton(mountPoint, ntripVersion, sklData);
+
+  locker.relock();
+  t_sklEntry& entry = sklCache[key];
+  entry._busy = false;
+  if (irc == success) {
+    entry._date = currDate;
+    entry._data = sklData;
+  }
+  sklDone.wakeAll();
+
+  return irc;
+}
+
+// Start the download of the skeleton file in background
+////////////////////////////////////////////////////////////////////////////
+void bncRinex::prefetchSkeleton() {
+  if (QFile::exists(_sklName) ||
+      _ntripVersion == "N" || _ntripVersion == "UN" || _ntripVersion == "S") {
+    return;
+  }
+  sklPool()->start(new t_sklPrefetch(_mountPoint, _ntripVersion));
+}
+
+// Download Skeleton Header File from the caster's skeleton directory (static)
+////////////////////////////////////////////////////////////////////////////
+t_irc bncRinex::fetchSkeleton(const QUrl& mountPoint,
+                              const QByteArray& ntripVersion,
+                              QByteArray& sklData) {
 
   t_irc irc = failure;
 
+  // Source-table is read once a day per caster (no lock during the
+  // download, the streams of other casters must not wait)
+  // --------------------------------------------------------------
+  QDate currDate = currentDateAndTimeGPS().date();
+  bool  alwaysRead;
+  {
+    QMutexLocker locker(&tableMutex);
+    alwaysRead = (tableDate.value(mountPoint.host()) != currDate);
+  }
   QStringList table;
-  bncTableDlg::getFullTable(_ntripVersion, _mountPoint.host(), _mountPoint.port(),
-      _mountPoint.userName(), _mountPoint.password(), table, true);
+  if (bncTableDlg::getFullTable(ntripVersion, mountPoint.host(), mountPoint.port(),
+        mountPoint.userName(), mountPoint.password(), table, alwaysRead) == success) {
+    QMutexLocker locker(&tableMutex);
+    tableDate[mountPoint.host()] = currDate;
+  }
   QString net;
   QStringListIterator it(table);
   while (it.hasNext()) {
@@ -145,7 +267,7 @@ t_irc bncRinex::downloadSkeleton() {
     if (line.indexOf("STR") == 0) {
       QStringList tags = line.split(";");
       if (tags.size() > 7) {
-        if (tags.at(1) == _mountPoint.path().mid(1).toAscii()) {
+        if (tags.at(1) == mountPoint.path().mid(1).toAscii()) {
           net = tags.at(7);
           break;
         }
@@ -171,9 +293,9 @@ t_irc bncRinex::downloadSkeleton() {
   if (!sklDir.isEmpty() && sklDir != "none") {
     QString staID, staIDalternative;
     QUrl url;
-    int stIdLength = _mountPoint.path().length()-2;
-    staID =            _mountPoint.path().mid(1,stIdLength).toUpper() + ".skl";
-    staIDalternative = _mountPoint.path().mid(1,stIdLength).toLower() + ".skl";
+    int stIdLength = mountPoint.path().length()-2;
+    staID =            mountPoint.path().mid(1,stIdLength).toUpper() + ".skl";
+    staIDalternative = mountPoint.path().mid(1,stIdLength).toLower() + ".skl";
     url = sklDir + "/" + staID;
     if (url.port() == -1) {
       if (sklDir.contains("https", Qt::CaseInsensitive)) {
@@ -189,16 +311,16 @@ t_irc bncRinex::downloadSkeleton() {
     query->waitForRequestResult(url, outData);
     if (query->status() == bncNetQuery::finished &&
         outData.contains("END OF HEADER")) {
-      QTextStream in(outData);
-      irc = _sklHeader.read(&in);
+      sklData = outData;
+      irc = success;
     }
     else {
       url = sklDir + "/" + staIDalternative;
       query->waitForRequestResult(url, outData);
       if (query->status() == bncNetQuery::finished &&
               outData.contains("END OF HEADER")) {
-            QTextStream in(outData);
-            irc = _sklHeader.read(&in);
+            sklData = outData;
+            irc = success;
           }
     }
     delete query;
@@ -324,9 +446,9 @@ QString bncRinex::nextEpochStr(const QDateTime& datTim,
   return epoStr;
 }
 
-// File Name according to RINEX Standards
+// Output Directory with trailing separator (static)
 ////////////////////////////////////////////////////////////////////////////
-void bncRinex::resolveFileName(const QDateTime& datTim) {
+QString bncRinex::outputPath() {
 
   bncSettings settings;
   QString path = settings.value("rnxPath").toString();
@@ -335,17 +457,16 @@ void bncRinex::resolveFileName(const QDateTime& datTim) {
   if ( path.length() > 0 && path[path.length()-1] != QDir::separator() ) {
     path += QDir::separator();
   }
+  return path;
+}
 
-  QString hlpStr = nextEpochStr(datTim, settings.value("rnxIntr").toString(),
-                                _rnxV3, &_nextCloseEpoch);
+// Check name conflict (several mountpoints of the same station)
+////////////////////////////////////////////////////////////////////////////
+QString bncRinex::distinctionStr() const {
 
-  int statIDlength = _statID.size() -1;
-  QString ID = _statID.left(statIDlength);
-  ID = ID.toUpper();
+  bncSettings settings;
 
-  // Check name conflict
-  // -------------------
-  QString distStr;
+  int statIDlength = _statID.size() -1;
   int num = 0;
   QListIterator<QString> it(settings.value("mountPoints").toStringList());
   while (it.hasNext()) {
@@ -355,12 +476,44 @@ void bncRinex::resolveFileName(const QDateTime& datTim) {
     }
   }
   if (num > 1) {
-    distStr = "_" + _statID.right(1);
+    return "_" + _statID.right(1);
   }
+  return QString();
+}
 
+// Local Skeleton File Name (empty if not used)
+////////////////////////////////////////////////////////////////////////////
+QString bncRinex::sklFileName() const {
+
+  bncSettings settings;
   QString sklExt = settings.value("rnxSkel").toString();
-  if (!sklExt.isEmpty()) {
-    _sklName = path + ID + distStr + "." + sklExt;
+  if (sklExt.isEmpty()) {
+    return QString();
+  }
+  int statIDlength = _statID.size() -1;
+  return outputPath() + _statID.left(statIDlength).toUpper() + distinctionStr()
+         + "." + sklExt;
+}
+
+// File Name according to RINEX Standards
+////////////////////////////////////////////////////////////////////////////
+void bncRinex::resolveFileName(const QDateTime& datTim) {
+
+  bncSettings settings;
+  QString path = outputPath();
+
+  QString hlpStr = nextEpochStr(datTim, settings.value("rnxIntr").toString(),
+                                _rnxV3, &_nextCloseEpoch);
+
+  int statIDlength = _statID.size() -1;
+  QString ID = _statID.left(statIDlength);
+  ID = ID.toUpper();
+
+  QString distStr = distinctionStr();
+
+  QString sklName = sklFileName();
+  if (!sklName.isEmpty()) {
+    _sklName = sklName;
   }
 
   if (_rnxV3) {
@@ -49,6 +49,9 @@ class bncRinex {
                                bool rnxV3,
                                QDateTime* nextEpoch = 0);
    static std::string asciiSatLine(const t_satObs& obs, bool outLockTime);
+   static t_irc skeletonData(const QUrl& mountPoint,
+                             const QByteArray& ntripVersion,
+                             QByteArray& sklData);
 
  private:
    void resolveFileName(const QDateTime& datTim);
@@ -56,6 +59,13 @@ class bncRinex {
    void writeHeader(const QByteArray& format, const bncTime& firstObsTime);
    void closeFile();
    t_irc downloadSkeleton();
+   void  prefetchSkeleton();
+   static t_irc fetchSkeleton(const QUrl& mountPoint,
+                              const QByteArray& ntripVersion,
+                              QByteArray& sklData);
+   static QString outputPath();
+   QString distinctionStr() const;
+   QString sklFileName() const;
 
    QByteArray      _statID;
    QByteArray      _fName;
@@ -18,8 +18,12 @@
 
 #include "bncsettings.h"
 #include "bnccore.h"
+#include "bncutils.h"
 
 QMutex bncSettings::_mutex;  // static mutex
+QAtomicPointer<const bncSettingsSnapshot> bncSettings::_snapshot;
+QAtomicInt bncSettings::_snapshotStale(1);
+QList<const bncSettingsSnapshot*> bncSettings::_retiredSnapshots;
 
 // Constructor
 ////////////////////////////////////////////////////////////////////////////
@@ -42,6 +46,8 @@ bncSettings::~bncSettings() {
 ////////////////////////////////////////////////////////////////////////////
 void bncSettings::reRead() {
 
+  _snapshotStale.fetchAndStoreOrdered(1);
+
   QSettings settings(BNC_CORE->confFileName(), QSettings::IniFormat);
 
 #ifdef GNSSCENTER_PLUGIN
@@ -76,12 +82,15 @@ void bncSettings::reRead() {
     setValue_p("proxyPort",           "");
     setValue_p("sslCaCertPath",       "");
     setValue_p("sslIgnoreErrors",     "0");
+    setValue_p("ioThreads",           "");
+    setValue_p("maxConnects",         "16");
     // General
     setValue_p("logFile",             "");
     setValue_p("rnxAppend",           "0");
     setValue_p("onTheFlyInterval",    "no");
     setValue_p("autoStart",           "0");
     setValue_p("rawOutFile",          "");
+    setValue_p("rawOutSplit",         "0");
     // RINEX Observations
     setValue_p("rnxPath",             "");
     setValue_p("rnxIntr",             "1 day");
@@ -167,6 +176,7 @@ void bncSettings::reRead() {
     setValue_p("miscIntr",            "");
     setValue_p("miscScanRTCM",        "0");
     setValue_p("miscPort",            "");
+    setValue_p("metricsPort",         "");
     // Combination
     setValue_p("cmbStreams",          "");
     setValue_p("cmbMethod",           "");
@@ -201,6 +211,7 @@ void bncSettings::reRead() {
     setValue_p("uploadEphMountpoint", "");
     setValue_p("uploadEphPassword",   "");
     setValue_p("uploadEphSample",     "5");
+    setValue_p("uploadEphPaced",      "0");
   }
 #ifdef GNSSCENTER_PLUGIN
   settings.endGroup();
@@ -232,6 +243,7 @@ void bncSettings::setValue(const QString &key, const QVariant& value) {
 ////////////////////////////////////////////////////////////////////////////
 void bncSettings::setValue_p(const QString &key, const QVariant& value) {
   BNC_CORE->_settings[key] = value;
+  _snapshotStale.fetchAndStoreOrdered(1);
 }
 
 //
@@ -239,6 +251,7 @@ void bncSettings::setValue_p(const QString &key, const QVariant& value) {
 void bncSettings::remove(const QString& key ) {
   QMutexLocker locker(&_mutex);
   BNC_CORE->_settings.remove(key);
+  _snapshotStale.fetchAndStoreOrdered(1);
 }
 
 //
@@ -267,3 +280,54 @@ void bncSettings::sync() {
 #endif
   settings.sync();
 }
+
+// Current options snapshot. Lock-free unless the options have been changed
+// since the last call. Replaced snapshots are kept until shutdown, so that
+// a pointer obtained by any thread remains valid.
+////////////////////////////////////////////////////////////////////////////
+const bncSettingsSnapshot* bncSettings::snapshot() {
+
+  if (_snapshotStale == 0) {
+    const bncSettingsSnapshot* snap = _snapshot;
+    if (snap) {
+      return snap;
+    }
+  }
+
+  bncSettings settings;
+
+  QMutexLocker locker(&_mutex);
+
+  if (_snapshotStale != 0 || _snapshot == 0) {
+    _snapshotStale.fetchAndStoreOrdered(0);
+
+    const QSettings::SettingsMap& opt = BNC_CORE->_settings;
+    bncSettingsSnapshot* snap = new bncSettingsSnapshot;
+
+    snap->rnxAppend  = Qt::CheckState(opt.value("rnxAppend").toInt()) == Qt::Checked;
+    snap->logFile    = opt.value("logFile").toString();
+    snap->outFile    = opt.value("outFile").toString();
+    snap->outPort    = opt.value("outPort").toInt();
+    snap->corrIntr   = opt.value("corrIntr").toString();
+    snap->rawOutFile = opt.value("rawOutFile").toByteArray();
+    expandEnvVar(snap->logFile);
+    expandEnvVar(snap->outFile);
+
+    const bncSettingsSnapshot* oldSnap = _snapshot.fetchAndStoreOrdered(snap);
+    if (oldSnap) {
+      _retiredSnapshots.append(oldSnap);
+    }
+  }
+
+  return _snapshot;
+}
+
+// Delete the current and all replaced snapshots
+////////////////////////////////////////////////////////////////////////////
+void bncSettings::deleteSnapshots() {
+  QMutexLocker locker(&_mutex);
+  delete _snapshot.fetchAndStoreOrdered(0);
+  qDeleteAll(_retiredSnapshots);
+  _retiredSnapshots.clear();
+  _snapshotStale.fetchAndStoreOrdered(1);
+}
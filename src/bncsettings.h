@@ -2,6 +2,22 @@
 #define BNCSETTINGS_H
 
 #include <QMutex>
+#include <QList>
+#include <QAtomicInt>
+#include <QAtomicPointer>
+#include <QString>
+
+// Immutable, typed copy of the options read on hot paths
+////////////////////////////////////////////////////////////////////////////
+class bncSettingsSnapshot {
+ public:
+  bool       rnxAppend;
+  QString    logFile;      // environment variables expanded
+  QString    outFile;      // environment variables expanded
+  int        outPort;
+  QString    corrIntr;
+  QByteArray rawOutFile;
+};
 
 class bncSettings {
  public:
@@ -14,9 +30,14 @@ class bncSettings {
   bool contains(const QString& key) const;
   void reRead(); 
   void sync();
+  static const bncSettingsSnapshot* snapshot();
+  static void deleteSnapshots();   // at shutdown, after all readers
  private:
   void setValue_p(const QString &key, const QVariant& value);
-  static QMutex _mutex;
+  static QMutex                                    _mutex;
+  static QAtomicPointer<const bncSettingsSnapshot> _snapshot;
+  static QAtomicInt                                _snapshotStale;
+  static QList<const bncSettingsSnapshot*>         _retiredSnapshots;
 };
 
 #endif
@@ -26,11 +26,17 @@ class bncSinexTro : public bncoutf {
  private:
   virtual void writeHeader(const QDateTime& datTim);
   virtual void closeFile();
+  QByteArray headerTemplate();
   QString _roverName;
   int _sampl;
+  int _intr;                    // nominal file interval [sec]
   const t_pppOptions*  _opt;
   bncAntex* _antex;
   double _antPCO[t_frequency::max];
+  std::string _ac;              // analysis center, 3 characters
+  QByteArray  _headerTemplate;  // header without the first line
+  int         _dayIndex;        // day of _dayStr (GPS days since 1980)
+  QByteArray  _dayStr;          // "yy:ddd:"
 };
 
 
@@ -5,7 +5,7 @@
  *
  * Class:      bncSP3
  *
- * Purpose:    writes SP3 files
+ * Purpose:    writes and reads SP3 files
  *
  * Author:     L. Mervart
  *
@@ -18,46 +18,23 @@
 #include <iomanip>
 #include <sstream>
 #include <math.h>
+#include <stdlib.h>
+#include <string.h>
 
 #include "bncsp3.h"
 #include "bncutils.h"
 
 using namespace std;
 
-// Constructor
-////////////////////////////////////////////////////////////////////////////
-bncSP3::bncSP3(const QString& fileName) : bncoutf(QString(), QString(), 0) {
-  _inpOut    = input;
-  _currEpoch = 0;
-  _prevEpoch = 0;
-
-  _stream.open(fileName.toAscii().data());
-  if (!_stream.good()) {
-    throw "t_sp3File: cannot open file " + fileName;
-  }
-
-  while (_stream.good()) {
-    getline(_stream, _lastLine);
-    if (_lastLine[0] == '*') {
-      break;
-    }
-  }
-}
-
 // Constructor
 ////////////////////////////////////////////////////////////////////////////
 bncSP3::bncSP3(const QString& sklFileName, const QString& intr, int sampl)
   : bncoutf(sklFileName, intr, sampl) {
-  _inpOut    = output;
-  _currEpoch = 0;
-  _prevEpoch = 0;
 }
 
 // Destructor
 ////////////////////////////////////////////////////////////////////////////
 bncSP3::~bncSP3() {
-  delete _currEpoch;
-  delete _prevEpoch;
 }
 
 // Write One Epoch
@@ -168,52 +145,403 @@ void bncSP3::writeHeader(const QDateTime& datTim) {
        << "/*                                                          \n";
 }
 
-// Read Next Epoch
+// Fixed-column fields of a line (no copy of the line)
+////////////////////////////////////////////////////////////////////////////
+static double sp3Field(const char* line, int len, int pos, int width) {
+  char buf[32];
+  int  nn = 0;
+  for (int ii = pos; ii < pos + width && ii < len && nn < 31; ii++) {
+    buf[nn++] = line[ii];
+  }
+  buf[nn] = '\0';
+  return strtod(buf, 0);
+}
+
+// Epoch header line ("*  yyyy mm dd hh mm ss.ssssssss")
+////////////////////////////////////////////////////////////////////////////
+static bncTime sp3Epoch(const char* line, int len) {
+  bncTime tt;
+  tt.set(int(sp3Field(line, len,  3, 4)), int(sp3Field(line, len,  8, 2)),
+         int(sp3Field(line, len, 11, 2)), int(sp3Field(line, len, 14, 2)),
+         int(sp3Field(line, len, 17, 2)), sp3Field(line, len, 20, 11));
+  return tt;
+}
+
+// Position record ("P"), position [m] and clock [m]; false if the record
+// is too short, the satellite unknown or the position missing
 ////////////////////////////////////////////////////////////////////////////
-const bncSP3::t_sp3Epoch* bncSP3::nextEpoch() {
+static bool sp3Position(const char* line, int len, t_prn& prn, double* xyz,
+                        double& clk, bool& clkValid) {
 
-  delete _prevEpoch; _prevEpoch = _currEpoch; _currEpoch = 0;
+  if (len < 46) {
+    return false;
+  }
 
-  if (_lastLine[0] == '*') {
-    _currEpoch = new t_sp3Epoch();
-    istringstream in(_lastLine.substr(1).c_str());
-    int    YY, MM, DD, hh, mm;
-    double ss;
-    in >> YY >> MM >> DD >> hh >> mm >> ss;
-    _currEpoch->_tt.set(YY, MM, DD, hh, mm, ss);
+  char sys = (line[1] == ' ') ? 'G' : line[1];
+  prn = t_prn(sys, int(sp3Field(line, len, 2, 2)));
+  if (prn.toIndex() < 0) {
+    return false;
   }
 
-  while (_stream.good()) {
-    getline(_stream, _lastLine);
-    if (_stream.eof() || _lastLine.find("EOF") == 0) {
-      _stream.close();
-      break;
+  xyz[0] = sp3Field(line, len,  4, 14);
+  xyz[1] = sp3Field(line, len, 18, 14);
+  xyz[2] = sp3Field(line, len, 32, 14);
+  if (xyz[0] == 0.0 && xyz[1] == 0.0 && xyz[2] == 0.0) {
+    return false;
+  }
+  for (int ii = 0; ii < 3; ii++) {
+    xyz[ii] *= 1.e3;
+  }
+
+  clk = sp3Field(line, len, 46, 14);
+  if (len < 60 || clk == 999999.999999) {
+    clk      = 0.0;
+    clkValid = false;
+  }
+  else {
+    clk     *= t_CST::c * 1.e-6;
+    clkValid = true;
+  }
+  return true;
+}
+
+// Constructor
+////////////////////////////////////////////////////////////////////////////
+bncSP3Orbits::bncSP3Orbits() {
+  for (unsigned ii = 0; ii < t_prn::NUMINDEX; ii++) {
+    _arcIndex[ii] = -1;
+  }
+}
+
+// Destructor
+////////////////////////////////////////////////////////////////////////////
+bncSP3Orbits::~bncSP3Orbits() {
+  for (unsigned ii = 0; ii < _arcs.size(); ii++) {
+    delete _arcs[ii];
+  }
+}
+
+// Read (and append) one SP3 file
+////////////////////////////////////////////////////////////////////////////
+t_irc bncSP3Orbits::readFile(const QString& fileName) {
+
+  QString fName = fileName; expandEnvVar(fName);
+  QFile file(fName);
+  if (!file.open(QIODevice::ReadOnly)) {
+    return failure;
+  }
+
+  QByteArray  data;
+  qint64      size = file.size();
+  const char* buf  = reinterpret_cast<const char*>(file.map(0, size));
+  if (!buf) {
+    data = file.readAll();
+    buf  = data.constData();
+    size = data.size();
+  }
+
+  bool        skipEpoch = true;   // before the first epoch or epoch already read
+  const char* end       = buf + size;
+  const char* line      = buf;
+  while (line < end) {
+    const char* eol = static_cast<const char*>(memchr(line, '\n', end - line));
+    if (!eol) {
+      eol = end;
     }
-    if (_lastLine[0] == '*') {
+    int len = eol - line;
+    if (len > 0 && line[len-1] == '\r') {
+      --len;
+    }
+
+    if      (len >= 3 && strncmp(line, "EOF", 3) == 0) {
       break;
     }
+    else if (len > 0 && line[0] == '*') {
+      bncTime tt = sp3Epoch(line, len);
+      skipEpoch = !_epochs.empty() && tt <= _epochs.back();
+      if (!skipEpoch) {
+        _epochs.push_back(tt);
+      }
+    }
+    else if (len > 0 && line[0] == 'P' && !skipEpoch) {
+      addSatellite(line, len);
+    }
+
+    line = eol + 1;
+  }
+
+  return success;
+}
+
+// Position record of the last epoch
+////////////////////////////////////////////////////////////////////////////
+void bncSP3Orbits::addSatellite(const char* line, int len) {
+
+  t_prn  prn;
+  double xyz[3];
+  double clk;
+  bool   clkValid;
+  if (!sp3Position(line, len, prn, xyz, clk, clkValid)) {
+    return;
+  }
+
+  int iPrn = prn.toIndex();
+  if (_arcIndex[iPrn] < 0) {
+    _arcIndex[iPrn] = _arcs.size();
+    _arcs.push_back(new t_satArc);
+    _prns.push_back(prn);
+  }
+  t_satArc* satArc = _arcs[_arcIndex[iPrn]];
+
+  unsigned nEpo = _epochs.size();
+  satArc->_xyz.resize(3 * nEpo, 0.0);
+  satArc->_clk.resize(nEpo, 0.0);
+  satArc->_flags.resize(nEpo, 0);
+
+  unsigned iEpo = nEpo - 1;
+  for (int ii = 0; ii < 3; ii++) {
+    satArc->_xyz[3*iEpo + ii] = xyz[ii];
+  }
+  satArc->_clk[iEpo]   = clk;
+  satArc->_flags[iEpo] = clkValid ? 2 : 1;
+}
+
+// Arrays of a satellite (0 if unknown)
+////////////////////////////////////////////////////////////////////////////
+const bncSP3Orbits::t_satArc* bncSP3Orbits::arc(const t_prn& prn) const {
+  int iPrn = prn.toIndex();
+  if (iPrn < 0 || _arcIndex[iPrn] < 0) {
+    return 0;
+  }
+  return _arcs[_arcIndex[iPrn]];
+}
+
+// Tabulated values
+////////////////////////////////////////////////////////////////////////////
+bool bncSP3Orbits::value(const t_prn& prn, int iEpo, ColumnVector& xyz,
+                         double& clk, bool& clkValid) const {
+  const t_satArc* satArc = arc(prn);
+  if (!satArc || iEpo < 0 || iEpo >= int(satArc->_flags.size()) ||
+      satArc->_flags[iEpo] == 0) {
+    return false;
+  }
+  xyz.ReSize(3);
+  xyz[0]   = satArc->_xyz[3*iEpo];
+  xyz[1]   = satArc->_xyz[3*iEpo + 1];
+  xyz[2]   = satArc->_xyz[3*iEpo + 2];
+  clk      = satArc->_clk[iEpo];
+  clkValid = satArc->_flags[iEpo] == 2;
+  return true;
+}
 
-    t_sp3Sat* sp3Sat = new t_sp3Sat();
-    istringstream in(_lastLine.substr(1).c_str());
-    in >> sp3Sat->_prn >> sp3Sat->_xyz(1) >> sp3Sat->_xyz(2) >> sp3Sat->_xyz(3) >> sp3Sat->_clk;
+// Index of the last epoch not later than tt (-1 if none)
+////////////////////////////////////////////////////////////////////////////
+int bncSP3Orbits::findEpoch(const bncTime& tt) const {
+  int i1 = 0;
+  int i2 = _epochs.size();
+  while (i1 < i2) {
+    int im = (i1 + i2) / 2;
+    if (_epochs[im] <= tt) {
+      i1 = im + 1;
+    }
+    else {
+      i2 = im;
+    }
+  }
+  return i1 - 1;
+}
 
-    if (sp3Sat->_xyz.norm_Frobenius() == 0.0) {
-      delete sp3Sat;
+// Interpolated values
+////////////////////////////////////////////////////////////////////////////
+t_irc bncSP3Orbits::interpolate(const t_prn& prn, const bncTime& tt,
+                                ColumnVector& xyz, double& clk,
+                                bool& clkValid, int numNodes,
+                                bool excludeTabulated) const {
+
+  const t_satArc* satArc = arc(prn);
+  int iEpo = findEpoch(tt);
+  if (!satArc || iEpo < 0 || iEpo >= int(satArc->_flags.size())) {
+    return failure;
+  }
+  int nEpo  = satArc->_flags.size();
+  int iSkip = (excludeTabulated && _epochs[iEpo] == tt) ? iEpo : -1;
+
+  // Nodes centered around tt, all with position (window of nWin epochs,
+  // the skipped one included)
+  // -------------------------------------------------------------------
+  const int maxNodes = 20;
+  if (numNodes > maxNodes) {
+    numNodes = maxNodes;
+  }
+  int nWin = numNodes + (iSkip >= 0 ? 1 : 0);
+  if (nWin > nEpo) {
+    nWin     = nEpo;
+    numNodes = nWin - (iSkip >= 0 ? 1 : 0);
+  }
+  if (numNodes < 2) {
+    return failure;
+  }
+  int i0 = iEpo - nWin / 2 + 1;
+  if (i0 < 0) {
+    i0 = 0;
+  }
+  if (i0 + nWin > nEpo) {
+    i0 = nEpo - nWin;
+  }
+  if (tt > _epochs[i0 + nWin - 1] || iSkip == i0 || iSkip == i0 + nWin - 1) {
+    return failure;
+  }
+  int    idx[maxNodes];
+  double dt[maxNodes];
+  int    nn = 0;
+  for (int ii = i0; ii < i0 + nWin; ii++) {
+    if (ii == iSkip) {
       continue;
     }
+    if (satArc->_flags[ii] == 0) {
+      return failure;
+    }
+    idx[nn] = ii;
+    dt[nn]  = tt - _epochs[ii];
+    ++nn;
+  }
 
-    sp3Sat->_xyz *= 1.e3;
-    if (sp3Sat->_clk == 999999.999999) {
-      sp3Sat->_clkValid = false;
-      sp3Sat->_clk      = 0.0;
+  // Lagrange polynomial
+  // -------------------
+  xyz.ReSize(3);
+  xyz = 0.0;
+  for (int jj = 0; jj < nn; jj++) {
+    double ll = 1.0;
+    for (int mm = 0; mm < nn; mm++) {
+      if (mm != jj) {
+        ll *= dt[mm] / (dt[mm] - dt[jj]);
+      }
     }
-    else {
-      sp3Sat->_clkValid = true;
-      sp3Sat->_clk *= t_CST::c * 1.e-6;
+    for (int ii = 0; ii < 3; ii++) {
+      xyz[ii] += ll * satArc->_xyz[3*idx[jj] + ii];
     }
+  }
+
+  // Clock (tabulated or linear between the neighbouring epochs)
+  // -----------------------------------------------------------
+  clk      = 0.0;
+  clkValid = false;
+  int iLow = (iSkip >= 0) ? iEpo - 1 : iEpo;
+  if (iSkip < 0 && _epochs[iEpo] == tt) {
+    clkValid = satArc->_flags[iEpo] == 2;
+    clk      = satArc->_clk[iEpo];
+  }
+  else if (iLow >= 0 && iEpo + 1 < nEpo &&
+           satArc->_flags[iLow] == 2 && satArc->_flags[iEpo + 1] == 2) {
+    double t1 = tt - _epochs[iLow];
+    double t2 = tt - _epochs[iEpo + 1];
+    clkValid  = true;
+    clk       = (satArc->_clk[iLow] * t2 - satArc->_clk[iEpo + 1] * t1) / (t2 - t1);
+  }
+  if (!clkValid) {
+    clk = 0.0;
+  }
 
-    _currEpoch->_sp3Sat.push_back(sp3Sat);
+  return success;
+}
+
+// Constructor
+////////////////////////////////////////////////////////////////////////////
+bncSP3Reader::bncSP3Reader(const QString& fileName) : _file(fileName) {
+  _haveLine = false;
+  _atEnd    = !_file.open(QIODevice::ReadOnly);
+  _xyz.resize(3 * t_prn::NUMINDEX, 0.0);
+  _clk.resize(t_prn::NUMINDEX, 0.0);
+  _flags.resize(t_prn::NUMINDEX, 0);
+}
+
+// Destructor
+////////////////////////////////////////////////////////////////////////////
+bncSP3Reader::~bncSP3Reader() {
+}
+
+// Next line without the line end, false at the end of the file
+////////////////////////////////////////////////////////////////////////////
+bool bncSP3Reader::readLine() {
+  if (_file.atEnd()) {
+    return false;
+  }
+  _line = _file.readLine();
+  while (_line.endsWith('\n') || _line.endsWith('\r')) {
+    _line.chop(1);
+  }
+  if (_line.startsWith("EOF")) {
+    _file.close();
+    return false;
+  }
+  return true;
+}
+
+// Read the next epoch
+////////////////////////////////////////////////////////////////////////////
+bool bncSP3Reader::nextEpoch() {
+
+  for (unsigned ii = 0; ii < _prns.size(); ii++) {
+    _flags[_prns[ii].toIndex()] = 0;
+  }
+  _prns.clear();
+
+  if (_atEnd) {
+    return false;
+  }
+
+  // Epoch header (skip the file header)
+  // -----------------------------------
+  while (!_haveLine || !_line.startsWith('*')) {
+    if (!readLine()) {
+      _atEnd = true;
+      return false;
+    }
+    _haveLine = true;
+  }
+  _epoch    = sp3Epoch(_line.constData(), _line.size());
+  _haveLine = false;
+
+  // Position records up to the next epoch
+  // -------------------------------------
+  while (readLine()) {
+    if (_line.startsWith('*')) {
+      _haveLine = true;
+      break;
+    }
+    t_prn  prn;
+    double xyz[3];
+    double clk;
+    bool   clkValid;
+    if (_line.startsWith('P') &&
+        sp3Position(_line.constData(), _line.size(), prn, xyz, clk, clkValid)) {
+      int iPrn = prn.toIndex();
+      if (_flags[iPrn] == 0) {
+        _prns.push_back(prn);
+      }
+      for (int ii = 0; ii < 3; ii++) {
+        _xyz[3*iPrn + ii] = xyz[ii];
+      }
+      _clk[iPrn]   = clk;
+      _flags[iPrn] = clkValid ? 2 : 1;
+    }
   }
+  return true;
+}
 
-  return _currEpoch;
+// Values of the current epoch
+////////////////////////////////////////////////////////////////////////////
+bool bncSP3Reader::value(const t_prn& prn, ColumnVector& xyz, double& clk,
+                         bool& clkValid) const {
+  int iPrn = prn.toIndex();
+  if (iPrn < 0 || _flags[iPrn] == 0) {
+    return false;
+  }
+  xyz.ReSize(3);
+  xyz[0]   = _xyz[3*iPrn];
+  xyz[1]   = _xyz[3*iPrn + 1];
+  xyz[2]   = _xyz[3*iPrn + 2];
+  clk      = _clk[iPrn];
+  clkValid = _flags[iPrn] == 2;
+  return true;
 }
@@ -2,6 +2,7 @@
 #define BNCSP3_H
 
 #include <fstream>
+#include <vector>
 #include <newmat.h>
 #include <QtCore>
 
@@ -12,55 +13,97 @@
 class bncSP3 : public bncoutf {
  public:
 
-  class t_sp3Sat {
-   public:
-    t_sp3Sat() {
-      _xyz.ReSize(3); 
-      _xyz      = 0.0;
-      _clk      = 0.0;
-      _clkValid = false;
-    }
-    ~t_sp3Sat() {}
-    t_prn        _prn;
-    ColumnVector _xyz;
-    double       _clk;
-    bool         _clkValid;
-  };
-
-  class t_sp3Epoch {
-   public:
-    t_sp3Epoch() {}
-    ~t_sp3Epoch() {
-      for (int ii = 0; ii < _sp3Sat.size(); ii++) {
-        delete _sp3Sat[ii];
-      }
-    }
-    bncTime            _tt;
-    QVector<t_sp3Sat*> _sp3Sat;
-  };
-
-  bncSP3(const QString& fileName); // input
   bncSP3(const QString& sklFileName, const QString& intr, int sampl); // output
   virtual ~bncSP3();
   t_irc write(int GPSweek, double GPSweeks, const QString& prn, 
               const ColumnVector& xCoM, double sp3Clk,
               const ColumnVector& v, double sp3ClkRate);
-  const t_sp3Epoch* nextEpoch();
-  const t_sp3Epoch* currEpoch() const {return _currEpoch;}
-  const t_sp3Epoch* prevEpoch() const {return _prevEpoch;}
 
  private:
-  enum e_inpOut {input, output};
-
   virtual void writeHeader(const QDateTime& datTim);
   virtual void closeFile();
 
-  e_inpOut      _inpOut;
-  bncTime       _lastEpoTime;
-  std::ifstream _stream;
-  std::string   _lastLine;
-  t_sp3Epoch*   _currEpoch;
-  t_sp3Epoch*   _prevEpoch;
+  bncTime _lastEpoTime;
+};
+
+/**
+ * SP3 file(s) held in memory for random access. The file is mapped and
+ * parsed by fixed columns, the positions and clocks of each satellite are
+ * stored in arrays over the common epoch list. Several files (e.g. one per
+ * day) can be read one after the other, epochs already read are skipped.
+ */
+class bncSP3Orbits {
+ public:
+  bncSP3Orbits();
+  ~bncSP3Orbits();
+  t_irc                     readFile(const QString& fileName);
+  int                       numEpochs() const {return _epochs.size();}
+  const bncTime&            epoch(int iEpo) const {return _epochs[iEpo];}
+  const std::vector<t_prn>& prns() const {return _prns;}
+
+  /** Tabulated position [m] and clock [m] of epoch iEpo */
+  bool value(const t_prn& prn, int iEpo, ColumnVector& xyz,
+             double& clk, bool& clkValid) const;
+
+  /**
+   * Position interpolated at an arbitrary epoch (Lagrange polynomial over
+   * numNodes epochs around tt, no extrapolation), clock interpolated
+   * linearly between the neighbouring epochs. With excludeTabulated a
+   * tabulated epoch tt is not used itself (check of the interpolation).
+   */
+  t_irc interpolate(const t_prn& prn, const bncTime& tt, ColumnVector& xyz,
+                    double& clk, bool& clkValid, int numNodes = 10,
+                    bool excludeTabulated = false) const;
+
+ private:
+  class t_satArc {
+   public:
+    std::vector<double> _xyz;     // 3 values per epoch
+    std::vector<double> _clk;
+    std::vector<char>   _flags;   // per epoch: 0 = none, 1 = position, 2 = position and clock
+  };
+
+  void    addSatellite(const char* line, int len);
+  int     findEpoch(const bncTime& tt) const;
+  const t_satArc* arc(const t_prn& prn) const;
+
+  std::vector<bncTime>   _epochs;
+  std::vector<t_prn>     _prns;
+  std::vector<t_satArc*> _arcs;
+  int                    _arcIndex[t_prn::NUMINDEX];
+};
+
+/**
+ * Sequential SP3 reader, only the current epoch is held in memory (long
+ * files of high-rate products). Same parser as bncSP3Orbits.
+ */
+class bncSP3Reader {
+ public:
+  bncSP3Reader(const QString& fileName);
+  ~bncSP3Reader();
+
+  /** Read the next epoch, false at the end of the file */
+  bool                      nextEpoch();
+  bool                      atEnd() const {return _atEnd;}
+  const bncTime&            epoch() const {return _epoch;}
+  const std::vector<t_prn>& prns() const {return _prns;}
+
+  /** Position [m] and clock [m] of the current epoch */
+  bool value(const t_prn& prn, ColumnVector& xyz, double& clk,
+             bool& clkValid) const;
+
+ private:
+  bool readLine();
+
+  QFile               _file;
+  QByteArray          _line;
+  bool                _haveLine;  // _line is the header of the next epoch
+  bool                _atEnd;
+  bncTime             _epoch;
+  std::vector<t_prn>  _prns;
+  std::vector<double> _xyz;       // 3 values per satellite index
+  std::vector<double> _clk;
+  std::vector<char>   _flags;     // 0 = none, 1 = position, 2 = position and clock
 };
 
 #endif
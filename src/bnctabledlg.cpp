@@ -201,6 +201,8 @@ t_irc bncTableDlg::getFullTable(const QString& ntripVersion,
   static QMutex mutex;
   static QMap<QString, QStringList> allTables;
 
+  // Lock the cache only, not the download
+  // -------------------------------------
   QMutexLocker locker(&mutex);
 
   if (!alwaysRead && allTables.find(casterHost) != allTables.end()) {
@@ -208,6 +210,8 @@ t_irc bncTableDlg::getFullTable(const QString& ntripVersion,
     return success;
   }
 
+  locker.unlock();
+
   allLines.clear();
 
   bncNetQuery* query = 0;
@@ -242,6 +246,7 @@ t_irc bncTableDlg::getFullTable(const QString& ntripVersion,
       allLines.append(line);
       line = in.readLine();
     }
+    locker.relock();
     allTables.insert(casterHost, allLines);
     delete query;
     return success;
@@ -0,0 +1,188 @@
+/* -------------------------------------------------------------------------
+ * BKG NTRIP Client
+ * -------------------------------------------------------------------------
+ *
+ * Class:      bncUdpReceiver
+ *
+ * Purpose:    Batched receive of UDP/RTP datagrams
+ *
+ * Changes:
+ *
+ * -----------------------------------------------------------------------*/
+
+#include <algorithm>
+#include <vector>
+#include <string.h>
+
+#include "bncudpreceiver.h"
+
+#ifdef Q_OS_LINUX
+#include <sys/socket.h>
+#endif
+
+using namespace std;
+
+// Constructor
+////////////////////////////////////////////////////////////////////////////
+bncUdpReceiver::bncUdpReceiver(bool rtp) {
+  _rtp = rtp;
+  _ring.resize(MAXBATCH * SLOTSIZE);
+  reset();
+}
+
+//
+////////////////////////////////////////////////////////////////////////////
+void bncUdpReceiver::reset() {
+  _seqValid = false;
+  _nextSeq  = 0;
+  _numLost  = 0;
+}
+
+//
+////////////////////////////////////////////////////////////////////////////
+int bncUdpReceiver::takeNumLost() {
+  int numLost = _numLost;
+  _numLost = 0;
+  return numLost;
+}
+
+// RTP sequence number
+////////////////////////////////////////////////////////////////////////////
+quint16 bncUdpReceiver::seq(int iDgr) const {
+  const unsigned char* header = reinterpret_cast<const unsigned char*>(_data[iDgr]);
+  return quint16((header[2] << 8) | header[3]);
+}
+
+// Read the pending datagrams
+////////////////////////////////////////////////////////////////////////////
+t_irc bncUdpReceiver::read(QUdpSocket* socket, QByteArray& outData, int maxNum) {
+
+  // First datagram by QUdpSocket (enables its read notification again)
+  // ------------------------------------------------------------------
+  qint64 size = socket->pendingDatagramSize();
+  if (size < 0) {
+    return success;
+  }
+  _first.resize(size);
+  size = socket->readDatagram(_first.data(), size);
+  if (size < 0) {
+    return success;
+  }
+  int numDgr = 0;
+  _data[numDgr] = _first.constData();
+  _size[numDgr] = size;
+  ++numDgr;
+
+  // Further datagrams into the ring
+  // -------------------------------
+  maxNum = qMin(maxNum, int(MAXBATCH));
+#ifdef Q_OS_LINUX
+  if (maxNum > 1) {
+    struct mmsghdr msgs[MAXBATCH];
+    struct iovec   iovs[MAXBATCH];
+    memset(msgs, 0, sizeof(msgs));
+    int numMsg = maxNum - 1;
+    for (int ii = 0; ii < numMsg; ii++) {
+      iovs[ii].iov_base = _ring.data() + ii * SLOTSIZE;
+      iovs[ii].iov_len  = SLOTSIZE;
+      msgs[ii].msg_hdr.msg_iov    = &iovs[ii];
+      msgs[ii].msg_hdr.msg_iovlen = 1;
+    }
+    int numRecv = recvmmsg(socket->socketDescriptor(), msgs, numMsg,
+                           MSG_DONTWAIT, 0);
+    for (int ii = 0; ii < numRecv; ii++) {
+      if (msgs[ii].msg_hdr.msg_flags & MSG_TRUNC) {
+        if (!_rtp) {
+          ++_numLost;  // RTP: counted as a gap in the sequence
+        }
+        continue;
+      }
+      _data[numDgr] = static_cast<const char*>(iovs[ii].iov_base);
+      _size[numDgr] = msgs[ii].msg_len;
+      ++numDgr;
+    }
+  }
+#else
+  while (numDgr < maxNum && socket->hasPendingDatagrams() &&
+         socket->pendingDatagramSize() <= SLOTSIZE) {
+    char* slot = _ring.data() + (numDgr - 1) * SLOTSIZE;
+    size = socket->readDatagram(slot, SLOTSIZE);
+    if (size < 0) {
+      break;
+    }
+    _data[numDgr] = slot;
+    _size[numDgr] = size;
+    ++numDgr;
+  }
+#endif
+
+  // Plain UDP: arrival order
+  // ------------------------
+  if (!_rtp) {
+    for (int ii = 0; ii < numDgr; ii++) {
+      outData.append(_data[ii], _size[ii]);
+    }
+    return success;
+  }
+
+  // RTP: datagrams without payload
+  // ------------------------------
+  t_irc irc = success;
+  vector<int> valid;
+  for (int ii = 0; ii < numDgr; ii++) {
+    if (_size[ii] > RTPHEADER) {
+      valid.push_back(ii);
+    }
+    else {
+      irc = failure;
+    }
+  }
+  if (valid.empty()) {
+    return irc;
+  }
+
+  // Sequence numbers relative to the next expected one; if all are out of
+  // range the sender has restarted and a new session begins
+  // ----------------------------------------------------------------------
+  vector<pair<int, int> > order;   // relative sequence number, datagram
+  bool newSession = !_seqValid;
+  for (int iPass = 0; iPass < 2; iPass++) {
+    if (newSession) {
+      _nextSeq  = quint16(seq(valid[0]) - MAXMISORDER);
+      _seqValid = true;
+    }
+    bool inRange = false;
+    order.clear();
+    for (unsigned ii = 0; ii < valid.size(); ii++) {
+      int delta = qint16(seq(valid[ii]) - _nextSeq);
+      if (delta >= 0 && delta < MAXDROPOUT) {
+        order.push_back(make_pair(delta, valid[ii]));
+      }
+      if (delta >= -MAXMISORDER && delta < MAXDROPOUT) {
+        inRange = true;
+      }
+    }
+    if (inRange || newSession) {
+      break;
+    }
+    newSession = true;
+  }
+
+  // Sequence order, duplicates skipped, gaps counted
+  // ------------------------------------------------
+  sort(order.begin(), order.end());
+  int expected = (newSession && !order.empty()) ? order[0].first : 0;
+  for (unsigned ii = 0; ii < order.size(); ii++) {
+    int delta = order[ii].first;
+    int iDgr  = order[ii].second;
+    if (delta < expected) {
+      continue;
+    }
+    _numLost += delta - expected;
+    outData.append(_data[iDgr] + RTPHEADER, _size[iDgr] - RTPHEADER);
+    expected = delta + 1;
+  }
+  _nextSeq = quint16(_nextSeq + expected);
+
+  return irc;
+}
@@ -0,0 +1,50 @@
+#ifndef BNCUDPRECEIVER_H
+#define BNCUDPRECEIVER_H
+
+#include <QtNetwork>
+#include "bncconst.h"
+
+/**
+ * Batched receive of the datagrams of a UDP query. All datagrams pending
+ * at a wake-up (MAXBATCH at most) are read into a ring of reusable slots,
+ * on Linux by a single recvmmsg call, and returned as one block. With RTP
+ * headers the datagrams of a batch are put in sequence order, duplicates
+ * and late datagrams are dropped and gaps in the sequence are counted.
+ */
+class bncUdpReceiver {
+ public:
+  bncUdpReceiver(bool rtp);
+
+  /** New session, the sequence numbers start again */
+  void  reset();
+
+  /**
+   * Append the payload of the pending datagrams (maxNum at most) to
+   * outData, failure if a datagram has no RTP payload
+   */
+  t_irc read(QUdpSocket* socket, QByteArray& outData, int maxNum = MAXBATCH);
+
+  /** Datagrams lost since the last call */
+  int   takeNumLost();
+
+  static const int MAXBATCH = 32;     // datagrams read at one wake-up
+  static const int SLOTSIZE = 4096;   // larger ones are lost unless first
+
+ private:
+  static const int RTPHEADER   = 12;
+  static const int MAXMISORDER = 100;   // RFC 3550, A.1
+  static const int MAXDROPOUT  = 3000;
+
+  quint16 seq(int iDgr) const;
+
+  bool        _rtp;
+  QByteArray  _ring;              // MAXBATCH slots
+  QByteArray  _first;             // first datagram of a batch
+  const char* _data[MAXBATCH];
+  int         _size[MAXBATCH];
+  bool        _seqValid;
+  quint16     _nextSeq;
+  int         _numLost;
+};
+
+#endif
@@ -40,6 +40,8 @@
 
 #include <iostream>
 #include <ctime>
+#include <cstdio>
+#include <cstring>
 #include <math.h>
 
 #include <QRegExp>
@@ -894,40 +896,49 @@ QString fortranFormat(double value, int width, int prec) {
   }
 }
 
-//
-//////////////////////////////////////////////////////////////////////////////
-void kalman(const Matrix& AA, const ColumnVector& ll, const DiagonalMatrix& PP,
-            SymmetricMatrix& QQ, ColumnVector& xx) {
-
-  Tracer tracer("kalman");
-
-  int nPar = AA.Ncols();
-  int nObs = AA.Nrows();
-  UpperTriangularMatrix SS = Cholesky(QQ).t();
-
-  Matrix SA = SS*AA.t();
-  Matrix SRF(nObs+nPar, nObs+nPar); SRF = 0;
-  for (int ii = 1; ii <= nObs; ++ii) {
-    SRF(ii,ii) = 1.0 / sqrt(PP(ii,ii));
+// Fixed-point number right-aligned in width characters (as "%*.*f"),
+// no terminating zero, returns the number of characters
+////////////////////////////////////////////////////////////////////////////
+int fixedFormat(char* buf, double value, int width, int prec) {
+  static const double scales[] = {1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7, 1e8, 1e9};
+  double scaled = (prec < 0 || prec > 9) ? 0.0 : fabs(value) * scales[prec];
+  double frac    = scaled - floor(scaled);
+
+  // Large numbers and (nearly) exact halves are left to the C library
+  // ------------------------------------------------------------------
+  if (prec < 0 || prec > 9 || !(scaled < 1e12) ||
+      fabs(frac - 0.5) < 4e-16 * scaled + 1e-12) {
+    char hlp[400];
+    int  len = snprintf(hlp, sizeof(hlp), "%*.*f", width, prec, value);
+    len = qBound(0, len, int(sizeof(hlp)) - 1);
+    memcpy(buf, hlp, len);
+    return len;
   }
-
-  SRF.SubMatrix   (nObs+1, nObs+nPar, 1, nObs) = SA;
-  SRF.SymSubMatrix(nObs+1, nObs+nPar)          = SS;
-
-  UpperTriangularMatrix UU;
-  QRZ(SRF, UU);
-
-  SS = UU.SymSubMatrix(nObs+1, nObs+nPar);
-  UpperTriangularMatrix SH_rt = UU.SymSubMatrix(1, nObs);
-  Matrix YY  = UU.SubMatrix(1, nObs, nObs+1, nObs+nPar);
-
-  UpperTriangularMatrix SHi = SH_rt.i();
-
-  Matrix KT  = SHi * YY;
-  SymmetricMatrix Hi; Hi << SHi * SHi.t();
-
-  xx += KT.t() * (ll - AA * xx);
-  QQ << (SS.t() * SS);
+  unsigned long long ival = (unsigned long long)(floor(scaled + 0.5));
+  char digits[32];
+  int  nDig = 0;
+  for (int ii = 0; ii < prec; ii++) {
+    digits[nDig++] = char('0' + ival % 10);
+    ival /= 10;
+  }
+  if (prec > 0) {
+    digits[nDig++] = '.';
+  }
+  do {
+    digits[nDig++] = char('0' + ival % 10);
+    ival /= 10;
+  } while (ival > 0);
+  if (value < 0.0) {
+    digits[nDig++] = '-';
+  }
+  int len = 0;
+  while (len < width - nDig) {
+    buf[len++] = ' ';
+  }
+  while (nDig > 0) {
+    buf[len++] = digits[--nDig];
+  }
+  return len;
 }
 
 double accuracyFromIndex(int index, t_eph::e_type type) {
@@ -196,8 +196,7 @@ void         deg2DMS(double decDeg, int& deg, int& min, double& sec);
 
 QString      fortranFormat(double value, int width, int prec);
 
-void         kalman(const Matrix& AA, const ColumnVector& ll, const DiagonalMatrix& PP,
-                    SymmetricMatrix& QQ, ColumnVector& xx);
+int          fixedFormat(char* buf, double value, int width, int prec);
 
 double       djul(long j1, long m1, double tt);
 
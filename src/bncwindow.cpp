@@ -176,11 +176,16 @@ bncWindow::bncWindow() {
   _sslIgnoreErrorsCheckBox = new QCheckBox();
   _sslIgnoreErrorsCheckBox->setCheckState(Qt::CheckState(
                                           settings.value("sslIgnoreErrors").toInt()));
+  _ioThreadsLineEdit       = new QLineEdit(settings.value("ioThreads").toString());
+  _maxConnectsLineEdit     = new QLineEdit(settings.value("maxConnects").toString());
 
   // General Options
   // ---------------
   _logFileLineEdit    = new QLineEdit(settings.value("logFile").toString());
   _rawOutFileLineEdit = new QLineEdit(settings.value("rawOutFile").toString());
+  _rawOutSplitCheckBox = new QCheckBox();
+  _rawOutSplitCheckBox->setCheckState(Qt::CheckState(
+                                      settings.value("rawOutSplit").toInt()));
   _rnxAppendCheckBox  = new QCheckBox();
   _rnxAppendCheckBox->setCheckState(Qt::CheckState(
                                     settings.value("rnxAppend").toInt()));
@@ -384,6 +389,7 @@ bncWindow::bncWindow() {
   // ---------------------
   _miscMountLineEdit  = new QLineEdit(settings.value("miscMount").toString());
   _miscPortLineEdit   = new QLineEdit(settings.value("miscPort").toString());
+  _metricsPortLineEdit = new QLineEdit(settings.value("metricsPort").toString());
   _miscIntrComboBox   = new QComboBox();
   _miscIntrComboBox->setEditable(false);
   _miscIntrComboBox->addItems(QString(",2 sec,10 sec,1 min,5 min,15 min,1 hour,6 hours,1 day").split(","));
@@ -576,6 +582,9 @@ bncWindow::bncWindow() {
   _uploadEphSampleSpinBox->setMaximumWidth(9*ww);
   _uploadEphSampleSpinBox->setValue(settings.value("uploadEphSample").toInt());
   _uploadEphSampleSpinBox->setSuffix(" sec");
+  _uploadEphPacedCheckBox      = new QCheckBox();
+  _uploadEphPacedCheckBox->setCheckState(Qt::CheckState(
+                                    settings.value("uploadEphPaced").toInt()));
   _uploadEphBytesCounter       = new bncBytesCounter;
 
   // Canvas with Editable Fields
@@ -636,6 +645,8 @@ bncWindow::bncWindow() {
   QGridLayout* pLayout = new QGridLayout;
   pLayout->setColumnMinimumWidth(0,13*ww);
   _proxyPortLineEdit->setMaximumWidth(9*ww);
+  _ioThreadsLineEdit->setMaximumWidth(9*ww);
+  _maxConnectsLineEdit->setMaximumWidth(9*ww);
 
   pLayout->addWidget(new QLabel("Settings for proxy in protected networks and for SSL authorization, leave boxes blank if none.<br>"),0, 0, 1, 50);
   pLayout->addWidget(new QLabel("Proxy host"),                               1, 0);
@@ -647,8 +658,12 @@ bncWindow::bncWindow() {
   pLayout->addWidget(new QLabel("Default:  " + bncSslConfig::defaultPath()), 3,11, 1,20);
   pLayout->addWidget(new QLabel("Ignore SSL authorization errors"),          4, 0);
   pLayout->addWidget(_sslIgnoreErrorsCheckBox,                               4, 1, 1,10);
-  pLayout->addWidget(new QLabel(""),                                         5, 1);
-  pLayout->setRowStretch(6, 999);
+  pLayout->addWidget(new QLabel("I/O threads"),                              5, 0);
+  pLayout->addWidget(_ioThreadsLineEdit,                                     5, 1);
+  pLayout->addWidget(new QLabel("Max connection attempts"),                  6, 0);
+  pLayout->addWidget(_maxConnectsLineEdit,                                   6, 1);
+  pLayout->addWidget(new QLabel(""),                                         7, 1);
+  pLayout->setRowStretch(8, 999);
 
   pgroup->setLayout(pLayout);
 
@@ -669,8 +684,10 @@ bncWindow::bncWindow() {
   gLayout->addWidget(_autoStartCheckBox,                         4, 1);
   gLayout->addWidget(new QLabel("Raw output file (full path)"),  5, 0);
   gLayout->addWidget(_rawOutFileLineEdit,                        5, 1, 1,20);
-  gLayout->addWidget(new QLabel(""),                             6, 1);
-  gLayout->setRowStretch(7, 999);
+  gLayout->addWidget(new QLabel("Raw output file per stream"),   6, 0);
+  gLayout->addWidget(_rawOutSplitCheckBox,                       6, 1);
+  gLayout->addWidget(new QLabel(""),                             7, 1);
+  gLayout->setRowStretch(8, 999);
 
   ggroup->setLayout(gLayout);
 
@@ -838,6 +855,7 @@ bncWindow::bncWindow() {
   rLayout->setColumnMinimumWidth(0,14*ww);
   _miscIntrComboBox->setMaximumWidth(9*ww);
   _miscPortLineEdit->setMaximumWidth(9*ww);
+  _metricsPortLineEdit->setMaximumWidth(9*ww);
 
   rLayout->addWidget(new QLabel("Log latencies or scan RTCM streams for message types and antenna information or output raw data through TCP/IP port.<br>"),0, 0,1,50);
   rLayout->addWidget(new QLabel("Mountpoint"),                    1, 0);
@@ -848,8 +866,10 @@ bncWindow::bncWindow() {
   rLayout->addWidget(_miscScanRTCMCheckBox,                       3, 1);
   rLayout->addWidget(new QLabel("Port"),                          4, 0);
   rLayout->addWidget(_miscPortLineEdit,                           4, 1);
-  rLayout->addWidget(new QLabel(""),                              5, 1);
-  rLayout->setRowStretch(6, 999);
+  rLayout->addWidget(new QLabel("Metrics port"),                  5, 0);
+  rLayout->addWidget(_metricsPortLineEdit,                        5, 1);
+  rLayout->addWidget(new QLabel(""),                              6, 1);
+  rLayout->setRowStretch(7, 999);
 
   rgroup->setLayout(rLayout);
 
@@ -902,6 +922,8 @@ bncWindow::bncWindow() {
   pppLayout1->addWidget(new QLabel("   SNX TRO sampling"),   ir, 5);
   pppLayout1->addWidget(_pppWidgets._snxtroSampl,            ir, 6, Qt::AlignRight);
   ++ir;
+  pppLayout1->addWidget(new QLabel("Binary directory"),      ir, 0);
+  pppLayout1->addWidget(_pppWidgets._resultPath,             ir, 1);
   pppLayout1->addWidget(new QLabel("   SNX TRO AC"),         ir, 3);
   pppLayout1->addWidget(_pppWidgets._snxtroAc,               ir, 4);
   pppLayout1->addWidget(new QLabel("   SNX TRO solution")    ,ir, 5);
@@ -983,6 +1005,9 @@ bncWindow::bncWindow() {
   pppLayout4->addWidget(new QLabel("Mountpoint"),                        ir, 2, 1, 10, Qt::AlignLeft);
   pppLayout4->addWidget(_pppWidgets._audioResponse,                      ir, 4, Qt::AlignLeft);
   pppLayout4->addWidget(new QLabel("Audio response"),                    ir, 5, Qt::AlignRight);
+  ++ir;
+  pppLayout4->addWidget(new QLabel("Plot frame rate"),                   ir, 0, Qt::AlignLeft);
+  pppLayout4->addWidget(_pppWidgets._plotFrameRate,                      ir, 1, Qt::AlignLeft);
 
   ++ir;
   pppLayout4->addWidget(new QLabel("Track map"),                         ir, 0, Qt::AlignLeft);
@@ -1204,6 +1229,8 @@ bncWindow::bncWindow() {
   uploadLayoutEph->addWidget(_uploadEphPasswordLineEdit,          2, 3);
   uploadLayoutEph->addWidget(new QLabel("Sampling"),              3, 0);
   uploadLayoutEph->addWidget(_uploadEphSampleSpinBox,             3, 1);
+  uploadLayoutEph->addWidget(new QLabel("          Paced"),       3, 2, Qt::AlignRight);
+  uploadLayoutEph->addWidget(_uploadEphPacedCheckBox,             3, 3);
   uploadLayoutEph->addWidget(new QLabel("Uploaded"),              4, 0);
   uploadLayoutEph->addWidget(_uploadEphBytesCounter,              4, 1);
   uploadLayoutEph->setRowStretch(5, 999);
@@ -1230,6 +1257,8 @@ bncWindow::bncWindow() {
   _proxyPortLineEdit->setWhatsThis(tr("<p>Enter your proxy server port number in case a proxy is operated in front of BNC.</p>"));
   _sslCaCertPathLineEdit->setWhatsThis(tr("<p>Communication with an Ntrip Broadcaster over SSL requires the exchange of client and/or server certificates. Specify the path to a directory where you save certificates on your system. Don't try communication via SSL if you are not sure whether this is supported by the involved Ntrip Broadcaster.</p><p>Note that SSL communication is usually done over port 443.</p>"));
   _sslIgnoreErrorsCheckBox->setWhatsThis(tr("<p>SSL communication may involve queries coming from the Ntrip Broadcaster. Tick 'Ignore SSL authorization errors' if you don't want to be bothered with this.</p>"));
+  _ioThreadsLineEdit->setWhatsThis(tr("<p>By default BNC reads every stream in a thread of its own. When pulling hundreds of streams, enter a small number of I/O threads here to read all streams event-driven; decoding is then done by one thread per CPU core.</p><p>Streams from a serial port, streams which need NMEA input and raw files are still read by a thread of their own. Default is an empty option field, meaning one thread per stream.</p>"));
+  _maxConnectsLineEdit->setWhatsThis(tr("<p>Specify the maximum number of streams trying to connect at the same time. Reconnects are delayed by a randomized, exponentially increasing interval (max. 256 sec) so that the streams of a restarted Ntrip Broadcaster do not all reconnect at once.</p><p>Default is '16'.</p>"));
 
   // WhatsThis, General
   // ------------------
@@ -1238,6 +1267,7 @@ bncWindow::bncWindow() {
   _onTheFlyComboBox->setWhatsThis(tr("<p>When operating BNC online in 'no window' mode, some configuration parameters can be changed on-the-fly without interrupting the running process. For that BNC rereads parts of its configuration in pre-defined intervals.<p></p>Select '1 min', '5 min', '1 hour', or '1 day' to force BNC to reread its configuration every full minute, five minutes, hour, or day and let in between edited configuration options become effective on-the-fly without terminating uninvolved threads.</p><p>Note that when operating BNC in window mode, on-the-fly changeable configuration options become effective immediately via button 'Save & Reread Configuration'.</p>"));
   _autoStartCheckBox->setWhatsThis(tr("<p>Tick 'Auto start' for auto-start of BNC at startup time in window mode with preassigned processing options.</p>"));
   _rawOutFileLineEdit->setWhatsThis(tr("<p>Save all data coming in through various streams in the received order and format in one file.</p><p>This option is primarily meant for debugging purposes.</p>"));
+  _rawOutSplitCheckBox->setWhatsThis(tr("<p>Tick 'Raw output file per stream' to save the data of each stream in a file of its own. The mountpoint is appended to the raw output file name.</p><p>The raw output is written in blocks, once a second at the latest.</p>"));
 
   // WhatsThis, RINEX Observations
   // -----------------------------
@@ -1272,7 +1302,7 @@ bncWindow::bncWindow() {
 
   // WhatsThis, SP3 Comparison
   // -------------------------
-  _sp3CompFileChooser->setWhatsThis(tr("<p>BNC can compare two SP3 files containing GNSS satellite orbit and clock information.</p></p>Specify the full path to two files with orbits and clocks in SP3 format, separate them by comma.</p>"));
+  _sp3CompFileChooser->setWhatsThis(tr("<p>BNC can compare two SP3 files containing GNSS satellite orbit and clock information.</p></p>Specify the full path to two files with orbits and clocks in SP3 format, separate them by comma.</p><p>With only one file, BNC checks the interpolation of its orbits and clocks.</p>"));
   _sp3CompExclude->setWhatsThis(tr("<p>Specify satellites to exclude them from orbit and clock comparison. Example:<p>G04,G31,R</p><p>This excludes GPS satellites PRN 4 and 31 as well as all GLONASS satellites from the comparison.</p><p>Default is an empty option field, meaning that no satellite is excluded from the comparison.</p>"));
   _sp3CompLogLineEdit->setWhatsThis(tr("<p>Specify the full path to a logfile saving comparison results.</p><p>Specifying a logfile is mandatory. Comparing SP3 files and not saving comparison results on disk would be useless.</p>"));
 
@@ -1318,6 +1348,7 @@ bncWindow::bncWindow() {
   _miscIntrComboBox->setWhatsThis(tr("<p>BNC can average latencies per stream over a certain period of GPS time. The resulting mean latencies are recorded in the 'Log' tab at the end of each 'Log latency' interval together with results of a statistical evaluation (approximate number of covered epochs, data gaps).</p><p>Select a 'Log latency' interval or select the empty option field if you do not want BNC to log latencies and statistical information.</p>"));
   _miscScanRTCMCheckBox->setWhatsThis(tr("<p>Tick 'Scan RTCM' to log the numbers of incoming message types as well as contained antenna coordinates, antenna height, and antenna descriptor.</p><p>In case of RTCM Version 3 MSM streams, BNC will also log contained RINEX Version 3 observation types.</p>."));
   _miscPortLineEdit->setWhatsThis(tr("<p>BNC can output an incoming stream through an IP port of your local host.</p><p>Specify a port number to activate this function.</p>"));
+  _metricsPortLineEdit->setWhatsThis(tr("<p>BNC can serve metrics like per-stream throughput, decoding times, observation latencies, PPP processing times and upload backlogs in Prometheus text format through an IP port of your local host (HTTP GET, any path).</p><p>Specify a port number to activate this function. The option is independent from the mountpoint specified above.</p>"));
 
   // WhatsThis, PPP (1)
   // ------------------
@@ -1325,13 +1356,14 @@ bncWindow::bncWindow() {
   _pppWidgets._rinexObs->setWhatsThis(tr("<p>Specify the RINEX Observation file.</p>"));
   _pppWidgets._rinexNav->setWhatsThis(tr("<p>Specify the RINEX Navigation file.</p>"));
   _pppWidgets._corrMount->setWhatsThis(tr("<p>Specify a 'mountpoint' from the 'Streams' canvas below which provides corrections to Broadcast Ephemeris.</p><p>If you don't specify a corrections stream via this option, BNC will fall back to Single Point Positioning (SPP, positioning from observations and Broadcast Ephemeris only) instead of doing PPP.</p>"));
-  _pppWidgets._corrFile->setWhatsThis(tr("<p>Specify the Broadcast Ephemeris Corrections file as saved beforehand using BNC.</p><p>If you don't specify corrections by this option, BNC will fall back to Single Point Positioning (SPP, positioning from RINEX Obs and RINEX Nav files only) instead of doing PPP.</p>"));
+  _pppWidgets._corrFile->setWhatsThis(tr("<p>Specify the Broadcast Ephemeris Corrections file as saved beforehand using BNC.</p><p>If you don't specify corrections by this option, BNC will fall back to Single Point Positioning (SPP, positioning from RINEX Obs and RINEX Nav files only) instead of doing PPP.</p><p>The file is converted into a binary file (extension '.bcor') when used for the first time.</p>"));
   _pppWidgets._antexFile->setWhatsThis(tr("<p>Observations in RTCM streams or RINEX files should be referred to the receiver's and to the satellite's Antenna Phase Center (APC) and therefore be corrected for<ul><li>Receiver APC offsets</li><li>Receiver APC variations</li><li>Satellite APC offsets.</li></ul> Specify the full path to an IGS 'ANTEX file' which contains APC offsets and variations.</p><p>If you don't specify an 'ANTEX file' then observations will not be corrected for APC offsets and variations.</p>"));
   _pppWidgets._crdFile->setWhatsThis(tr("<p>Enter the full path to an ASCII file which specifies the streams or files of those stations you want to process. Specifying a 'Coordinates file' is optional. If it exists, it should contain one record per station with the following parameters separated by blank character:<p><ul><li>Specify the station either by<ul><li>the 'Mountpoint' of the station's RTCM stream (when in real-time PPP mode), or</li><li>the 4-charater station ID of the RINEX Observations file (when in post processing PPP mode).</li></ul></li><li>Approximate X,Y,Z coordinate of station's Antenna Reference Point [m] (ARP, specify '0.0 0.0 0.0' if unknown).</li><li>North, East and Up component of antenna eccentricity [m] (specify '0.0 0.0 0.0' if unknown).</li><li>20 Characters describing the antenna type and radome following the IGS 'ANTEX file' standard (leave blank if unknown).</li><li>Receiver type following the naming conventions for IGS equipment.</li></ul></p><p>Records with exclamation mark '!' in the first column or blank records will be interpreted as comment lines and ignored.</p>"));
   _pppWidgets._v3filenames->setWhatsThis(tr("<p>Tick 'Version 3 filenames' to let BNC create so-called extended filenames for PPP logfiles, NMEA files and SINEX Troposphere files following the RINEX Version 3 standard.</p><p>Default is an empty check box, meaning to create filenames following the RINEX Version 2 standard. The file content is not affected by this option. It only concerns the filenames.</p>"));
   _pppWidgets._logPath->setWhatsThis(tr("<p>Specify a directory for saving daily PPP logfiles. If the specified directory does not exist, BNC will not create such files.</p><p>Default is an empty option field, meaning that no PPP logfiles shall be produced.</p>"));
   _pppWidgets._nmeaPath->setWhatsThis(tr("<p>Specify a directory for saving coordinates in daily NMEA files. If the specified directory does not exist, BNC will not create such files.</p><p>Default is an empty option field, meaning that no NMEA file shall be produced.</p>"));
   _pppWidgets._snxtroPath->setWhatsThis(tr("<p>Specify a directory for saving SINEX Troposphere files. If the specified directory does not exist, BNC will not create such files.</p><p>Default is an empty option field, meaning that no SINEX Troposphere files shall be produced.</p>"));
+  _pppWidgets._resultPath->setWhatsThis(tr("<p>Specify a directory for saving the PPP results (epoch, coordinates, covariance matrix, North/East/Up displacements, troposphere, number of satellites, residual statistics) in daily binary files for fast post-analysis. If the specified directory does not exist, BNC will not create such files.</p><p>Default is an empty option field, meaning that no binary result files shall be produced.</p>"));
   _pppWidgets._snxtroIntr->setWhatsThis(tr("<p>Select a length for SINEX Troposphere files.</p><p>Default 'SNX TRO interval' for saving SINEX Troposphere files on disk is '1 hour'.</p>"));
   _pppWidgets._snxtroSampl->setWhatsThis(tr("<p>Select a 'Sampling' rate for saving troposphere parameters.</p>"));
   _pppWidgets._snxtroAc->setWhatsThis(tr("<p>Specify a 3-character abbreviation describing you as the generating Analysis Center (AC) in your SINEX troposphere files.</p>"));
@@ -1381,6 +1413,7 @@ bncWindow::bncWindow() {
   _uploadEphMountpointLineEdit->setWhatsThis(tr("<p>Specify a mountpoint for uploading the Broadcast Ephemeris stream.</p>"));
   _uploadEphPasswordLineEdit->setWhatsThis(tr("<p>Specify the stream upload password protecting the mounpoint on the Ntrip Broadcaster.</p>"));
   _uploadEphSampleSpinBox->setWhatsThis(tr("<p>Select the Broadcast Ephemeris sampling interval in seconds.</p><p>Default is '5', meaning that a complete set of Broadcast Ephemeris is uploaded every 5 seconds.</p>"));
+  _uploadEphPacedCheckBox->setWhatsThis(tr("<p>Tick 'Paced' to spread the upload of the Broadcast Ephemeris set over the sampling interval instead of sending it as one burst.</p>"));
   _uploadEphBytesCounter->setWhatsThis(tr("<p>BNC shows the amount of data uploaded via this stream.</p>"));
 // weber
 
@@ -1440,8 +1473,11 @@ bncWindow::~bncWindow() {
   delete _proxyPortLineEdit;
   delete _sslCaCertPathLineEdit;
   delete _sslIgnoreErrorsCheckBox;
+  delete _ioThreadsLineEdit;
+  delete _maxConnectsLineEdit;
   delete _logFileLineEdit;
   delete _rawOutFileLineEdit;
+  delete _rawOutSplitCheckBox;
   delete _rnxAppendCheckBox;
   delete _onTheFlyComboBox;
   delete _autoStartCheckBox;
@@ -1483,6 +1519,7 @@ bncWindow::~bncWindow() {
   delete _adviseScriptLineEdit;
   delete _miscMountLineEdit;
   delete _miscPortLineEdit;
+  delete _metricsPortLineEdit;
   delete _miscIntrComboBox;
   delete _miscScanRTCMCheckBox;
   _mountPointsTable->deleteLater();
@@ -1503,6 +1540,7 @@ bncWindow::~bncWindow() {
   delete _uploadEphPasswordLineEdit;
   delete _uploadEphMountpointLineEdit;
   delete _uploadEphSampleSpinBox;
+  delete _uploadEphPacedCheckBox;
   delete _uploadEphBytesCounter;
   delete _loggroup;
   delete _reqcActionComboBox;
@@ -1853,12 +1891,15 @@ void bncWindow::saveOptions() {
   settings.setValue("proxyPort",   _proxyPortLineEdit->text());
   settings.setValue("sslCaCertPath",   _sslCaCertPathLineEdit->text());
   settings.setValue("sslIgnoreErrors",  _sslIgnoreErrorsCheckBox->checkState());
+  settings.setValue("ioThreads",   _ioThreadsLineEdit->text());
+  settings.setValue("maxConnects", _maxConnectsLineEdit->text());
 // General
   settings.setValue("logFile",     _logFileLineEdit->text());
   settings.setValue("rnxAppend",   _rnxAppendCheckBox->checkState());
   settings.setValue("onTheFlyInterval", _onTheFlyComboBox->currentText());
   settings.setValue("autoStart",   _autoStartCheckBox->checkState());
   settings.setValue("rawOutFile",  _rawOutFileLineEdit->text());
+  settings.setValue("rawOutSplit", _rawOutSplitCheckBox->checkState());
 // RINEX Observations
   settings.setValue("rnxPath",     _rnxPathLineEdit->text());
   settings.setValue("rnxIntr",     _rnxIntrComboBox->currentText());
@@ -1904,6 +1945,7 @@ void bncWindow::saveOptions() {
 // Miscellaneous
   settings.setValue("miscMount",   _miscMountLineEdit->text());
   settings.setValue("miscPort",    _miscPortLineEdit->text());
+  settings.setValue("metricsPort", _metricsPortLineEdit->text());
   settings.setValue("miscIntr",    _miscIntrComboBox->currentText());
   settings.setValue("miscScanRTCM", _miscScanRTCMCheckBox->checkState());
 // Reqc
@@ -1949,6 +1991,7 @@ void bncWindow::saveOptions() {
   settings.setValue("uploadEphMountpoint",_uploadEphMountpointLineEdit->text());
   settings.setValue("uploadEphPassword",  _uploadEphPasswordLineEdit->text());
   settings.setValue("uploadEphSample",    _uploadEphSampleSpinBox->value());
+  settings.setValue("uploadEphPaced",     _uploadEphPacedCheckBox->checkState());
 
   if (_caster) {
     _caster->readMountPoints();
@@ -2022,6 +2065,7 @@ void bncWindow::startRealTime() {
   BNC_CORE->setCaster(_caster);
   BNC_CORE->setPortEph(_ephOutPortLineEdit->text().toInt());
   BNC_CORE->setPortCorr(_corrPortLineEdit->text().toInt());
+  BNC_CORE->setPortMetrics(_metricsPortLineEdit->text().toInt());
   BNC_CORE->initCombination();
 
   connect(_caster, SIGNAL(getThreadsFinished()),
@@ -2446,6 +2490,7 @@ void bncWindow::slotBncTextChanged(){
     enableWidget(enable, _uploadEphMountpointLineEdit);
     enableWidget(enable, _uploadEphPasswordLineEdit);
     enableWidget(enable, _uploadEphSampleSpinBox);
+    enableWidget(enable, _uploadEphPacedCheckBox);
   }
 
   // Combine Corrections
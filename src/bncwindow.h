@@ -128,6 +128,8 @@ class bncWindow : public QMainWindow {
     QLineEdit* _proxyPortLineEdit;
     QLineEdit* _sslCaCertPathLineEdit;
     QCheckBox* _sslIgnoreErrorsCheckBox;
+    QLineEdit* _ioThreadsLineEdit;
+    QLineEdit* _maxConnectsLineEdit;
     QLineEdit* _outFileLineEdit;
     QLineEdit* _outPortLineEdit;
     QLineEdit* _outUPortLineEdit;
@@ -139,6 +141,7 @@ class bncWindow : public QMainWindow {
     QLineEdit* _corrPathLineEdit;
     QLineEdit* _miscMountLineEdit;
     QLineEdit* _miscPortLineEdit;
+    QLineEdit* _metricsPortLineEdit;
 
     QComboBox*     _reqcActionComboBox;
     QPushButton*   _reqcEditOptionButton;
@@ -163,6 +166,7 @@ class bncWindow : public QMainWindow {
     QLineEdit* _rnxScrpLineEdit;
     QLineEdit* _logFileLineEdit;
     QLineEdit* _rawOutFileLineEdit;
+    QCheckBox* _rawOutSplitCheckBox;
     QComboBox* _rnxIntrComboBox;
     QComboBox* _ephIntrComboBox;
     QComboBox* _corrIntrComboBox;
@@ -224,6 +228,7 @@ class bncWindow : public QMainWindow {
     QLineEdit*       _uploadEphPasswordLineEdit;
     QLineEdit*       _uploadEphMountpointLineEdit;
     QSpinBox*        _uploadEphSampleSpinBox;
+    QCheckBox*       _uploadEphPacedCheckBox;
     bncBytesCounter* _uploadEphBytesCounter;
 
     bncCaster*          _caster;
@@ -17,11 +17,13 @@
 #include <newmatio.h>
 #include <iomanip>
 #include <sstream>
+#include <QElapsedTimer>
 
 #include "bnccomb.h"
 #include "bnccore.h"
 #include "upload/bncrtnetdecoder.h"
 #include "bncsettings.h"
+#include "bncmetrics.h"
 #include "bncutils.h"
 #include "bncsp3.h"
 #include "bncantex.h"
@@ -146,6 +148,11 @@ bncComb::bncComb() : _ephUser(true) {
 
   _masterMissingEpochs = 0;
 
+  _metricEpoch   = BNC_METRICS->histogram("bnc_comb_epoch_seconds",
+                     "Combination processing time per epoch");
+  _metricPending = BNC_METRICS->gauge("bnc_comb_pending_epochs",
+                     "Combination epochs buffered for processing");
+
   if (cmbStreams.size() >= 1 && !cmbStreams[0].isEmpty()) {
     QListIterator<QString> it(cmbStreams);
     while (it.hasNext()) {
@@ -274,6 +281,8 @@ bncComb::~bncComb() {
     bncTime epoTime = itTime.next();
     _buffer.remove(epoTime);
   }
+  BNC_METRICS->release(_metricEpoch);
+  BNC_METRICS->release(_metricPending);
 }
 
 // Remember orbit corrections
@@ -435,9 +444,13 @@ void bncComb::slotNewClkCorrections(QList<t_clkCorr> clkCorrections) {
     bncTime epoTime = itTime.next();
     if (epoTime < lastTime - outWait) {
       _resTime = epoTime;
+      QElapsedTimer epochTimer;
+      epochTimer.start();
       processEpoch();
+      _metricEpoch->observe(epochTimer.nsecsElapsed() * 1.e-9);
     }
   }
+  _metricPending->set(_buffer.size());
 }
 
 // Change the correction so that it refers to last received ephemeris
@@ -629,7 +642,7 @@ t_irc bncComb::processEpoch_filter(QTextStream& out,
     }
 
     dx.ReSize(nPar); dx = 0.0;
-    kalman(AA, ll, PP, _QQ, dx);
+    _kalman.update(AA, ll, PP, _QQ, dx);
 
     ColumnVector vv = ll - AA * dx;
 
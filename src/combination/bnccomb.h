@@ -6,10 +6,13 @@
 #include <newmat.h>
 #include "bncephuser.h"
 #include "satObs.h"
+#include "bnckalman.h"
 
 class bncRtnetDecoder;
 class bncSP3;
 class bncAntex;
+class bncMetricHistogram;
+class bncMetricGauge;
 
 class bncComb : public QObject {
  Q_OBJECT
@@ -115,6 +118,7 @@ class bncComb : public QObject {
   QMap<bncTime, cmbEpoch>                _buffer;
   bncRtnetDecoder*                       _rtnetDecoder;
   SymmetricMatrix                        _QQ;
+  bncKalman                              _kalman;
   QByteArray                             _log;
   bncAntex*                              _antex;
   double                                 _MAXRES;
@@ -125,6 +129,8 @@ class bncComb : public QObject {
   int                                    _cmbSampl;
   QMap<QString, QMap<t_prn, t_orbCorr> > _orbCorrections;
   bncEphUser                             _ephUser;
+  bncMetricHistogram*                    _metricEpoch;
+  bncMetricGauge*                        _metricPending;
 };
 
 #define BNC_CMB (bncComb::instance())
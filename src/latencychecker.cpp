@@ -40,13 +40,8 @@
 
 #include <iostream>
 
-#ifdef WIN32
-#include <windows.h>
-#else
-#include <unistd.h>
-#endif
-
 #include "latencychecker.h"
+#include "bncadvisedispatcher.h"
 #include "bnccore.h"
 #include "bncutils.h"
 #include "bncsettings.h"
@@ -164,16 +159,18 @@ void latencyChecker::checkReconnect() {
 
   if (_inspSegm == 0) { return;}
 
+  const QDateTime now = QDateTime::currentDateTime();
+
   // Begin outage threshold
   // ----------------------
   if (!_fromReconnect) {
-    _endDateTimeOut = QDateTime::currentDateTime();
+    _endDateTimeOut = now;
   }
   _fromReconnect = true;
 
   if ( _decodeStop.isValid() ) {
-    _begDateTimeOut = QDateTime::currentDateTime();
-    if ( _endDateTimeOut.secsTo(QDateTime::currentDateTime()) >  _adviseFail * 60 ) {
+    _begDateTimeOut = now;
+    if ( _endDateTimeOut.secsTo(now) >  _adviseFail * 60 ) {
       _begDateOut = _endDateTimeOut.toUTC().date().toString("yy-MM-dd");
       _begTimeOut = _endDateTimeOut.toUTC().time().toString("hh:mm:ss");
       emit(newMessage((_staID + ": Failure threshold exceeded, outage since "
@@ -182,7 +179,7 @@ void latencyChecker::checkReconnect() {
                     + _begDateOut + " " + _begTimeOut + " UTC").toAscii());
       _decodeStop.setDate(QDate());
       _decodeStop.setTime(QTime());
-      _decodeStart = QDateTime::currentDateTime();
+      _decodeStart = now;
     }
   }
 }
@@ -193,11 +190,13 @@ void latencyChecker::checkOutage(bool decoded) {
 
   if (_inspSegm == 0) { return;}
 
+  const QDateTime now = QDateTime::currentDateTime();
+
   if (decoded) { _numSucc += 1; }
 
-  if (!_checkPause.isValid() || _checkPause.secsTo(QDateTime::currentDateTime()) >= _currPause )  {
+  if (!_checkPause.isValid() || _checkPause.secsTo(now) >= _currPause )  {
     if (!_checkSeg) {
-      if ( _checkTime.secsTo(QDateTime::currentDateTime()) > _inspSegm ) {
+      if ( _checkTime.secsTo(now) > _inspSegm ) {
         _checkSeg = true;
       }
     }
@@ -206,12 +205,12 @@ void latencyChecker::checkOutage(bool decoded) {
     // --------------------------------
     if (_checkSeg) {
 
-      _checkTime = QDateTime::currentDateTime();
+      _checkTime = now;
 
       if (_numSucc > 0) {
         _secSucc += _inspSegm;
         _secFail = 0;
-        _decodeSucc = QDateTime::currentDateTime();
+        _decodeSucc = now;
         if (_secSucc > _adviseReco * 60) {
           _secSucc = _adviseReco * 60 + 1;
         }
@@ -227,7 +226,7 @@ void latencyChecker::checkOutage(bool decoded) {
           _secFail = _adviseFail * 60 + 1;
         }
         if (!_checkPause.isValid()) {
-          _checkPause = QDateTime::currentDateTime();
+          _checkPause = now;
         }
         else {
           _checkPause.setDate(QDate());
@@ -243,16 +242,16 @@ void latencyChecker::checkOutage(bool decoded) {
       // Begin corrupt threshold
       // -----------------------
       if (_secSucc > 0) {
-        _endDateTimeCorr = QDateTime::currentDateTime();
+        _endDateTimeCorr = now;
       }
 
       if (_secFail > 0) {
-        _begDateTimeCorr = QDateTime::currentDateTime();
+        _begDateTimeCorr = now;
       }
 
       if ( _decodeStopCorr.isValid() ) {
-        _begDateTimeCorr = QDateTime::currentDateTime();
-        if ( _endDateTimeCorr.secsTo(QDateTime::currentDateTime()) > _adviseFail * 60 ) {
+        _begDateTimeCorr = now;
+        if ( _endDateTimeCorr.secsTo(now) > _adviseFail * 60 ) {
           _begDateCorr = _endDateTimeCorr.toUTC().date().toString("yy-MM-dd");
           _begTimeCorr = _endDateTimeCorr.toUTC().time().toString("hh:mm:ss");
           emit(newMessage((_staID + ": Failure threshold exceeded, corrupted since "
@@ -263,7 +262,7 @@ void latencyChecker::checkOutage(bool decoded) {
           _numSucc = 0;
           _decodeStopCorr.setDate(QDate());
           _decodeStopCorr.setTime(QTime());
-          _decodeStartCorr = QDateTime::currentDateTime();
+          _decodeStartCorr = now;
         }
       }
       else {
@@ -271,8 +270,8 @@ void latencyChecker::checkOutage(bool decoded) {
         // End corrupt threshold
         // ---------------------
         if ( _decodeStartCorr.isValid() ) {
-          _endDateTimeCorr = QDateTime::currentDateTime();
-          if ( _begDateTimeCorr.secsTo(QDateTime::currentDateTime()) > _adviseReco * 60 ) {
+          _endDateTimeCorr = now;
+          if ( _begDateTimeCorr.secsTo(now) > _adviseReco * 60 ) {
             _endDateCorr = _begDateTimeCorr.toUTC().date().toString("yy-MM-dd");
             _endTimeCorr = _begDateTimeCorr.toUTC().time().toString("hh:mm:ss");
             emit(newMessage((_staID + ": Recovery threshold exceeded, corruption ended "
@@ -282,7 +281,7 @@ void latencyChecker::checkOutage(bool decoded) {
                         + _begDateCorr + " " + _begTimeCorr + " UTC").toAscii());
             _decodeStartCorr.setDate(QDate());
             _decodeStartCorr.setTime(QTime());
-            _decodeStopCorr = QDateTime::currentDateTime();
+            _decodeStopCorr = now;
             _secFail = 0;
           }
         }
@@ -294,13 +293,13 @@ void latencyChecker::checkOutage(bool decoded) {
   // End outage threshold
   // --------------------
   if (_fromReconnect) {
-    _begDateTimeOut = QDateTime::currentDateTime();
+    _begDateTimeOut = now;
   }
   _fromReconnect = false;
 
   if ( _decodeStart.isValid() ) {
-    _endDateTimeOut = QDateTime::currentDateTime();
-    if ( _begDateTimeOut.secsTo(QDateTime::currentDateTime()) >  _adviseReco * 60 ) {
+    _endDateTimeOut = now;
+    if ( _begDateTimeOut.secsTo(now) >  _adviseReco * 60 ) {
       _endDateOut = _begDateTimeOut.toUTC().date().toString("yy-MM-dd");
       _endTimeOut = _begDateTimeOut.toUTC().time().toString("hh:mm:ss");
       emit(newMessage((_staID + ": Recovery threshold exceeded, outage ended "
@@ -310,7 +309,7 @@ void latencyChecker::checkOutage(bool decoded) {
                     + _begDateOut + " " + _begTimeOut + " UTC").toAscii());
       _decodeStart.setDate(QDate());
       _decodeStart.setTime(QTime());
-      _decodeStop = QDateTime::currentDateTime();
+      _decodeStop = now;
     }
   }
 }
@@ -545,12 +544,6 @@ void latencyChecker::checkCorrLatency(int corrGPSEpochTime, int type) {
 ////////////////////////////////////////////////////////////////////////////
 void latencyChecker::callScript(const char* comment) {
   if (!_adviseScript.isEmpty()) {
-#ifdef WIN32
-    Sleep(1);
-    QProcess::startDetached(_adviseScript, QStringList() << _staID << comment) ;
-#else
-    sleep(1);
-    QProcess::startDetached("nohup", QStringList() << _adviseScript << _staID << comment) ;
-#endif
+    bncAdviseDispatcher::instance()->post(_adviseScript, _staID, comment);
   }
 }
@@ -40,6 +40,7 @@
 
 #include <iostream>
 #include <iomanip>
+#include <algorithm>
 #include "sp3Comp.h"
 #include "bnccore.h"
 #include "bncsettings.h"
@@ -89,14 +90,20 @@ void t_sp3Comp::run() {
   for (int ii = 0; ii < _sp3FileNames.size(); ii++) {
     *_log << "! SP3 File " << ii+1 << ": " << _sp3FileNames[ii] << endl;
   }
-  if (_sp3FileNames.size() != 2) {
-    *_log << "ERROR: sp3Comp requires two input SP3 files" << endl;
+  if (_sp3FileNames.size() != 1 && _sp3FileNames.size() != 2) {
+    *_log << "ERROR: sp3Comp requires one (interpolation check) or two "
+             "(comparison) input SP3 files" << endl;
     goto end;
   }
 
   try {
     ostringstream msg;
-    compare(msg);
+    if (_sp3FileNames.size() == 1) {
+      checkInterpolation(msg);
+    }
+    else {
+      compare(msg);
+    }
     *_log << msg.str().c_str();
   }
   catch (const string& error) {
@@ -132,249 +139,331 @@ void t_sp3Comp::run() {
   }
 }
 
-// Satellite Index in clkSats set
+// Satellite index (new satellites are appended)
 ////////////////////////////////////////////////////////////////////////////////
-int t_sp3Comp::satIndex(const set<t_prn>& clkSats, const t_prn& prn) const {
-  int ret = 0;
-  for (set<t_prn>::const_iterator it = clkSats.begin(); it != clkSats.end(); it++) {
-    if ( *it == prn) {
-      return ret;
-    }
-    ++ret;
+int t_sp3Comp::t_clkSolver::index(const t_prn& prn) {
+  map<t_prn, int>::const_iterator it = _index.find(prn);
+  if (it != _index.end()) {
+    return it->second;
   }
-  return -1;
+  int iSat = _nSat++;
+  _index[prn] = iSat;
+  _NN.resize(_nSat * (_nSat + 1) / 2, 0.0);
+  _bb.resize(_nSat, 0.0);
+  return iSat;
 }
 
-// Estimate Clock Offsets
+// Add one epoch, the epoch offset is eliminated
+//
+// Observation equations dc_j = o + s_j (all satellites j of the epoch).
+// Eliminating o from the normal equations adds (I - 1/n) to the satellite
+// block and dc_j - sum(dc)/n to the right-hand side.
 ////////////////////////////////////////////////////////////////////////////////
-void t_sp3Comp::processClocks(const set<t_prn>& clkSats, const vector<t_epoch*>& epochsIn,
-                              map<string, t_stat>& stat) const {
-
-  if (clkSats.size() == 0) {
+void t_sp3Comp::t_clkSolver::addEpoch(const vector<t_prn>& prns,
+                                      const vector<double>& dc) {
+  unsigned nn = prns.size();
+  if (nn == 0) {
     return;
   }
-
-  vector<t_epoch*> epochs;
-  for (unsigned ii = 0; ii < epochsIn.size(); ii++) {
-    unsigned numSatOK = 0;
-    std::map<t_prn, double>::const_iterator it;
-    for (it = epochsIn[ii]->_dc.begin(); it != epochsIn[ii]->_dc.end(); it++) {
-      if (satIndex(clkSats, it->first) != -1) {
-        numSatOK += 1;
-      }
-    }
-    if (numSatOK > 0) {
-      epochs.push_back(epochsIn[ii]);
+  vector<int> idx(nn);
+  double sumDc = 0.0;
+  for (unsigned ii = 0; ii < nn; ii++) {
+    idx[ii] = index(prns[ii]);
+    sumDc  += dc[ii];
+  }
+  double rn = 1.0 / nn;
+  for (unsigned ii = 0; ii < nn; ii++) {
+    _bb[idx[ii]] += dc[ii] - sumDc * rn;
+    for (unsigned jj = 0; jj <= ii; jj++) {
+      int i1 = max(idx[ii], idx[jj]);
+      int i2 = min(idx[ii], idx[jj]);
+      _NN[i1 * (i1 + 1) / 2 + i2] += (ii == jj ? 1.0 : 0.0) - rn;
     }
   }
-  if (epochs.size() == 0) {
+}
+
+// Solve the (regularized) satellite system
+////////////////////////////////////////////////////////////////////////////////
+void t_sp3Comp::t_clkSolver::solve() {
+  _xx.clear();
+  if (_nSat == 0) {
     return;
   }
-
-  int nPar = epochs.size() + clkSats.size();
-  SymmetricMatrix NN(nPar); NN = 0.0;
-  ColumnVector    bb(nPar); bb = 0.0;
-
-  // Create Matrix A'A and vector b
-  // ------------------------------
-  for (unsigned ie = 0; ie < epochs.size(); ie++) {
-    const map<t_prn, double>& dc = epochs[ie]->_dc;
-    Matrix       AA(dc.size(), nPar); AA = 0.0;
-    ColumnVector ll(dc.size());       ll = 0.0;
-    map<t_prn, double>::const_iterator it;
-    int ii = -1;
-    for (it = dc.begin(); it != dc.end(); it++) {
-      const t_prn& prn = it->first;
-      if (satIndex(clkSats, prn) != -1) {
-        ++ii;
-        int index = epochs.size() + satIndex(clkSats, prn);
-        AA[ii][ie]    = 1.0; // epoch-specfic offset (common for all satellites)
-        AA[ii][index] = 1.0; // satellite-specific offset (common for all epochs)
-        ll[ii]        = it->second;
-      }
-    }
-    SymmetricMatrix dN; dN << AA.t() * AA;
-    NN += dN;
-    bb += AA.t() * ll;
+  SymmetricMatrix NN(_nSat);
+  ColumnVector    bb(_nSat);
+  double* nn = NN.Store();
+  for (unsigned ii = 0; ii < _NN.size(); ii++) {
+    nn[ii] = _NN[ii] + 1.0;  // sum of satellite offsets is zero
+  }
+  for (int ii = 0; ii < _nSat; ii++) {
+    bb[ii] = _bb[ii];
   }
-
-  // Regularize NN
-  // -------------
-  RowVector HH(nPar);
-  HH.columns(1, epochs.size())      = 0.0;
-  HH.columns(epochs.size()+1, nPar) = 1.0;
-  SymmetricMatrix dN; dN << HH.t() * HH;
-  NN += dN;
-
-  // Estimate Parameters
-  // -------------------
   ColumnVector xx = NN.i() * bb;
+  _xx.assign(xx.Store(), xx.Store() + _nSat);
+}
 
-  // Compute clock residuals
-  // -----------------------
-  for (unsigned ie = 0; ie < epochs.size(); ie++) {
-    map<t_prn, double>& dc = epochs[ie]->_dc;
-    for (map<t_prn, double>::iterator it = dc.begin(); it != dc.end(); it++) {
-      const t_prn& prn = it->first;
-      if (satIndex(clkSats, prn) != -1) {
-        int  index = epochs.size() + satIndex(clkSats, prn);
-        dc[prn]                      = it->second - xx[ie] - xx[index];
-        stat[prn.toString()]._offset = xx[index];
-      }
-    }
+// Estimated satellite offset
+////////////////////////////////////////////////////////////////////////////////
+bool t_sp3Comp::t_clkSolver::satOffset(const t_prn& prn, double& offset) const {
+  map<t_prn, int>::const_iterator it = _index.find(prn);
+  if (it == _index.end() || it->second >= int(_xx.size())) {
+    return false;
   }
+  offset = _xx[it->second];
+  return true;
 }
 
-// Main Routine
+// Epoch offset (back-substitution)
 ////////////////////////////////////////////////////////////////////////////////
-void t_sp3Comp::compare(ostringstream& out) const {
-
-  // Synchronize reading of two sp3 files
-  // ------------------------------------
-  bncSP3 in1(_sp3FileNames[0]); in1.nextEpoch();
-  bncSP3 in2(_sp3FileNames[1]); in2.nextEpoch();
+double t_sp3Comp::t_clkSolver::epochOffset(const vector<t_prn>& prns,
+                                           const vector<double>& dc) const {
+  if (prns.size() == 0) {
+    return 0.0;
+  }
+  double sum = 0.0;
+  for (unsigned ii = 0; ii < prns.size(); ii++) {
+    double offset = 0.0;
+    satOffset(prns[ii], offset);
+    sum += dc[ii] - offset;
+  }
+  return sum / prns.size();
+}
 
-  vector<t_epoch*> epochs;
-  while (in1.currEpoch() && in2.currEpoch()) {
-    bncTime t1 = in1.currEpoch()->_tt;
-    bncTime t2 = in2.currEpoch()->_tt;
+// Read the next epoch common to both files
+////////////////////////////////////////////////////////////////////////////////
+t_sp3Comp::t_epoch* t_sp3Comp::readEpoch(bncSP3Reader& in1, bncSP3Reader& in2) const {
+  while (!in1.atEnd() && !in2.atEnd()) {
+    bncTime t1 = in1.epoch();
+    bncTime t2 = in2.epoch();
     if      (t1 < t2) {
       in1.nextEpoch();
     }
     else if (t1 > t2) {
       in2.nextEpoch();
     }
-    else if (t1 == t2) {
+    else {
       t_epoch* epo = new t_epoch; epo->_tt = t1;
       bool epochOK = false;
-      for (int i1 = 0; i1 < in1.currEpoch()->_sp3Sat.size(); i1++) {
-        bncSP3::t_sp3Sat* sat1 = in1.currEpoch()->_sp3Sat[i1];
-        for (int i2 = 0; i2 < in2.currEpoch()->_sp3Sat.size(); i2++) {
-          bncSP3::t_sp3Sat* sat2 = in2.currEpoch()->_sp3Sat[i2];
-          if (sat1->_prn == sat2->_prn) {
-            epochOK        = true;
-            epo->_dr[sat1->_prn]  = sat1->_xyz - sat2->_xyz;
-            epo->_xyz[sat1->_prn] = sat1->_xyz;
-            if (sat1->_clkValid && sat2->_clkValid) {
-              epo->_dc[sat1->_prn] = sat1->_clk - sat2->_clk;
-            }
+      const vector<t_prn>& prns = in1.prns();
+      for (unsigned ip = 0; ip < prns.size(); ip++) {
+        const t_prn& prn = prns[ip];
+        ColumnVector xyz1, xyz2;
+        double       clk1, clk2;
+        bool         clkValid1, clkValid2;
+        if (in1.value(prn, xyz1, clk1, clkValid1) &&
+            in2.value(prn, xyz2, clk2, clkValid2)) {
+          epochOK        = true;
+          epo->_dr[prn]  = xyz1 - xyz2;
+          epo->_xyz[prn] = xyz1;
+          if (clkValid1 && clkValid2) {
+            epo->_dc[prn] = clk1 - clk2;
           }
         }
       }
-      if (epochOK) {
-        epochs.push_back(epo);
-      }
-      else {
-        delete epo;
-      }
       in1.nextEpoch();
       in2.nextEpoch();
+      if (epochOK) {
+        return epo;
+      }
+      delete epo;
     }
   }
+  return 0;
+}
 
-  // Transform xyz into radial, along-track, and out-of-plane
-  // --------------------------------------------------------
-  if (epochs.size() < 2) {
-    throw "t_sp3Comp: not enough common epochs";
-  }
-
-  set<t_prn> clkSatsAll;
-
-  for (unsigned ie = 0; ie < epochs.size(); ie++) {
-    t_epoch* epoch  = epochs[ie];
-    t_epoch* epoch2 = 0;
-    if (ie == 0) {
-      epoch2 = epochs[ie+1];
+// Transform xyz into radial, along-track, and out-of-plane (epoch2 is the
+// neighbouring epoch used for the velocity)
+////////////////////////////////////////////////////////////////////////////////
+void t_sp3Comp::transformEpoch(t_epoch* epoch, const t_epoch* epoch2) const {
+  double dt = epoch->_tt - epoch2->_tt;
+  map<t_prn, ColumnVector>&       dr   = epoch->_dr;
+  const map<t_prn, ColumnVector>& xyz  = epoch->_xyz;
+  const map<t_prn, ColumnVector>& xyz2 = epoch2->_xyz;
+  vector<t_prn> missing;
+  for (map<t_prn, ColumnVector>::iterator it = dr.begin(); it != dr.end(); it++) {
+    const t_prn& prn = it->first;
+    map<t_prn, ColumnVector>::const_iterator it2 = xyz2.find(prn);
+    if (it2 != xyz2.end()) {
+      const ColumnVector  dx = it->second;
+      const ColumnVector& x1 = xyz.find(prn)->second;
+      ColumnVector vel = (x1 - it2->second) / dt;
+      XYZ_to_RSW(x1, vel, dx, it->second);
     }
     else {
-      epoch2 = epochs[ie-1];
+      missing.push_back(prn);
     }
-    double dt = epoch->_tt - epoch2->_tt;
-    map<t_prn, ColumnVector>& dr   = epoch->_dr;
-    map<t_prn, ColumnVector>& xyz  = epoch->_xyz;
-    map<t_prn, ColumnVector>& xyz2 = epoch2->_xyz;
-    for (map<t_prn, ColumnVector>::const_iterator it = dr.begin(); it != dr.end(); it++) {
-      const t_prn&  prn = it->first;
-      if (xyz2.find(prn) != xyz2.end()) {
-        const ColumnVector  dx = dr[prn];
-        const ColumnVector& x1 = xyz[prn];
-        const ColumnVector& x2 = xyz2[prn];
-        ColumnVector vel = (x1 - x2) / dt;
-        XYZ_to_RSW(x1, vel, dx, dr[prn]);
-        if (epoch->_dc.find(prn) != epoch->_dc.end()) {
-          clkSatsAll.insert(prn);
-        }
-      }
-      else {
-        epoch->_dc.erase(prn);
-        epoch->_dr.erase(prn);
-      }
+  }
+  for (unsigned ii = 0; ii < missing.size(); ii++) {
+    epoch->_dc.erase(missing[ii]);
+    epoch->_dr.erase(missing[ii]);
+  }
+}
+
+// Clock differences of an epoch sorted by satellite system
+////////////////////////////////////////////////////////////////////////////////
+void t_sp3Comp::splitClocks(const t_epoch* epoch,
+                            map<char, vector<t_prn> >& prns,
+                            map<char, vector<double> >& dc) const {
+  for (map<t_prn, double>::const_iterator it = epoch->_dc.begin(); it != epoch->_dc.end(); it++) {
+    const t_prn& prn = it->first;
+    if (!excludeSat(prn)) {
+      prns[prn.system()].push_back(prn);
+      dc[prn.system()].push_back(it->second);
     }
   }
+}
 
-  map<string, t_stat> stat;
+// Add the clocks of one epoch to the normal equations
+////////////////////////////////////////////////////////////////////////////////
+void t_sp3Comp::addClocks(const t_epoch* epoch, map<char, t_clkSolver>& solvers) const {
+  map<char, vector<t_prn> >  prns;
+  map<char, vector<double> > dc;
+  splitClocks(epoch, prns, dc);
+  for (map<char, vector<t_prn> >::const_iterator it = prns.begin(); it != prns.end(); it++) {
+    solvers[it->first].addEpoch(it->second, dc[it->first]);
+  }
+}
 
-  // Estimate Clock Offsets
-  // ----------------------
-  string systems;
-  for (set<t_prn>::const_iterator it = clkSatsAll.begin(); it != clkSatsAll.end(); it++) {
-    if (systems.find(it->system()) == string::npos) {
-      systems += it->system();
+// Replace clock differences by clock residuals
+////////////////////////////////////////////////////////////////////////////////
+void t_sp3Comp::clockResiduals(t_epoch* epoch, const map<char, t_clkSolver>& solvers,
+                               map<string, t_stat>& stat) const {
+  map<char, vector<t_prn> >  prns;
+  map<char, vector<double> > dc;
+  splitClocks(epoch, prns, dc);
+  for (map<char, vector<t_prn> >::const_iterator it = prns.begin(); it != prns.end(); it++) {
+    map<char, t_clkSolver>::const_iterator itSol = solvers.find(it->first);
+    if (itSol == solvers.end()) {
+      continue;
+    }
+    const t_clkSolver&    solver = itSol->second;
+    const vector<t_prn>&  sysPrns = it->second;
+    const vector<double>& sysDc   = dc[it->first];
+    double epoOffset = solver.epochOffset(sysPrns, sysDc);
+    for (unsigned ii = 0; ii < sysPrns.size(); ii++) {
+      double satOffset = 0.0;
+      solver.satOffset(sysPrns[ii], satOffset);
+      epoch->_dc[sysPrns[ii]]                = sysDc[ii] - epoOffset - satOffset;
+      stat[sysPrns[ii].toString()]._offset = satOffset;
     }
   }
-  for (unsigned iSys = 0; iSys < systems.size(); iSys++) {
-    char system = systems[iSys];
-    set<t_prn> clkSats;
-    for (set<t_prn>::const_iterator it = clkSatsAll.begin(); it != clkSatsAll.end(); it++) {
-      if (it->system() == system && !excludeSat(*it)) {
-        clkSats.insert(*it);
+}
+
+// Print Residuals of one epoch
+////////////////////////////////////////////////////////////////////////////////
+void t_sp3Comp::printEpoch(const t_epoch* epo, map<string, t_stat>& stat,
+                           ostringstream& out) const {
+  const string all = "ZZZ";
+  const map<t_prn, ColumnVector>& dr = epo->_dr;
+  const map<t_prn, double>&       dc = epo->_dc;
+  for (map<t_prn, ColumnVector>::const_iterator it = dr.begin(); it != dr.end(); it++) {
+    const t_prn&  prn = it->first;
+    if (!excludeSat(prn)) {
+      const ColumnVector& rao = it->second;
+      out << setprecision(6) << epo->_tt.mjddec() << ' ' << prn.toString() << ' '
+          << setw(7) << setprecision(4) << rao[0] << ' '
+          << setw(7) << setprecision(4) << rao[1] << ' '
+          << setw(7) << setprecision(4) << rao[2] << "    ";
+      stat[prn.toString()]._rao += SP(rao, rao); // Schur product
+      stat[prn.toString()]._nr  += 1;
+      stat[all]._rao            += SP(rao, rao);
+      stat[all]._nr             += 1;
+      if (dc.find(prn) != dc.end()) {
+        double clkRes    = dc.find(prn)->second;
+        double clkResRed = clkRes - it->second[0]; // clock minus radial component
+        out << setw(7) << setprecision(4) << clkRes << ' '
+            << setw(7) << setprecision(4) << clkResRed;
+        stat[prn.toString()]._dc    += clkRes * clkRes;
+        stat[prn.toString()]._dcRed += clkResRed * clkResRed;
+        stat[prn.toString()]._nc    += 1;
+        stat[all]._dc               += clkRes * clkRes;
+        stat[all]._dcRed            += clkResRed * clkResRed;
+        stat[all]._nc               += 1;
       }
+      else {
+        out << "  .       .    ";
+      }
+      out << "    " << setw(2) << int(prn) << endl;
     }
-    processClocks(clkSats, epochs, stat);
   }
+}
+
+// Main Routine
+//
+// The files are read twice: the first pass accumulates the clock normal
+// equations, the second one prints the residuals. Only two epochs are
+// kept in memory at any time.
+////////////////////////////////////////////////////////////////////////////////
+void t_sp3Comp::compare(ostringstream& out) const {
 
-  // Print Residuals
-  // ---------------
   const string all = "ZZZ";
 
-  out.setf(ios::fixed);
-  out << "!\n!  MJD       PRN  radial   along   out        clk    clkRed   iPRN"
-           "\n! ----------------------------------------------------------------\n";
-  for (unsigned ii = 0; ii < epochs.size(); ii++) {
-    const t_epoch* epo = epochs[ii];
-    const map<t_prn, ColumnVector>& dr = epochs[ii]->_dr;
-    const map<t_prn, double>&       dc = epochs[ii]->_dc;
-    for (map<t_prn, ColumnVector>::const_iterator it = dr.begin(); it != dr.end(); it++) {
-      const t_prn&  prn = it->first;
-      if (!excludeSat(prn)) {
-        const ColumnVector& rao = it->second;
-        out << setprecision(6) << epo->_tt.mjddec() << ' ' << prn.toString() << ' '
-            << setw(7) << setprecision(4) << rao[0] << ' '
-            << setw(7) << setprecision(4) << rao[1] << ' '
-            << setw(7) << setprecision(4) << rao[2] << "    ";
-        stat[prn.toString()]._rao += SP(rao, rao); // Schur product
-        stat[prn.toString()]._nr  += 1;
-        stat[all]._rao            += SP(rao, rao);
-        stat[all]._nr             += 1;
-        if (dc.find(prn) != dc.end()) {
-          double clkRes    = dc.find(prn)->second;
-          double clkResRed = clkRes - it->second[0]; // clock minus radial component
-          out << setw(7) << setprecision(4) << clkRes << ' '
-              << setw(7) << setprecision(4) << clkResRed;
-          stat[prn.toString()]._dc    += clkRes * clkRes;
-          stat[prn.toString()]._dcRed += clkResRed * clkResRed;
-          stat[prn.toString()]._nc    += 1;
-          stat[all]._dc               += clkRes * clkRes;
-          stat[all]._dcRed            += clkResRed * clkResRed;
-          stat[all]._nc               += 1;
+  map<char, t_clkSolver> solvers;
+  map<string, t_stat>    stat;
+
+  for (int iPass = 1; iPass <= 2; iPass++) {
+
+    if (iPass == 2) {
+      out.setf(ios::fixed);
+      out << "!\n!  MJD       PRN  radial   along   out        clk    clkRed   iPRN"
+               "\n! ----------------------------------------------------------------\n";
+    }
+
+    // Synchronize reading of two sp3 files
+    // ------------------------------------
+    bncSP3Reader in1(_sp3FileNames[0]); in1.nextEpoch();
+    bncSP3Reader in2(_sp3FileNames[1]); in2.nextEpoch();
+    if (in1.atEnd() || in2.atEnd()) {
+      throw "t_sp3Comp: cannot read the sp3 files";
+    }
+
+    // The first epoch uses the second one for the velocity, all other
+    // epochs use their predecessor
+    // ---------------------------------------------------------------
+    t_epoch* first = 0;
+    t_epoch* prev  = 0;
+    int      nEpo  = 0;
+    t_epoch* epo;
+    while ( (epo = readEpoch(in1, in2)) != 0 ) {
+      vector<t_epoch*> ready;
+      if (++nEpo == 1) {
+        first = epo;
+        continue;
+      }
+      if (first) {
+        transformEpoch(first, epo);
+        ready.push_back(first);
+        prev  = first;
+        first = 0;
+      }
+      transformEpoch(epo, prev);
+      ready.push_back(epo);
+      for (unsigned ii = 0; ii < ready.size(); ii++) {
+        if (iPass == 1) {
+          addClocks(ready[ii], solvers);
         }
         else {
-          out << "  .       .    ";
+          clockResiduals(ready[ii], solvers, stat);
+          printEpoch(ready[ii], stat, out);
         }
-        out << "    " << setw(2) << int(prn) << endl;
+      }
+      delete prev;
+      prev = epo;
+    }
+    delete first;
+    delete prev;
+
+    if (nEpo < 2) {
+      throw "t_sp3Comp: not enough common epochs";
+    }
+
+    // Estimate Clock Offsets
+    // ----------------------
+    if (iPass == 1) {
+      for (map<char, t_clkSolver>::iterator it = solvers.begin(); it != solvers.end(); it++) {
+        it->second.solve();
       }
     }
-    delete epo;
   }
 
   // Print Summary
@@ -417,6 +506,88 @@ void t_sp3Comp::compare(ostringstream& out) const {
   }
 }
 
+// Interpolation check of a single file
+//
+// Every tabulated position and clock is compared with the value
+// interpolated from the neighbouring epochs (bncSP3Orbits::interpolate,
+// the epoch itself excluded). The file is held in memory as a whole.
+////////////////////////////////////////////////////////////////////////////////
+void t_sp3Comp::checkInterpolation(ostringstream& out) const {
+
+  const string all = "ZZZ";
+
+  bncSP3Orbits in;
+  if (in.readFile(_sp3FileNames[0]) != success) {
+    throw "t_sp3Comp: cannot read the sp3 file";
+  }
+
+  map<string, t_stat> stat;
+  for (int iEpo = 0; iEpo < in.numEpochs(); iEpo++) {
+    const vector<t_prn>& prns = in.prns();
+    for (unsigned ip = 0; ip < prns.size(); ip++) {
+      const t_prn& prn = prns[ip];
+      if (excludeSat(prn)) {
+        continue;
+      }
+      ColumnVector xyz, xyzInt;
+      double       clk, clkInt;
+      bool         clkValid, clkValidInt;
+      if (!in.value(prn, iEpo, xyz, clk, clkValid) ||
+          in.interpolate(prn, in.epoch(iEpo), xyzInt, clkInt, clkValidInt,
+                         10, true) != success) {
+        continue;
+      }
+      ColumnVector dx = xyzInt - xyz;
+      stat[prn.toString()]._rao += SP(dx, dx);
+      stat[prn.toString()]._nr  += 1;
+      stat[all]._rao            += SP(dx, dx);
+      stat[all]._nr             += 1;
+      if (clkValid && clkValidInt) {
+        double dc = clkInt - clk;
+        stat[prn.toString()]._dc += dc * dc;
+        stat[prn.toString()]._nc += 1;
+        stat[all]._dc            += dc * dc;
+        stat[all]._nc            += 1;
+      }
+    }
+  }
+  if (stat[all]._nr == 0) {
+    throw "t_sp3Comp: not enough epochs for the interpolation check";
+  }
+
+  // Print Summary
+  // -------------
+  out.setf(ios::fixed);
+  out << "!\n! Interpolated minus tabulated values, RMS[m]"
+         "\n! (position: Lagrange polynomial over 10 epochs, clock: linear)\n";
+  out << "!\n!    PRN       x       y       z     nOrb    clk   nClk"
+           "\n! -----------------------------------------------------\n";
+  for (map<string, t_stat>::iterator it = stat.begin(); it != stat.end(); it++) {
+    const string& prn  = it->first;
+    t_stat&       stat = it->second;
+    if (stat._nr > 0) {
+      if (prn == all) {
+        out << "!\n!  Total ";
+      }
+      else {
+        out << "!    " << prn << ' ';
+      }
+      out << setw(7) << setprecision(4) << sqrt(stat._rao[0] / stat._nr) << ' '
+          << setw(7) << setprecision(4) << sqrt(stat._rao[1] / stat._nr) << ' '
+          << setw(7) << setprecision(4) << sqrt(stat._rao[2] / stat._nr) << ' '
+          << setw(6) << stat._nr << " ";
+      if (stat._nc > 0) {
+        out << setw(7) << setprecision(4) << sqrt(stat._dc / stat._nc) << ' '
+            << setw(6) << stat._nc;
+      }
+      else {
+        out << "  .       .";
+      }
+      out << endl;
+    }
+  }
+}
+
 //
 ////////////////////////////////////////////////////////////////////////////
 bool t_sp3Comp::excludeSat(const t_prn& prn) const {
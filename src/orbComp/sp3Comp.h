@@ -26,7 +26,6 @@
 #define SP3COMP_H
 
 #include <map>
-#include <set>
 #include <vector>
 #include <string>
 #include <sstream>
@@ -35,6 +34,8 @@
 #include "bnctime.h"
 #include "t_prn.h"
 
+class bncSP3Reader;
+
 class t_sp3Comp : public QThread {
 Q_OBJECT
  
@@ -80,10 +81,38 @@ Q_OBJECT
     int          _nc;
   };
 
-  int  satIndex(const std::set<t_prn>& clkSats, const t_prn& prn) const;
-  void processClocks(const std::set<t_prn>& clkSats, const std::vector<t_epoch*>& epochsIn,
-                     std::map<std::string, t_stat>& stat) const;
-  void compare(std::ostringstream& out) const;
+  // Clock offsets: one per epoch plus one per satellite (sum of the latter
+  // constrained to zero). The epoch offsets are eliminated epoch by epoch
+  // (Schur complement), so that only the satellite system is accumulated
+  // and solved; an epoch offset is recovered from the epoch's own data.
+  class t_clkSolver {
+   public:
+    t_clkSolver() : _nSat(0) {}
+    void   addEpoch(const std::vector<t_prn>& prns, const std::vector<double>& dc);
+    void   solve();
+    bool   satOffset(const t_prn& prn, double& offset) const;
+    double epochOffset(const std::vector<t_prn>& prns, const std::vector<double>& dc) const;
+   private:
+    int                  index(const t_prn& prn);
+    std::map<t_prn, int> _index;
+    int                  _nSat;
+    std::vector<double>  _NN;   // lower triangle, row-wise (as SymmetricMatrix)
+    std::vector<double>  _bb;
+    std::vector<double>  _xx;
+  };
+
+  t_epoch* readEpoch(bncSP3Reader& in1, bncSP3Reader& in2) const;
+  void     transformEpoch(t_epoch* epoch, const t_epoch* epoch2) const;
+  void     splitClocks(const t_epoch* epoch,
+                       std::map<char, std::vector<t_prn> >& prns,
+                       std::map<char, std::vector<double> >& dc) const;
+  void     addClocks(const t_epoch* epoch, std::map<char, t_clkSolver>& solvers) const;
+  void     clockResiduals(t_epoch* epoch, const std::map<char, t_clkSolver>& solvers,
+                          std::map<std::string, t_stat>& stat) const;
+  void     printEpoch(const t_epoch* epoch, std::map<std::string, t_stat>& stat,
+                      std::ostringstream& out) const;
+  void     compare(std::ostringstream& out) const;
+  void     checkInterpolation(std::ostringstream& out) const;
   bool excludeSat(const t_prn& prn) const;
 
   QStringList  _sp3FileNames;
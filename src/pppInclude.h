@@ -35,6 +35,12 @@ class t_output {
   double       _trpStdev;
   int          _numSat;       
   double       _hDop;         
+  int          _numResCode;
+  double       _rmsResCode;
+  double       _maxResCode;
+  int          _numResPhase;
+  double       _rmsResPhase;
+  double       _maxResPhase;
   std::string  _log;          
   bool         _error;      \
   
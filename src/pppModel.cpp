@@ -27,7 +27,7 @@
  * BKG NTRIP Client
  * -------------------------------------------------------------------------
  *
- * Class:      t_astro, t_tides, t_tropo
+ * Class:      t_astro, t_tidesEpoch, t_tides, t_tropo
  *
  * Purpose:    Observation model
  *
@@ -40,13 +40,33 @@
  * -----------------------------------------------------------------------*/
 
 
+#include <algorithm>
 #include <cmath>
+#include <map>
+#include <vector>
+#include <QMap>
+#include <QMutex>
 
 #include "pppModel.h"
 
 using namespace BNC_PPP;
 using namespace std;
 
+namespace {
+
+  // Recent epochs of the shared tidal quantities
+  // --------------------------------------------
+  const int                  MAXTIDESEPOCHS = 16;
+  QMutex                     tidesMutex;
+  QMap<double, t_tidesEpoch> tidesEpochs;
+
+  // BLQ files read so far (station name -> ocean loading parameters)
+  // ----------------------------------------------------------------
+  typedef map<string, vector<double> > t_blqTable;
+  QMutex                     blqMutex;
+  map<string, t_blqTable>    blqTables;
+}
+
 const double t_astro::RHO_DEG   = 180.0 / M_PI;
 const double t_astro::RHO_SEC   = 3600.0 * 180.0 / M_PI;
 const double t_astro::MJD_J2000 = 51544.5;
@@ -217,38 +237,51 @@ ColumnVector t_astro::Moon(double Mjd_TT) {
 //+++++++++++++++++++++++++++++++++++++++++++
 
 /* read blq ocean tide loading parameters --------------------------------------
-* read blq ocean tide loading parameters
+* read blq ocean tide loading parameters (the file is scanned once per process,
+* its records are kept in a table indexed by station name)
 * args   : char   *file       I   BLQ ocean tide loading parameter file
 *          char   *sta        I   station name
 *          double *odisp      O   ocean tide loading parameters
-* return : status (1:ok,0:file open error)
+* return : status (1:ok,0:file open error or station not found)
 *-----------------------------------------------------------------------------*/
 int t_tides::readblq(const char* file, const char* sta, double* odisp){
 
-    FILE *fp;
     char buff[256],staname[32]="",name[32],*p;
     
     /* station name to upper case */
     sscanf(sta,"%16s",staname);
     for (p=staname;(*p=(char)toupper((int)(*p)));p++) ;
     
-    if (!(fp=fopen(file,"r"))) {
-        return 0;
-    }
-    while (fgets(buff,sizeof(buff),fp)) {
-        if (!strncmp(buff,"$$",2)||strlen(buff)<2)continue;
-        if (sscanf(buff+2,"%16s",name)<1) continue;
-        for (p=name;(*p=(char)toupper((int)(*p)));p++) ;
-        if (strcmp(name,staname)) continue;
-        
-        /* read blq record */
-        if (readblqrecord(fp,odisp)) {
-            fclose(fp);
-            return 1;
+    QMutexLocker locker(&blqMutex);
+
+    map<string, t_blqTable>::iterator itFile = blqTables.find(file);
+    if (itFile == blqTables.end()) {
+        t_blqTable& table = blqTables[file];
+        FILE *fp;
+        if (!(fp=fopen(file,"r"))) {
+            return 0;
         }
+        while (fgets(buff,sizeof(buff),fp)) {
+            if (!strncmp(buff,"$$",2)||strlen(buff)<2)continue;
+            if (sscanf(buff+2,"%16s",name)<1) continue;
+            for (p=name;(*p=(char)toupper((int)(*p)));p++) ;
+            
+            /* read blq record */
+            vector<double> record(6*11);
+            if (readblqrecord(fp,&record[0]) && table.find(name)==table.end()) {
+                table[name]=record;
+            }
+        }
+        fclose(fp);
+        itFile = blqTables.find(file);
     }
-    fclose(fp);
-    return 0;
+
+    t_blqTable::const_iterator itSta = itFile->second.find(staname);
+    if (itSta == itFile->second.end()) {
+        return 0;
+    }
+    copy(itSta->second.begin(), itSta->second.end(), odisp);
+    return 1;
 }
 /* read blq record -----------------------------------------------------------*/
 int t_tides::readblqrecord(FILE* fp, double* odisp){
@@ -264,77 +297,40 @@ int t_tides::readblqrecord(FILE* fp, double* odisp){
     }
     return 0;
 } 
-void t_tides::tide_oload(gtime_t tut, const double* odisp, double* denu){
-    const double args[][5]={
-        {1.40519E-4, 2.0,-2.0, 0.0, 0.00},  /* M2 */
-        {1.45444E-4, 0.0, 0.0, 0.0, 0.00},  /* S2 */
-        {1.37880E-4, 2.0,-3.0, 1.0, 0.00},  /* N2 */
-        {1.45842E-4, 2.0, 0.0, 0.0, 0.00},  /* K2 */
-        {0.72921E-4, 1.0, 0.0, 0.0, 0.25},  /* K1 */
-        {0.67598E-4, 1.0,-2.0, 0.0,-0.25},  /* O1 */
-        {0.72523E-4,-1.0, 0.0, 0.0,-0.25},  /* P1 */
-        {0.64959E-4, 1.0,-3.0, 1.0,-0.25},  /* Q1 */
-        {0.53234E-5, 0.0, 2.0, 0.0, 0.00},  /* Mf */
-        {0.26392E-5, 0.0, 1.0,-1.0, 0.00},  /* Mm */
-        {0.03982E-5, 2.0, 0.0, 0.0, 0.00}   /* Ssa */
-    };
-    const double ep1975[]={1975,1,1,0,0,0};
-    double ep[6],fday,days,t,t2,t3,a[5],ang,dp[3]={0};
-    int i,j;
-    
-    //trace(3,"tide_oload:\n");
-   
-    /* angular argument: see subroutine arg.f for reference [1] */
-    time2epoch(tut,ep);
-    fday=ep[3]*3600.0+ep[4]*60.0+ep[5];
-    ep[3]=ep[4]=ep[5]=0.0;
-    days=timediff(epoch2time(ep),epoch2time(ep1975))/86400.0+1.0;
-    t=(27392.500528+1.000000035*days)/36525.0;
-    t2=t*t; t3=t2*t;
-    
-    a[0]=fday;
-    a[1]=(279.69668+36000.768930485*t+3.03E-4*t2)*D2R; /* H0 */
-    a[2]=(270.434358+481267.88314137*t-0.001133*t2+1.9E-6*t3)*D2R; /* S0 */
-    a[3]=(334.329653+4069.0340329577*t-0.010325*t2-1.2E-5*t3)*D2R; /* P0 */
-    a[4]=2.0*M_PI;
-    
-    /* displacements by 11 constituents */
-    for (i=0;i<11;i++) {
-        ang=0.0;
-        for (j=0;j<5;j++) ang+=a[j]*args[i][j];
-        for (j=0;j<3;j++) dp[j]+=odisp[j+i*6]*cos(ang-odisp[j+3+i*6]*D2R);
-    }
-    denu[0]=-dp[1];
-    denu[1]=-dp[2];
-    denu[2]= dp[0];    
-}
 
 ColumnVector t_tides::tideOcean(const bncTime& time, const ColumnVector& xyz){
-	gtime_t tutc = bncTimeTogtime(time);
-	double ell[3];
-	xyz2ell(xyz.data(), ell);
-  		 
-    gtime_t tut;
-    double E[9],drt[3],denu[3],rs[3],rm[3],gmst,erpv[5]={0};
-    int i;  
-    tut=timeadd(tutc,erpv[2]);
+
     ColumnVector dX(3); dX = 0.0;
-	double dr[3];
-    dr[0]=dr[1]=dr[2]=0.0;
-    xyz2enu(ell,E);
-    	
+
     /* ocean tide loading */
-	if (_blqfile) {	
-        tide_oload(tut,_odisp,denu);
-        //std::cout << "\nOcean tide loading" << std::endl; 
-        matmul("TN",3,1,3,1.0,E,denu,0.0,drt);
-        for (i=0;i<3;i++) dr[i]+=drt[i];     
+    if (!_blqfile || time.undef() ||
+        (xyz[0] == 0.0 && xyz[1] == 0.0 && xyz[2] == 0.0)) {
+        return dX;
     }
 
-    
-    dX[0] = dr[0];
-    dX[1] = dr[1];
-    dX[2] = dr[2];
+    /* the displacement changes slowly, its ENU components are evaluated
+       once per epoch and projected to XYZ at the given position */
+    double Mjd = time.mjd() + time.daysec() / 86400.0;
+    if (Mjd != _oceanMjd) {
+        setEpoch(time);
+
+        double dp[3];
+        for (int j=0;j<3;j++) {
+            dp[j]=0.0;
+            for (int i=0;i<t_tidesEpoch::NUMCONST;i++) {
+                dp[j]+=_oceanCos[j][i]*_epoch._cosArg[i]+_oceanSin[j][i]*_epoch._sinArg[i];
+            }
+        }
+        _oceanEnu[0] = -dp[1];
+        _oceanEnu[1] = -dp[2];
+        _oceanEnu[2] =  dp[0];
+        _oceanMjd = Mjd;
+    }
+
+    double ell[3],E[9];
+    xyz2ell(xyz.data(), ell);
+    xyz2enu(ell,E);
+    matmul("TN",3,1,3,1.0,E,_oceanEnu,0.0,dX.data());
     return dX;
 }
 // Constructor
@@ -345,47 +341,130 @@ t_tides::t_tides(std::string roverName, std::string cwd) {
 	 * 		roverName
 	 * 		cwd : execute path
 	 */
-	_lastMjd = 0.0;
-	_rSun    = 0.0;
-	_rMoon   = 0.0;
-	_blqfile = 0;
+	_epoch._mjd = 0.0;
+	_oceanMjd   = 0.0;
+	_blqfile    = 0;
  
-	char* rn = strdup(roverName.c_str());
 	std::string strblq = cwd + "/Example_Configs/tides/OTL.blq";
-	char* blqfile = strdup(strblq.c_str());	
-	_blqfile = readblq(blqfile, rn, _odisp); 
-	free(blqfile);
-	free(rn);
+	_blqfile = readblq(strblq.c_str(), roverName.c_str(), _odisp);
+
+	/* amplitudes and phases of the constituents for the multiply-adds in
+	   tideOcean: A*cos(arg-phase) = A*cos(phase)*cos(arg)+A*sin(phase)*sin(arg) */
+	for (int i=0;i<t_tidesEpoch::NUMCONST;i++) {
+		for (int j=0;j<3;j++) {
+			double amp   = _blqfile ? _odisp[j+i*6]       : 0.0;
+			double phase = _blqfile ? _odisp[j+3+i*6]*D2R : 0.0;
+			_oceanCos[j][i] = amp*cos(phase);
+			_oceanSin[j][i] = amp*sin(phase);
+		}
+	}
 }
 //+++++++++++++++++++++++++++++++++++++++++++
 
+// Shared epoch quantities (computed once per epoch for all rovers)
+////////////////////////////////////////////////////////////////////////////
+void t_tidesEpoch::get(const bncTime& time, t_tidesEpoch& epoch) {
+
+  double Mjd = time.mjd() + time.daysec() / 86400.0;
+
+  QMutexLocker locker(&tidesMutex);
+
+  QMap<double, t_tidesEpoch>::const_iterator it = tidesEpochs.find(Mjd);
+  if (it != tidesEpochs.end()) {
+    epoch = it.value();
+    return;
+  }
+
+  epoch.compute(time);
+  tidesEpochs[Mjd] = epoch;
+  while (tidesEpochs.size() > MAXTIDESEPOCHS) {
+    tidesEpochs.erase(tidesEpochs.begin());
+  }
+}
+
+// Sun, Moon and ocean loading arguments
+////////////////////////////////////////////////////////////////////////////
+void t_tidesEpoch::compute(const bncTime& time) {
+
+  _mjd = time.mjd() + time.daysec() / 86400.0;
+
+  ColumnVector xSun = t_astro::Sun(_mjd);
+  _rSun = sqrt(DotProduct(xSun,xSun));
+  ColumnVector xMoon = t_astro::Moon(_mjd);
+  _rMoon = sqrt(DotProduct(xMoon,xMoon));
+  for (int ii = 0; ii < 3; ii++) {
+    _xSun[ii]  = xSun[ii]  / _rSun;
+    _xMoon[ii] = xMoon[ii] / _rMoon;
+  }
 
+  // Angular arguments of the ocean loading constituents (see subroutine arg.f)
+  // --------------------------------------------------------------------------
+  const double args[][5]={
+      {1.40519E-4, 2.0,-2.0, 0.0, 0.00},  /* M2 */
+      {1.45444E-4, 0.0, 0.0, 0.0, 0.00},  /* S2 */
+      {1.37880E-4, 2.0,-3.0, 1.0, 0.00},  /* N2 */
+      {1.45842E-4, 2.0, 0.0, 0.0, 0.00},  /* K2 */
+      {0.72921E-4, 1.0, 0.0, 0.0, 0.25},  /* K1 */
+      {0.67598E-4, 1.0,-2.0, 0.0,-0.25},  /* O1 */
+      {0.72523E-4,-1.0, 0.0, 0.0,-0.25},  /* P1 */
+      {0.64959E-4, 1.0,-3.0, 1.0,-0.25},  /* Q1 */
+      {0.53234E-5, 0.0, 2.0, 0.0, 0.00},  /* Mf */
+      {0.26392E-5, 0.0, 1.0,-1.0, 0.00},  /* Mm */
+      {0.03982E-5, 2.0, 0.0, 0.0, 0.00}   /* Ssa */
+  };
+  const double ep1975[]={1975,1,1,0,0,0};
+  double ep[6],fday,days,t,t2,t3,a[5];
+
+  time2epoch(bncTimeTogtime(time),ep);
+  fday=ep[3]*3600.0+ep[4]*60.0+ep[5];
+  ep[3]=ep[4]=ep[5]=0.0;
+  days=timediff(epoch2time(ep),epoch2time(ep1975))/86400.0+1.0;
+  t=(27392.500528+1.000000035*days)/36525.0;
+  t2=t*t; t3=t2*t;
+
+  a[0]=fday;
+  a[1]=(279.69668+36000.768930485*t+3.03E-4*t2)*D2R; /* H0 */
+  a[2]=(270.434358+481267.88314137*t-0.001133*t2+1.9E-6*t3)*D2R; /* S0 */
+  a[3]=(334.329653+4069.0340329577*t-0.010325*t2-1.2E-5*t3)*D2R; /* P0 */
+  a[4]=2.0*M_PI;
+
+  for (int i = 0; i < NUMCONST; i++) {
+    double ang = 0.0;
+    for (int j = 0; j < 5; j++) {
+      ang += a[j]*args[i][j];
+    }
+    _cosArg[i] = cos(ang);
+    _sinArg[i] = sin(ang);
+  }
+}
 
+// Fetch the shared epoch quantities if the epoch changed
+////////////////////////////////////////////////////////////////////////////
+void t_tides::setEpoch(const bncTime& time) {
+  double Mjd = time.mjd() + time.daysec() / 86400.0;
+  if (Mjd != _epoch._mjd) {
+    t_tidesEpoch::get(time, _epoch);
+  }
+}
 
 // Tidal Correction 
 ////////////////////////////////////////////////////////////////////////////
 ColumnVector t_tides::displacement(const bncTime& time, const ColumnVector& xyz) {
 
+  ColumnVector dX(3); dX = 0.0;
+
   if (time.undef()) {
-    ColumnVector dX(3); dX = 0.0;
     return dX;
   }
 
-  double Mjd = time.mjd() + time.daysec() / 86400.0;
+  setEpoch(time);
 
-  if (Mjd != _lastMjd) {
-    _lastMjd = Mjd;
-    _xSun = t_astro::Sun(Mjd);
-    _rSun = sqrt(DotProduct(_xSun,_xSun));
-    _xSun /= _rSun;
-    _xMoon = t_astro::Moon(Mjd);
-    _rMoon = sqrt(DotProduct(_xMoon,_xMoon));
-    _xMoon /= _rMoon;
+  double rRec    = sqrt(DotProduct(xyz, xyz));
+  double xyzUnit[3];
+  for (int ii = 0; ii < 3; ii++) {
+    xyzUnit[ii] = xyz[ii] / rRec;
   }
 
-  double       rRec    = sqrt(DotProduct(xyz, xyz));
-  ColumnVector xyzUnit = xyz / rRec;
-
   // Love's Numbers
   // --------------
   const double H2 = 0.6078;
@@ -393,8 +472,10 @@ ColumnVector t_tides::displacement(const bncTime& time, const ColumnVector& xyz)
 
   // Tidal Displacement
   // ------------------
-  double scSun  = DotProduct(xyzUnit, _xSun);
-  double scMoon = DotProduct(xyzUnit, _xMoon);
+  double scSun  = xyzUnit[0] * _epoch._xSun[0]  + xyzUnit[1] * _epoch._xSun[1]
+                + xyzUnit[2] * _epoch._xSun[2];
+  double scMoon = xyzUnit[0] * _epoch._xMoon[0] + xyzUnit[1] * _epoch._xMoon[1]
+                + xyzUnit[2] * _epoch._xMoon[2];
 
   double p2Sun  = 3.0 * (H2/2.0-L2) * scSun  * scSun  - H2/2.0;
   double p2Moon = 3.0 * (H2/2.0-L2) * scMoon * scMoon - H2/2.0;
@@ -406,14 +487,19 @@ ColumnVector t_tides::displacement(const bncTime& time, const ColumnVector& xyz)
   const double gms   = 1.3271250e20;
   const double gmm   = 4.9027890e12;
 
+  const double rSun  = _epoch._rSun;
+  const double rMoon = _epoch._rMoon;
+
   double facSun  = gms / gmWGS * 
-                   (rRec * rRec * rRec * rRec) / (_rSun * _rSun * _rSun);
+                   (rRec * rRec * rRec * rRec) / (rSun * rSun * rSun);
 
   double facMoon = gmm / gmWGS * 
-                   (rRec * rRec * rRec * rRec) / (_rMoon * _rMoon * _rMoon);
+                   (rRec * rRec * rRec * rRec) / (rMoon * rMoon * rMoon);
 
-  ColumnVector dX = facSun  * (x2Sun  * _xSun  + p2Sun  * xyzUnit) + 
-                    facMoon * (x2Moon * _xMoon + p2Moon * xyzUnit);
+  for (int ii = 0; ii < 3; ii++) {
+    dX[ii] = facSun  * (x2Sun  * _epoch._xSun[ii]  + p2Sun  * xyzUnit[ii]) +
+             facMoon * (x2Moon * _epoch._xMoon[ii] + p2Moon * xyzUnit[ii]);
+  }
 
   return dX;
 }
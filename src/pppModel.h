@@ -53,6 +53,25 @@ class t_astro {
   static Matrix PrecMatrix (double Mjd_1, double Mjd_2);
 };
 
+// Station-independent tidal quantities of one epoch (shared by all rovers)
+////////////////////////////////////////////////////////////////////////////
+class t_tidesEpoch {
+ public:
+  enum {NUMCONST = 11};                // ocean loading constituents
+  static void get(const bncTime& time, t_tidesEpoch& epoch);
+
+  double _mjd;
+  double _xSun[3];                     // unit vector
+  double _rSun;
+  double _xMoon[3];                    // unit vector
+  double _rMoon;
+  double _cosArg[NUMCONST];            // astronomical arguments
+  double _sinArg[NUMCONST];
+
+ private:
+  void compute(const bncTime& time);
+};
+
 class t_tides {
  public:
   t_tides(std::string blqfile, std::string cwd);
@@ -61,12 +80,11 @@ class t_tides {
   
  /* Modified by Chaiyut 02-JUN-2017*/
  /*++++++++++++++++++++++++++++++++*/
-	void tide_oload(gtime_t tut, const double* odisp, double* denu);
 	ColumnVector tideOcean(const bncTime& time, const ColumnVector& xyz);
 	
-	int readblq(const char* file, const char* sta, double* odisp);
+	static int readblq(const char* file, const char* sta, double* odisp);
 	
-	int readblqrecord(FILE* fp, double* odisp);
+	static int readblqrecord(FILE* fp, double* odisp);
 
 	double 	_odisp[6*11];
 	bool 	_blqfile;		
@@ -75,6 +93,8 @@ class t_tides {
  
    
  private:
+  void setEpoch(const bncTime& time);
+
  /* Modified by Chaiyut 02-JUN-2017*/
  /*++++++++++++++++++++++++++++++++*/
 	static const double RE_WGS84;
@@ -86,11 +106,11 @@ class t_tides {
 	static const std::string FILEPATH;
 
  /*++++++++++++++END ++++++++++++++++++*/  
-  double       _lastMjd;
-  ColumnVector _xSun;
-  ColumnVector _xMoon;
-  double       _rSun;
-  double       _rMoon;
+  t_tidesEpoch _epoch;
+  double       _oceanCos[3][t_tidesEpoch::NUMCONST]; // amplitude * cos(phase)
+  double       _oceanSin[3][t_tidesEpoch::NUMCONST]; // amplitude * sin(phase)
+  double       _oceanMjd;                           // epoch of _oceanEnu
+  double       _oceanEnu[3];
 };
 
 class t_windUp {
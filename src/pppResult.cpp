@@ -0,0 +1,501 @@
+// Part of BNC, a utility for retrieving decoding and
+// converting GNSS data streams from NTRIP broadcasters.
+//
+// Copyright (C) 2007
+// German Federal Agency for Cartography and Geodesy (BKG)
+// http://www.bkg.bund.de
+// Czech Technical University Prague, Department of Geodesy
+// http://www.fsv.cvut.cz
+//
+// Email: euref-ip@bkg.bund.de
+//
+// This program is free software; you can redistribute it and/or
+// modify it under the terms of the GNU General Public License
+// as published by the Free Software Foundation, version 2.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program; if not, write to the Free Software
+// Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA 02111-1307, USA.
+
+/* -------------------------------------------------------------------------
+ * BKG NTRIP Client
+ * -------------------------------------------------------------------------
+ *
+ * Class:      t_pppResult, t_pppResultFile, t_pppResultWriter
+ *
+ * Purpose:    PPP results of one epoch and their output
+ *
+ * Changes:
+ *
+ * -----------------------------------------------------------------------*/
+
+#include <cmath>
+#include <iomanip>
+#include <sstream>
+
+#include <QElapsedTimer>
+
+#include "pppResult.h"
+#include "bnccore.h"
+#include "bncsinextro.h"
+#include "bncutils.h"
+
+using namespace BNC_PPP;
+using namespace std;
+
+// Constructor
+////////////////////////////////////////////////////////////////////////////
+t_pppResult::t_pppResult() {
+  _error    = true;
+  _trp0     = 0.0;
+  _trp      = 0.0;
+  _trpStdev = 0.0;
+  _numSat   = 0;
+  _hDop     = 0.0;
+  _blq      = 0.0;
+  for (int ii = 0; ii < 3; ii++) {
+    _xyz[ii]  = 0.0;
+    _neu[ii]  = 0.0;
+    _tide[ii] = 0.0;
+  }
+  for (int ii = 0; ii < 6; ii++) {
+    _covMatrix[ii] = 0.0;
+  }
+  for (int ii = 0; ii < 2; ii++) {
+    _numRes[ii] = 0;
+    _rmsRes[ii] = 0.0;
+    _maxRes[ii] = 0.0;
+  }
+}
+
+// Constructor
+////////////////////////////////////////////////////////////////////////////
+t_pppResult::t_pppResult(const QByteArray& staID, const t_output& output) {
+  *this    = t_pppResult();
+  _staID   = staID;
+  _epoTime = output._epoTime;
+  _error   = output._error;
+  _log     = QByteArray(output._log.data(), output._log.size());
+  if (_error) {
+    return;
+  }
+  for (int ii = 0; ii < 3; ii++) {
+    _xyz[ii]  = output._xyzRover[ii];
+    _neu[ii]  = output._neu[ii];
+    _tide[ii] = output._xyz[ii];
+  }
+  for (int ii = 0; ii < 6; ii++) {
+    _covMatrix[ii] = output._covMatrix[ii];
+  }
+  _trp0      = output._trp0;
+  _trp       = output._trp;
+  _trpStdev  = output._trpStdev;
+  _numSat    = output._numSat;
+  _hDop      = output._hDop;
+  _numRes[0] = output._numResCode;
+  _rmsRes[0] = output._rmsResCode;
+  _maxRes[0] = output._maxResCode;
+  _numRes[1] = output._numResPhase;
+  _rmsRes[1] = output._rmsResPhase;
+  _maxRes[1] = output._maxResPhase;
+  _blq       = output._tempDb;
+}
+
+// One-line summary for BNC's log (detailed log if no solution)
+////////////////////////////////////////////////////////////////////////////
+QByteArray t_pppResult::logLine() const {
+  if (_error) {
+    return _log;
+  }
+  ostringstream log;
+  log.setf(ios::fixed);
+  log << string(_epoTime) << ' ' << _staID.data()
+      << " X = "  << setprecision(4) << _xyz[0]
+      << " Y = "  << setprecision(4) << _xyz[1]
+      << " Z = "  << setprecision(4) << _xyz[2]
+      << " NEU: " << showpos << setw(8) << setprecision(4) << _neu[0]
+      << " "      << showpos << setw(8) << setprecision(4) << _neu[1]
+      << " "      << showpos << setw(8) << setprecision(4) << _neu[2]
+      << " TRP: " << showpos << setw(8) << setprecision(4) << _trp0
+      << " "      << showpos << setw(8) << setprecision(4) << _trp
+      << " STD "  << showpos << setw(8) << setprecision(4) << _trpStdev
+      << " STR: " << "OCEAN"
+      << " TIDE: " << showpos << setw(8) << setprecision(4) << _tide[0]
+      << " "      << showpos << setw(8) << setprecision(4) << _tide[1]
+      << " "      << showpos << setw(8) << setprecision(4) << _tide[2]
+      << " BLQ"   << showpos << setw(8) << setprecision(1) << _blq;
+  return QByteArray(log.str().c_str());
+}
+
+// NMEA sentence ('R' = GPRMC, 'G' = GPGGA)
+////////////////////////////////////////////////////////////////////////////
+QString t_pppResult::nmeaString(char strType) const {
+
+  double ell[3];
+  xyz2ell(_xyz, ell);
+  double phiDeg = ell[0] * 180 / M_PI;
+  double lamDeg = ell[1] * 180 / M_PI;
+
+  unsigned year, month, day;
+  _epoTime.civil_date(year, month, day);
+  double gps_utc = gnumleap(year, month, day);
+
+  char phiCh = 'N';
+  if (phiDeg < 0) {
+    phiDeg = -phiDeg;
+    phiCh  =  'S';
+  }
+  char lamCh = 'E';
+  if (lamDeg < 0) {
+    lamDeg = -lamDeg;
+    lamCh  =  'W';
+  }
+
+  ostringstream out;
+  out.setf(ios::fixed);
+
+  if      (strType == 'R') {
+    string datestr = _epoTime.datestr(0); // yyyymmdd
+    out << "GPRMC,"
+        << (_epoTime - gps_utc).timestr(3,0) << ",A,"
+        << setw(2) << setfill('0') << int(phiDeg)
+        << setw(6) << setprecision(3) << setfill('0')
+        << fmod(60*phiDeg,60) << ',' << phiCh << ','
+        << setw(3) << setfill('0') << int(lamDeg)
+        << setw(6) << setprecision(3) << setfill('0')
+        << fmod(60*lamDeg,60) << ',' << lamCh << ",,,"
+        << datestr[6] << datestr[7] << datestr[4] << datestr[5]
+        << datestr[2] << datestr[3] << ",,";
+  }
+  else if (strType == 'G') {
+    out << "GPGGA,"
+        << (_epoTime - gps_utc).timestr(2,0) << ','
+        << setw(2) << setfill('0') << int(phiDeg)
+        << setw(10) << setprecision(7) << setfill('0')
+        << fmod(60*phiDeg,60) << ',' << phiCh << ','
+        << setw(3) << setfill('0') << int(lamDeg)
+        << setw(10) << setprecision(7) << setfill('0')
+        << fmod(60*lamDeg,60) << ',' << lamCh
+        << ",1," << setw(2) << setfill('0') << _numSat << ','
+        << setw(3) << setprecision(1) << _hDop << ','
+        << setprecision(3) << ell[2] << ",M,0.0,M,,";
+  }
+  else {
+    return "";
+  }
+
+  QString nmStr(out.str().c_str());
+  unsigned char XOR = 0;
+  for (int ii = 0; ii < nmStr.length(); ii++) {
+    XOR ^= (unsigned char) nmStr[ii].toAscii();
+  }
+
+  return '$' + nmStr + QString("*%1").arg(XOR, 2, 16, QLatin1Char('0'));
+}
+
+// Binary record (without the detailed log)
+////////////////////////////////////////////////////////////////////////////
+QDataStream& BNC_PPP::operator<<(QDataStream& out, const t_pppResult& result) {
+  out << quint32(result._epoTime.mjd()) << result._epoTime.daysec()
+      << quint8(result._error);
+  for (int ii = 0; ii < 3; ii++) {
+    out << result._xyz[ii];
+  }
+  for (int ii = 0; ii < 6; ii++) {
+    out << result._covMatrix[ii];
+  }
+  for (int ii = 0; ii < 3; ii++) {
+    out << result._neu[ii];
+  }
+  out << result._trp0 << result._trp << result._trpStdev
+      << qint32(result._numSat) << result._hDop;
+  for (int ii = 0; ii < 2; ii++) {
+    out << qint32(result._numRes[ii]) << result._rmsRes[ii] << result._maxRes[ii];
+  }
+  for (int ii = 0; ii < 3; ii++) {
+    out << result._tide[ii];
+  }
+  out << result._blq;
+  return out;
+}
+
+//
+////////////////////////////////////////////////////////////////////////////
+QDataStream& BNC_PPP::operator>>(QDataStream& in, t_pppResult& result) {
+  quint32 mjd;
+  double  daysec;
+  quint8  error;
+  qint32  numSat;
+  in >> mjd >> daysec >> error;
+  result._epoTime.setmjd(daysec, mjd);
+  result._error = error;
+  for (int ii = 0; ii < 3; ii++) {
+    in >> result._xyz[ii];
+  }
+  for (int ii = 0; ii < 6; ii++) {
+    in >> result._covMatrix[ii];
+  }
+  for (int ii = 0; ii < 3; ii++) {
+    in >> result._neu[ii];
+  }
+  in >> result._trp0 >> result._trp >> result._trpStdev >> numSat >> result._hDop;
+  result._numSat = numSat;
+  for (int ii = 0; ii < 2; ii++) {
+    qint32 numRes;
+    in >> numRes >> result._rmsRes[ii] >> result._maxRes[ii];
+    result._numRes[ii] = numRes;
+  }
+  for (int ii = 0; ii < 3; ii++) {
+    in >> result._tide[ii];
+  }
+  in >> result._blq;
+  return in;
+}
+
+// Constructor
+////////////////////////////////////////////////////////////////////////////
+t_pppResultFile::t_pppResultFile(const QByteArray& staID,
+                                 const QString& sklFileName,
+                                 const QString& intr, int sampl) :
+  bncoutf(sklFileName, intr, sampl) {
+  _staID  = staID;
+  _binary = true;
+}
+
+// File Header
+////////////////////////////////////////////////////////////////////////////
+void t_pppResultFile::writeHeader(const QDateTime& /* datTim */) {
+  QByteArray header;
+  QDataStream out(&header, QIODevice::WriteOnly);
+  out.setVersion(QDataStream::Qt_4_6);
+  out << MAGIC << VERSION << _staID;
+  _out.write(header.data(), header.size());
+}
+
+// Write one epoch
+////////////////////////////////////////////////////////////////////////////
+t_irc t_pppResultFile::write(const t_pppResult& result) {
+  QByteArray record;
+  QDataStream out(&record, QIODevice::WriteOnly);
+  out.setVersion(QDataStream::Qt_4_6);
+  out << result;
+  return bncoutf::write(result._epoTime.gpsw(), result._epoTime.gpssec(),
+                        record.data(), record.size());
+}
+
+// Read and check the file header (post-analysis)
+////////////////////////////////////////////////////////////////////////////
+t_irc t_pppResultFile::readHeader(QDataStream& in, QByteArray& staID) {
+  quint32 magic;
+  quint16 version;
+  in.setVersion(QDataStream::Qt_4_6);
+  in >> magic >> version >> staID;
+  if (in.status() != QDataStream::Ok || magic != MAGIC || version != VERSION) {
+    return failure;
+  }
+  return success;
+}
+
+// Single instance (started on first use, runs until the program ends)
+////////////////////////////////////////////////////////////////////////////
+t_pppResultWriter* t_pppResultWriter::instance() {
+  static QMutex             mutex;
+  static t_pppResultWriter* writer = 0;
+  QMutexLocker locker(&mutex);
+  if (!writer) {
+    writer = new t_pppResultWriter();
+    writer->start();
+  }
+  return writer;
+}
+
+// Constructor
+////////////////////////////////////////////////////////////////////////////
+t_pppResultWriter::t_pppResultWriter() {
+  _nextSta = 0;
+
+  connect(this, SIGNAL(newMessage(QByteArray,bool)),
+          BNC_CORE, SLOT(slotMessage(const QByteArray,bool)));
+
+  connect(this,     SIGNAL(newNMEAstr(QByteArray, QByteArray)),
+          BNC_CORE, SIGNAL(newNMEAstr(QByteArray, QByteArray)));
+}
+
+// Destructor
+////////////////////////////////////////////////////////////////////////////
+t_pppResultWriter::~t_pppResultWriter() {
+}
+
+// Register the files of a station
+////////////////////////////////////////////////////////////////////////////
+int t_pppResultWriter::addStation(bncoutf* logFile, bncoutf* nmeaFile,
+                                  bncSinexTro* snxtroFile,
+                                  t_pppResultFile* resultFile) {
+  t_station station;
+  station._logFile    = logFile;
+  station._nmeaFile   = nmeaFile;
+  station._snxtroFile = snxtroFile;
+  station._resultFile = resultFile;
+  if (logFile) {
+    logFile->setAutoFlush(false);
+  }
+  if (nmeaFile) {
+    nmeaFile->setAutoFlush(false);
+  }
+  if (snxtroFile) {
+    snxtroFile->setAutoFlush(false);
+  }
+  if (resultFile) {
+    resultFile->setAutoFlush(false);
+  }
+
+  QMutexLocker locker(&_mutex);
+  int iSta = _nextSta++;
+  _stations[iSta] = station;
+  return iSta;
+}
+
+// Queue a result
+////////////////////////////////////////////////////////////////////////////
+void t_pppResultWriter::post(int iSta, const t_pppResult& result) {
+  QMutexLocker locker(&_mutex);
+  while (_items.size() >= MAXPENDING) {
+    _queueNotFull.wait(&_mutex);
+  }
+  t_item item;
+  item._iSta   = iSta;
+  item._result = result;
+  _items.enqueue(item);
+  _newItem.wakeOne();
+}
+
+// Remove a station after its queued results are written
+////////////////////////////////////////////////////////////////////////////
+void t_pppResultWriter::removeStation(int iSta) {
+  QMutexLocker locker(&_mutex);
+  t_item item;
+  item._iSta   = iSta;
+  item._remove = true;
+  _items.enqueue(item);
+  _newItem.wakeOne();
+  while (_stations.contains(iSta)) {
+    _removed.wait(&_mutex);
+  }
+}
+
+// Thread loop
+////////////////////////////////////////////////////////////////////////////
+void t_pppResultWriter::run() {
+
+  QElapsedTimer flushTimer;
+  flushTimer.start();
+
+  while (true) {
+    t_item    item;
+    t_station station;
+    {
+      QMutexLocker locker(&_mutex);
+      if (_items.isEmpty()) {
+        qint64 msec = FLUSHMSEC - flushTimer.elapsed();
+        if (msec > 0) {
+          _newItem.wait(&_mutex, msec);
+        }
+      }
+      if (!_items.isEmpty()) {
+        item = _items.dequeue();
+        _queueNotFull.wakeOne();
+        station = _stations.value(item._iSta);
+      }
+    }
+
+    // Write a result, close the files of a removed station
+    // ----------------------------------------------------
+    if      (item._remove) {
+      station.flush();
+      delete station._logFile;
+      delete station._nmeaFile;
+      delete station._snxtroFile;
+      delete station._resultFile;
+      QMutexLocker locker(&_mutex);
+      _stations.remove(item._iSta);
+      _removed.wakeAll();
+    }
+    else if (item._iSta != -1) {
+      output(station, item._result);
+    }
+
+    // Flush all files once a second
+    // -----------------------------
+    if (flushTimer.elapsed() >= FLUSHMSEC) {
+      QList<t_station> stations;
+      {
+        QMutexLocker locker(&_mutex);
+        stations = _stations.values();
+      }
+      for (int ii = 0; ii < stations.size(); ii++) {
+        stations[ii].flush();
+      }
+      flushTimer.restart();
+    }
+  }
+}
+
+// Flush the files of a station
+////////////////////////////////////////////////////////////////////////////
+void t_pppResultWriter::t_station::flush() {
+  if (_logFile) {
+    _logFile->flush();
+  }
+  if (_nmeaFile) {
+    _nmeaFile->flush();
+  }
+  if (_snxtroFile) {
+    _snxtroFile->flush();
+  }
+  if (_resultFile) {
+    _resultFile->flush();
+  }
+}
+
+// Write one result to all outputs
+////////////////////////////////////////////////////////////////////////////
+void t_pppResultWriter::output(const t_station& station,
+                               const t_pppResult& result) {
+
+  const bncTime& tt = result._epoTime;
+
+  if (station._logFile && tt.valid()) {
+    station._logFile->write(tt.gpsw(), tt.gpssec(), QString(result._log));
+  }
+
+  if (!result._error) {
+    bool nmeaListened = BNC_CORE->nmeaListened();
+    if (station._nmeaFile || nmeaListened) {
+      QString rmcStr = result.nmeaString('R');
+      QString ggaStr = result.nmeaString('G');
+      if (station._nmeaFile) {
+        station._nmeaFile->write(tt.gpsw(), tt.gpssec(), rmcStr);
+        station._nmeaFile->write(tt.gpsw(), tt.gpssec(), ggaStr);
+      }
+      if (nmeaListened) {
+        emit newNMEAstr(result._staID, rmcStr.toAscii());
+        emit newNMEAstr(result._staID, ggaStr.toAscii());
+      }
+    }
+    if (station._snxtroFile && tt.valid()) {
+      station._snxtroFile->write(result._staID, int(tt.gpsw()), tt.gpssec(),
+                         result._trp0 + result._trp, result._trpStdev);
+    }
+  }
+
+  if (station._resultFile && tt.valid()) {
+    station._resultFile->write(result);
+  }
+
+  emit newMessage(result.logLine(), true);
+}
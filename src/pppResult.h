@@ -0,0 +1,134 @@
+#ifndef PPPRESULT_H
+#define PPPRESULT_H
+
+#include <QtCore>
+
+#include "bnctime.h"
+#include "bncoutf.h"
+#include "pppInclude.h"
+
+class bncSinexTro;
+
+namespace BNC_PPP {
+
+/**
+ * Result of one PPP epoch. The record is passed to the output thread
+ * unformatted, each output formats only what it needs.
+ */
+class t_pppResult {
+ public:
+  t_pppResult();
+  t_pppResult(const QByteArray& staID, const t_output& output);
+
+  QByteArray logLine() const;
+  QString    nmeaString(char strType) const;
+
+  QByteArray _staID;
+  bncTime    _epoTime;
+  bool       _error;
+  double     _xyz[3];
+  double     _covMatrix[6];   // XX, XY, XZ, YY, YZ, ZZ
+  double     _neu[3];
+  double     _trp0;           // a priori zenith delay
+  double     _trp;            // estimated zenith delay
+  double     _trpStdev;
+  int        _numSat;
+  double     _hDop;
+  int        _numRes[2];      // code, phase residuals used in the solution
+  double     _rmsRes[2];
+  double     _maxRes[2];
+  double     _tide[3];
+  double     _blq;
+  QByteArray _log;            // detailed log of the epoch
+};
+
+QDataStream& operator<<(QDataStream& out, const t_pppResult& result);
+QDataStream& operator>>(QDataStream& in, t_pppResult& result);
+
+/**
+ * Binary file of PPP results: header (magic number, format version,
+ * station ID) followed by one record per epoch, both written by
+ * QDataStream (Qt 4.6 format, big-endian). The detailed log is not saved.
+ */
+class t_pppResultFile : public bncoutf {
+ public:
+  static const quint32 MAGIC   = 0x424e4350; // "BNCP"
+  static const quint16 VERSION = 1;
+  t_pppResultFile(const QByteArray& staID, const QString& sklFileName,
+                  const QString& intr, int sampl);
+  t_irc write(const t_pppResult& result);
+  static t_irc readHeader(QDataStream& in, QByteArray& staID);
+
+ private:
+  virtual void writeHeader(const QDateTime& datTim);
+  QByteArray _staID;
+};
+
+/**
+ * Output of the PPP results of all stations (log files, NMEA files and
+ * NMEA servers, SINEX Troposphere files, binary files and BNC's log) in
+ * one thread. The files of a station are handed over by addStation and
+ * owned by the writer. They are not flushed per record but once a second
+ * (FLUSHMSEC) and when the station is removed.
+ */
+class t_pppResultWriter : public QThread {
+ Q_OBJECT
+
+ public:
+  static t_pppResultWriter* instance();
+
+  /** Register the files of a station, returns the station handle */
+  int  addStation(bncoutf* logFile, bncoutf* nmeaFile,
+                  bncSinexTro* snxtroFile, t_pppResultFile* resultFile);
+
+  /** Queue a result, waits if the queue is full */
+  void post(int iSta, const t_pppResult& result);
+
+  /** Write the queued results of a station and close its files */
+  void removeStation(int iSta);
+
+ signals:
+  void newMessage(QByteArray msg, bool showOnScreen);
+  void newNMEAstr(QByteArray staID, QByteArray str);
+
+ protected:
+  virtual void run();
+
+ private:
+  class t_station {
+   public:
+    t_station() : _logFile(0), _nmeaFile(0), _snxtroFile(0), _resultFile(0) {}
+    void flush();
+    bncoutf*         _logFile;
+    bncoutf*         _nmeaFile;
+    bncSinexTro*     _snxtroFile;
+    t_pppResultFile* _resultFile;
+  };
+
+  class t_item {
+   public:
+    t_item() : _iSta(-1), _remove(false) {}
+    int         _iSta;
+    bool        _remove;   // station removed, no result
+    t_pppResult _result;
+  };
+
+  t_pppResultWriter();
+  ~t_pppResultWriter();
+  void output(const t_station& station, const t_pppResult& result);
+
+  static const int MAXPENDING = 10000;   // queued results of all stations
+  static const int FLUSHMSEC  = 1000;    // maximum delay of the file output
+
+  QMutex               _mutex;
+  QWaitCondition       _newItem;
+  QWaitCondition       _queueNotFull;
+  QWaitCondition       _removed;
+  QQueue<t_item>       _items;
+  QMap<int, t_station> _stations;
+  int                  _nextSta;
+};
+
+}
+
+#endif
@@ -51,8 +51,10 @@
 #include "bnccore.h"
 #include "bncephuser.h"
 #include "bncsettings.h"
+#include "bncmetrics.h"
 #include "bncoutf.h"
 #include "bncsinextro.h"
+#include "pppResult.h"
 #include "rinex/rnxobsfile.h"
 #include "rinex/rnxnavfile.h"
 #include "rinex/corrfile.h"
@@ -73,11 +75,16 @@ t_pppRun::t_pppRun(const t_pppOptions* opt) {
   connect(this,     SIGNAL(newPosition(QByteArray, bncTime, QVector<double>)),
           BNC_CORE, SIGNAL(newPosition(QByteArray, bncTime, QVector<double>)));
 
-  connect(this,     SIGNAL(newNMEAstr(QByteArray, QByteArray)),
-          BNC_CORE, SIGNAL(newNMEAstr(QByteArray, QByteArray)));
-
   _pppClient = new t_pppClient(_opt);
 
+  QString staLabel = bncMetrics::label("station", _opt->_roverName.c_str());
+  _metricEpoch   = BNC_METRICS->histogram("bnc_ppp_epoch_seconds",
+                     "PPP processing time per epoch", staLabel);
+  _metricErrors  = BNC_METRICS->counter("bnc_ppp_epoch_errors_total",
+                     "PPP epochs without solution", staLabel);
+  _metricPending = BNC_METRICS->gauge("bnc_ppp_pending_epochs",
+                     "PPP epochs buffered for processing", staLabel);
+
   bncSettings settings;
 
   if (_opt->_realTime) {
@@ -176,10 +183,8 @@ t_pppRun::t_pppRun(const t_pppOptions* opt) {
   bool v3filenames = settings.value("PPP/v3filenames").toBool();
   QString logFileSkl = settings.value("PPP/logPath").toString();
   int l = logFileSkl.length();
-  if (logFileSkl.isEmpty()) {
-    _logFile = 0;
-  }
-  else {
+  bncoutf* logFile = 0;
+  if (!logFileSkl.isEmpty()) {
     if (l && logFileSkl[l-1] != QDir::separator() ) {
       logFileSkl += QDir::separator();
     }
@@ -189,15 +194,13 @@ t_pppRun::t_pppRun(const t_pppOptions* opt) {
     else {
       logFileSkl = logFileSkl + ID4 + "${GPSWD}" + distStr + ".ppp";
     }
-    _logFile = new bncoutf(logFileSkl, intr, sampl);
+    logFile = new bncoutf(logFileSkl, intr, sampl);
   }
 
   QString nmeaFileSkl = settings.value("PPP/nmeaPath").toString();
   l = nmeaFileSkl.length();
-  if (nmeaFileSkl.isEmpty()) {
-    _nmeaFile = 0;
-  }
-  else {
+  bncoutf* nmeaFile = 0;
+  if (!nmeaFileSkl.isEmpty()) {
     if (l > 0 && nmeaFileSkl[l-1] != QDir::separator() ) {
       nmeaFileSkl += QDir::separator();
     }
@@ -207,14 +210,12 @@ t_pppRun::t_pppRun(const t_pppOptions* opt) {
     else {
       nmeaFileSkl = nmeaFileSkl + ID4 + "${GPSWD}" + distStr + ".nmea";
     }
-    _nmeaFile = new bncoutf(nmeaFileSkl, intr, sampl);
+    nmeaFile = new bncoutf(nmeaFileSkl, intr, sampl);
   }
   QString snxtroFileSkl = settings.value("PPP/snxtroPath").toString();
   l = snxtroFileSkl.length();
-  if (snxtroFileSkl.isEmpty()) {
-    _snxtroFile = 0;
-  }
-  else {
+  bncSinexTro* snxtroFile = 0;
+  if (!snxtroFileSkl.isEmpty()) {
     if (l > 0 && snxtroFileSkl[l-1] != QDir::separator() ) {
       snxtroFileSkl += QDir::separator();
     }
@@ -224,10 +225,29 @@ t_pppRun::t_pppRun(const t_pppOptions* opt) {
     else {
       snxtroFileSkl = snxtroFileSkl + ID4 + "${GPSWD}" + distStr + ".tro";
     }
-    sampl = settings.value("PPP/snxtroSampl").toString().split("sec").first().toInt();
-    intr  = settings.value("PPP/snxtroIntr").toString();
-    _snxtroFile = new bncSinexTro(_opt, snxtroFileSkl, intr, sampl);
+    int     snxtroSampl = settings.value("PPP/snxtroSampl").toString().split("sec").first().toInt();
+    QString snxtroIntr  = settings.value("PPP/snxtroIntr").toString();
+    snxtroFile = new bncSinexTro(_opt, snxtroFileSkl, snxtroIntr, snxtroSampl);
+  }
+  QString resultFileSkl = settings.value("PPP/resultPath").toString();
+  l = resultFileSkl.length();
+  t_pppResultFile* resultFile = 0;
+  if (!resultFileSkl.isEmpty()) {
+    if (l > 0 && resultFileSkl[l-1] != QDir::separator() ) {
+      resultFileSkl += QDir::separator();
+    }
+    if (v3filenames) {
+      resultFileSkl = resultFileSkl + ID9 + "${V3}" + distStr + ".pppb";
+    }
+    else {
+      resultFileSkl = resultFileSkl + ID4 + "${GPSWD}" + distStr + ".pppb";
+    }
+    resultFile = new t_pppResultFile(QByteArray(_opt->_roverName.c_str()),
+                                     resultFileSkl, intr, sampl);
   }
+
+  _resultWriter  = t_pppResultWriter::instance();
+  _resultStation = _resultWriter->addStation(logFile, nmeaFile, snxtroFile, resultFile);
 }
 
 
@@ -236,9 +256,10 @@ t_pppRun::t_pppRun(const t_pppOptions* opt) {
 // Destructor
 ////////////////////////////////////////////////////////////////////////////
 t_pppRun::~t_pppRun() {
-  delete _logFile;
-  delete _nmeaFile;
-  delete _snxtroFile;
+  _resultWriter->removeStation(_resultStation);
+  BNC_METRICS->release(_metricEpoch);
+  BNC_METRICS->release(_metricErrors);
+  BNC_METRICS->release(_metricPending);
   while (!_epoData.empty()) {
     delete _epoData.front();
     _epoData.pop_front();
@@ -324,6 +345,7 @@ void t_pppRun::slotNewObs(QByteArray staID, QList<t_satObs> obsList) {
     delete _epoData.front();
     _epoData.pop_front();
   }
+  _metricPending->set(_epoData.size());
 
   // Process the oldest epochs
   // ------------------------
@@ -343,7 +365,13 @@ void t_pppRun::slotNewObs(QByteArray staID, QList<t_satObs> obsList) {
         _epoData.front()->_time - _lastClkCorrTime < _opt->_corrWaitTime) {
 
       t_output output;
+      QElapsedTimer epochTimer;
+      epochTimer.start();
       _pppClient->processEpoch(satObs, &output);
+      _metricEpoch->observe(epochTimer.nsecsElapsed() * 1.e-9);
+      if (output._error) {
+        _metricErrors->add();
+      }
 
       if (!output._error) {
         QVector<double> xx(6);
@@ -359,49 +387,7 @@ void t_pppRun::slotNewObs(QByteArray staID, QList<t_satObs> obsList) {
       delete _epoData.front();
       _epoData.pop_front();
 
-      ostringstream log;
-      if (output._error) {
-        log << output._log;
-      }
-      else {
-        log.setf(ios::fixed);
-        log << string(output._epoTime) << ' ' << staID.data()
-            << " X = "  << setprecision(4) << output._xyzRover[0]
-            << " Y = "  << setprecision(4) << output._xyzRover[1]
-            << " Z = "  << setprecision(4) << output._xyzRover[2]
-            << " NEU: " << showpos << setw(8) << setprecision(4) << output._neu[0]
-            << " "      << showpos << setw(8) << setprecision(4) << output._neu[1]
-            << " "      << showpos << setw(8) << setprecision(4) << output._neu[2]
-            << " TRP: " << showpos << setw(8) << setprecision(4) << output._trp0
-            << " "      << showpos << setw(8) << setprecision(4) << output._trp
-            << " STD "  << showpos << setw(8) << setprecision(4) << output._trpStdev
-			<< " STR: " << "OCEAN"
-			<< " TIDE: " << showpos << setw(8) << setprecision(4) << output._xyz[0]
-			<< " "      << showpos << setw(8) << setprecision(4) << output._xyz[1]
-			<< " "      << showpos << setw(8) << setprecision(4) << output._xyz[2]
-			<< " BLQ"   << showpos << setw(8) << setprecision(1) << output._tempDb;	
-      }
-
-      if (_logFile && output._epoTime.valid()) {
-        _logFile->write(output._epoTime.gpsw(), output._epoTime.gpssec(),
-                        QString(output._log.c_str()));
-      }
-
-      if (!output._error) {
-        QString rmcStr = nmeaString('R', output);
-        QString ggaStr = nmeaString('G', output);
-        if (_nmeaFile) {
-          _nmeaFile->write(output._epoTime.gpsw(), output._epoTime.gpssec(), rmcStr);
-          _nmeaFile->write(output._epoTime.gpsw(), output._epoTime.gpssec(), ggaStr);
-        }
-        emit newNMEAstr(staID, rmcStr.toAscii());
-        emit newNMEAstr(staID, ggaStr.toAscii());
-        if (_snxtroFile && output._epoTime.valid()) {
-          _snxtroFile->write(staID, int(output._epoTime.gpsw()), output._epoTime.gpssec(),
-                             output._trp0 + output._trp, output._trpStdev);
-        }
-      }
-      emit newMessage(QByteArray(log.str().c_str()), true);
+      _resultWriter->post(_resultStation, t_pppResult(staID, output));
     }
     else {
       return;
@@ -634,72 +620,6 @@ void t_pppRun::slotSetStopFlag() {
   _stopFlag = true;
 }
 
-//
-////////////////////////////////////////////////////////////////////////////
-QString t_pppRun::nmeaString(char strType, const t_output& output) {
-
-  double ell[3];
-  xyz2ell(output._xyzRover, ell);
-  double phiDeg = ell[0] * 180 / M_PI;
-  double lamDeg = ell[1] * 180 / M_PI;
-
-  unsigned year, month, day;
-  output._epoTime.civil_date(year, month, day);
-  double gps_utc = gnumleap(year, month, day);
-
-  char phiCh = 'N';
-  if (phiDeg < 0) {
-    phiDeg = -phiDeg;
-    phiCh  =  'S';
-  }
-  char lamCh = 'E';
-  if (lamDeg < 0) {
-    lamDeg = -lamDeg;
-    lamCh  =  'W';
-  }
-
-  ostringstream out;
-  out.setf(ios::fixed);
-
-  if      (strType == 'R') {
-    string datestr = output._epoTime.datestr(0); // yyyymmdd
-    out << "GPRMC,"
-        << (output._epoTime - gps_utc).timestr(3,0) << ",A,"
-        << setw(2) << setfill('0') << int(phiDeg)
-        << setw(6) << setprecision(3) << setfill('0')
-        << fmod(60*phiDeg,60) << ',' << phiCh << ','
-        << setw(3) << setfill('0') << int(lamDeg)
-        << setw(6) << setprecision(3) << setfill('0')
-        << fmod(60*lamDeg,60) << ',' << lamCh << ",,,"
-        << datestr[6] << datestr[7] << datestr[4] << datestr[5]
-        << datestr[2] << datestr[3] << ",,";
-  }
-  else if (strType == 'G') {
-    out << "GPGGA,"
-        << (output._epoTime - gps_utc).timestr(2,0) << ','
-        << setw(2) << setfill('0') << int(phiDeg)
-        << setw(10) << setprecision(7) << setfill('0')
-        << fmod(60*phiDeg,60) << ',' << phiCh << ','
-        << setw(3) << setfill('0') << int(lamDeg)
-        << setw(10) << setprecision(7) << setfill('0')
-        << fmod(60*lamDeg,60) << ',' << lamCh
-        << ",1," << setw(2) << setfill('0') << output._numSat << ','
-        << setw(3) << setprecision(1) << output._hDop << ','
-        << setprecision(3) << ell[2] << ",M,0.0,M,,";
-  }
-  else {
-    return "";
-  }
-
-  QString nmStr(out.str().c_str());
-  unsigned char XOR = 0;
-  for (int ii = 0; ii < nmStr.length(); ii++) {
-    XOR ^= (unsigned char) nmStr[ii].toAscii();
-  }
-
-  return '$' + nmStr + QString("*%1").arg(XOR, 2, 16, QLatin1Char('0'));
-}
-
 //
 ////////////////////////////////////////////////////////////////////////////
 void t_pppRun::slotProviderIDChanged(QString mountPoint) {
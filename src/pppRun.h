@@ -12,11 +12,14 @@
 class t_rnxObsFile;
 class t_rnxNavFile;
 class t_corrFile;
-class bncoutf;
-class bncSinexTro;
+class bncMetricCounter;
+class bncMetricGauge;
+class bncMetricHistogram;
 
 namespace BNC_PPP {
 
+class t_pppResultWriter;
+
 class t_pppRun : public QObject {
  Q_OBJECT
  public:
@@ -25,12 +28,9 @@ class t_pppRun : public QObject {
 
   void processFiles();
 
-  static QString nmeaString(char strType, const t_output& output);
-
  signals:
   void newMessage(QByteArray msg, bool showOnScreen);
   void newPosition(QByteArray staID, bncTime time, QVector<double> xx);
-  void newNMEAstr(QByteArray staID, QByteArray str);
   void progressRnxPPP(int);
   void finishedRnxPPP();
 
@@ -72,9 +72,11 @@ class t_pppRun : public QObject {
   t_corrFile*            _corrFile;
   int                    _speed;
   bool                   _stopFlag;
-  bncoutf*               _logFile;
-  bncoutf*               _nmeaFile;
-  bncSinexTro*           _snxtroFile;
+  t_pppResultWriter*     _resultWriter;
+  int                    _resultStation;
+  bncMetricHistogram*    _metricEpoch;
+  bncMetricCounter*      _metricErrors;
+  bncMetricGauge*        _metricPending;
 };
 
 }
@@ -61,6 +61,7 @@ t_pppWidgets::t_pppWidgets() {
   _logPath      = new QLineEdit();     _logPath     ->setObjectName("PPP/logPath");      _widgets << _logPath;
   _nmeaPath     = new QLineEdit();     _nmeaPath    ->setObjectName("PPP/nmeaPath");     _widgets << _nmeaPath;
   _snxtroPath   = new QLineEdit();     _snxtroPath  ->setObjectName("PPP/snxtroPath");   _widgets << _snxtroPath;
+  _resultPath   = new QLineEdit();     _resultPath  ->setObjectName("PPP/resultPath");   _widgets << _resultPath;
   _snxtroSampl  = new QComboBox();      _snxtroSampl->setObjectName("PPP/snxtroSampl");  _widgets << _snxtroSampl;
   _snxtroIntr   = new QComboBox();     _snxtroIntr  ->setObjectName("PPP/snxtroIntr");   _widgets << _snxtroIntr;
   _snxtroAc     = new QLineEdit();     _snxtroAc    ->setObjectName("PPP/snxtroAc");     _widgets << _snxtroAc;
@@ -93,6 +94,7 @@ t_pppWidgets::t_pppWidgets() {
   _useGoogleMap     = new QRadioButton; _useGoogleMap    ->setObjectName("PPP/useGoogleMap");     _widgets << _useGoogleMap;
   _useOpenStreetMap = new QRadioButton; _useOpenStreetMap->setObjectName("PPP/useOpenStreetMap"); _widgets << _useOpenStreetMap;
   _audioResponse    = new QLineEdit;    _audioResponse   ->setObjectName("PPP/audioResponse");    _widgets << _audioResponse;
+  _plotFrameRate    = new QSpinBox;     _plotFrameRate   ->setObjectName("PPP/plotFrameRate");    _widgets << _plotFrameRate;
   _mapWinDotSize    = new QLineEdit;    _mapWinDotSize   ->setObjectName("PPP/mapWinDotSize");    _widgets << _mapWinDotSize;
   _mapWinDotColor   = new QComboBox;    _mapWinDotColor  ->setObjectName("PPP/mapWinDotColor");   _widgets << _mapWinDotColor;
   _mapSpeedSlider   = new QSlider;      _mapSpeedSlider  ->setObjectName("PPP/mapSpeedSlider");   _widgets << _mapSpeedSlider;
@@ -161,6 +163,11 @@ t_pppWidgets::t_pppWidgets() {
   _corrWaitTime->setSingleStep(1);
   _corrWaitTime->setSuffix(" sec");
 
+  _plotFrameRate->setMinimum(1);
+  _plotFrameRate->setMaximum(25);
+  _plotFrameRate->setSingleStep(1);
+  _plotFrameRate->setSuffix(" Hz");
+
   _staTable->setColumnCount(10);
   _staTable->setRowCount(0);
   _staTable->setHorizontalHeaderLabels(
@@ -196,6 +203,7 @@ t_pppWidgets::t_pppWidgets() {
   // WhatsThis, PPP (4)
   // ------------------
   _plotCoordinates->setWhatsThis(tr("<p>For one of your PPP Stations BNC can produce a time series plot of coordinate displacements in the 'PPP Plot' tab below. Specify a 'Mountpoint' (when in 'Real-Time Streams' mode) or the 4-character station ID (when in 'RINEX Files' mode) to define the station whose coordinate displacements you would like to see plotted.</p><p>Note that this option makes only sense for a stationary receiver with known a priori marker coordinates as specified through PPP option 'Coordinates file'.</p><p>Default is an empty option field, meaning that BNC shall not produce a time series plot of PPP coordinate displacements.</p>"));
+  _plotFrameRate->setWhatsThis(tr("<p>Specify how often per second the 'PPP Plot' is redrawn at most. PPP solutions arriving in between are shown together with the next frame. The plot is not redrawn while it is hidden.</p><p>Default is a 'Plot frame rate' of 2 Hz.</p>"));
   _audioResponse->setWhatsThis(tr("<p>Specify an 'Audio response' threshold in meters. A beep is produced by BNC whenever a horizontal PPP coordinate component differs by more than the threshold value from the a priori marker coordinate.</p><p>Default is an empty option field, meaning that you don't want BNC to produce alarm signals.</p>"));
   _mapWinButton->setWhatsThis(tr("<p>You may like to track your rover position using Google Maps or Open Street Map as a background map. A 'Track map' can be produced with BNC in 'Real-Time Streams' or 'RINEX files' PPP mode.</p><p>The 'Open Map' button opens a windows showing a map according to specified options.</p><p>Even in 'RINEX files' post processing mode you should not forget to specify a proxy under the 'Network' tab if that is operated in front of BNC because the program needs to download the map data.</p>"));
   _useGoogleMap->setWhatsThis(tr("<p>Specify Google Maps as the background for your rover positions.</p>"));
@@ -220,6 +228,7 @@ t_pppWidgets::~t_pppWidgets() {
   delete _logPath;
   delete _nmeaPath;
   delete _snxtroPath;
+  delete _resultPath;
   delete _snxtroSampl;
   delete _snxtroIntr;
   delete _snxtroAc;
@@ -250,6 +259,7 @@ t_pppWidgets::~t_pppWidgets() {
   delete _useGoogleMap;
   delete _useOpenStreetMap;
   delete _audioResponse;
+  delete _plotFrameRate;
   delete _mapWinDotSize;
   delete _mapWinDotColor;
   delete _mapSpeedSlider;
@@ -302,6 +312,7 @@ void t_pppWidgets::readOptions() {
   _logPath    ->setText(settings.value(_logPath    ->objectName()).toString());
   _nmeaPath   ->setText(settings.value(_nmeaPath   ->objectName()).toString());
   _snxtroPath ->setText(settings.value(_snxtroPath ->objectName()).toString());
+  _resultPath ->setText(settings.value(_resultPath ->objectName()).toString());
   _snxtroAc   ->setText(settings.value(_snxtroAc   ->objectName()).toString());
   _snxtroSol  ->setText(settings.value(_snxtroSol  ->objectName()).toString());
 
@@ -381,6 +392,10 @@ void t_pppWidgets::readOptions() {
   _useOpenStreetMap->setChecked(settings.value(_useOpenStreetMap->objectName()).toBool());
   _mapWinDotSize   ->setText(settings.value(_mapWinDotSize->objectName()).toString());
 
+  int frameRate = settings.value(_plotFrameRate->objectName()).toInt();
+  if (frameRate == 0) frameRate = 2;
+  _plotFrameRate->setValue(frameRate);
+
   ii = _mapWinDotColor->findText(settings.value(_mapWinDotColor->objectName()).toString());
   if (ii != -1) {
     _mapWinDotColor->setCurrentIndex(ii);
@@ -407,6 +422,7 @@ void t_pppWidgets::saveOptions() {
   settings.setValue(_logPath     ->objectName(), _logPath     ->text());
   settings.setValue(_nmeaPath    ->objectName(), _nmeaPath    ->text());
   settings.setValue(_snxtroPath  ->objectName(), _snxtroPath  ->text());
+  settings.setValue(_resultPath  ->objectName(), _resultPath  ->text());
   settings.setValue(_snxtroSampl ->objectName(), _snxtroSampl ->currentText());
   settings.setValue(_snxtroIntr  ->objectName(), _snxtroIntr  ->currentText());
   settings.setValue(_snxtroAc    ->objectName(), _snxtroAc    ->text());
@@ -443,6 +459,7 @@ void t_pppWidgets::saveOptions() {
 
   settings.setValue(_plotCoordinates ->objectName(), _plotCoordinates ->text());
   settings.setValue(_audioResponse   ->objectName(), _audioResponse   ->text());
+  settings.setValue(_plotFrameRate   ->objectName(), _plotFrameRate   ->value());
   settings.setValue(_useGoogleMap    ->objectName(), _useGoogleMap    ->isChecked());
   settings.setValue(_useOpenStreetMap->objectName(), _useOpenStreetMap->isChecked());
   settings.setValue(_mapWinDotSize   ->objectName(), _mapWinDotSize   ->text());
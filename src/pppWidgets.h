@@ -47,6 +47,7 @@ class t_pppWidgets : public QObject {
   QLineEdit*     _logPath;
   QLineEdit*     _nmeaPath;
   QLineEdit*     _snxtroPath;
+  QLineEdit*     _resultPath;
   QComboBox*     _snxtroSampl;
   QComboBox*     _snxtroIntr;
   QLineEdit*     _snxtroAc;
@@ -76,6 +77,7 @@ class t_pppWidgets : public QObject {
   QRadioButton*  _useGoogleMap;
   QRadioButton*  _useOpenStreetMap;
   QLineEdit*     _audioResponse;
+  QSpinBox*      _plotFrameRate;
   QLineEdit*     _mapWinDotSize;
   QComboBox*     _mapWinDotColor;
   QSlider*       _mapSpeedSlider;
@@ -39,28 +39,463 @@
  * -----------------------------------------------------------------------*/
 
 #include <iostream>
+#include <algorithm>
 #include "corrfile.h"
 #include "bncutils.h"
 #include "bncephuser.h"
 
 using namespace std;
 
+QMutex t_corrFile::_convertMutex;
+
+// Binary records of the corrections
+////////////////////////////////////////////////////////////////////////////
+static QDataStream& operator<<(QDataStream& out, const string& str) {
+  return out << QByteArray(str.data(), str.size());
+}
+
+static QDataStream& operator>>(QDataStream& in, string& str) {
+  QByteArray ba;
+  in >> ba;
+  str.assign(ba.constData(), ba.size());
+  return in;
+}
+
+static QDataStream& operator<<(QDataStream& out, const t_prn& prn) {
+  return out << qint8(prn.system()) << qint32(prn.number()) << qint8(prn.flags());
+}
+
+static QDataStream& operator>>(QDataStream& in, t_prn& prn) {
+  qint8  system;
+  qint32 number;
+  qint8  flags;
+  in >> system >> number >> flags;
+  prn.set(char(system), number, flags);
+  return in;
+}
+
+static QDataStream& operator<<(QDataStream& out, const bncTime& tt) {
+  return out << quint32(tt.mjd()) << tt.daysec();
+}
+
+static QDataStream& operator>>(QDataStream& in, bncTime& tt) {
+  quint32 mjd;
+  double  daysec;
+  in >> mjd >> daysec;
+  tt.setmjd(daysec, mjd);
+  return in;
+}
+
+static QDataStream& operator<<(QDataStream& out, const t_orbCorr& corr) {
+  out << corr._staID << corr._prn << quint32(corr._iod) << corr._time
+      << quint32(corr._updateInt) << qint8(corr._system);
+  for (int ii = 1; ii <= 3; ii++) {
+    out << corr._xr(ii) << corr._dotXr(ii);
+  }
+  return out;
+}
+
+static QDataStream& operator>>(QDataStream& in, t_orbCorr& corr) {
+  quint32 iod, updateInt;
+  qint8   system;
+  in >> corr._staID >> corr._prn >> iod >> corr._time >> updateInt >> system;
+  corr._iod       = iod;
+  corr._updateInt = updateInt;
+  corr._system    = char(system);
+  for (int ii = 1; ii <= 3; ii++) {
+    in >> corr._xr(ii) >> corr._dotXr(ii);
+  }
+  return in;
+}
+
+static QDataStream& operator<<(QDataStream& out, const t_clkCorr& corr) {
+  return out << corr._staID << corr._prn << quint32(corr._iod) << corr._time
+             << quint32(corr._updateInt)
+             << corr._dClk << corr._dotDClk << corr._dotDotDClk;
+}
+
+static QDataStream& operator>>(QDataStream& in, t_clkCorr& corr) {
+  quint32 iod, updateInt;
+  in >> corr._staID >> corr._prn >> iod >> corr._time >> updateInt
+     >> corr._dClk >> corr._dotDClk >> corr._dotDotDClk;
+  corr._iod       = iod;
+  corr._updateInt = updateInt;
+  return in;
+}
+
+static QDataStream& operator<<(QDataStream& out, const t_satCodeBias& satBias) {
+  out << satBias._staID << satBias._prn << satBias._time
+      << quint32(satBias._updateInt) << quint32(satBias._bias.size());
+  for (unsigned ii = 0; ii < satBias._bias.size(); ii++) {
+    out << satBias._bias[ii]._rnxType2ch << satBias._bias[ii]._value;
+  }
+  return out;
+}
+
+static QDataStream& operator>>(QDataStream& in, t_satCodeBias& satBias) {
+  quint32 updateInt, numBias;
+  in >> satBias._staID >> satBias._prn >> satBias._time >> updateInt >> numBias;
+  satBias._updateInt = updateInt;
+  satBias._bias.resize(numBias);
+  for (unsigned ii = 0; ii < numBias; ii++) {
+    in >> satBias._bias[ii]._rnxType2ch >> satBias._bias[ii]._value;
+  }
+  return in;
+}
+
+static QDataStream& operator<<(QDataStream& out, const t_satPhaseBias& satBias) {
+  out << satBias._staID << satBias._prn << satBias._time
+      << quint32(satBias._updateInt)
+      << quint32(satBias._dispBiasConstistInd) << quint32(satBias._MWConsistInd)
+      << satBias._yawDeg << satBias._yawDegRate << quint32(satBias._bias.size());
+  for (unsigned ii = 0; ii < satBias._bias.size(); ii++) {
+    const t_frqPhaseBias& frqBias = satBias._bias[ii];
+    out << frqBias._rnxType2ch << frqBias._value
+        << qint32(frqBias._fixIndicator) << qint32(frqBias._fixWideLaneIndicator)
+        << qint32(frqBias._jumpCounter);
+  }
+  return out;
+}
+
+static QDataStream& operator>>(QDataStream& in, t_satPhaseBias& satBias) {
+  quint32 updateInt, dispInd, mwInd, numBias;
+  in >> satBias._staID >> satBias._prn >> satBias._time >> updateInt
+     >> dispInd >> mwInd >> satBias._yawDeg >> satBias._yawDegRate >> numBias;
+  satBias._updateInt           = updateInt;
+  satBias._dispBiasConstistInd = dispInd;
+  satBias._MWConsistInd        = mwInd;
+  satBias._bias.resize(numBias);
+  for (unsigned ii = 0; ii < numBias; ii++) {
+    t_frqPhaseBias& frqBias = satBias._bias[ii];
+    qint32 fixInd, fixWLInd, jumpCounter;
+    in >> frqBias._rnxType2ch >> frqBias._value >> fixInd >> fixWLInd >> jumpCounter;
+    frqBias._fixIndicator         = fixInd;
+    frqBias._fixWideLaneIndicator = fixWLInd;
+    frqBias._jumpCounter          = jumpCounter;
+  }
+  return in;
+}
+
+static QDataStream& operator<<(QDataStream& out, const Matrix& mat) {
+  out << qint32(mat.Nrows()) << qint32(mat.Ncols());
+  for (int iRow = 1; iRow <= mat.Nrows(); iRow++) {
+    for (int iCol = 1; iCol <= mat.Ncols(); iCol++) {
+      out << mat(iRow, iCol);
+    }
+  }
+  return out;
+}
+
+static QDataStream& operator>>(QDataStream& in, Matrix& mat) {
+  qint32 nRows, nCols;
+  in >> nRows >> nCols;
+  mat.ReSize(nRows, nCols);
+  for (int iRow = 1; iRow <= nRows; iRow++) {
+    for (int iCol = 1; iCol <= nCols; iCol++) {
+      in >> mat(iRow, iCol);
+    }
+  }
+  return in;
+}
+
+static QDataStream& operator<<(QDataStream& out, const t_vTec& vTec) {
+  out << vTec._staID << vTec._time << quint32(vTec._updateInt)
+      << quint32(vTec._layers.size());
+  for (unsigned ii = 0; ii < vTec._layers.size(); ii++) {
+    const t_vTecLayer& layer = vTec._layers[ii];
+    out << layer._height << layer._C << layer._S;
+  }
+  return out;
+}
+
+static QDataStream& operator>>(QDataStream& in, t_vTec& vTec) {
+  quint32 updateInt, numLayers;
+  in >> vTec._staID >> vTec._time >> updateInt >> numLayers;
+  vTec._updateInt = updateInt;
+  vTec._layers.resize(numLayers);
+  for (unsigned ii = 0; ii < numLayers; ii++) {
+    t_vTecLayer& layer = vTec._layers[ii];
+    in >> layer._height >> layer._C >> layer._S;
+  }
+  return in;
+}
+
 // Constructor
 ////////////////////////////////////////////////////////////////////////////
 t_corrFile::t_corrFile(QString fileName) {
   expandEnvVar(fileName);
-  _stream.open(fileName.toAscii().data());
+  _storeFile = 0;
+  _nextBlock = 0;
+
+  // Runs started together convert the file once
+  // -------------------------------------------
+  QString storeName = fileName + ".bcor";
+  {
+    QMutexLocker locker(&_convertMutex);
+    if (openStore(fileName, storeName) != success &&
+        convert(fileName, storeName) == success) {
+      openStore(fileName, storeName);
+    }
+  }
+
+  if (!_storeFile) {
+    _stream.open(fileName.toAscii().data());
+  }
 }
 
 // Destructor
 ////////////////////////////////////////////////////////////////////////////
 t_corrFile::~t_corrFile() {
+  _storeData.clear();
+  delete _storeFile;
+}
+
+// Convert the ASCII file (blocks rejected by syncRead make it fail)
+////////////////////////////////////////////////////////////////////////////
+t_irc t_corrFile::convert(const QString& fileName, const QString& storeName) {
+
+  QFileInfo fileInfo(fileName);
+  ifstream  inStream(fileName.toAscii().data());
+  if (!fileInfo.exists() || !inStream.good()) {
+    return failure;
+  }
+
+  // Other processes may read the old store or convert at the same time
+  // ------------------------------------------------------------------
+  QString tmpName = storeName + QString(".%1").arg(QCoreApplication::applicationPid());
+  QFile   outFile(tmpName);
+  if (!outFile.open(QIODevice::WriteOnly)) {
+    return failure;
+  }
+  QDataStream out(&outFile);
+  out.setVersion(QDataStream::Qt_4_6);
+  out << MAGIC << VERSION << qint64(fileInfo.size())
+      << quint32(fileInfo.lastModified().toTime_t())
+      << quint32(0) << quint64(0);   // number of blocks, index offset
+
+  vector<bncTime> blockTime;
+  vector<quint64> blockOffset;
+  bool            ok = true;
+  while (true) {
+    string line;
+    getline(inStream, line); stripWhiteSpace(line);
+    if      (!inStream.good()) {
+      break;
+    }
+    else if (line.empty() || line[0] == '!') {
+      continue;
+    }
+    else if (line[0] != '>') {
+      ok = false;
+      break;
+    }
+
+    bncTime      epoTime;
+    int          numEntries;
+    unsigned int updateInt;
+    string       staID;
+    t_corrSSR::e_type corrType = t_corrSSR::readEpoLine(line, epoTime, updateInt, numEntries, staID);
+    if (corrType != t_corrSSR::clkCorr   && corrType != t_corrSSR::orbCorr   &&
+        corrType != t_corrSSR::codeBias  && corrType != t_corrSSR::phaseBias &&
+        corrType != t_corrSSR::vTec) {
+      ok = false;
+      break;
+    }
+
+    blockTime.push_back(epoTime);
+    blockOffset.push_back(outFile.pos());
+    out << quint8(corrType);
+
+    if      (corrType == t_corrSSR::clkCorr) {
+      QList<t_clkCorr> clkCorrList;
+      t_clkCorr::readEpoch(line, inStream, clkCorrList);
+      out << clkCorrList;
+    }
+    else if (corrType == t_corrSSR::orbCorr) {
+      QList<t_orbCorr> orbCorrList;
+      t_orbCorr::readEpoch(line, inStream, orbCorrList);
+      out << orbCorrList;
+    }
+    else if (corrType == t_corrSSR::codeBias) {
+      QList<t_satCodeBias> satCodeBiasList;
+      t_satCodeBias::readEpoch(line, inStream, satCodeBiasList);
+      out << satCodeBiasList;
+    }
+    else if (corrType == t_corrSSR::phaseBias) {
+      QList<t_satPhaseBias> satPhaseBiasList;
+      t_satPhaseBias::readEpoch(line, inStream, satPhaseBiasList);
+      out << satPhaseBiasList;
+    }
+    else if (corrType == t_corrSSR::vTec) {
+      t_vTec vTec;
+      t_vTec::read(line, inStream, vTec);
+      out << vTec;
+    }
+  }
+
+  // Index of the block epochs, header completed
+  // -------------------------------------------
+  if (ok) {
+    quint64 indexOffset = outFile.pos();
+    for (unsigned ii = 0; ii < blockTime.size(); ii++) {
+      out << blockTime[ii] << blockOffset[ii];
+    }
+    outFile.seek(0);
+    out << MAGIC << VERSION << qint64(fileInfo.size())
+        << quint32(fileInfo.lastModified().toTime_t())
+        << quint32(blockTime.size()) << indexOffset;
+    ok = (out.status() == QDataStream::Ok);
+  }
+  outFile.close();
+
+  if (ok) {
+    QFile::remove(storeName);
+    ok = QFile::rename(tmpName, storeName);
+  }
+  if (!ok) {
+    QFile::remove(tmpName);
+    return failure;
+  }
+  return success;
+}
+
+// Map the binary store, failure if missing or out of date
+////////////////////////////////////////////////////////////////////////////
+t_irc t_corrFile::openStore(const QString& fileName, const QString& storeName) {
+
+  QFileInfo fileInfo(fileName);
+  if (!fileInfo.exists()) {
+    return failure;
+  }
+
+  _storeFile = new QFile(storeName);
+  if (_storeFile->open(QIODevice::ReadOnly)) {
+    qint64 size = _storeFile->size();
+    uchar* data = _storeFile->map(0, size);
+    if (data) {
+      _storeData = QByteArray::fromRawData(reinterpret_cast<const char*>(data), size);
+    }
+    else {
+      _storeData = _storeFile->readAll();
+    }
+
+    QDataStream in(_storeData);
+    in.setVersion(QDataStream::Qt_4_6);
+    quint32 magic, fileModified, numBlocks;
+    quint16 version;
+    qint64  fileSize;
+    quint64 indexOffset;
+    in >> magic >> version >> fileSize >> fileModified >> numBlocks >> indexOffset;
+    if (in.status() == QDataStream::Ok && magic == MAGIC && version == VERSION &&
+        fileSize     == fileInfo.size() &&
+        fileModified == fileInfo.lastModified().toTime_t() &&
+        indexOffset  <= quint64(size)) {
+      in.device()->seek(indexOffset);
+      _blockTime.resize(numBlocks);
+      _blockOffset.resize(numBlocks);
+      for (unsigned ii = 0; ii < numBlocks; ii++) {
+        in >> _blockTime[ii] >> _blockOffset[ii];
+      }
+      if (in.status() == QDataStream::Ok) {
+        _blockMaxTime = _blockTime;
+        for (unsigned ii = 1; ii < numBlocks; ii++) {
+          if (_blockMaxTime[ii] < _blockMaxTime[ii-1]) {
+            _blockMaxTime[ii] = _blockMaxTime[ii-1];
+          }
+        }
+        return success;
+      }
+    }
+  }
+
+  _blockTime.clear();
+  _blockOffset.clear();
+  _storeData.clear();
+  delete _storeFile;
+  _storeFile = 0;
+  return failure;
+}
+
+// Position before the first block not earlier than tt (binary store only)
+////////////////////////////////////////////////////////////////////////////
+t_irc t_corrFile::seek(const bncTime& tt) {
+  if (!_storeFile) {
+    return failure;
+  }
+  _nextBlock = lower_bound(_blockMaxTime.begin(), _blockMaxTime.end(), tt)
+             - _blockMaxTime.begin();
+  return success;
 }
 
 // Read till a given time
 ////////////////////////////////////////////////////////////////////////////
 void t_corrFile::syncRead(const bncTime& tt) {
 
+  if (!_storeFile) {
+    syncReadAscii(tt);
+    return;
+  }
+
+  int numBlocks = _blockTime.size();
+  while (_nextBlock < numBlocks && _blockTime[_nextBlock] <= tt) {
+    emitBlock(_nextBlock++);
+  }
+
+  // End of file reported once, as by the ASCII reader
+  // -------------------------------------------------
+  if (_nextBlock == numBlocks) {
+    ++_nextBlock;
+    throw "t_corrFile: end of file";
+  }
+}
+
+// Emit one block of the binary store
+////////////////////////////////////////////////////////////////////////////
+void t_corrFile::emitBlock(int iBlock) {
+
+  QDataStream in(_storeData);
+  in.setVersion(QDataStream::Qt_4_6);
+  in.device()->seek(_blockOffset[iBlock]);
+
+  quint8 corrType;
+  in >> corrType;
+
+  if      (corrType == t_corrSSR::clkCorr) {
+    QList<t_clkCorr> clkCorrList;
+    in >> clkCorrList;
+    emit newClkCorrections(clkCorrList);
+  }
+  else if (corrType == t_corrSSR::orbCorr) {
+    QList<t_orbCorr> orbCorrList;
+    in >> orbCorrList;
+    QListIterator<t_orbCorr> it(orbCorrList);
+    while (it.hasNext()) {
+      const t_orbCorr& corr = it.next();
+      _corrIODs[QString(corr._prn.toInternalString().c_str())] = corr._iod;
+    }
+    emit newOrbCorrections(orbCorrList);
+  }
+  else if (corrType == t_corrSSR::codeBias) {
+    QList<t_satCodeBias> satCodeBiasList;
+    in >> satCodeBiasList;
+    emit newCodeBiases(satCodeBiasList);
+  }
+  else if (corrType == t_corrSSR::phaseBias) {
+    QList<t_satPhaseBias> satPhaseBiasList;
+    in >> satPhaseBiasList;
+    emit newPhaseBiases(satPhaseBiasList);
+  }
+  else if (corrType == t_corrSSR::vTec) {
+    t_vTec vTec;
+    in >> vTec;
+    emit newTec(vTec);
+  }
+}
+
+// Read till a given time (ASCII file)
+////////////////////////////////////////////////////////////////////////////
+void t_corrFile::syncReadAscii(const bncTime& tt) {
+
   while (_stream.good() && (!_lastEpoTime.valid() || _lastEpoTime <= tt)) {
 
     if (_lastLine.empty()) {
@@ -26,20 +26,37 @@
 #define CORRFILE_H
 
 #include <fstream>
+#include <vector>
 #include <QtCore>
 #include "bncconst.h"
 #include "bnctime.h"
 #include "satObs.h"
 
+/**
+ * Correction file read epoch by epoch. On first use the ASCII file is
+ * converted into a binary store (file name + ".bcor"): header (magic
+ * number, format version, size and modification time of the ASCII file),
+ * one QDataStream record per correction block and an index of the block
+ * epochs. The store is memory-mapped read-only, so PPP runs processing
+ * the same corrections share it, and seek() positions without replay.
+ * The ASCII file is read directly if the store cannot be written.
+ */
 class t_corrFile : public QObject {
  Q_OBJECT
 
  public:
+  static const quint32 MAGIC   = 0x424e4343; // "BNCC"
+  static const quint16 VERSION = 1;
+
   t_corrFile(QString fileName);
   ~t_corrFile();
   void syncRead(const bncTime& tt);
+  t_irc seek(const bncTime& tt);
   const QMap<QString, unsigned int>& corrIODs() const {return _corrIODs;}
 
+  /** Convert an ASCII correction file into a binary store */
+  static t_irc convert(const QString& fileName, const QString& storeName);
+
  signals:
   void newOrbCorrections(QList<t_orbCorr>);
   void newClkCorrections(QList<t_clkCorr>);
@@ -48,10 +65,21 @@ class t_corrFile : public QObject {
   void newTec(t_vTec);
 
  private:
+  t_irc openStore(const QString& fileName, const QString& storeName);
+  void  syncReadAscii(const bncTime& tt);
+  void  emitBlock(int iBlock);
+
+  static QMutex               _convertMutex;
   std::ifstream               _stream;
   std::string                 _lastLine;
   bncTime                     _lastEpoTime;
   QMap<QString, unsigned int> _corrIODs;
+  QFile*                      _storeFile;
+  QByteArray                  _storeData;   // mapped store (raw data)
+  std::vector<bncTime>        _blockTime;
+  std::vector<bncTime>        _blockMaxTime; // latest epoch up to the block
+  std::vector<quint64>        _blockOffset;
+  int                         _nextBlock;
 };
 
 #endif
@@ -39,6 +39,7 @@
  * -----------------------------------------------------------------------*/
 
 #include <iostream>
+#include <cmath>
 #include "reqcedit.h"
 #include "bnccore.h"
 #include "bncsettings.h"
@@ -157,13 +158,12 @@ void t_reqcEdit::run() {
   }
 }
 
-// Initialize input observation files, sort them according to start time
+// File names with wildcards expanded
 ////////////////////////////////////////////////////////////////////////////
-void t_reqcEdit::initRnxObsFiles(const QStringList& obsFileNames,
-                                 QVector<t_rnxObsFile*>& rnxObsFiles,
-                                 QTextStream* log) {
+QStringList t_reqcEdit::expandFileNames(const QStringList& fileNames) {
 
-  QStringListIterator it(obsFileNames);
+  QStringList result;
+  QStringListIterator it(fileNames);
   while (it.hasNext()) {
     QString fileName = it.next();
     if (fileName.indexOf('*') != -1 || fileName.indexOf('?') != -1) {
@@ -172,30 +172,31 @@ void t_reqcEdit::initRnxObsFiles(const QStringList& obsFileNames,
       QStringList filters; filters << fileInfo.fileName();
       QListIterator<QFileInfo> it(dir.entryInfoList(filters));
       while (it.hasNext()) {
-        QString filePath = it.next().filePath();
-        t_rnxObsFile* rnxObsFile = 0;
-        try {
-          rnxObsFile = new t_rnxObsFile(filePath, t_rnxObsFile::input);
-          rnxObsFiles.append(rnxObsFile);
-        }
-        catch (...) {
-          delete rnxObsFile;
-          if (log) {
-            *log << "Error in rnxObsFile " << filePath.toAscii().data() << endl;
-          }
-        }
+        result << it.next().filePath();
       }
     }
     else {
-      t_rnxObsFile* rnxObsFile = 0;
-      try {
-        rnxObsFile = new t_rnxObsFile(fileName, t_rnxObsFile::input);
-        rnxObsFiles.append(rnxObsFile);
-      }
-      catch (...) {
-        if (log) {
-          *log << "Error in rnxObsFile " << fileName.toAscii().data() << endl;
-        }
+      result << fileName;
+    }
+  }
+  return result;
+}
+
+// Initialize input observation files, sort them according to start time
+////////////////////////////////////////////////////////////////////////////
+void t_reqcEdit::initRnxObsFiles(const QStringList& obsFileNames,
+                                 QVector<t_rnxObsFile*>& rnxObsFiles,
+                                 QTextStream* log) {
+
+  QStringListIterator it(expandFileNames(obsFileNames));
+  while (it.hasNext()) {
+    QString fileName = it.next();
+    try {
+      rnxObsFiles.append(new t_rnxObsFile(fileName, t_rnxObsFile::input));
+    }
+    catch (...) {
+      if (log) {
+        *log << "Error in rnxObsFile " << fileName.toAscii().data() << endl;
       }
     }
   }
@@ -203,6 +204,80 @@ void t_reqcEdit::initRnxObsFiles(const QStringList& obsFileNames,
               t_rnxObsFile::earlierStartTime);
 }
 
+// Read the headers of the input observation files, sort them according
+// to start time (the files are closed again)
+////////////////////////////////////////////////////////////////////////////
+void t_reqcEdit::indexRnxObsFiles(QVector<t_obsInput>& inputs) {
+
+  QStringListIterator it(expandFileNames(_obsFileNames));
+  while (it.hasNext()) {
+    QString fileName = it.next();
+    t_rnxObsFile* obsFile = 0;
+    try {
+      obsFile = new t_rnxObsFile(fileName, t_rnxObsFile::input);
+    }
+    catch (...) {
+      if (_log) {
+        *_log << "Error in rnxObsFile " << fileName.toAscii().data() << endl;
+      }
+      continue;
+    }
+    t_obsInput input;
+    input.fileName  = fileName;
+    input.startTime = obsFile->startTime();
+    for (int iSys = 0; iSys < obsFile->numSys(); iSys++) {
+      char sys = obsFile->system(iSys);
+      if (sys != ' ') {
+        for (int iType = 0; iType < obsFile->nTypes(sys); iType++) {
+          QString type = obsFile->obsType(sys, iType);
+          if (_rnxVersion < 3.0) {
+            input.obsTypes << type;
+          }
+          else {
+            input.obsTypes << QString(sys) + ":" + type;
+          }
+        }
+      }
+    }
+    input.phaseShifts  = obsFile->phaseShifts();
+    input.gloBiases    = obsFile->gloBiases();
+    input.gloSlots     = obsFile->gloSlots();
+    input.allGloBiases = (obsFile->numGloBiases() == 4);
+    input.allGloSlots  = (obsFile->numGloSlots() == signed(t_prn::MAXPRN_GLONASS));
+    inputs.append(input);
+    delete obsFile;
+  }
+  qStableSort(inputs.begin(), inputs.end(), t_obsInput::earlierStartTime);
+}
+
+// Next epoch of an input file within the time window (0 at the end)
+////////////////////////////////////////////////////////////////////////////
+t_rnxObsFile::t_rnxEpo* t_reqcEdit::nextEpoch(t_rnxObsFile* obsFile) {
+  t_rnxObsFile::t_rnxEpo* epo = 0;
+  while ( (epo = obsFile->nextEpoch()) != 0) {
+    if (_begTime.valid() && epo->tt < _begTime) {
+      continue;
+    }
+    if (_endTime.valid() && epo->tt > _endTime) {
+      return 0;
+    }
+    return epo;
+  }
+  return 0;
+}
+
+// Input file with the earliest pending epoch (the first of equal ones)
+////////////////////////////////////////////////////////////////////////////
+static int earliestEpoch(const QVector<t_rnxObsFile::t_rnxEpo*>& epos) {
+  int iMin = -1;
+  for (int ii = 0; ii < epos.size(); ii++) {
+    if (iMin == -1 || epos[ii]->tt < epos[iMin]->tt) {
+      iMin = ii;
+    }
+  }
+  return iMin;
+}
+
 //
 ////////////////////////////////////////////////////////////////////////////
 void t_reqcEdit::editObservations() {
@@ -213,7 +288,8 @@ void t_reqcEdit::editObservations() {
     return;
   }
 
-  t_reqcEdit::initRnxObsFiles(_obsFileNames, _rnxObsFiles, _log);
+  QVector<t_obsInput> inputs;
+  indexRnxObsFiles(inputs);
 
   // Initialize output observation file
   // ----------------------------------
@@ -226,23 +302,9 @@ void t_reqcEdit::editObservations() {
 
   // Put together all observation types
   // ----------------------------------
-  if (_rnxObsFiles.size() > 1 && useObsTypes.size() == 0) {
-    for (int ii = 0; ii < _rnxObsFiles.size(); ii++) {
-      t_rnxObsFile* obsFile = _rnxObsFiles[ii];
-      for (int iSys = 0; iSys < obsFile->numSys(); iSys++) {
-        char sys = obsFile->system(iSys);
-        if (sys != ' ') {
-          for (int iType = 0; iType < obsFile->nTypes(sys); iType++) {
-            QString type = obsFile->obsType(sys, iType);
-            if (_rnxVersion < 3.0) {
-              useObsTypes << type;
-            }
-            else {
-              useObsTypes << QString(sys) + ":" + type;
-            }
-          }
-        }
-      }
+  if (inputs.size() > 1 && useObsTypes.size() == 0) {
+    for (int ii = 0; ii < inputs.size(); ii++) {
+      useObsTypes << inputs[ii].obsTypes;
     }
     useObsTypes.removeDuplicates();
   }
@@ -250,10 +312,9 @@ void t_reqcEdit::editObservations() {
   // Put together all phase shifts
   // -----------------------------
   QStringList phaseShifts;
-  if (_rnxVersion >= 3.0 && _rnxObsFiles.size() > 1) {
-    for (int ii = 0; ii < _rnxObsFiles.size(); ii++) {
-      t_rnxObsFile* obsFile = _rnxObsFiles[ii];
-      phaseShifts << obsFile->phaseShifts();
+  if (_rnxVersion >= 3.0 && inputs.size() > 1) {
+    for (int ii = 0; ii < inputs.size(); ii++) {
+      phaseShifts << inputs[ii].phaseShifts;
     }
     phaseShifts.removeDuplicates();
   }
@@ -261,14 +322,13 @@ void t_reqcEdit::editObservations() {
   // Put together all GLONASS biases
   // -------------------------------
   QStringList gloBiases;
-  if (_rnxVersion >= 3.0 && _rnxObsFiles.size() > 1) {
-    for (int ii = 0; ii < _rnxObsFiles.size(); ii++) {
-      t_rnxObsFile* obsFile = _rnxObsFiles[ii];
-      if (ii == 0 &&  obsFile->numGloBiases() == 4) {
+  if (_rnxVersion >= 3.0 && inputs.size() > 1) {
+    for (int ii = 0; ii < inputs.size(); ii++) {
+      if (ii == 0 && inputs[ii].allGloBiases) {
         break;
       }
       else {
-        gloBiases << obsFile->gloBiases();
+        gloBiases << inputs[ii].gloBiases;
       }
     }
     gloBiases.removeDuplicates();
@@ -277,92 +337,123 @@ void t_reqcEdit::editObservations() {
   // Put together all GLONASS slots
   // -----------------------------
   QStringList gloSlots;
-  if (_rnxVersion >= 3.0 && _rnxObsFiles.size() > 1) {
-    for (int ii = 0; ii < _rnxObsFiles.size(); ii++) {
-      t_rnxObsFile* obsFile = _rnxObsFiles[ii];
-      if (ii == 0 &&
-          obsFile->numGloSlots() == signed(t_prn::MAXPRN_GLONASS)) {
+  if (_rnxVersion >= 3.0 && inputs.size() > 1) {
+    for (int ii = 0; ii < inputs.size(); ii++) {
+      if (ii == 0 && inputs[ii].allGloSlots) {
         break;
       }
       else {
-        gloSlots << obsFile->gloSlots();
+        gloSlots << inputs[ii].gloSlots;
       }
     }
     gloSlots.removeDuplicates();
   }
 
-  // Loop over all input observation files
-  // -------------------------------------
-  for (int ii = 0; ii < _rnxObsFiles.size(); ii++) {
-    t_rnxObsFile* obsFile = _rnxObsFiles[ii];
-    if (_log) {
-      *_log << "Processing File: " << obsFile->fileName() << "  start: "
-            << obsFile->startTime().datestr().c_str() << ' '
-            << obsFile->startTime().timestr(0).c_str() << endl;
-    }
-    if (ii == 0) {
-      outObsFile.setHeader(obsFile->header(), int(_rnxVersion), &useObsTypes,
-          &phaseShifts, &gloBiases, &gloSlots);
-      if (_begTime.valid() && _begTime > outObsFile.startTime()) {
-        outObsFile.setStartTime(_begTime);
-      }
-      if (_samplingRate > outObsFile.interval()) {
-        outObsFile.setInterval(_samplingRate);
-      }
-      editRnxObsHeader(outObsFile);
-      bncSettings settings;
-      QMap<QString, QString> txtMap;
-      QString runBy = settings.value("reqcRunBy").toString();
-      if (!runBy.isEmpty()) {
-        txtMap["RUN BY"]  = runBy;
-      }
-      QString comment = settings.value("reqcComment").toString();
-      if (!comment.isEmpty()) {
-        txtMap["COMMENT"]  = comment;
-      }
-      if (int(_rnxVersion) < int(obsFile->header().version())) {
-        addRnxConversionDetails(obsFile, txtMap);
-      }
-      outObsFile.header().write(outObsFile.stream(), &txtMap);
-    }
-    t_rnxObsFile::t_rnxEpo* epo = 0;
-    try {
-      while ( (epo = obsFile->nextEpoch()) != 0) {
-        if (_begTime.valid() && epo->tt < _begTime) {
+  // Merge the epochs of the input files. A file is opened when the merge
+  // reaches its start time and closed at its end, epochs not later than
+  // the last one handled (overlapping files) are skipped.
+  // ---------------------------------------------------------------------
+  QVector<t_rnxObsFile::t_rnxEpo*> epos;     // pending epoch of _rnxObsFiles
+  bool    headerWritten = false;
+  bncTime lastTime;
+  int     iNext         = 0;
+  try {
+    while (true) {
+      int iMin = earliestEpoch(epos);
+      while (iNext < inputs.size() &&
+             (iMin == -1 || !(epos[iMin]->tt < inputs[iNext].startTime))) {
+        const t_obsInput& input = inputs[iNext++];
+        t_rnxObsFile* obsFile = 0;
+        try {
+          obsFile = new t_rnxObsFile(input.fileName, t_rnxObsFile::input);
+        }
+        catch (...) {
+          if (_log) {
+            *_log << "Error in rnxObsFile " << input.fileName.toAscii().data() << endl;
+          }
           continue;
         }
-        if (_endTime.valid() && epo->tt > _endTime) {
-          break;
+        if (_log) {
+          *_log << "Processing File: " << obsFile->fileName() << "  start: "
+                << obsFile->startTime().datestr().c_str() << ' '
+                << obsFile->startTime().timestr(0).c_str() << endl;
+        }
+        if (!headerWritten) {
+          outObsFile.setHeader(obsFile->header(), int(_rnxVersion), &useObsTypes,
+              &phaseShifts, &gloBiases, &gloSlots);
+          if (_begTime.valid() && _begTime > outObsFile.startTime()) {
+            outObsFile.setStartTime(_begTime);
+          }
+          if (_samplingRate > outObsFile.interval()) {
+            outObsFile.setInterval(_samplingRate);
+          }
+          editRnxObsHeader(outObsFile);
+          QMap<QString, QString> txtMap;
+          QString runBy = settings.value("reqcRunBy").toString();
+          if (!runBy.isEmpty()) {
+            txtMap["RUN BY"]  = runBy;
+          }
+          QString comment = settings.value("reqcComment").toString();
+          if (!comment.isEmpty()) {
+            txtMap["COMMENT"]  = comment;
+          }
+          if (int(_rnxVersion) < int(obsFile->header().version())) {
+            addRnxConversionDetails(obsFile, txtMap);
+          }
+          outObsFile.header().write(outObsFile.stream(), &txtMap);
+          headerWritten = true;
         }
+        _rnxObsFiles.append(obsFile);
+        epos.append(nextEpoch(obsFile));
+        if (epos.last() == 0) {
+          delete _rnxObsFiles.last();
+          _rnxObsFiles.pop_back();
+          epos.pop_back();
+        }
+        iMin = earliestEpoch(epos);
+      }
+      if (iMin == -1) {
+        break;
+      }
 
+      t_rnxObsFile::t_rnxEpo* epo = epos[iMin];
+      if (!lastTime.valid() || epo->tt > lastTime) {
+        lastTime = epo->tt;
         int sec = int(nint(epo->tt.gpssec()*10));
         if (sec % (int(_samplingRate)*10) == 0) {
-          applyLLI(obsFile, epo);
+          applyLLI(epo);
           outObsFile.writeEpoch(epo);
         }
         else {
-          rememberLLI(obsFile, epo);
+          rememberLLI(epo);
         }
       }
-    }
-    catch (QString str) {
-      if (_log) {
-        *_log << "Exception " << str << endl;
-      }
-      else {
-        qDebug() << str;
+
+      epos[iMin] = nextEpoch(_rnxObsFiles[iMin]);
+      if (epos[iMin] == 0) {
+        delete _rnxObsFiles[iMin];
+        _rnxObsFiles.remove(iMin);
+        epos.remove(iMin);
       }
-      return;
     }
-    catch (...) {
-      if (_log) {
-        *_log << "Exception unknown" << endl;
-      }
-      else {
-        qDebug() << "Exception unknown";
-      }
-      return;
+  }
+  catch (QString str) {
+    if (_log) {
+      *_log << "Exception " << str << endl;
+    }
+    else {
+      qDebug() << str;
     }
+    return;
+  }
+  catch (...) {
+    if (_log) {
+      *_log << "Exception unknown" << endl;
+    }
+    else {
+      qDebug() << "Exception unknown";
+    }
+    return;
   }
 }
 
@@ -445,10 +536,9 @@ void t_reqcEdit::editRnxObsHeader(t_rnxObsFile& obsFile) {
   }
 }
 
-//
+// Remember the loss of lock of epochs not written
 ////////////////////////////////////////////////////////////////////////////
-void t_reqcEdit::rememberLLI(const t_rnxObsFile* obsFile,
-                             const t_rnxObsFile::t_rnxEpo* epo) {
+void t_reqcEdit::rememberLLI(const t_rnxObsFile::t_rnxEpo* epo) {
 
   if (_samplingRate == 0) {
     return;
@@ -456,41 +546,35 @@ void t_reqcEdit::rememberLLI(const t_rnxObsFile* obsFile,
 
   for (unsigned iSat = 0; iSat < epo->rnxSat.size(); iSat++) {
     const t_rnxObsFile::t_rnxSat& rnxSat = epo->rnxSat[iSat];
-    char    sys = rnxSat.prn.system();
-    QString prn(rnxSat.prn.toString().c_str());
-
-    for (int iType = 0; iType < obsFile->nTypes(sys); iType++) {
-      QString type = obsFile->obsType(sys, iType);
-      if (!_lli[prn].contains(iType)) {
-        _lli[prn][iType] = 0;
-      }
-      if (rnxSat.obs.contains(type) && rnxSat.obs[type].lli & 1) {
-        _lli[prn][iType] |= 1;
+    QMapIterator<QString, t_rnxObsFile::t_rnxObs> itObs(rnxSat.obs);
+    while (itObs.hasNext()) {
+      itObs.next();
+      if (itObs.value().lli & 1) {
+        _lli[rnxSat.prn].insert(itObs.key());
       }
     }
   }
 }
 
-//
+// Set the loss of lock remembered since the last epoch written
 ////////////////////////////////////////////////////////////////////////////
-void t_reqcEdit::applyLLI(const t_rnxObsFile* obsFile,
-                          t_rnxObsFile::t_rnxEpo* epo) {
+void t_reqcEdit::applyLLI(t_rnxObsFile::t_rnxEpo* epo) {
 
- if (_samplingRate == 0) {
+  if (_samplingRate == 0 || _lli.isEmpty()) {
     return;
   }
 
   for (unsigned iSat = 0; iSat < epo->rnxSat.size(); iSat++) {
     t_rnxObsFile::t_rnxSat& rnxSat = epo->rnxSat[iSat];
-    char    sys = rnxSat.prn.system();
-    QString prn(rnxSat.prn.toString().c_str());
-
-    for (int iType = 0; iType < obsFile->nTypes(sys); iType++) {
-      QString type = obsFile->obsType(sys, iType);
-      if (_lli[prn].contains(iType) && _lli[prn][iType] & 1) {
-        if (rnxSat.obs.contains(type)) {
-          rnxSat.obs[type].lli |= 1;
-        }
+    QMap<t_prn, QSet<QString> >::const_iterator itSat = _lli.constFind(rnxSat.prn);
+    if (itSat == _lli.constEnd()) {
+      continue;
+    }
+    QSetIterator<QString> itType(itSat.value());
+    while (itType.hasNext()) {
+      QMap<QString, t_rnxObsFile::t_rnxObs>::iterator itObs = rnxSat.obs.find(itType.next());
+      if (itObs != rnxSat.obs.end()) {
+        itObs.value().lli |= 1;
       }
     }
   }
@@ -498,28 +582,94 @@ void t_reqcEdit::applyLLI(const t_rnxObsFile* obsFile,
   _lli.clear();
 }
 
+// Key of the ephemeris index (satellite and time of clock)
+////////////////////////////////////////////////////////////////////////////
+class t_ephKey {
+ public:
+  t_ephKey(const t_eph* eph) {
+    _prn = eph->prn();
+    _toc = qint64(floor((eph->TOC().mjd() * 86400.0 + eph->TOC().daysec())
+                        * 1000.0 + 0.5));
+  }
+  bool operator==(const t_ephKey& key2) const {
+    return _prn == key2._prn && _toc == key2._toc;
+  }
+  t_prn  _prn;
+  qint64 _toc;   // milliseconds
+};
+
+inline uint qHash(const t_ephKey& key) {
+  return qHash(key._toc) ^ (uint(key._prn.system()) << 24) ^
+         (uint(key._prn.number()) << 16) ^ (uint(key._prn.flags()) << 12);
+}
+
+// Read one navigation file (on the worker pool)
+////////////////////////////////////////////////////////////////////////////
+class t_navFileTask : public QRunnable {
+ public:
+  t_navFileTask(const QString& fileName) {
+    _fileName = fileName;
+    setAutoDelete(false);
+  }
+  ~t_navFileTask() {
+    for (unsigned ii = 0; ii < _ephs.size(); ii++) {
+      delete _ephs[ii];
+    }
+  }
+  virtual void run() {
+    t_rnxNavFile rnxNavFile(_fileName, t_rnxNavFile::input);
+    rnxNavFile.takeEphs(_ephs);
+    _comments = rnxNavFile.comments();
+  }
+  QString             _fileName;
+  std::vector<t_eph*> _ephs;
+  QStringList         _comments;
+};
+
 /// Read All Ephemerides
 ////////////////////////////////////////////////////////////////////////////
 void t_reqcEdit::readEphemerides(const QStringList& navFileNames,
-                                 QVector<t_eph*>& ephs) {
+                                 QVector<t_eph*>& ephs, QStringList* comments) {
 
-  QStringListIterator it(navFileNames);
-  while (it.hasNext()) {
-    QString fileName = it.next();
-    if (fileName.indexOf('*') != -1 || fileName.indexOf('?') != -1) {
-      QFileInfo fileInfo(fileName);
-      QDir dir = fileInfo.dir();
-      QStringList filters; filters << fileInfo.fileName();
-      QListIterator<QFileInfo> it(dir.entryInfoList(filters));
-      while (it.hasNext()) {
-        QString filePath = it.next().filePath();
-        appendEphemerides(filePath, ephs);
+  QStringList fileNames = expandFileNames(navFileNames);
+
+  // Ephemerides already collected
+  // -----------------------------
+  QSet<t_ephKey> keys;
+  for (int ii = 0; ii < ephs.size(); ii++) {
+    keys.insert(t_ephKey(ephs[ii]));
+  }
+
+  // Files are read in parallel, a batch at a time, and merged in the order
+  // of the list (the first of identical ephemerides is kept)
+  // ----------------------------------------------------------------------
+  QThreadPool pool;
+  const int batchSize = 2 * pool.maxThreadCount();
+  for (int iBeg = 0; iBeg < fileNames.size(); iBeg += batchSize) {
+    QList<t_navFileTask*> tasks;
+    for (int ii = iBeg; ii < fileNames.size() && ii < iBeg + batchSize; ii++) {
+      tasks << new t_navFileTask(fileNames[ii]);
+      pool.start(tasks.last());
+    }
+    pool.waitForDone();
+
+    for (int iTask = 0; iTask < tasks.size(); iTask++) {
+      t_navFileTask* task = tasks[iTask];
+      for (unsigned ii = 0; ii < task->_ephs.size(); ii++) {
+        t_eph* eph = task->_ephs[ii];
+        if (eph && !keys.contains(t_ephKey(eph))) {
+          keys.insert(t_ephKey(eph));
+          ephs.append(eph);
+          task->_ephs[ii] = 0;
+        }
       }
-    }
-    else {
-      appendEphemerides(fileName, ephs);
+      if (comments) {
+        *comments << task->_comments;
+      }
+      delete task;
     }
   }
+
   qStableSort(ephs.begin(), ephs.end(), t_eph::earlierTime);
 }
 
@@ -541,20 +691,11 @@ void t_reqcEdit::editEphemerides() {
   if (!comment.isEmpty()) {
     comments.append(comment);
   }
-  QStringListIterator it(_navFileNames);
-  while (it.hasNext()) {
-    QString fileName = it.next();
-    t_rnxNavFile rnxNavFile(fileName, t_rnxNavFile::input);
-    QStringListIterator itCmnt(rnxNavFile.comments());
-    while (itCmnt.hasNext()) {
-      comments.append(itCmnt.next());
-    }
-  }
-  comments.removeDuplicates();
 
   // Read Ephemerides
   // ----------------
-  t_reqcEdit::readEphemerides(_navFileNames, _ephs);
+  t_reqcEdit::readEphemerides(_navFileNames, _ephs, &comments);
+  comments.removeDuplicates();
 
   // Check Satellite Systems
   // -----------------------
@@ -648,49 +789,6 @@ void t_reqcEdit::editEphemerides() {
   }
 }
 
-//
-////////////////////////////////////////////////////////////////////////////
-void t_reqcEdit::appendEphemerides(const QString& fileName,
-                                   QVector<t_eph*>& ephs) {
-
-  t_rnxNavFile rnxNavFile(fileName, t_rnxNavFile::input);
-  for (unsigned ii = 0; ii < rnxNavFile.ephs().size(); ii++) {
-    t_eph* eph   = rnxNavFile.ephs()[ii];
-    bool   isNew = true;
-    for (int iOld = 0; iOld < ephs.size(); iOld++) {
-      const t_eph* ephOld = ephs[iOld];
-      if (ephOld->prn() == eph->prn() &&
-          ephOld->TOC() == eph->TOC()) {
-        isNew = false;
-        break;
-      }
-    }
-    if (isNew) {
-      if      (eph->type() == t_eph::GPS) {
-        ephs.append(new t_ephGPS(*dynamic_cast<t_ephGPS*>(eph)));
-      }
-      else if (eph->type() == t_eph::GLONASS) {
-        ephs.append(new t_ephGlo(*dynamic_cast<t_ephGlo*>(eph)));
-      }
-      else if (eph->type() == t_eph::Galileo) {
-        ephs.append(new t_ephGal(*dynamic_cast<t_ephGal*>(eph)));
-      }
-      else if (eph->type() == t_eph::QZSS) {
-        ephs.append(new t_ephGPS(*dynamic_cast<t_ephGPS*>(eph)));
-      }
-      else if (eph->type() == t_eph::SBAS) {
-        ephs.append(new t_ephSBAS(*dynamic_cast<t_ephSBAS*>(eph)));
-      }
-      else if (eph->type() == t_eph::BDS) {
-        ephs.append(new t_ephBDS(*dynamic_cast<t_ephBDS*>(eph)));
-      }
-      else if (eph->type() == t_eph::IRNSS) {
-        ephs.append(new t_ephGPS(*dynamic_cast<t_ephGPS*>(eph)));
-      }
-    }
-  }
-}
-
 void t_reqcEdit::addRnxConversionDetails(const t_rnxObsFile* obsFile,
                                           QMap<QString, QString>& txtMap) {
 
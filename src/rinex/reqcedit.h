@@ -50,22 +50,41 @@ Q_OBJECT
                               QVector<t_rnxObsFile*>& rnxObsFiles,
                               QTextStream* log);
   static void readEphemerides(const QStringList& navFileNames,
-                              QVector<t_eph*>& ephs);
-  static void appendEphemerides(const QString& fileName, QVector<t_eph*>& ephs);
+                              QVector<t_eph*>& ephs, QStringList* comments = 0);
 
  private:
+  // Header data of an input observation file, the file is opened again
+  // when the merge of the epochs reaches its start time
+  class t_obsInput {
+   public:
+    static bool earlierStartTime(const t_obsInput& inp1, const t_obsInput& inp2) {
+      return inp1.startTime < inp2.startTime;
+    }
+    QString     fileName;
+    bncTime     startTime;
+    QStringList obsTypes;
+    QStringList phaseShifts;
+    QStringList gloBiases;
+    QStringList gloSlots;
+    bool        allGloBiases;
+    bool        allGloSlots;
+  };
+
+  static QStringList expandFileNames(const QStringList& fileNames);
   void editObservations();
   void editEphemerides();
   void editRnxObsHeader(t_rnxObsFile& obsFile);
-  void rememberLLI(const t_rnxObsFile* obsFile, const t_rnxObsFile::t_rnxEpo* epo);
-  void applyLLI(const t_rnxObsFile* obsFile, t_rnxObsFile::t_rnxEpo* epo);
+  void indexRnxObsFiles(QVector<t_obsInput>& inputs);
+  t_rnxObsFile::t_rnxEpo* nextEpoch(t_rnxObsFile* obsFile);
+  void rememberLLI(const t_rnxObsFile::t_rnxEpo* epo);
+  void applyLLI(t_rnxObsFile::t_rnxEpo* epo);
   void addRnxConversionDetails(const t_rnxObsFile* obsFile, QMap<QString, QString>& txtMap);
 
   QString                _logFileName;
   QFile*                 _logFile;
   QTextStream*           _log;
   QStringList            _obsFileNames;
-  QVector<t_rnxObsFile*> _rnxObsFiles;
+  QVector<t_rnxObsFile*> _rnxObsFiles;   // input files being merged
   QString                _outObsFileName;
   QStringList            _navFileNames;
   QString                _outNavFileName;
@@ -73,7 +92,7 @@ Q_OBJECT
   double                 _samplingRate;
   bncTime                _begTime;
   bncTime                _endTime;
-  QMap<QString, QMap<int, int> > _lli;
+  QMap<t_prn, QSet<QString> > _lli;   // types with loss of lock since the last epoch written
   QVector<t_eph*>        _ephs;
 };
 
@@ -39,6 +39,8 @@
  * -----------------------------------------------------------------------*/
 
 #include <iostream>
+#include <algorithm>
+#include <cctype>
 #include <newmatio.h>
 #include "rnxnavfile.h"
 #include "bnccore.h"
@@ -47,6 +49,75 @@
 
 using namespace std;
 
+// One record of the file (lines in the buffer, satellite system)
+////////////////////////////////////////////////////////////////////////////
+class t_navRecord {
+ public:
+  char _system;
+  int  _firstLine;
+  int  _numLines;
+};
+
+// New ephemeris from the lines of a record, 0 if the system is unknown
+////////////////////////////////////////////////////////////////////////////
+static t_eph* newEph(double version, char system, const QStringList& lines) {
+  if      (system == 'G' || system == 'J' || system == 'I') {
+    return new t_ephGPS(version, lines);
+  }
+  else if (system == 'R') {
+    return new t_ephGlo(version, lines);
+  }
+  else if (system == 'E') {
+    return new t_ephGal(version, lines);
+  }
+  else if (system == 'S') {
+    return new t_ephSBAS(version, lines);
+  }
+  else if (system == 'C') {
+    return new t_ephBDS(version, lines);
+  }
+  return 0;
+}
+
+// Parses a range of records
+////////////////////////////////////////////////////////////////////////////
+class t_navRecordTask : public QRunnable {
+ public:
+  t_navRecordTask(double version, const QByteArray& buffer,
+                  const vector<pair<int, int> >& lines,
+                  const vector<t_navRecord>& records, int iBeg, int iEnd,
+                  vector<t_eph*>& ephs) :
+    _version(version), _buffer(buffer), _lines(lines), _records(records),
+    _iBeg(iBeg), _iEnd(iEnd), _ephs(ephs) {
+    setAutoDelete(false);
+  }
+  virtual void run() {
+    for (int iRec = _iBeg; iRec < _iEnd; iRec++) {
+      const t_navRecord& record = _records[iRec];
+      QStringList recLines;
+      for (int ii = 0; ii < record._numLines; ii++) {
+        unsigned iLine = record._firstLine + ii;
+        if (iLine < _lines.size()) {
+          recLines << QString::fromLatin1(_buffer.constData() + _lines[iLine].first,
+                                          _lines[iLine].second);
+        }
+        else {
+          recLines << QString();   // as read past the end of the file
+        }
+      }
+      _ephs[iRec] = newEph(_version, record._system, recLines);
+    }
+  }
+ private:
+  double                         _version;
+  const QByteArray&              _buffer;
+  const vector<pair<int, int> >& _lines;
+  const vector<t_navRecord>&     _records;
+  int                            _iBeg;
+  int                            _iEnd;
+  vector<t_eph*>&                _ephs;
+};
+
 // Constructor
 ////////////////////////////////////////////////////////////////////////////
 t_rnxNavFile::t_rnxNavHeader::t_rnxNavHeader() {
@@ -90,9 +161,11 @@ t_irc t_rnxNavFile::t_rnxNavHeader::read(QTextStream* stream) {
 // Constructor
 ////////////////////////////////////////////////////////////////////////////
 t_rnxNavFile::t_rnxNavFile(const QString& fileName, e_inpOut inpOut) {
-  _inpOut = inpOut;
-  _stream = 0;
-  _file   = 0;
+  _inpOut  = inpOut;
+  _stream  = 0;
+  _file    = 0;
+  _indexed = false;
+  _tocNext = 0;
   if (_inpOut == input) {
     openRead(fileName);
   }
@@ -107,12 +180,39 @@ void t_rnxNavFile::openRead(const QString& fileName) {
 
   _fileName = fileName; expandEnvVar(_fileName);
   _file     = new QFile(_fileName);
-  _file->open(QIODevice::ReadOnly | QIODevice::Text);
-  _stream = new QTextStream();
-  _stream->setDevice(_file);
+  if (!_file->open(QIODevice::ReadOnly)) {
+    return;
+  }
+
+  QByteArray buffer;
+  qint64     size = _file->size();
+  uchar*     data = _file->map(0, size);
+  if (data) {
+    buffer = QByteArray::fromRawData(reinterpret_cast<const char*>(data), size);
+  }
+  else {
+    buffer = _file->readAll();
+  }
+
+  // Header up to END OF HEADER
+  // --------------------------
+  int pos = 0;
+  while (pos < buffer.size()) {
+    int end = buffer.indexOf('\n', pos);
+    end = (end == -1) ? buffer.size() : end + 1;
+    QByteArray line = buffer.mid(pos, end - pos);
+    pos = end;
+    if (line.mid(60).trimmed() == "END OF HEADER") {
+      break;
+    }
+  }
+  QTextStream headerStream(buffer.left(pos), QIODevice::ReadOnly);
+  _header.read(&headerStream);
 
-  _header.read(_stream);
-  this->read(_stream);
+  this->read(buffer, pos);
+
+  buffer.clear();
+  _file->close();
 }
 
 // Open for output
@@ -142,115 +242,188 @@ void t_rnxNavFile::close() {
   delete _file;   _file = 0;
 }
 
-// Read File Content
+// Read File Content (records parsed in parallel)
 ////////////////////////////////////////////////////////////////////////////
-void t_rnxNavFile::read(QTextStream* stream) {
+void t_rnxNavFile::read(const QByteArray& buffer, int pos) {
 
-  while (stream->status() == QTextStream::Ok && !stream->atEnd()) {
-    QString line = stream->readLine();
-    if (line.isEmpty()) {
-      continue;
+  // Lines (offset, length without end of line)
+  // ------------------------------------------
+  vector<pair<int, int> > lines;
+  while (pos < buffer.size()) {
+    int end = buffer.indexOf('\n', pos);
+    if (end == -1) {
+      end = buffer.size();
     }
-    QStringList hlp = line.split(QRegExp("\\s+"), QString::SkipEmptyParts);
-    QString prn;
-    if (version() >= 3.0) {
-      prn = hlp.at(0);
-    }
-    else {
-      if (glonass()) {
-        prn = QString("R%1_0").arg(hlp.at(0).toInt(), 2, 10, QChar('0'));
-      }
-      else {
-        prn = QString("G%1_0").arg(hlp.at(0).toInt(), 2, 10, QChar('0'));
-      }
+    int len = end - pos;
+    if (len > 0 && buffer[end-1] == '\r') {
+      --len;
     }
+    lines.push_back(make_pair(pos, len));
+    pos = end + 1;
+  }
 
-    t_eph* eph = 0;
-    QStringList lines; lines << line;
-    if      (prn[0] == 'G') {
-      for (int ii = 1; ii < 8; ii++) {
-        lines << stream->readLine();
-      }
-      eph = new t_ephGPS(version(), lines);
+  // Records: first line gives the system and the number of lines
+  // ------------------------------------------------------------
+  vector<t_navRecord> records;
+  unsigned iLine = 0;
+  while (iLine < lines.size()) {
+    const char* line = buffer.constData() + lines[iLine].first;
+    int         len  = lines[iLine].second;
+    int         ii   = 0;
+    while (ii < len && isspace(static_cast<unsigned char>(line[ii]))) {
+      ++ii;
     }
-    else if (prn[0] == 'R') {
-      for (int ii = 1; ii < 4; ii++) {
-        lines << stream->readLine();
-      }
-      eph = new t_ephGlo(version(), lines);
+    if (ii == len) {
+      ++iLine;
+      continue;
     }
-    else if (prn[0] == 'E') {
-      for (int ii = 1; ii < 8; ii++) {
-        lines << stream->readLine();
-      }
-      eph = new t_ephGal(version(), lines);
+    t_navRecord record;
+    if (version() >= 3.0) {
+      record._system = line[ii];
     }
-    else if (prn[0] == 'J') {
-      for (int ii = 1; ii < 8; ii++) {
-        lines << stream->readLine();
-      }
-      eph = new t_ephGPS(version(), lines);
+    else {
+      record._system = glonass() ? 'R' : 'G';
     }
-    else if (prn[0] == 'S') {
-      for (int ii = 1; ii < 4; ii++) {
-        lines << stream->readLine();
-      }
-      eph = new t_ephSBAS(version(), lines);
+    record._firstLine = iLine;
+    switch (record._system) {
+      case 'G': case 'E': case 'J': case 'C': case 'I':
+        record._numLines = 8;
+        break;
+      case 'R': case 'S':
+        record._numLines = 4;
+        break;
+      default:
+        record._numLines = 1;
     }
-    else if (prn[0] == 'C') {
-      for (int ii = 1; ii < 8; ii++) {
-        lines << stream->readLine();
-      }
-      eph = new t_ephBDS(version(), lines);
+    records.push_back(record);
+    iLine += record._numLines;
+  }
+
+  // Parse, chunks of at least MINRECORDS records in parallel
+  // --------------------------------------------------------
+  _ephs.resize(records.size(), 0);
+  int numRecords = records.size();
+  if (numRecords <= MINRECORDS) {
+    t_navRecordTask task(version(), buffer, lines, records, 0, numRecords, _ephs);
+    task.run();
+  }
+  else {
+    QThreadPool pool;
+    int chunkSize = max(int(MINRECORDS),
+                        (numRecords + pool.maxThreadCount() - 1) / pool.maxThreadCount());
+    QList<t_navRecordTask*> tasks;
+    for (int iBeg = 0; iBeg < numRecords; iBeg += chunkSize) {
+      tasks << new t_navRecordTask(version(), buffer, lines, records,
+                                   iBeg, min(iBeg + chunkSize, numRecords), _ephs);
+      pool.start(tasks.last());
     }
-    else if (prn[0] == 'I') {
-      for (int ii = 1; ii < 8; ii++) {
-        lines << stream->readLine();
-      }
-      eph = new t_ephGPS(version(), lines);
+    pool.waitForDone();
+    for (int ii = 0; ii < tasks.size(); ii++) {
+      delete tasks[ii];
     }
-    _ephs.push_back(eph);
   }
 }
 
+// Index of the ephemerides by satellite and IOD and by TOC
+////////////////////////////////////////////////////////////////////////////
+void t_rnxNavFile::buildIndex() {
+
+  _iodIndex.clear();
+  _tocOrder.clear();
+  _tocReady.clear();
+  _tocNext = 0;
+  _tocTime.reset();
+
+  vector<pair<bncTime, int> > tocs;
+  for (unsigned ii = 0; ii < _ephs.size(); ii++) {
+    t_eph* eph = _ephs[ii];
+    if (eph) {
+      QString prn(eph->prn().toInternalString().c_str());
+      _iodIndex[prn].push_back(make_pair(eph->IOD(), int(ii)));
+      tocs.push_back(make_pair(eph->TOC(), int(ii)));
+    }
+  }
+
+  // Positions ascending within equal keys
+  // -------------------------------------
+  QMutableHashIterator<QString, t_iodIndex> it(_iodIndex);
+  while (it.hasNext()) {
+    it.next();
+    sort(it.value().begin(), it.value().end());
+  }
+  sort(tocs.begin(), tocs.end());
+  for (unsigned ii = 0; ii < tocs.size(); ii++) {
+    _tocOrder.push_back(tocs[ii].second);
+  }
+
+  _indexed = true;
+}
+
+// Remove an ephemeris from the file
+////////////////////////////////////////////////////////////////////////////
+t_eph* t_rnxNavFile::take(int iEph) {
+  t_eph* eph = _ephs[iEph];
+  _ephs[iEph] = 0;
+  return eph;
+}
+
 // Read Next Ephemeris
 ////////////////////////////////////////////////////////////////////////////
 t_eph* t_rnxNavFile::getNextEph(const bncTime& tt,
                                 const QMap<QString, unsigned int>* corrIODs) {
 
-  // Get Ephemeris according to IOD
-  // ------------------------------
+  if (!_indexed) {
+    buildIndex();
+  }
+
+  // Get Ephemeris according to IOD (first one in the file)
+  // ------------------------------------------------------
   if (corrIODs) {
     QMapIterator<QString, unsigned int> itIOD(*corrIODs);
     while (itIOD.hasNext()) {
       itIOD.next();
-      QString prn = itIOD.key();
+      QHash<QString, t_iodIndex>::const_iterator itSat = _iodIndex.find(itIOD.key());
+      if (itSat == _iodIndex.end()) {
+        continue;
+      }
       unsigned int iod = itIOD.value();
-      vector<t_eph*>::iterator it = _ephs.begin();
-      while (it != _ephs.end()) {
-        t_eph* eph = *it;
-        double dt = eph->TOC() - tt;
-        if (dt < 8*3600.0 && QString(eph->prn().toInternalString().c_str()) == prn && eph->IOD() == iod) {
-          it = _ephs.erase(it);
-          return eph;
+      const t_iodIndex& index = itSat.value();
+      t_iodIndex::const_iterator it = lower_bound(index.begin(), index.end(),
+                                                  make_pair(iod, -1));
+      while (it != index.end() && it->first == iod) {
+        t_eph* eph = _ephs[it->second];
+        if (eph && eph->TOC() - tt < 8*3600.0) {
+          return take(it->second);
         }
         ++it;
       }
     }
   }
 
-  // Get Ephemeris according to time
-  // -------------------------------
+  // Get Ephemeris according to time (first one in the file)
+  // -------------------------------------------------------
   else {
-    vector<t_eph*>::iterator it = _ephs.begin();
-    while (it != _ephs.end()) {
-      t_eph* eph = *it;
-      double dt = eph->TOC() - tt;
-      if (dt < 2*3600.0) {
-        it = _ephs.erase(it);
-        return eph;
+    if (!_tocTime.valid() || tt < _tocTime) {
+      _tocReady.clear();
+      _tocNext = 0;
+    }
+    _tocTime = tt;
+    while (_tocNext < int(_tocOrder.size())) {
+      int iEph = _tocOrder[_tocNext];
+      if (_ephs[iEph]) {
+        if (_ephs[iEph]->TOC() - tt >= 2*3600.0) {
+          break;
+        }
+        _tocReady.insert(iEph);
+      }
+      ++_tocNext;
+    }
+    while (!_tocReady.empty()) {
+      int iEph = *_tocReady.begin();
+      _tocReady.erase(_tocReady.begin());
+      if (_ephs[iEph]) {
+        return take(iEph);
       }
-      ++it;
     }
   }
 
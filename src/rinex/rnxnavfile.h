@@ -26,6 +26,8 @@
 #define RNXNAVFILE_H
 
 #include <queue>
+#include <set>
+#include <vector>
 #include <QtCore>
 #include "bncconst.h"
 #include "bnctime.h"
@@ -57,8 +59,14 @@ class t_rnxNavFile {
  public:
   t_rnxNavFile(const QString& fileName, e_inpOut inpOut);
   ~t_rnxNavFile();
+
+  /**
+   * Next ephemeris to be used at tt (ownership passes to the caller),
+   * found in an index built on the first call
+   */
   t_eph* getNextEph(const bncTime& tt, const QMap<QString, unsigned int>* corrIODs);
   const std::vector<t_eph*> ephs() const {return _ephs;}
+  void   takeEphs(std::vector<t_eph*>& ephs) {ephs.swap(_ephs); _ephs.clear(); _indexed = false;}
   double version() const {return _header._version;}
   void   setVersion(double version) {_header._version = version;}
   bool   glonass() const {return _header._glonass;}
@@ -76,7 +84,11 @@ class t_rnxNavFile {
   void close();
 
  private:
-  void read(QTextStream* stream);
+  void   read(const QByteArray& buffer, int pos);
+  void   buildIndex();
+  t_eph* take(int iEph);
+
+  static const int MINRECORDS = 500;   // records parsed by one thread at least
 
   e_inpOut            _inpOut;
   QFile*              _file;
@@ -84,6 +96,16 @@ class t_rnxNavFile {
   QTextStream*        _stream;
   std::vector<t_eph*> _ephs;
   t_rnxNavHeader      _header;
+
+  // Index of the ephemerides (positions in _ephs)
+  // ---------------------------------------------
+  typedef std::vector<std::pair<unsigned int, int> > t_iodIndex; // IOD, position
+  bool                       _indexed;
+  QHash<QString, t_iodIndex> _iodIndex;  // per satellite, sorted
+  std::vector<int>           _tocOrder;  // sorted by TOC
+  int                        _tocNext;   // next in _tocOrder
+  bncTime                    _tocTime;   // tt of _tocReady
+  std::set<int>              _tocReady;  // valid at _tocTime
 };
 
 #endif
@@ -75,6 +75,7 @@ t_rnxObsHeader::~t_rnxObsHeader() {
 ////////////////////////////////////////////////////////////////////////////
 t_irc t_rnxObsHeader::read(QTextStream* stream, int maxLines) {
   _comments.clear();
+  _columns.clear();
   int numLines = 0;
 
   while ( stream->status() == QTextStream::Ok && !stream->atEnd() ) {
@@ -315,6 +316,7 @@ void t_rnxObsHeader::setDefault(const QString& markerName, int version) {
   _comments << "Default set of observation types used";
   _comments.removeDuplicates();
 
+  _columns.clear();
   _obsTypes.clear();
   if (_version < 3.0) {
     _obsTypes['G'] << "C1" << "P1" << "L1" << "S1"
@@ -408,6 +410,7 @@ void t_rnxObsHeader::set(const t_rnxObsHeader& header, int version,
 
   // Set observation types
   // ---------------------
+  _columns.clear();
   _obsTypes.clear();
   if (!useObsTypes || useObsTypes->size() == 0) {
     if      (int(_version) == int(header._version)) {
@@ -856,6 +859,69 @@ QStringList t_rnxObsHeader::obsTypes(char sys) const {
   }
 }
 
+// Output columns of an observation type (satellite-system specific)
+////////////////////////////////////////////////////////////////////////////
+const t_rnxObsHeader::t_columns& t_rnxObsHeader::columns(char sys,
+                                                        const QString& type) const {
+
+  QHash<QString, t_columns>& sysColumns = _columns[sys];
+  QHash<QString, t_columns>::const_iterator it = sysColumns.constFind(type);
+  if (it != sysColumns.constEnd()) {
+    return it.value();
+  }
+
+  t_columns&  cols     = sysColumns[type];
+  QStringList outTypes = _obsTypes.value(sys);
+
+  // Version 3: exact and non-exact match
+  // ------------------------------------
+  if (_version >= 3.0) {
+    QString typeV3 = t_rnxObsFile::type2to3(sys, type);
+    for (int iTypeV3 = 0; iTypeV3 < outTypes.size(); iTypeV3++) {
+      if (outTypes[iTypeV3] == typeV3) {
+        cols.exact.push_back(iTypeV3);
+      }
+      if (outTypes[iTypeV3] == typeV3.left(2)) {
+        cols.nonExact.push_back(iTypeV3);
+      }
+    }
+  }
+
+  // Version 2: first preferred tracking attribute the type matches
+  // --------------------------------------------------------------
+  else {
+    QString     typeV2              = t_rnxObsFile::type3to2(sys, type);
+    QStringList preferredAttribList = t_rnxObsFile::signalPriorities(sys);
+    for (int iTypeV2 = 0; iTypeV2 < outTypes.size(); iTypeV2++) {
+      if (outTypes[iTypeV2] != typeV2) {
+        continue;
+      }
+      QString preferredAttrib;
+      for (int ii = 0; ii < preferredAttribList.size(); ii++) {
+        if (preferredAttribList[ii].indexOf("&") != -1) {
+          QStringList hlp = preferredAttribList[ii].split("&", QString::SkipEmptyParts);
+          if (hlp.size() == 2 && hlp[0].contains(typeV2[1])) {
+            preferredAttrib = hlp[1];
+          }
+        }
+        else {
+          preferredAttrib = preferredAttribList[ii];
+        }
+      }
+      for (int iPref = 0; iPref < preferredAttrib.size(); iPref++) {
+        if ( preferredAttrib[iPref] == '?'                             ||
+             (type.length() == 2 && preferredAttrib[iPref] == '_'    ) ||
+             (type.length() == 3 && preferredAttrib[iPref] == type[2]) ) {
+          cols.v2.push_back(qMakePair(iTypeV2, iPref));
+          break;
+        }
+      }
+    }
+  }
+
+  return cols;
+}
+
 // Number of Observation Types (satellite-system specific)
 ////////////////////////////////////////////////////////////////////////////
 int t_rnxObsHeader::nTypes(char sys) const {
@@ -1041,8 +1107,7 @@ void t_rnxObsFile::openWrite(const QString& fileName) {
   _fileName = fileName; expandEnvVar(_fileName);
   _file     = new QFile(_fileName);
   _file->open(QIODevice::WriteOnly | QIODevice::Text);
-  _stream = new QTextStream();
-  _stream->setDevice(_file);
+  _stream = new QTextStream(&_outBuffer, QIODevice::WriteOnly);
 }
 
 // Destructor
@@ -1054,6 +1119,9 @@ t_rnxObsFile::~t_rnxObsFile() {
 // Close
 ////////////////////////////////////////////////////////////////////////////
 void t_rnxObsFile::close() {
+  if (_inpOut == output && _stream) {
+    flushOutput();
+  }
   delete _stream; _stream = 0;
   delete _file;   _file = 0;
 }
@@ -1306,11 +1374,24 @@ void t_rnxObsFile::writeEpoch(const t_rnxEpo* epo) {
   }
 
   if (version() < 3.0) {
-    return writeEpochV2(_stream, _header, &epoLocal);
+    writeEpochV2(_stream, _header, &epoLocal);
   }
   else {
-    return writeEpochV3(_stream, _header, &epoLocal);
+    writeEpochV3(_stream, _header, &epoLocal);
   }
+
+  if (_outBuffer.size() >= OUTBUFSIZE) {
+    flushOutput();
+  }
+}
+
+// Write the collected output lines (endl does not reach the file)
+////////////////////////////////////////////////////////////////////////////
+void t_rnxObsFile::flushOutput() {
+  _stream->flush();
+  _file->write(_outBuffer.toAscii());
+  _outBuffer.clear();
+  _stream->setString(&_outBuffer, QIODevice::WriteOnly);
 }
 // Write Data Epoch (RINEX Version 2)
 ////////////////////////////////////////////////////////////////////////////
@@ -1345,62 +1426,52 @@ void t_rnxObsFile::writeEpochV2(QTextStream* stream, const t_rnxObsHeader& heade
   for (unsigned iSat = 0; iSat < epo->rnxSat.size(); iSat++) {
     const t_rnxSat& rnxSat = epo->rnxSat[iSat];
     char            sys    = rnxSat.prn.system();
-    for (int iTypeV2 = 0; iTypeV2 < header.nTypes(sys); iTypeV2++) {
+    int             nTypes = header.nTypes(sys);
+
+    // Observation of the most preferred tracking attribute, the first one
+    // of equal preference
+    // --------------------------------------------------------------------
+    const t_rnxObs* hlp[nTypes];
+    int             hlpPref[nTypes];
+    for (int iTypeV2 = 0; iTypeV2 < nTypes; iTypeV2++) {
+      hlp[iTypeV2]     = 0;
+      hlpPref[iTypeV2] = 0;
+    }
+    QMapIterator<QString, t_rnxObs> itObs(rnxSat.obs);
+    while (itObs.hasNext()) {
+      itObs.next();
+      const QVector<QPair<int, int> >& cols = header.columns(sys, itObs.key()).v2;
+      for (int ii = 0; ii < cols.size(); ii++) {
+        int iTypeV2 = cols[ii].first;
+        if (hlp[iTypeV2] == 0 || cols[ii].second < hlpPref[iTypeV2]) {
+          hlp[iTypeV2]     = &itObs.value();
+          hlpPref[iTypeV2] = cols[ii].second;
+        }
+      }
+    }
+
+    for (int iTypeV2 = 0; iTypeV2 < nTypes; iTypeV2++) {
       if (iTypeV2 > 0 && iTypeV2 % 5 == 0) {
         *stream << endl;
       }
-      QString typeV2 = header.obsType(sys, iTypeV2);
-      bool    found  = false;
-      QStringList preferredAttribList = signalPriorities(sys);
-      QString preferredAttrib;
-      for (int ii = 0; ii < preferredAttribList.size(); ii++) {
-        if (preferredAttribList[ii].indexOf("&") != -1) {
-          QStringList hlp = preferredAttribList[ii].split("&", QString::SkipEmptyParts);
-          if (hlp.size() == 2 && hlp[0].contains(typeV2[1])) {
-            preferredAttrib = hlp[1];
-          }
+      const t_rnxObs* rnxObs = hlp[iTypeV2];
+      if (rnxObs == 0 || rnxObs->value == 0.0) {
+        *stream << QString().leftJustified(16);
+      }
+      else {
+        *stream << QString("%1").arg(rnxObs->value, 14, 'f', 3);
+        if (rnxObs->lli != 0.0) {
+          *stream << QString("%1").arg(rnxObs->lli,1);
         }
         else {
-          preferredAttrib = preferredAttribList[ii];
+          *stream << ' ';
         }
-      }
-
-      for (int iPref = 0; iPref < preferredAttrib.size(); iPref++) {
-        QMapIterator<QString, t_rnxObs> itObs(rnxSat.obs);
-        while (itObs.hasNext()) {
-          itObs.next();
-          const QString&  type   = itObs.key();
-          const t_rnxObs& rnxObs = itObs.value();
-          if ( preferredAttrib[iPref] == '?'                             ||
-               (type.length() == 2 && preferredAttrib[iPref] == '_'    ) ||
-               (type.length() == 3 && preferredAttrib[iPref] == type[2]) ) {
-            if (typeV2 == type3to2(sys, type)) {
-              found = true;
-              if (rnxObs.value == 0.0) {
-                *stream << QString().leftJustified(16);
-              }
-              else {
-                *stream << QString("%1").arg(rnxObs.value, 14, 'f', 3);
-                if (rnxObs.lli != 0.0) {
-                  *stream << QString("%1").arg(rnxObs.lli,1);
-                }
-                else {
-                  *stream << ' ';
-                }
-                if (rnxObs.snr != 0.0) {
-                  *stream << QString("%1").arg(rnxObs.snr,1);
-                }
-                else {
-                  *stream << ' ';
-                }
-              }
-              goto end_loop_iPref;
-            }
-          }
+        if (rnxObs->snr != 0.0) {
+          *stream << QString("%1").arg(rnxObs->snr,1);
+        }
+        else {
+          *stream << ' ';
         }
-      } end_loop_iPref:
-      if (!found) {
-        *stream << QString().leftJustified(16);
       }
     }
     *stream << endl;
@@ -1434,35 +1505,35 @@ void t_rnxObsFile::writeEpochV3(QTextStream* stream, const t_rnxObsHeader& heade
     const t_rnxSat& rnxSat = epo->rnxSat[iSat];
     char sys = rnxSat.prn.system();
 
+    // Exact match (the last one), else non-exact match (the first one)
+    // ----------------------------------------------------------------
     const t_rnxObs* hlp[header.nTypes(sys)];
+    const t_rnxObs* hlpNonExact[header.nTypes(sys)];
     for (int iTypeV3 = 0; iTypeV3 < header.nTypes(sys); iTypeV3++) {
-      hlp[iTypeV3] = 0;
-      QString typeV3 = header.obsType(sys, iTypeV3);
-      QMapIterator<QString, t_rnxObs> itObs(rnxSat.obs);
-
-      // Exact match
-      // -----------
-      while (itObs.hasNext()) {
-        itObs.next();
-        const QString& type = itObs.key();
-        const t_rnxObs& rnxObs = itObs.value();
-        if (typeV3 == type2to3(sys, type) && rnxObs.value != 0.0) {
-          hlp[iTypeV3] = &itObs.value();
-        }
+      hlp[iTypeV3]         = 0;
+      hlpNonExact[iTypeV3] = 0;
+    }
+    QMapIterator<QString, t_rnxObs> itObs(rnxSat.obs);
+    while (itObs.hasNext()) {
+      itObs.next();
+      if (itObs.value().value == 0.0) {
+        continue;
       }
-
-      // Non-Exact match
-      // ---------------
-      itObs.toFront();
-      while (itObs.hasNext()) {
-        itObs.next();
-        const QString& type = itObs.key();
-        const t_rnxObs& rnxObs = itObs.value();
-        if (hlp[iTypeV3] == 0 && typeV3 == type2to3(sys, type).left(2) && rnxObs.value != 0.0) {
-          hlp[iTypeV3] = &itObs.value();
+      const t_rnxObsHeader::t_columns& cols = header.columns(sys, itObs.key());
+      for (int ii = 0; ii < cols.exact.size(); ii++) {
+        hlp[cols.exact[ii]] = &itObs.value();
+      }
+      for (int ii = 0; ii < cols.nonExact.size(); ii++) {
+        if (hlpNonExact[cols.nonExact[ii]] == 0) {
+          hlpNonExact[cols.nonExact[ii]] = &itObs.value();
         }
       }
     }
+    for (int iTypeV3 = 0; iTypeV3 < header.nTypes(sys); iTypeV3++) {
+      if (hlp[iTypeV3] == 0) {
+        hlp[iTypeV3] = hlpNonExact[iTypeV3];
+      }
+    }
 
     if (header.nTypes(sys)) {
       *stream << rnxSat.prn.toString().c_str();
@@ -71,7 +71,16 @@ class t_rnxObsHeader {
   void        setStartTime(const bncTime& startTime) {_startTime = startTime;}
 
  private:
-  QStringList obsTypesStrings() const;
+  // Output columns of an observation type of the epochs to be written
+  class t_columns {
+   public:
+    QVector<int>               exact;      // version 3, same type
+    QVector<int>               nonExact;   // version 3, same type without attribute
+    QVector<QPair<int, int> >  v2;         // version 2, column and signal priority
+  };
+
+  QStringList      obsTypesStrings() const;
+  const t_columns& columns(char sys, const QString& type) const;
   QString         _usedSystems;
   double          _version;
   double          _interval;
@@ -99,6 +108,8 @@ class t_rnxObsHeader {
   bool                    _writeRinexOnlyWithSklObsTypes;
 
   QMap<QString, QPair<double, QStringList> > _phaseShifts;
+
+  mutable QMap<char, QHash<QString, t_columns> > _columns;   // built on first use
 };
 
 class t_rnxObsFile {
@@ -244,11 +255,15 @@ class t_rnxObsFile {
   t_rnxEpo* nextEpochV2();
   t_rnxEpo* nextEpochV3();
   void handleEpochFlag(int flag, const QString& line, bool& headerReRead);
+  void flushOutput();
+
+  static const int OUTBUFSIZE = 1 << 16;   // output written in blocks of this size
 
   e_inpOut       _inpOut;
   QFile*         _file;
   QString        _fileName;
   QTextStream*   _stream;
+  QString        _outBuffer;
   t_rnxObsHeader _header;
   t_rnxEpo       _currEpo;
   bool           _flgPowerFail;
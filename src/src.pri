@@ -42,24 +42,29 @@ HEADERS = bnchelp.html bncgetthread.h    bncwindow.h   bnctabledlg.h  \
           bncnetquery.h bncnetqueryv1.h bncnetqueryv2.h               \
           bncnetqueryrtp.h bncsettings.h latencychecker.h             \
           bncipport.h bncnetqueryv0.h bncnetqueryudp.h                \
-          bncnetqueryudp0.h bncudpport.h bnctime.h                    \
+          bncnetqueryudp0.h bncudpport.h bnctime.h bncudpreceiver.h   \
           bncserialport.h bncnetquerys.h bncfigure.h                  \
           bncfigurelate.h bncversion.h                                \
           bncfigureppp.h bncrawfile.h                                 \
           bncmap.h bncantex.h bncephuser.h                            \
           bncoutf.h bncclockrinex.h bncsp3.h bncsinextro.h            \
           bncbytescounter.h bncsslconfig.h reqcdlg.h                  \
+          bnckalman.h bncrawreplay.h bncmetrics.h                     \
+          bncnetreactor.h bncconnscheduler.h                          \
+          bncadvisedispatcher.h bncrawrecorder.h                      \
           upload/bncrtnetdecoder.h upload/bncuploadcaster.h           \
           ephemeris.h t_prn.h satObs.h                                \
           upload/bncrtnetuploadcaster.h upload/bnccustomtrafo.h       \
           upload/bncephuploadcaster.h qtfilechooser.h                 \
           GPSDecoder.h pppInclude.h pppWidgets.h pppModel.h           \
           pppMain.h pppRun.h pppOptions.h pppCrdFile.h pppThread.h    \
+          pppResult.h                                                 \
           RTCM/RTCM2.h RTCM/RTCM2Decoder.h                            \
           RTCM/RTCM2_2021.h RTCM/rtcm_utils.h                         \
           RTCM3/RTCM3Decoder.h RTCM3/bits.h RTCM3/gnss.h              \
           RTCM3/RTCM3coDecoder.h RTCM3/ephEncoder.h                   \
           RTCM3/clock_and_orbit/clock_orbit_rtcm.h                    \
+          RTCM3/ssrSignals.h                                          \
           rinex/rnxobsfile.h                                          \
           rinex/rnxnavfile.h       rinex/corrfile.h                   \
           rinex/reqcedit.h         rinex/reqcanalyze.h                \
@@ -78,25 +83,29 @@ SOURCES = bncgetthread.cpp  bncwindow.cpp bnctabledlg.cpp             \
           bnczerodecoder.cpp bncnetqueryv1.cpp bncnetqueryv2.cpp      \
           bncnetqueryrtp.cpp bncsettings.cpp latencychecker.cpp       \
           bncipport.cpp bncnetqueryv0.cpp bncnetqueryudp.cpp          \
-          bncnetqueryudp0.cpp bncudpport.cpp                          \
+          bncnetqueryudp0.cpp bncudpport.cpp bncudpreceiver.cpp       \
           bncserialport.cpp bncnetquerys.cpp bncfigure.cpp            \
           bncfigurelate.cpp bnctime.cpp                               \
           bncfigureppp.cpp bncrawfile.cpp                             \
           bncmap_svg.cpp bncantex.cpp bncephuser.cpp                  \
           bncoutf.cpp bncclockrinex.cpp bncsp3.cpp bncsinextro.cpp    \
           bncbytescounter.cpp bncsslconfig.cpp reqcdlg.cpp            \
+          bnckalman.cpp bncrawreplay.cpp bncmetrics.cpp               \
+          bncnetreactor.cpp bncconnscheduler.cpp                      \
+          bncadvisedispatcher.cpp bncrawrecorder.cpp                  \
           ephemeris.cpp t_prn.cpp satObs.cpp                          \
           upload/bncrtnetdecoder.cpp upload/bncuploadcaster.cpp       \
           upload/bncrtnetuploadcaster.cpp upload/bnccustomtrafo.cpp   \
           upload/bncephuploadcaster.cpp qtfilechooser.cpp             \
           GPSDecoder.cpp pppWidgets.cpp pppModel.cpp                  \
           pppMain.cpp pppRun.cpp pppOptions.cpp pppCrdFile.cpp        \
-          pppThread.cpp                                               \
+          pppThread.cpp pppResult.cpp                                 \
           RTCM/RTCM2.cpp RTCM/RTCM2Decoder.cpp                        \
           RTCM/RTCM2_2021.cpp RTCM/rtcm_utils.cpp                     \
           RTCM3/RTCM3Decoder.cpp                                      \
           RTCM3/RTCM3coDecoder.cpp RTCM3/ephEncoder.cpp               \
           RTCM3/clock_and_orbit/clock_orbit_rtcm.c                    \
+          RTCM3/ssrSignals.cpp                                        \
           rinex/rnxobsfile.cpp                                        \
           rinex/rnxnavfile.cpp     rinex/corrfile.cpp                 \
           rinex/reqcedit.cpp       rinex/reqcanalyze.cpp              \
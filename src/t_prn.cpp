@@ -33,6 +33,26 @@ int t_prn::toInt() const {
   return 0;
 }
 
+// Dense index 0 .. NUMINDEX-1 (flags included), -1 if out of range
+//////////////////////////////////////////////////////////////////////////////
+int t_prn::toIndex() const {
+  int maxNumber = 0;
+  switch (_system) {
+    case 'G': maxNumber = MAXPRN_GPS;     break;
+    case 'R': maxNumber = MAXPRN_GLONASS; break;
+    case 'E': maxNumber = MAXPRN_GALILEO; break;
+    case 'J': maxNumber = MAXPRN_QZSS;    break;
+    case 'S': maxNumber = MAXPRN_SBAS;    break;
+    case 'C': maxNumber = MAXPRN_BDS;     break;
+    case 'I': maxNumber = MAXPRN_IRNSS;   break;
+    default:  return -1;
+  }
+  if (_number < 1 || _number > maxNumber || _flags < 0 || _flags > 1) {
+    return -1;
+  }
+  return _flags * (MAXPRN + 1) + toInt();
+}
+
 // 
 //////////////////////////////////////////////////////////////////////////////
 string t_prn::toString() const {
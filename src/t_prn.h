@@ -10,10 +10,11 @@ public:
   static const unsigned MAXPRN_GALILEO = 36;
   static const unsigned MAXPRN_QZSS = 10;
   static const unsigned MAXPRN_SBAS = 38;
-  static const unsigned MAXPRN_BDS = 37;
+  static const unsigned MAXPRN_BDS = 63;
   static const unsigned MAXPRN_IRNSS = 7;
   static const unsigned MAXPRN = MAXPRN_GPS + MAXPRN_GLONASS + MAXPRN_GALILEO
       + MAXPRN_QZSS + MAXPRN_SBAS + MAXPRN_BDS + MAXPRN_IRNSS;
+  static const unsigned NUMINDEX = 2 * (MAXPRN + 1); // flags 0 and 1
 
   t_prn() :
       _system('G'), _number(0), _flags(0) {
@@ -57,6 +58,7 @@ public:
     return _flags;
   }
   int toInt() const;
+  int toIndex() const;
   std::string toString() const;
   std::string toInternalString() const;
 
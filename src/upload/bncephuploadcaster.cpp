@@ -36,9 +36,11 @@ bncEphUploadCaster::bncEphUploadCaster() : bncEphUser(true) {
     int     outPort  = settings.value("uploadEphPort").toInt();
     QString password = settings.value("uploadEphPassword").toString();
     int     sampl    = settings.value("uploadEphSample").toInt();
+    bool    paced    = Qt::CheckState(settings.value("uploadEphPaced").toInt()) == Qt::Checked;
 
     _ephUploadCaster = new bncUploadCaster(mountpoint, outHost, outPort,
                                            password, -1, sampl);
+    _ephUploadCaster->setPaced(paced);
 
     connect(_ephUploadCaster, SIGNAL(newBytes(QByteArray,double)),
           this, SIGNAL(newBytes(QByteArray,double)));
@@ -57,56 +59,64 @@ bncEphUploadCaster::~bncEphUploadCaster() {
 
 // List of Stored Ephemeris changed (virtual)
 ////////////////////////////////////////////////////////////////////////////
-void bncEphUploadCaster::ephBufferChanged() {
+void bncEphUploadCaster::ephBufferChanged(const t_eph* newEph) {
   if (_ephUploadCaster) {
-    QByteArray outBuffer;
 
-    QDateTime now = currentDateAndTimeGPS();
-    bncTime currentTime(now.toString(Qt::ISODate).toStdString());
+    // Encode the new ephemeris only
+    // -----------------------------
+    unsigned char Array[80];
+    int    size   = 0;
+    double maxAge = 0.0;
 
-    QListIterator<QString> it(prnList());
-    while (it.hasNext()) {
-      const t_eph* eph = ephLast(it.next());
+    switch (newEph->type()) {
+      case t_eph::GPS: case t_eph::QZSS: case t_eph::IRNSS:
+        size   = t_ephEncoder::RTCM3(*static_cast<const t_ephGPS*>(newEph), Array);
+        maxAge = 4*3600;
+        break;
+      case t_eph::GLONASS:
+        size   = t_ephEncoder::RTCM3(*static_cast<const t_ephGlo*>(newEph), Array);
+        maxAge = 1*3600;
+        break;
+      case t_eph::Galileo:
+        size   = t_ephEncoder::RTCM3(*static_cast<const t_ephGal*>(newEph), Array);
+        maxAge = 4*3600;
+        break;
+      case t_eph::SBAS:
+        size   = t_ephEncoder::RTCM3(*static_cast<const t_ephSBAS*>(newEph), Array);
+        maxAge = 600;
+        break;
+      case t_eph::BDS:
+        size   = t_ephEncoder::RTCM3(*static_cast<const t_ephBDS*>(newEph), Array);
+        maxAge = 6*3600;
+        break;
+      default:
+        break;
+    }
 
-      bncTime toc = eph->TOC();
-      double timeDiff = fabs(toc - currentTime);
+    QString prn(newEph->prn().toInternalString().c_str());
+    if (size > 0) {
+      t_ephFrame& ephFrame = _ephFrames[prn];
+      ephFrame.frame  = QByteArray((char*) Array, size);
+      ephFrame.toc    = newEph->TOC();
+      ephFrame.maxAge = maxAge;
+    }
+    else {
+      _ephFrames.remove(prn);
+    }
 
-      const t_ephGPS*  ephGPS  = dynamic_cast<const t_ephGPS*>(eph);
-      const t_ephGlo*  ephGlo  = dynamic_cast<const t_ephGlo*>(eph);
-      const t_ephGal*  ephGal  = dynamic_cast<const t_ephGal*>(eph);
-      const t_ephSBAS* ephSBAS = dynamic_cast<const t_ephSBAS*>(eph);
-      const t_ephBDS*  ephBDS  = dynamic_cast<const t_ephBDS*>(eph);
+    // Assemble the output buffer from the cached messages
+    // ---------------------------------------------------
+    QDateTime now = currentDateAndTimeGPS();
+    bncTime currentTime(now.toString(Qt::ISODate).toStdString());
 
-      unsigned char Array[80];
-      int size = 0;
+    QByteArray outBuffer;
+    outBuffer.reserve(_ephFrames.size() * sizeof(Array));
 
-      if (ephGPS) {
-        if (timeDiff <= 4*3600) {
-          size = t_ephEncoder::RTCM3(*ephGPS, Array);
-        }
-      }
-      else if (ephGlo) {
-        if (timeDiff <= 1*3600) {
-          size = t_ephEncoder::RTCM3(*ephGlo, Array);
-        }
-      }
-      else if (ephGal) {
-        if (timeDiff <= 4*3600) {
-          size = t_ephEncoder::RTCM3(*ephGal, Array);
-        }
-      }
-      else if (ephSBAS) {
-        if (timeDiff <= 600) {
-          size = t_ephEncoder::RTCM3(*ephSBAS, Array);
-        }
-      }
-      else if (ephBDS) {
-        if (timeDiff <= 6*3600) {
-          size = t_ephEncoder::RTCM3(*ephBDS, Array);
-        }
-      }
-      if (size > 0) {
-        outBuffer += QByteArray((char*) Array, size);
+    QMapIterator<QString, t_ephFrame> it(_ephFrames);
+    while (it.hasNext()) {
+      const t_ephFrame& ephFrame = it.next().value();
+      if (fabs(ephFrame.toc - currentTime) <= ephFrame.maxAge) {
+        outBuffer += ephFrame.frame;
       }
     }
     if (outBuffer.size() > 0) {
@@ -13,9 +13,16 @@ class bncEphUploadCaster : public bncEphUser {
  signals:
   void newBytes(QByteArray staID, double nbyte);
  protected:
-  virtual void ephBufferChanged();
+  virtual void ephBufferChanged(const t_eph* newEph);
  private:
-  bncUploadCaster* _ephUploadCaster;
+  class t_ephFrame {
+   public:
+    QByteArray frame;    // encoded RTCM3 message
+    bncTime    toc;
+    double     maxAge;   // seconds
+  };
+  bncUploadCaster*          _ephUploadCaster;
+  QMap<QString, t_ephFrame> _ephFrames;
 };
 
 #endif
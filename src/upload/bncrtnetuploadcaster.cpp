@@ -21,6 +21,7 @@
 #include "bncclockrinex.h"
 #include "bncsp3.h"
 #include "gnss.h"
+#include "ssrSignals.h"
 
 using namespace std;
 
@@ -101,6 +102,13 @@ bncRtnetUploadCaster::bncRtnetUploadCaster(const QString& mountpoint,
 
   // Set Transformation Parameters
   // -----------------------------
+  _dx  = _dy  = _dz  = 0.0;
+  _dxr = _dyr = _dzr = 0.0;
+  _ox  = _oy  = _oz  = 0.0;
+  _oxr = _oyr = _ozr = 0.0;
+  _sc  = _scr = _t0  = 0.0;
+  _meanSta[0] = _meanSta[1] = _meanSta[2] = 0.0; // approximate center of area
+  _doTrafo = (_crdTrafo != "IGS14");
   // Transformation Parameters from ITRF2014 to ETRF2000
   if (_crdTrafo == "ETRF2000") {
     _dx  =  0.0537;
@@ -118,6 +126,9 @@ bncRtnetUploadCaster::bncRtnetUploadCaster(const QString& mountpoint,
     _sc  =  1.02;
     _scr =  0.11;
     _t0  =  2000.0;
+    _meanSta[0] = 3661090.0;
+    _meanSta[1] =  845230.0;
+    _meanSta[2] = 5136850.0;
   }
   // Transformation Parameters from ITRF2014 to GDA2020 (Ryan Ruddick, GA)
   else if (_crdTrafo == "GDA2020") {
@@ -136,6 +147,9 @@ bncRtnetUploadCaster::bncRtnetUploadCaster(const QString& mountpoint,
     _sc  = 0.0;
     _scr = 0.0;
     _t0  = 2020.0;
+    _meanSta[0] = -4052050.0;
+    _meanSta[1] =  4212840.0;
+    _meanSta[2] = -2545110.0;
   }
   // Transformation Parameters from IGb14 to SIRGAS2000 (Sonia Costa, BRA)
   else if (_crdTrafo == "SIRGAS2000") {
@@ -154,6 +168,9 @@ bncRtnetUploadCaster::bncRtnetUploadCaster(const QString& mountpoint,
     _sc  = -1.000;
     _scr =  0.000;
     _t0  =  2000.4;
+    _meanSta[0] =  3740860.0;
+    _meanSta[1] = -4964290.0;
+    _meanSta[2] = -1425420.0;
   }
   // Transformation Parameters from ITRF2014 to DREF91
   else if (_crdTrafo == "DREF91") {
@@ -172,6 +189,9 @@ bncRtnetUploadCaster::bncRtnetUploadCaster(const QString& mountpoint,
     _sc  =  1.02;
     _scr =  0.11;
     _t0  =  2000.0;
+    _meanSta[0] = 3959579.0;
+    _meanSta[1] =  721719.0;
+    _meanSta[2] = 4931539.0;
   }
   else if (_crdTrafo == "Custom") {
     _dx = settings.value("trafo_dx").toDouble();
@@ -190,6 +210,8 @@ bncRtnetUploadCaster::bncRtnetUploadCaster(const QString& mountpoint,
     _scr = settings.value("trafo_scr").toDouble();
     _t0 = settings.value("trafo_t0").toDouble();
   }
+
+  _epoSats = new t_epoSats;
 }
 
 // Destructor
@@ -202,6 +224,7 @@ bncRtnetUploadCaster::~bncRtnetUploadCaster() {
   delete _sp3;
   delete _ephUser;
   delete _usedEph;
+  delete _epoSats;
 }
 
 //
@@ -327,6 +350,8 @@ void bncRtnetUploadCaster::decodeRtnetStream(char* buffer, int bufLen) {
   bias.UpdateInterval = clkUpdInd;
   phasebias.UpdateInterval = clkUpdInd;
 
+  _epoSats->_num = 0;
+
   for (int ii = 1; ii < lines.size(); ii++) {
     QString key;  // prn or key VTEC, IND (phase bias indicators)
     double rtnUra = 0.0;    // [m]
@@ -380,8 +405,8 @@ void bncRtnetUploadCaster::decodeRtnetStream(char* buffer, int bufLen) {
     QString prnInternalStr = QString::fromStdString(prn.toInternalString());
     QString prnStr = QString::fromStdString(prn.toString());
 
-    const t_eph* ephLast = _ephUser->ephLast(prnInternalStr);
-    const t_eph* ephPrev = _ephUser->ephPrev(prnInternalStr);
+    const t_eph* ephLast = _ephUser->ephLast(prn);
+    const t_eph* ephPrev = _ephUser->ephPrev(prn);
     const t_eph* eph = ephLast;
 
     if (eph) {
@@ -538,14 +563,8 @@ void bncRtnetUploadCaster::decodeRtnetStream(char* buffer, int bufLen) {
         ++co.NumberOfSat[CLOCKORBIT_SATBDS];
       }
       if (sd) {
-        QString outLine;
-        t_irc irc = processSatellite(eph, epoTime.gpsw(), epoTime.gpssec(), prnStr, rtnAPC,
-                                     rtnUra, rtnClk, rtnVel, rtnCoM, rtnClkSig, sd, outLine);
-        if (irc != success) {
-          // very few cases: check states bad and unhealthy are excluded earlier
-          sd->ID = prnStr.mid(1).toInt(); // to prevent G00, R00 entries
-          sd->IOD = eph->IOD();
-        }
+        _epoSats->append(eph, prnStr, sd, rtnUra, _CoM ? rtnCoM : rtnAPC,
+                         rtnVel, rtnCoM, rtnClk, rtnClkSig);
       }
 
       // Code Biases
@@ -588,681 +607,19 @@ void bncRtnetUploadCaster::decodeRtnetStream(char* buffer, int bufLen) {
       if (biasSat) {
         biasSat->ID = prn.number();
         biasSat->NumberOfCodeBiases = 0;
-        if (prn.system() == 'G') {
-          QMapIterator<QString, double> it(codeBiases);
-          while (it.hasNext()) {
-            it.next();
-            if (it.key() == "1C") {
-              int ii = biasSat->NumberOfCodeBiases;
-              if (ii >= CLOCKORBIT_NUMBIAS)
-                break;
-              biasSat->NumberOfCodeBiases += 1;
-              biasSat->Biases[ii].Type = CODETYPEGPS_L1_CA;
-              biasSat->Biases[ii].Bias = it.value();
-            }
-            else if (it.key() == "1S") {
-              int ii = biasSat->NumberOfCodeBiases;
-              if (ii >= CLOCKORBIT_NUMBIAS)
-                break;
-              biasSat->NumberOfCodeBiases += 1;
-              biasSat->Biases[ii].Type = CODETYPEGPS_L1C_D;
-              biasSat->Biases[ii].Bias = it.value();
-            }
-            else if (it.key() == "1L") {
-              int ii = biasSat->NumberOfCodeBiases;
-              if (ii >= CLOCKORBIT_NUMBIAS)
-                break;
-              biasSat->NumberOfCodeBiases += 1;
-              biasSat->Biases[ii].Type = CODETYPEGPS_L1C_P;
-              biasSat->Biases[ii].Bias = it.value();
-            }
-            else if (it.key() == "1X") {
-              int ii = biasSat->NumberOfCodeBiases;
-              if (ii >= CLOCKORBIT_NUMBIAS)
-                break;
-              biasSat->NumberOfCodeBiases += 1;
-              biasSat->Biases[ii].Type = CODETYPEGPS_L1C_DP;
-              biasSat->Biases[ii].Bias = it.value();
-            }
-            else if (it.key() == "1P") {
-              int ii = biasSat->NumberOfCodeBiases;
-              if (ii >= CLOCKORBIT_NUMBIAS)
-                break;
-              biasSat->NumberOfCodeBiases += 1;
-              biasSat->Biases[ii].Type = CODETYPEGPS_L1_P;
-              biasSat->Biases[ii].Bias = it.value();
-            }
-            else if (it.key() == "1W") {
-              int ii = biasSat->NumberOfCodeBiases;
-              if (ii >= CLOCKORBIT_NUMBIAS)
-                break;
-              biasSat->NumberOfCodeBiases += 1;
-              biasSat->Biases[ii].Type = CODETYPEGPS_L1_Z;
-              biasSat->Biases[ii].Bias = it.value();
-            }
-            else if (it.key() == "2C") {
-              int ii = biasSat->NumberOfCodeBiases;
-              if (ii >= CLOCKORBIT_NUMBIAS)
-                break;
-              biasSat->NumberOfCodeBiases += 1;
-              biasSat->Biases[ii].Type = CODETYPEGPS_L2_CA;
-              biasSat->Biases[ii].Bias = it.value();
-            }
-            else if (it.key() == "2D") {
-              int ii = biasSat->NumberOfCodeBiases;
-              if (ii >= CLOCKORBIT_NUMBIAS)
-                break;
-              biasSat->NumberOfCodeBiases += 1;
-              biasSat->Biases[ii].Type = CODETYPEGPS_SEMI_CODELESS;
-              biasSat->Biases[ii].Bias = it.value();
-            }
-            else if (it.key() == "2S") {
-              int ii = biasSat->NumberOfCodeBiases;
-              if (ii >= CLOCKORBIT_NUMBIAS)
-                break;
-              biasSat->NumberOfCodeBiases += 1;
-              biasSat->Biases[ii].Type = CODETYPEGPS_L2C_M;
-              biasSat->Biases[ii].Bias = it.value();
-            }
-            else if (it.key() == "2L") {
-              int ii = biasSat->NumberOfCodeBiases;
-              if (ii >= CLOCKORBIT_NUMBIAS)
-                break;
-              biasSat->NumberOfCodeBiases += 1;
-              biasSat->Biases[ii].Type = CODETYPEGPS_L2C_L;
-              biasSat->Biases[ii].Bias = it.value();
-            }
-            else if (it.key() == "2X") {
-              int ii = biasSat->NumberOfCodeBiases;
-              if (ii >= CLOCKORBIT_NUMBIAS)
-                break;
-              biasSat->NumberOfCodeBiases += 1;
-              biasSat->Biases[ii].Type = CODETYPEGPS_L2C_ML;
-              biasSat->Biases[ii].Bias = it.value();
-            }
-            else if (it.key() == "2P") {
-              int ii = biasSat->NumberOfCodeBiases;
-              if (ii >= CLOCKORBIT_NUMBIAS)
-                break;
-              biasSat->NumberOfCodeBiases += 1;
-              biasSat->Biases[ii].Type = CODETYPEGPS_L2_P;
-              biasSat->Biases[ii].Bias = it.value();
-            }
-            else if (it.key() == "2W") {
-              int ii = biasSat->NumberOfCodeBiases;
-              if (ii >= CLOCKORBIT_NUMBIAS)
-                break;
-              biasSat->NumberOfCodeBiases += 1;
-              biasSat->Biases[ii].Type = CODETYPEGPS_L2_Z;
-              biasSat->Biases[ii].Bias = it.value();
-            }
-            else if (it.key() == "5I") {
-              int ii = biasSat->NumberOfCodeBiases;
-              if (ii >= CLOCKORBIT_NUMBIAS)
-                break;
-              biasSat->NumberOfCodeBiases += 1;
-              biasSat->Biases[ii].Type = CODETYPEGPS_L5_I;
-              biasSat->Biases[ii].Bias = it.value();
-            }
-            else if (it.key() == "5Q") {
-              int ii = biasSat->NumberOfCodeBiases;
-              if (ii >= CLOCKORBIT_NUMBIAS)
-                break;
-              biasSat->NumberOfCodeBiases += 1;
-              biasSat->Biases[ii].Type = CODETYPEGPS_L5_Q;
-              biasSat->Biases[ii].Bias = it.value();
-            }
-            else if (it.key() == "5X") {
-              int ii = biasSat->NumberOfCodeBiases;
-              if (ii >= CLOCKORBIT_NUMBIAS)
-                break;
-              biasSat->NumberOfCodeBiases += 1;
-              biasSat->Biases[ii].Type = CODETYPEGPS_L5_IQ;
-              biasSat->Biases[ii].Bias = it.value();
-            }
-          }
-        }
-        else if (prn.system() == 'R') {
-          QMapIterator<QString, double> it(codeBiases);
-          while (it.hasNext()) {
-            it.next();
-            if (it.key() == "1C") {
-              int ii = biasSat->NumberOfCodeBiases;
-              if (ii >= CLOCKORBIT_NUMBIAS)
-                break;
-              biasSat->NumberOfCodeBiases += 1;
-              biasSat->Biases[ii].Type = CODETYPEGLONASS_L1_CA;
-              biasSat->Biases[ii].Bias = it.value();
-            }
-            else if (it.key() == "1P") {
-              int ii = biasSat->NumberOfCodeBiases;
-              if (ii >= CLOCKORBIT_NUMBIAS)
-                break;
-              biasSat->NumberOfCodeBiases += 1;
-              biasSat->Biases[ii].Type = CODETYPEGLONASS_L1_P;
-              biasSat->Biases[ii].Bias = it.value();
-            }
-            else if (it.key() == "2C") {
-              int ii = biasSat->NumberOfCodeBiases;
-              if (ii >= CLOCKORBIT_NUMBIAS)
-                break;
-              biasSat->NumberOfCodeBiases += 1;
-              biasSat->Biases[ii].Type = CODETYPEGLONASS_L2_CA;
-              biasSat->Biases[ii].Bias = it.value();
-            }
-            else if (it.key() == "2P") {
-              int ii = biasSat->NumberOfCodeBiases;
-              if (ii >= CLOCKORBIT_NUMBIAS)
-                break;
-              biasSat->NumberOfCodeBiases += 1;
-              biasSat->Biases[ii].Type = CODETYPEGLONASS_L2_P;
-              biasSat->Biases[ii].Bias = it.value();
-            }
-            else if (it.key() == "4A") {
-              int ii = biasSat->NumberOfCodeBiases;
-              if (ii >= CLOCKORBIT_NUMBIAS)
-                break;
-              biasSat->NumberOfCodeBiases += 1;
-              biasSat->Biases[ii].Type = CODETYPEGLONASS_L1a_OCd;
-              biasSat->Biases[ii].Bias = it.value();
-            }
-            else if (it.key() == "4B") {
-              int ii = biasSat->NumberOfCodeBiases;
-              if (ii >= CLOCKORBIT_NUMBIAS)
-                break;
-              biasSat->NumberOfCodeBiases += 1;
-              biasSat->Biases[ii].Type = CODETYPEGLONASS_L1a_OCp;
-              biasSat->Biases[ii].Bias = it.value();
-            }
-            else if (it.key() == "4X") {
-              int ii = biasSat->NumberOfCodeBiases;
-              if (ii >= CLOCKORBIT_NUMBIAS)
-                break;
-              biasSat->NumberOfCodeBiases += 1;
-              biasSat->Biases[ii].Type = CODETYPEGLONASS_L1a_OCdp;
-              biasSat->Biases[ii].Bias = it.value();
-            }
-            else if (it.key() == "6A") {
-              int ii = biasSat->NumberOfCodeBiases;
-              if (ii >= CLOCKORBIT_NUMBIAS)
-                break;
-              biasSat->NumberOfCodeBiases += 1;
-              biasSat->Biases[ii].Type = CODETYPEGLONASS_L2a_CSI;
-              biasSat->Biases[ii].Bias = it.value();
-            }
-            else if (it.key() == "6B") {
-              int ii = biasSat->NumberOfCodeBiases;
-              if (ii >= CLOCKORBIT_NUMBIAS)
-                break;
-              biasSat->NumberOfCodeBiases += 1;
-              biasSat->Biases[ii].Type = CODETYPEGLONASS_L2a_OCp;
-              biasSat->Biases[ii].Bias = it.value();
-            }
-            else if (it.key() == "6X") {
-              int ii = biasSat->NumberOfCodeBiases;
-              if (ii >= CLOCKORBIT_NUMBIAS)
-                break;
-              biasSat->NumberOfCodeBiases += 1;
-              biasSat->Biases[ii].Type = CODETYPEGLONASS_L2a_CSIOCp;
-              biasSat->Biases[ii].Bias = it.value();
-            }
-            else if (it.key() == "3I") {
-              int ii = biasSat->NumberOfCodeBiases;
-              if (ii >= CLOCKORBIT_NUMBIAS)
-                break;
-              biasSat->NumberOfCodeBiases += 1;
-              biasSat->Biases[ii].Type = CODETYPEGLONASS_L3_I;
-              biasSat->Biases[ii].Bias = it.value();
-            }
-            else if (it.key() == "3Q") {
-              int ii = biasSat->NumberOfCodeBiases;
-              if (ii >= CLOCKORBIT_NUMBIAS)
-                break;
-              biasSat->NumberOfCodeBiases += 1;
-              biasSat->Biases[ii].Type = CODETYPEGLONASS_L3_Q;
-              biasSat->Biases[ii].Bias = it.value();
-            }
-            else if (it.key() == "3X") {
-              int ii = biasSat->NumberOfCodeBiases;
-              if (ii >= CLOCKORBIT_NUMBIAS)
-                break;
-              biasSat->NumberOfCodeBiases += 1;
-              biasSat->Biases[ii].Type = CODETYPEGLONASS_L3_IQ;
-              biasSat->Biases[ii].Bias = it.value();
-            }
-          }
-        }
-        else if (prn.system() == 'E') {
-          QMapIterator<QString, double> it(codeBiases);
-          while (it.hasNext()) {
-            it.next();
-            if (it.key() == "1A") {
-              int ii = biasSat->NumberOfCodeBiases;
-              if (ii >= CLOCKORBIT_NUMBIAS)
-                break;
-              biasSat->NumberOfCodeBiases += 1;
-              biasSat->Biases[ii].Type = CODETYPEGALILEO_E1_A;
-              biasSat->Biases[ii].Bias = it.value();
-            }
-            else if (it.key() == "1B") {
-              int ii = biasSat->NumberOfCodeBiases;
-              if (ii >= CLOCKORBIT_NUMBIAS)
-                break;
-              biasSat->NumberOfCodeBiases += 1;
-              biasSat->Biases[ii].Type = CODETYPEGALILEO_E1_B;
-              biasSat->Biases[ii].Bias = it.value();
-            }
-            else if (it.key() == "1C") {
-              int ii = biasSat->NumberOfCodeBiases;
-              if (ii >= CLOCKORBIT_NUMBIAS)
-                break;
-              biasSat->NumberOfCodeBiases += 1;
-              biasSat->Biases[ii].Type = CODETYPEGALILEO_E1_C;
-              biasSat->Biases[ii].Bias = it.value();
-            }
-            else if (it.key() == "1X") {
-              int ii = biasSat->NumberOfCodeBiases;
-              if (ii >= CLOCKORBIT_NUMBIAS)
-                break;
-              biasSat->NumberOfCodeBiases += 1;
-              biasSat->Biases[ii].Type = CODETYPEGALILEO_E1_BC;
-              biasSat->Biases[ii].Bias = it.value();
-            }
-            else if (it.key() == "1Z") {
-              int ii = biasSat->NumberOfCodeBiases;
-              if (ii >= CLOCKORBIT_NUMBIAS)
-                break;
-              biasSat->NumberOfCodeBiases += 1;
-              biasSat->Biases[ii].Type = CODETYPEGALILEO_E1_ABC;
-              biasSat->Biases[ii].Bias = it.value();
-            }
-            else if (it.key() == "5I") {
-              int ii = biasSat->NumberOfCodeBiases;
-              if (ii >= CLOCKORBIT_NUMBIAS)
-                break;
-              biasSat->NumberOfCodeBiases += 1;
-              biasSat->Biases[ii].Type = CODETYPEGALILEO_E5A_I;
-              biasSat->Biases[ii].Bias = it.value();
-            }
-            else if (it.key() == "5Q") {
-              int ii = biasSat->NumberOfCodeBiases;
-              if (ii >= CLOCKORBIT_NUMBIAS)
-                break;
-              biasSat->NumberOfCodeBiases += 1;
-              biasSat->Biases[ii].Type = CODETYPEGALILEO_E5A_Q;
-              biasSat->Biases[ii].Bias = it.value();
-            }
-            else if (it.key() == "5X") {
-              int ii = biasSat->NumberOfCodeBiases;
-              if (ii >= CLOCKORBIT_NUMBIAS)
-                break;
-              biasSat->NumberOfCodeBiases += 1;
-              biasSat->Biases[ii].Type = CODETYPEGALILEO_E5A_IQ;
-              biasSat->Biases[ii].Bias = it.value();
-            }
-            else if (it.key() == "7I") {
-              int ii = biasSat->NumberOfCodeBiases;
-              if (ii >= CLOCKORBIT_NUMBIAS)
-                break;
-              biasSat->NumberOfCodeBiases += 1;
-              biasSat->Biases[ii].Type = CODETYPEGALILEO_E5B_I;
-              biasSat->Biases[ii].Bias = it.value();
-            }
-            else if (it.key() == "7Q") {
-              int ii = biasSat->NumberOfCodeBiases;
-              if (ii >= CLOCKORBIT_NUMBIAS)
-                break;
-              biasSat->NumberOfCodeBiases += 1;
-              biasSat->Biases[ii].Type = CODETYPEGALILEO_E5B_Q;
-              biasSat->Biases[ii].Bias = it.value();
-            }
-            else if (it.key() == "7X") {
-              int ii = biasSat->NumberOfCodeBiases;
-              if (ii >= CLOCKORBIT_NUMBIAS)
-                break;
-              biasSat->NumberOfCodeBiases += 1;
-              biasSat->Biases[ii].Type = CODETYPEGALILEO_E5B_IQ;
-              biasSat->Biases[ii].Bias = it.value();
-            }
-            else if (it.key() == "8I") {
-              int ii = biasSat->NumberOfCodeBiases;
-              if (ii >= CLOCKORBIT_NUMBIAS)
-                break;
-              biasSat->NumberOfCodeBiases += 1;
-              biasSat->Biases[ii].Type = CODETYPEGALILEO_E5_I;
-              biasSat->Biases[ii].Bias = it.value();
-            }
-            else if (it.key() == "8Q") {
-              int ii = biasSat->NumberOfCodeBiases;
-              if (ii >= CLOCKORBIT_NUMBIAS)
-                break;
-              biasSat->NumberOfCodeBiases += 1;
-              biasSat->Biases[ii].Type = CODETYPEGALILEO_E5_Q;
-              biasSat->Biases[ii].Bias = it.value();
-            }
-            else if (it.key() == "8X") {
-              int ii = biasSat->NumberOfCodeBiases;
-              if (ii >= CLOCKORBIT_NUMBIAS)
-                break;
-              biasSat->NumberOfCodeBiases += 1;
-              biasSat->Biases[ii].Type = CODETYPEGALILEO_E5_IQ;
-              biasSat->Biases[ii].Bias = it.value();
-            }
-            else if (it.key() == "6A") {
-              int ii = biasSat->NumberOfCodeBiases;
-              if (ii >= CLOCKORBIT_NUMBIAS)
-                break;
-              biasSat->NumberOfCodeBiases += 1;
-              biasSat->Biases[ii].Type = CODETYPEGALILEO_E6_A;
-              biasSat->Biases[ii].Bias = it.value();
-            }
-            else if (it.key() == "6B") {
-              int ii = biasSat->NumberOfCodeBiases;
-              if (ii >= CLOCKORBIT_NUMBIAS)
-                break;
-              biasSat->NumberOfCodeBiases += 1;
-              biasSat->Biases[ii].Type = CODETYPEGALILEO_E6_B;
-              biasSat->Biases[ii].Bias = it.value();
-            }
-            else if (it.key() == "6C") {
-              int ii = biasSat->NumberOfCodeBiases;
-              if (ii >= CLOCKORBIT_NUMBIAS)
-                break;
-              biasSat->NumberOfCodeBiases += 1;
-              biasSat->Biases[ii].Type = CODETYPEGALILEO_E6_C;
-              biasSat->Biases[ii].Bias = it.value();
-            }
-            else if (it.key() == "6X") {
-              int ii = biasSat->NumberOfCodeBiases;
-              if (ii >= CLOCKORBIT_NUMBIAS)
-                break;
-              biasSat->NumberOfCodeBiases += 1;
-              biasSat->Biases[ii].Type = CODETYPEGALILEO_E6_BC;
-              biasSat->Biases[ii].Bias = it.value();
-            }
-            else if (it.key() == "6Z") {
-              int ii = biasSat->NumberOfCodeBiases;
-              if (ii >= CLOCKORBIT_NUMBIAS)
-                break;
-              biasSat->NumberOfCodeBiases += 1;
-              biasSat->Biases[ii].Type = CODETYPEGALILEO_E6_ABC;
-              biasSat->Biases[ii].Bias = it.value();
-            }
-          }
-        }
-        else if (prn.system() == 'J') {
-          QMapIterator<QString, double> it(codeBiases);
-          while (it.hasNext()) {
-            it.next();
-            if (it.key() == "1C") {
-              int ii = biasSat->NumberOfCodeBiases;
-              if (ii >= CLOCKORBIT_NUMBIAS)
-                break;
-              biasSat->NumberOfCodeBiases += 1;
-              biasSat->Biases[ii].Type = CODETYPEQZSS_L1_CA;
-              biasSat->Biases[ii].Bias = it.value();
-            }
-            else if (it.key() == "1S") {
-              int ii = biasSat->NumberOfCodeBiases;
-              if (ii >= CLOCKORBIT_NUMBIAS)
-                break;
-              biasSat->NumberOfCodeBiases += 1;
-              biasSat->Biases[ii].Type = CODETYPEQZSS_L1C_D;
-              biasSat->Biases[ii].Bias = it.value();
-            }
-            else if (it.key() == "1L") {
-              int ii = biasSat->NumberOfCodeBiases;
-              if (ii >= CLOCKORBIT_NUMBIAS)
-                break;
-              biasSat->NumberOfCodeBiases += 1;
-              biasSat->Biases[ii].Type = CODETYPEQZSS_L1C_P;
-              biasSat->Biases[ii].Bias = it.value();
-            }
-            else if (it.key() == "2S") {
-              int ii = biasSat->NumberOfCodeBiases;
-              if (ii >= CLOCKORBIT_NUMBIAS)
-                break;
-              biasSat->NumberOfCodeBiases += 1;
-              biasSat->Biases[ii].Type = CODETYPEQZSS_L2C_M;
-              biasSat->Biases[ii].Bias = it.value();
-            }
-            else if (it.key() == "2L") {
-              int ii = biasSat->NumberOfCodeBiases;
-              if (ii >= CLOCKORBIT_NUMBIAS)
-                break;
-              biasSat->NumberOfCodeBiases += 1;
-              biasSat->Biases[ii].Type = CODETYPEQZSS_L2C_L;
-              biasSat->Biases[ii].Bias = it.value();
-            }
-            else if (it.key() == "2X") {
-              int ii = biasSat->NumberOfCodeBiases;
-              if (ii >= CLOCKORBIT_NUMBIAS)
-                break;
-              biasSat->NumberOfCodeBiases += 1;
-              biasSat->Biases[ii].Type = CODETYPEQZSS_L2C_ML;
-              biasSat->Biases[ii].Bias = it.value();
-            }
-            else if (it.key() == "5I") {
-              int ii = biasSat->NumberOfCodeBiases;
-              if (ii >= CLOCKORBIT_NUMBIAS)
-                break;
-              biasSat->NumberOfCodeBiases += 1;
-              biasSat->Biases[ii].Type = CODETYPEQZSS_L5_I;
-              biasSat->Biases[ii].Bias = it.value();
-            }
-            else if (it.key() == "5Q") {
-              int ii = biasSat->NumberOfCodeBiases;
-              if (ii >= CLOCKORBIT_NUMBIAS)
-                break;
-              biasSat->NumberOfCodeBiases += 1;
-              biasSat->Biases[ii].Type = CODETYPEQZSS_L5_Q;
-              biasSat->Biases[ii].Bias = it.value();
-            }
-            else if (it.key() == "5X") {
-              int ii = biasSat->NumberOfCodeBiases;
-              if (ii >= CLOCKORBIT_NUMBIAS)
-                break;
-              biasSat->NumberOfCodeBiases += 1;
-              biasSat->Biases[ii].Type = CODETYPEQZSS_L5_IQ;
-              biasSat->Biases[ii].Bias = it.value();
-            }
-            else if (it.key() == "6S") {
-              int ii = biasSat->NumberOfCodeBiases;
-              if (ii >= CLOCKORBIT_NUMBIAS)
-                break;
-              biasSat->NumberOfCodeBiases += 1;
-              biasSat->Biases[ii].Type = CODETYPEQZSS_L6_D;
-              biasSat->Biases[ii].Bias = it.value();
-            }
-            else if (it.key() == "6L") {
-              int ii = biasSat->NumberOfCodeBiases;
-              if (ii >= CLOCKORBIT_NUMBIAS)
-                break;
-              biasSat->NumberOfCodeBiases += 1;
-              biasSat->Biases[ii].Type = CODETYPEQZSS_L6_P;
-              biasSat->Biases[ii].Bias = it.value();
-            }
-            else if (it.key() == "6X") {
-              int ii = biasSat->NumberOfCodeBiases;
-              if (ii >= CLOCKORBIT_NUMBIAS)
-                break;
-              biasSat->NumberOfCodeBiases += 1;
-              biasSat->Biases[ii].Type = CODETYPEQZSS_L6_DP;
-              biasSat->Biases[ii].Bias = it.value();
-            }
-            else if (it.key() == "1X") {
-              int ii = biasSat->NumberOfCodeBiases;
-              if (ii >= CLOCKORBIT_NUMBIAS)
-                break;
-              biasSat->NumberOfCodeBiases += 1;
-              biasSat->Biases[ii].Type = CODETYPEQZSS_L1C_DP;
-              biasSat->Biases[ii].Bias = it.value();
-            }
-            else if (it.key() == "1Z") {
-              int ii = biasSat->NumberOfCodeBiases;
-              if (ii >= CLOCKORBIT_NUMBIAS)
-                break;
-              biasSat->NumberOfCodeBiases += 1;
-              biasSat->Biases[ii].Type = CODETYPEQZSS_L1_S;
-              biasSat->Biases[ii].Bias = it.value();
-            }
-            else if (it.key() == "5D") {
-              int ii = biasSat->NumberOfCodeBiases;
-              if (ii >= CLOCKORBIT_NUMBIAS)
-                break;
-              biasSat->NumberOfCodeBiases += 1;
-              biasSat->Biases[ii].Type = CODETYPEQZSS_L5_D;
-              biasSat->Biases[ii].Bias = it.value();
-            }
-            else if (it.key() == "5P") {
-              int ii = biasSat->NumberOfCodeBiases;
-              if (ii >= CLOCKORBIT_NUMBIAS)
-                break;
-              biasSat->NumberOfCodeBiases += 1;
-              biasSat->Biases[ii].Type = CODETYPEQZSS_L5_P;
-              biasSat->Biases[ii].Bias = it.value();
-            }
-            else if (it.key() == "5Z") {
-              int ii = biasSat->NumberOfCodeBiases;
-              if (ii >= CLOCKORBIT_NUMBIAS)
-                break;
-              biasSat->NumberOfCodeBiases += 1;
-              biasSat->Biases[ii].Type = CODETYPEQZSS_L5_DP;
-              biasSat->Biases[ii].Bias = it.value();
-            }
-            else if (it.key() == "6E") {
-              int ii = biasSat->NumberOfCodeBiases;
-              if (ii >= CLOCKORBIT_NUMBIAS)
-                break;
-              biasSat->NumberOfCodeBiases += 1;
-              biasSat->Biases[ii].Type = CODETYPEQZSS_L6_E;
-              biasSat->Biases[ii].Bias = it.value();
-            }
-            else if (it.key() == "6Z") {
-              int ii = biasSat->NumberOfCodeBiases;
-              if (ii >= CLOCKORBIT_NUMBIAS)
-                break;
-              biasSat->NumberOfCodeBiases += 1;
-              biasSat->Biases[ii].Type = CODETYPEQZSS_L6_DE;
-              biasSat->Biases[ii].Bias = it.value();
-            }
-           }
-        }
-        else if (prn.system() == 'S') {
-          QMapIterator<QString, double> it(codeBiases);
-          while (it.hasNext()) {
-            it.next();
-            if (it.key() == "1C") {
-              int ii = biasSat->NumberOfCodeBiases;
-              if (ii >= CLOCKORBIT_NUMBIAS)
-                break;
-              biasSat->NumberOfCodeBiases += 1;
-              biasSat->Biases[ii].Type = CODETYPE_SBAS_L1_CA;
-              biasSat->Biases[ii].Bias = it.value();
-            }
-            else if (it.key() == "5I") {
-              int ii = biasSat->NumberOfCodeBiases;
-              if (ii >= CLOCKORBIT_NUMBIAS)
-                break;
-              biasSat->NumberOfCodeBiases += 1;
-              biasSat->Biases[ii].Type = CODETYPE_SBAS_L5_I;
-              biasSat->Biases[ii].Bias = it.value();
-            }
-            else if (it.key() == "5Q") {
-              int ii = biasSat->NumberOfCodeBiases;
-              if (ii >= CLOCKORBIT_NUMBIAS)
-                break;
-              biasSat->NumberOfCodeBiases += 1;
-              biasSat->Biases[ii].Type = CODETYPE_SBAS_L5_Q;
-              biasSat->Biases[ii].Bias = it.value();
-            }
-            else if (it.key() == "5X") {
-              int ii = biasSat->NumberOfCodeBiases;
-              if (ii >= CLOCKORBIT_NUMBIAS)
-                break;
-              biasSat->NumberOfCodeBiases += 1;
-              biasSat->Biases[ii].Type = CODETYPE_SBAS_L5_IQ;
-              biasSat->Biases[ii].Bias = it.value();
-            }
-          }
-        }
-        else if (prn.system() == 'C') {
-          QMapIterator<QString, double> it(codeBiases);
-          while (it.hasNext()) {
-            it.next();
-            if (it.key() == "2I") {
-              int ii = biasSat->NumberOfCodeBiases;
-              if (ii >= CLOCKORBIT_NUMBIAS)
-                break;
-              biasSat->NumberOfCodeBiases += 1;
-              biasSat->Biases[ii].Type = CODETYPE_BDS_B1_I;
-              biasSat->Biases[ii].Bias = it.value();
-            }
-            else if (it.key() == "2Q") {
-              int ii = biasSat->NumberOfCodeBiases;
-              if (ii >= CLOCKORBIT_NUMBIAS)
-                break;
-              biasSat->NumberOfCodeBiases += 1;
-              biasSat->Biases[ii].Type = CODETYPE_BDS_B1_Q;
-              biasSat->Biases[ii].Bias = it.value();
-            }
-            else if (it.key() == "2X") {
-              int ii = biasSat->NumberOfCodeBiases;
-              if (ii >= CLOCKORBIT_NUMBIAS)
-                break;
-              biasSat->NumberOfCodeBiases += 1;
-              biasSat->Biases[ii].Type = CODETYPE_BDS_B1_IQ;
-              biasSat->Biases[ii].Bias = it.value();
-            }
-            else if (it.key() == "6I") {
-              int ii = biasSat->NumberOfCodeBiases;
-              if (ii >= CLOCKORBIT_NUMBIAS)
-                break;
-              biasSat->NumberOfCodeBiases += 1;
-              biasSat->Biases[ii].Type = CODETYPE_BDS_B3_I;
-              biasSat->Biases[ii].Bias = it.value();
-            }
-            else if (it.key() == "6Q") {
-              int ii = biasSat->NumberOfCodeBiases;
-              if (ii >= CLOCKORBIT_NUMBIAS)
-                break;
-              biasSat->NumberOfCodeBiases += 1;
-              biasSat->Biases[ii].Type = CODETYPE_BDS_B3_Q;
-              biasSat->Biases[ii].Bias = it.value();
-            }
-            else if (it.key() == "6X") {
-              int ii = biasSat->NumberOfCodeBiases;
-              if (ii >= CLOCKORBIT_NUMBIAS)
-                break;
-              biasSat->NumberOfCodeBiases += 1;
-              biasSat->Biases[ii].Type = CODETYPE_BDS_B3_IQ;
-              biasSat->Biases[ii].Bias = it.value();
-            }
-            else if (it.key() == "7I") {
-              int ii = biasSat->NumberOfCodeBiases;
-              if (ii >= CLOCKORBIT_NUMBIAS)
-                break;
-              biasSat->NumberOfCodeBiases += 1;
-              biasSat->Biases[ii].Type = CODETYPE_BDS_B2_I;
-              biasSat->Biases[ii].Bias = it.value();
-            }
-            else if (it.key() == "7Q") {
-              int ii = biasSat->NumberOfCodeBiases;
-              if (ii >= CLOCKORBIT_NUMBIAS)
-                break;
-              biasSat->NumberOfCodeBiases += 1;
-              biasSat->Biases[ii].Type = CODETYPE_BDS_B2_Q;
-              biasSat->Biases[ii].Bias = it.value();
-            }
-            else if (it.key() == "7X") {
-              int ii = biasSat->NumberOfCodeBiases;
-              if (ii >= CLOCKORBIT_NUMBIAS)
-                break;
-              biasSat->NumberOfCodeBiases += 1;
-              biasSat->Biases[ii].Type = CODETYPE_BDS_B2_IQ;
-              biasSat->Biases[ii].Bias = it.value();
-            }
+        QMapIterator<QString, double> it(codeBiases);
+        while (it.hasNext()) {
+          it.next();
+          CodeType type;
+          if (!t_ssrSignals::codeType(prn.system(), it.key().toAscii().data(), type)) {
+            continue;
           }
+          int ii = biasSat->NumberOfCodeBiases;
+          if (ii >= CLOCKORBIT_NUMBIAS)
+            break;
+          biasSat->NumberOfCodeBiases += 1;
+          biasSat->Biases[ii].Type = type;
+          biasSat->Biases[ii].Bias = it.value();
         }
       }
       // Phase Biases
@@ -1313,937 +670,31 @@ void bncRtnetUploadCaster::decodeRtnetStream(char* buffer, int bufLen) {
         phasebiasSat->NumberOfPhaseBiases = 0;
         phasebiasSat->YawAngle = pbSat.yawAngle;
         phasebiasSat->YawRate = pbSat.yawRate;
-        if (prn.system() == 'G') {
-          QListIterator<phaseBiasSignal> it(phaseBiasList);
-          while (it.hasNext()) {
-            const phaseBiasSignal &pbSig = it.next();
-            if (pbSig.type == "1C") {
-              int ii = phasebiasSat->NumberOfPhaseBiases;
-              if (ii >= CLOCKORBIT_NUMBIAS)
-                break;
-              phasebiasSat->NumberOfPhaseBiases += 1;
-              phasebiasSat->Biases[ii].Type = CODETYPEGPS_L1_CA;
-              phasebiasSat->Biases[ii].Bias = pbSig.bias;
-              phasebiasSat->Biases[ii].SignalIntegerIndicator = pbSig.integerIndicator;
-              phasebiasSat->Biases[ii].SignalsWideLaneIntegerIndicator = pbSig.wlIndicator;
-              phasebiasSat->Biases[ii].SignalDiscontinuityCounter = pbSig.discontinuityCounter;
-            }
-            else if (pbSig.type == "1P") {
-              int ii = phasebiasSat->NumberOfPhaseBiases;
-              if (ii >= CLOCKORBIT_NUMBIAS)
-                break;
-              phasebiasSat->NumberOfPhaseBiases += 1;
-              phasebiasSat->Biases[ii].Type = CODETYPEGPS_L1_P;
-              phasebiasSat->Biases[ii].Bias = pbSig.bias;
-              phasebiasSat->Biases[ii].SignalIntegerIndicator = pbSig.integerIndicator;
-              phasebiasSat->Biases[ii].SignalsWideLaneIntegerIndicator = pbSig.wlIndicator;
-              phasebiasSat->Biases[ii].SignalDiscontinuityCounter = pbSig.discontinuityCounter;
-            }
-            else if (pbSig.type == "1W") {
-              int ii = phasebiasSat->NumberOfPhaseBiases;
-              if (ii >= CLOCKORBIT_NUMBIAS)
-                break;
-              phasebiasSat->NumberOfPhaseBiases += 1;
-              phasebiasSat->Biases[ii].Type = CODETYPEGPS_L1_Z;
-              phasebiasSat->Biases[ii].Bias = pbSig.bias;
-              phasebiasSat->Biases[ii].SignalIntegerIndicator = pbSig.integerIndicator;
-              phasebiasSat->Biases[ii].SignalsWideLaneIntegerIndicator = pbSig.wlIndicator;
-              phasebiasSat->Biases[ii].SignalDiscontinuityCounter = pbSig.discontinuityCounter;
-            }
-            else if (pbSig.type == "2C") {
-              int ii = phasebiasSat->NumberOfPhaseBiases;
-              if (ii >= CLOCKORBIT_NUMBIAS)
-                break;
-              phasebiasSat->NumberOfPhaseBiases += 1;
-              phasebiasSat->Biases[ii].Type = CODETYPEGPS_L2_CA;
-              phasebiasSat->Biases[ii].Bias = pbSig.bias;
-              phasebiasSat->Biases[ii].SignalIntegerIndicator = pbSig.integerIndicator;
-              phasebiasSat->Biases[ii].SignalsWideLaneIntegerIndicator = pbSig.wlIndicator;
-              phasebiasSat->Biases[ii].SignalDiscontinuityCounter = pbSig.discontinuityCounter;
-            }
-            else if (pbSig.type == "2D") {
-              int ii = phasebiasSat->NumberOfPhaseBiases;
-              if (ii >= CLOCKORBIT_NUMBIAS)
-                break;
-              phasebiasSat->NumberOfPhaseBiases += 1;
-              phasebiasSat->Biases[ii].Type = CODETYPEGPS_SEMI_CODELESS;
-              phasebiasSat->Biases[ii].Bias = pbSig.bias;
-              phasebiasSat->Biases[ii].SignalIntegerIndicator = pbSig.integerIndicator;
-              phasebiasSat->Biases[ii].SignalsWideLaneIntegerIndicator = pbSig.wlIndicator;
-              phasebiasSat->Biases[ii].SignalDiscontinuityCounter = pbSig.discontinuityCounter;
-            }
-            else if (pbSig.type == "2S") {
-              int ii = phasebiasSat->NumberOfPhaseBiases;
-              if (ii >= CLOCKORBIT_NUMBIAS)
-                break;
-              phasebiasSat->NumberOfPhaseBiases += 1;
-              phasebiasSat->Biases[ii].Type = CODETYPEGPS_L2C_M;
-              phasebiasSat->Biases[ii].Bias = pbSig.bias;
-              phasebiasSat->Biases[ii].SignalIntegerIndicator = pbSig.integerIndicator;
-              phasebiasSat->Biases[ii].SignalsWideLaneIntegerIndicator = pbSig.wlIndicator;
-              phasebiasSat->Biases[ii].SignalDiscontinuityCounter = pbSig.discontinuityCounter;
-            }
-            else if (pbSig.type == "2L") {
-              int ii = phasebiasSat->NumberOfPhaseBiases;
-              if (ii >= CLOCKORBIT_NUMBIAS)
-                break;
-              phasebiasSat->NumberOfPhaseBiases += 1;
-              phasebiasSat->Biases[ii].Type = CODETYPEGPS_L2C_L;
-              phasebiasSat->Biases[ii].Bias = pbSig.bias;
-              phasebiasSat->Biases[ii].SignalIntegerIndicator = pbSig.integerIndicator;
-              phasebiasSat->Biases[ii].SignalsWideLaneIntegerIndicator = pbSig.wlIndicator;
-              phasebiasSat->Biases[ii].SignalDiscontinuityCounter = pbSig.discontinuityCounter;
-            }
-            else if (pbSig.type == "2X") {
-              int ii = phasebiasSat->NumberOfPhaseBiases;
-              if (ii >= CLOCKORBIT_NUMBIAS)
-                break;
-              phasebiasSat->NumberOfPhaseBiases += 1;
-              phasebiasSat->Biases[ii].Type = CODETYPEGPS_L2C_ML;
-              phasebiasSat->Biases[ii].Bias = pbSig.bias;
-              phasebiasSat->Biases[ii].SignalIntegerIndicator = pbSig.integerIndicator;
-              phasebiasSat->Biases[ii].SignalsWideLaneIntegerIndicator = pbSig.wlIndicator;
-              phasebiasSat->Biases[ii].SignalDiscontinuityCounter = pbSig.discontinuityCounter;
-            }
-            else if (pbSig.type == "2P") {
-              int ii = phasebiasSat->NumberOfPhaseBiases;
-              if (ii >= CLOCKORBIT_NUMBIAS)
-                break;
-              phasebiasSat->NumberOfPhaseBiases += 1;
-              phasebiasSat->Biases[ii].Type = CODETYPEGPS_L2_P;
-              phasebiasSat->Biases[ii].Bias = pbSig.bias;
-              phasebiasSat->Biases[ii].SignalIntegerIndicator = pbSig.integerIndicator;
-              phasebiasSat->Biases[ii].SignalsWideLaneIntegerIndicator = pbSig.wlIndicator;
-              phasebiasSat->Biases[ii].SignalDiscontinuityCounter = pbSig.discontinuityCounter;
-            }
-            else if (pbSig.type == "2W") {
-              int ii = phasebiasSat->NumberOfPhaseBiases;
-              if (ii >= CLOCKORBIT_NUMBIAS)
-                break;
-              phasebiasSat->NumberOfPhaseBiases += 1;
-              phasebiasSat->Biases[ii].Type = CODETYPEGPS_L1_Z;
-              phasebiasSat->Biases[ii].Bias = pbSig.bias;
-              phasebiasSat->Biases[ii].SignalIntegerIndicator = pbSig.integerIndicator;
-              phasebiasSat->Biases[ii].SignalsWideLaneIntegerIndicator = pbSig.wlIndicator;
-              phasebiasSat->Biases[ii].SignalDiscontinuityCounter = pbSig.discontinuityCounter;
-            }
-            else if (pbSig.type == "5I") {
-              int ii = phasebiasSat->NumberOfPhaseBiases;
-              if (ii >= CLOCKORBIT_NUMBIAS)
-                break;
-              phasebiasSat->NumberOfPhaseBiases += 1;
-              phasebiasSat->Biases[ii].Type = CODETYPEGPS_L5_I;
-              phasebiasSat->Biases[ii].Bias = pbSig.bias;
-              phasebiasSat->Biases[ii].SignalIntegerIndicator = pbSig.integerIndicator;
-              phasebiasSat->Biases[ii].SignalsWideLaneIntegerIndicator = pbSig.wlIndicator;
-              phasebiasSat->Biases[ii].SignalDiscontinuityCounter = pbSig.discontinuityCounter;
-            }
-            else if (pbSig.type == "5Q") {
-              int ii = phasebiasSat->NumberOfPhaseBiases;
-              if (ii >= CLOCKORBIT_NUMBIAS)
-                break;
-              phasebiasSat->NumberOfPhaseBiases += 1;
-              phasebiasSat->Biases[ii].Type = CODETYPEGPS_L5_Q;
-              phasebiasSat->Biases[ii].Bias = pbSig.bias;
-              phasebiasSat->Biases[ii].SignalIntegerIndicator = pbSig.integerIndicator;
-              phasebiasSat->Biases[ii].SignalsWideLaneIntegerIndicator = pbSig.wlIndicator;
-              phasebiasSat->Biases[ii].SignalDiscontinuityCounter = pbSig.discontinuityCounter;
-            }
-            else if (pbSig.type == "5X") {
-              int ii = phasebiasSat->NumberOfPhaseBiases;
-              if (ii >= CLOCKORBIT_NUMBIAS)
-                break;
-              phasebiasSat->NumberOfPhaseBiases += 1;
-              phasebiasSat->Biases[ii].Type = CODETYPEGPS_L5_IQ;
-              phasebiasSat->Biases[ii].Bias = pbSig.bias;
-              phasebiasSat->Biases[ii].SignalIntegerIndicator = pbSig.integerIndicator;
-              phasebiasSat->Biases[ii].SignalsWideLaneIntegerIndicator = pbSig.wlIndicator;
-              phasebiasSat->Biases[ii].SignalDiscontinuityCounter = pbSig.discontinuityCounter;
-            }
-            else if (pbSig.type == "1S") {
-              int ii = phasebiasSat->NumberOfPhaseBiases;
-              if (ii >= CLOCKORBIT_NUMBIAS)
-                break;
-              phasebiasSat->NumberOfPhaseBiases += 1;
-              phasebiasSat->Biases[ii].Type = CODETYPEGPS_L1C_D;
-              phasebiasSat->Biases[ii].Bias = pbSig.bias;
-              phasebiasSat->Biases[ii].SignalIntegerIndicator = pbSig.integerIndicator;
-              phasebiasSat->Biases[ii].SignalsWideLaneIntegerIndicator = pbSig.wlIndicator;
-              phasebiasSat->Biases[ii].SignalDiscontinuityCounter = pbSig.discontinuityCounter;
-            }
-            else if (pbSig.type == "1L") {
-              int ii = phasebiasSat->NumberOfPhaseBiases;
-              if (ii >= CLOCKORBIT_NUMBIAS)
-                break;
-              phasebiasSat->NumberOfPhaseBiases += 1;
-              phasebiasSat->Biases[ii].Type = CODETYPEGPS_L1C_P;
-              phasebiasSat->Biases[ii].Bias = pbSig.bias;
-              phasebiasSat->Biases[ii].SignalIntegerIndicator = pbSig.integerIndicator;
-              phasebiasSat->Biases[ii].SignalsWideLaneIntegerIndicator = pbSig.wlIndicator;
-              phasebiasSat->Biases[ii].SignalDiscontinuityCounter = pbSig.discontinuityCounter;
-            }
-            else if (pbSig.type == "1X") {
-              int ii = phasebiasSat->NumberOfPhaseBiases;
-              if (ii >= CLOCKORBIT_NUMBIAS)
-                break;
-              phasebiasSat->NumberOfPhaseBiases += 1;
-              phasebiasSat->Biases[ii].Type = CODETYPEGPS_L1C_DP;
-              phasebiasSat->Biases[ii].Bias = pbSig.bias;
-              phasebiasSat->Biases[ii].SignalIntegerIndicator = pbSig.integerIndicator;
-              phasebiasSat->Biases[ii].SignalsWideLaneIntegerIndicator = pbSig.wlIndicator;
-              phasebiasSat->Biases[ii].SignalDiscontinuityCounter = pbSig.discontinuityCounter;
-            }
-          }
-        }
-        if (prn.system() == 'R') {
-          QListIterator<phaseBiasSignal> it(phaseBiasList);
-          while (it.hasNext()) {
-            const phaseBiasSignal &pbSig = it.next();
-            if (pbSig.type == "1C") {
-              int ii = phasebiasSat->NumberOfPhaseBiases;
-              if (ii >= CLOCKORBIT_NUMBIAS)
-                break;
-              phasebiasSat->NumberOfPhaseBiases += 1;
-              phasebiasSat->Biases[ii].Type = CODETYPEGLONASS_L1_CA;
-              phasebiasSat->Biases[ii].Bias = pbSig.bias;
-              phasebiasSat->Biases[ii].SignalIntegerIndicator = pbSig.integerIndicator;
-              phasebiasSat->Biases[ii].SignalsWideLaneIntegerIndicator =
-                  pbSig.wlIndicator;
-              phasebiasSat->Biases[ii].SignalDiscontinuityCounter =
-                  pbSig.discontinuityCounter;
-            }
-            else if (pbSig.type == "1P") {
-              int ii = phasebiasSat->NumberOfPhaseBiases;
-              if (ii >= CLOCKORBIT_NUMBIAS)
-                break;
-              phasebiasSat->NumberOfPhaseBiases += 1;
-              phasebiasSat->Biases[ii].Type = CODETYPEGLONASS_L1_P;
-              phasebiasSat->Biases[ii].Bias = pbSig.bias;
-              phasebiasSat->Biases[ii].SignalIntegerIndicator = pbSig.integerIndicator;
-              phasebiasSat->Biases[ii].SignalsWideLaneIntegerIndicator =
-                  pbSig.wlIndicator;
-              phasebiasSat->Biases[ii].SignalDiscontinuityCounter =
-                  pbSig.discontinuityCounter;
-            }
-            else if (pbSig.type == "2C") {
-              int ii = phasebiasSat->NumberOfPhaseBiases;
-              if (ii >= CLOCKORBIT_NUMBIAS)
-                break;
-              phasebiasSat->NumberOfPhaseBiases += 1;
-              phasebiasSat->Biases[ii].Type = CODETYPEGLONASS_L2_CA;
-              phasebiasSat->Biases[ii].Bias = pbSig.bias;
-              phasebiasSat->Biases[ii].SignalIntegerIndicator = pbSig.integerIndicator;
-              phasebiasSat->Biases[ii].SignalsWideLaneIntegerIndicator =
-                  pbSig.wlIndicator;
-              phasebiasSat->Biases[ii].SignalDiscontinuityCounter =
-                  pbSig.discontinuityCounter;
-            }
-            else if (pbSig.type == "2P") {
-              int ii = phasebiasSat->NumberOfPhaseBiases;
-              if (ii >= CLOCKORBIT_NUMBIAS)
-                break;
-              phasebiasSat->NumberOfPhaseBiases += 1;
-              phasebiasSat->Biases[ii].Type = CODETYPEGLONASS_L2_P;
-              phasebiasSat->Biases[ii].Bias = pbSig.bias;
-              phasebiasSat->Biases[ii].SignalIntegerIndicator = pbSig.integerIndicator;
-              phasebiasSat->Biases[ii].SignalsWideLaneIntegerIndicator =
-                  pbSig.wlIndicator;
-              phasebiasSat->Biases[ii].SignalDiscontinuityCounter =
-                  pbSig.discontinuityCounter;
-            }
-          }
-        }
-        if (prn.system() == 'E') {
-          QListIterator<phaseBiasSignal> it(phaseBiasList);
-          while (it.hasNext()) {
-            const phaseBiasSignal &pbSig = it.next();
-            if (pbSig.type == "1A") {
-              int ii = phasebiasSat->NumberOfPhaseBiases;
-              if (ii >= CLOCKORBIT_NUMBIAS)
-                break;
-              phasebiasSat->NumberOfPhaseBiases += 1;
-              phasebiasSat->Biases[ii].Type = CODETYPEGALILEO_E1_A;
-              phasebiasSat->Biases[ii].Bias = pbSig.bias;
-              phasebiasSat->Biases[ii].SignalIntegerIndicator = pbSig.integerIndicator;
-              phasebiasSat->Biases[ii].SignalsWideLaneIntegerIndicator =
-                  pbSig.wlIndicator;
-              phasebiasSat->Biases[ii].SignalDiscontinuityCounter =
-                  pbSig.discontinuityCounter;
-            }
-            else if (pbSig.type == "1B") {
-              int ii = phasebiasSat->NumberOfPhaseBiases;
-              if (ii >= CLOCKORBIT_NUMBIAS)
-                break;
-              phasebiasSat->NumberOfPhaseBiases += 1;
-              phasebiasSat->Biases[ii].Type = CODETYPEGALILEO_E1_B;
-              phasebiasSat->Biases[ii].Bias = pbSig.bias;
-              phasebiasSat->Biases[ii].SignalIntegerIndicator = pbSig.integerIndicator;
-              phasebiasSat->Biases[ii].SignalsWideLaneIntegerIndicator =
-                  pbSig.wlIndicator;
-              phasebiasSat->Biases[ii].SignalDiscontinuityCounter =
-                  pbSig.discontinuityCounter;
-            }
-            else if (pbSig.type == "1C") {
-              int ii = phasebiasSat->NumberOfPhaseBiases;
-              if (ii >= CLOCKORBIT_NUMBIAS)
-                break;
-              phasebiasSat->NumberOfPhaseBiases += 1;
-              phasebiasSat->Biases[ii].Type = CODETYPEGALILEO_E1_C;
-              phasebiasSat->Biases[ii].Bias = pbSig.bias;
-              phasebiasSat->Biases[ii].SignalIntegerIndicator = pbSig.integerIndicator;
-              phasebiasSat->Biases[ii].SignalsWideLaneIntegerIndicator =
-                  pbSig.wlIndicator;
-              phasebiasSat->Biases[ii].SignalDiscontinuityCounter =
-                  pbSig.discontinuityCounter;
-            }
-            else if (pbSig.type == "1X") {
-              int ii = phasebiasSat->NumberOfPhaseBiases;
-              if (ii >= CLOCKORBIT_NUMBIAS)
-                break;
-              phasebiasSat->NumberOfPhaseBiases += 1;
-              phasebiasSat->Biases[ii].Type = CODETYPEGALILEO_E1_BC;
-              phasebiasSat->Biases[ii].Bias = pbSig.bias;
-              phasebiasSat->Biases[ii].SignalIntegerIndicator = pbSig.integerIndicator;
-              phasebiasSat->Biases[ii].SignalsWideLaneIntegerIndicator =
-                  pbSig.wlIndicator;
-              phasebiasSat->Biases[ii].SignalDiscontinuityCounter =
-                  pbSig.discontinuityCounter;
-            }
-            else if (pbSig.type == "1Z") {
-              int ii = phasebiasSat->NumberOfPhaseBiases;
-              if (ii >= CLOCKORBIT_NUMBIAS)
-                break;
-              phasebiasSat->NumberOfPhaseBiases += 1;
-              phasebiasSat->Biases[ii].Type = CODETYPEGALILEO_E1_ABC;
-              phasebiasSat->Biases[ii].Bias = pbSig.bias;
-              phasebiasSat->Biases[ii].SignalIntegerIndicator = pbSig.integerIndicator;
-              phasebiasSat->Biases[ii].SignalsWideLaneIntegerIndicator =
-                  pbSig.wlIndicator;
-              phasebiasSat->Biases[ii].SignalDiscontinuityCounter =
-                  pbSig.discontinuityCounter;
-            }
-            else if (pbSig.type == "5I") {
-              int ii = phasebiasSat->NumberOfPhaseBiases;
-              if (ii >= CLOCKORBIT_NUMBIAS)
-                break;
-              phasebiasSat->NumberOfPhaseBiases += 1;
-              phasebiasSat->Biases[ii].Type = CODETYPEGALILEO_E5A_I;
-              phasebiasSat->Biases[ii].Bias = pbSig.bias;
-              phasebiasSat->Biases[ii].SignalIntegerIndicator = pbSig.integerIndicator;
-              phasebiasSat->Biases[ii].SignalsWideLaneIntegerIndicator =
-                  pbSig.wlIndicator;
-              phasebiasSat->Biases[ii].SignalDiscontinuityCounter =
-                  pbSig.discontinuityCounter;
-            }
-            else if (pbSig.type == "5Q") {
-              int ii = phasebiasSat->NumberOfPhaseBiases;
-              if (ii >= CLOCKORBIT_NUMBIAS)
-                break;
-              phasebiasSat->NumberOfPhaseBiases += 1;
-              phasebiasSat->Biases[ii].Type = CODETYPEGALILEO_E5A_Q;
-              phasebiasSat->Biases[ii].Bias = pbSig.bias;
-              phasebiasSat->Biases[ii].SignalIntegerIndicator = pbSig.integerIndicator;
-              phasebiasSat->Biases[ii].SignalsWideLaneIntegerIndicator =
-                  pbSig.wlIndicator;
-              phasebiasSat->Biases[ii].SignalDiscontinuityCounter =
-                  pbSig.discontinuityCounter;
-            }
-            else if (pbSig.type == "5X") {
-              int ii = phasebiasSat->NumberOfPhaseBiases;
-              if (ii >= CLOCKORBIT_NUMBIAS)
-                break;
-              phasebiasSat->NumberOfPhaseBiases += 1;
-              phasebiasSat->Biases[ii].Type = CODETYPEGALILEO_E5A_IQ;
-              phasebiasSat->Biases[ii].Bias = pbSig.bias;
-              phasebiasSat->Biases[ii].SignalIntegerIndicator = pbSig.integerIndicator;
-              phasebiasSat->Biases[ii].SignalsWideLaneIntegerIndicator =
-                  pbSig.wlIndicator;
-              phasebiasSat->Biases[ii].SignalDiscontinuityCounter =
-                  pbSig.discontinuityCounter;
-            }
-            else if (pbSig.type == "7I") {
-              int ii = phasebiasSat->NumberOfPhaseBiases;
-              if (ii >= CLOCKORBIT_NUMBIAS)
-                break;
-              phasebiasSat->NumberOfPhaseBiases += 1;
-              phasebiasSat->Biases[ii].Type = CODETYPEGALILEO_E5B_I;
-              phasebiasSat->Biases[ii].Bias = pbSig.bias;
-              phasebiasSat->Biases[ii].SignalIntegerIndicator = pbSig.integerIndicator;
-              phasebiasSat->Biases[ii].SignalsWideLaneIntegerIndicator =
-                  pbSig.wlIndicator;
-              phasebiasSat->Biases[ii].SignalDiscontinuityCounter =
-                  pbSig.discontinuityCounter;
-            }
-            else if (pbSig.type == "7Q") {
-              int ii = phasebiasSat->NumberOfPhaseBiases;
-              if (ii >= CLOCKORBIT_NUMBIAS)
-                break;
-              phasebiasSat->NumberOfPhaseBiases += 1;
-              phasebiasSat->Biases[ii].Type = CODETYPEGALILEO_E5B_Q;
-              phasebiasSat->Biases[ii].Bias = pbSig.bias;
-              phasebiasSat->Biases[ii].SignalIntegerIndicator = pbSig.integerIndicator;
-              phasebiasSat->Biases[ii].SignalsWideLaneIntegerIndicator =
-                  pbSig.wlIndicator;
-              phasebiasSat->Biases[ii].SignalDiscontinuityCounter =
-                  pbSig.discontinuityCounter;
-            }
-            else if (pbSig.type == "7X") {
-              int ii = phasebiasSat->NumberOfPhaseBiases;
-              if (ii >= CLOCKORBIT_NUMBIAS)
-                break;
-              phasebiasSat->NumberOfPhaseBiases += 1;
-              phasebiasSat->Biases[ii].Type = CODETYPEGALILEO_E5B_IQ;
-              phasebiasSat->Biases[ii].Bias = pbSig.bias;
-              phasebiasSat->Biases[ii].SignalIntegerIndicator = pbSig.integerIndicator;
-              phasebiasSat->Biases[ii].SignalsWideLaneIntegerIndicator =
-                  pbSig.wlIndicator;
-              phasebiasSat->Biases[ii].SignalDiscontinuityCounter =
-                  pbSig.discontinuityCounter;
-            }
-            else if (pbSig.type == "8I") {
-              int ii = phasebiasSat->NumberOfPhaseBiases;
-              if (ii >= CLOCKORBIT_NUMBIAS)
-                break;
-              phasebiasSat->NumberOfPhaseBiases += 1;
-              phasebiasSat->Biases[ii].Type = CODETYPEGALILEO_E5_I;
-              phasebiasSat->Biases[ii].Bias = pbSig.bias;
-              phasebiasSat->Biases[ii].SignalIntegerIndicator = pbSig.integerIndicator;
-              phasebiasSat->Biases[ii].SignalsWideLaneIntegerIndicator =
-                  pbSig.wlIndicator;
-              phasebiasSat->Biases[ii].SignalDiscontinuityCounter =
-                  pbSig.discontinuityCounter;
-            }
-            else if (pbSig.type == "8Q") {
-              int ii = phasebiasSat->NumberOfPhaseBiases;
-              if (ii >= CLOCKORBIT_NUMBIAS)
-                break;
-              phasebiasSat->NumberOfPhaseBiases += 1;
-              phasebiasSat->Biases[ii].Type = CODETYPEGALILEO_E5_Q;
-              phasebiasSat->Biases[ii].Bias = pbSig.bias;
-              phasebiasSat->Biases[ii].SignalIntegerIndicator = pbSig.integerIndicator;
-              phasebiasSat->Biases[ii].SignalsWideLaneIntegerIndicator =
-                  pbSig.wlIndicator;
-              phasebiasSat->Biases[ii].SignalDiscontinuityCounter =
-                  pbSig.discontinuityCounter;
-            }
-            else if (pbSig.type == "8X") {
-              int ii = phasebiasSat->NumberOfPhaseBiases;
-              if (ii >= CLOCKORBIT_NUMBIAS)
-                break;
-              phasebiasSat->NumberOfPhaseBiases += 1;
-              phasebiasSat->Biases[ii].Type = CODETYPEGALILEO_E5_IQ;
-              phasebiasSat->Biases[ii].Bias = pbSig.bias;
-              phasebiasSat->Biases[ii].SignalIntegerIndicator = pbSig.integerIndicator;
-              phasebiasSat->Biases[ii].SignalsWideLaneIntegerIndicator =
-                  pbSig.wlIndicator;
-              phasebiasSat->Biases[ii].SignalDiscontinuityCounter =
-                  pbSig.discontinuityCounter;
-            }
-            else if (pbSig.type == "6A") {
-              int ii = phasebiasSat->NumberOfPhaseBiases;
-              if (ii >= CLOCKORBIT_NUMBIAS)
-                break;
-              phasebiasSat->NumberOfPhaseBiases += 1;
-              phasebiasSat->Biases[ii].Type = CODETYPEGALILEO_E6_A;
-              phasebiasSat->Biases[ii].Bias = pbSig.bias;
-              phasebiasSat->Biases[ii].SignalIntegerIndicator = pbSig.integerIndicator;
-              phasebiasSat->Biases[ii].SignalsWideLaneIntegerIndicator =
-                  pbSig.wlIndicator;
-              phasebiasSat->Biases[ii].SignalDiscontinuityCounter =
-                  pbSig.discontinuityCounter;
-            }
-            else if (pbSig.type == "6B") {
-              int ii = phasebiasSat->NumberOfPhaseBiases;
-              if (ii >= CLOCKORBIT_NUMBIAS)
-                break;
-              phasebiasSat->NumberOfPhaseBiases += 1;
-              phasebiasSat->Biases[ii].Type = CODETYPEGALILEO_E6_B;
-              phasebiasSat->Biases[ii].Bias = pbSig.bias;
-              phasebiasSat->Biases[ii].SignalIntegerIndicator = pbSig.integerIndicator;
-              phasebiasSat->Biases[ii].SignalsWideLaneIntegerIndicator =
-                  pbSig.wlIndicator;
-              phasebiasSat->Biases[ii].SignalDiscontinuityCounter =
-                  pbSig.discontinuityCounter;
-            }
-            else if (pbSig.type == "6C") {
-              int ii = phasebiasSat->NumberOfPhaseBiases;
-              if (ii >= CLOCKORBIT_NUMBIAS)
-                break;
-              phasebiasSat->NumberOfPhaseBiases += 1;
-              phasebiasSat->Biases[ii].Type = CODETYPEGALILEO_E6_C;
-              phasebiasSat->Biases[ii].Bias = pbSig.bias;
-              phasebiasSat->Biases[ii].SignalIntegerIndicator = pbSig.integerIndicator;
-              phasebiasSat->Biases[ii].SignalsWideLaneIntegerIndicator =
-                  pbSig.wlIndicator;
-              phasebiasSat->Biases[ii].SignalDiscontinuityCounter =
-                  pbSig.discontinuityCounter;
-            }
-            else if (pbSig.type == "6X") {
-              int ii = phasebiasSat->NumberOfPhaseBiases;
-              if (ii >= CLOCKORBIT_NUMBIAS)
-                break;
-              phasebiasSat->NumberOfPhaseBiases += 1;
-              phasebiasSat->Biases[ii].Type = CODETYPEGALILEO_E6_BC;
-              phasebiasSat->Biases[ii].Bias = pbSig.bias;
-              phasebiasSat->Biases[ii].SignalIntegerIndicator = pbSig.integerIndicator;
-              phasebiasSat->Biases[ii].SignalsWideLaneIntegerIndicator =
-                  pbSig.wlIndicator;
-              phasebiasSat->Biases[ii].SignalDiscontinuityCounter =
-                  pbSig.discontinuityCounter;
-            }
-            else if (pbSig.type == "6Z") {
-              int ii = phasebiasSat->NumberOfPhaseBiases;
-              if (ii >= CLOCKORBIT_NUMBIAS)
-                break;
-              phasebiasSat->NumberOfPhaseBiases += 1;
-              phasebiasSat->Biases[ii].Type = CODETYPEGALILEO_E6_ABC;
-              phasebiasSat->Biases[ii].Bias = pbSig.bias;
-              phasebiasSat->Biases[ii].SignalIntegerIndicator = pbSig.integerIndicator;
-              phasebiasSat->Biases[ii].SignalsWideLaneIntegerIndicator =
-                  pbSig.wlIndicator;
-              phasebiasSat->Biases[ii].SignalDiscontinuityCounter =
-                  pbSig.discontinuityCounter;
-            }
-          }
-        }
-        if (prn.system() == 'J') {
-          QListIterator<phaseBiasSignal> it(phaseBiasList);
-          while (it.hasNext()) {
-            const phaseBiasSignal &pbSig = it.next();
-            if (pbSig.type == "1C") {
-              int ii = phasebiasSat->NumberOfPhaseBiases;
-              if (ii >= CLOCKORBIT_NUMBIAS)
-                break;
-              phasebiasSat->NumberOfPhaseBiases += 1;
-              phasebiasSat->Biases[ii].Type = CODETYPEQZSS_L1_CA;
-              phasebiasSat->Biases[ii].Bias = pbSig.bias;
-              phasebiasSat->Biases[ii].SignalIntegerIndicator = pbSig.integerIndicator;
-              phasebiasSat->Biases[ii].SignalsWideLaneIntegerIndicator =
-                  pbSig.wlIndicator;
-              phasebiasSat->Biases[ii].SignalDiscontinuityCounter =
-                  pbSig.discontinuityCounter;
-            }
-            else if (pbSig.type == "1S") {
-              int ii = phasebiasSat->NumberOfPhaseBiases;
-              if (ii >= CLOCKORBIT_NUMBIAS)
-                break;
-              phasebiasSat->NumberOfPhaseBiases += 1;
-              phasebiasSat->Biases[ii].Type = CODETYPEQZSS_L1C_D;
-              phasebiasSat->Biases[ii].Bias = pbSig.bias;
-              phasebiasSat->Biases[ii].SignalIntegerIndicator = pbSig.integerIndicator;
-              phasebiasSat->Biases[ii].SignalsWideLaneIntegerIndicator =
-                  pbSig.wlIndicator;
-              phasebiasSat->Biases[ii].SignalDiscontinuityCounter =
-                  pbSig.discontinuityCounter;
-            }
-            else if (pbSig.type == "1L") {
-              int ii = phasebiasSat->NumberOfPhaseBiases;
-              if (ii >= CLOCKORBIT_NUMBIAS)
-                break;
-              phasebiasSat->NumberOfPhaseBiases += 1;
-              phasebiasSat->Biases[ii].Type = CODETYPEQZSS_L1C_P;
-              phasebiasSat->Biases[ii].Bias = pbSig.bias;
-              phasebiasSat->Biases[ii].SignalIntegerIndicator = pbSig.integerIndicator;
-              phasebiasSat->Biases[ii].SignalsWideLaneIntegerIndicator =
-                  pbSig.wlIndicator;
-              phasebiasSat->Biases[ii].SignalDiscontinuityCounter =
-                  pbSig.discontinuityCounter;
-            }
-            else if (pbSig.type == "2S") {
-              int ii = phasebiasSat->NumberOfPhaseBiases;
-              if (ii >= CLOCKORBIT_NUMBIAS)
-                break;
-              phasebiasSat->NumberOfPhaseBiases += 1;
-              phasebiasSat->Biases[ii].Type = CODETYPEQZSS_L2C_M;
-              phasebiasSat->Biases[ii].Bias = pbSig.bias;
-              phasebiasSat->Biases[ii].SignalIntegerIndicator = pbSig.integerIndicator;
-              phasebiasSat->Biases[ii].SignalsWideLaneIntegerIndicator =
-                  pbSig.wlIndicator;
-              phasebiasSat->Biases[ii].SignalDiscontinuityCounter =
-                  pbSig.discontinuityCounter;
-            }
-            else if (pbSig.type == "2L") {
-              int ii = phasebiasSat->NumberOfPhaseBiases;
-              if (ii >= CLOCKORBIT_NUMBIAS)
-                break;
-              phasebiasSat->NumberOfPhaseBiases += 1;
-              phasebiasSat->Biases[ii].Type = CODETYPEQZSS_L2C_L;
-              phasebiasSat->Biases[ii].Bias = pbSig.bias;
-              phasebiasSat->Biases[ii].SignalIntegerIndicator = pbSig.integerIndicator;
-              phasebiasSat->Biases[ii].SignalsWideLaneIntegerIndicator =
-                  pbSig.wlIndicator;
-              phasebiasSat->Biases[ii].SignalDiscontinuityCounter =
-                  pbSig.discontinuityCounter;
-            }
-            else if (pbSig.type == "2X") {
-              int ii = phasebiasSat->NumberOfPhaseBiases;
-              if (ii >= CLOCKORBIT_NUMBIAS)
-                break;
-              phasebiasSat->NumberOfPhaseBiases += 1;
-              phasebiasSat->Biases[ii].Type = CODETYPEQZSS_L2C_ML;
-              phasebiasSat->Biases[ii].Bias = pbSig.bias;
-              phasebiasSat->Biases[ii].SignalIntegerIndicator = pbSig.integerIndicator;
-              phasebiasSat->Biases[ii].SignalsWideLaneIntegerIndicator =
-                  pbSig.wlIndicator;
-              phasebiasSat->Biases[ii].SignalDiscontinuityCounter =
-                  pbSig.discontinuityCounter;
-            }
-            else if (pbSig.type == "5I") {
-              int ii = phasebiasSat->NumberOfPhaseBiases;
-              if (ii >= CLOCKORBIT_NUMBIAS)
-                break;
-              phasebiasSat->NumberOfPhaseBiases += 1;
-              phasebiasSat->Biases[ii].Type = CODETYPEQZSS_L5_I;
-              phasebiasSat->Biases[ii].Bias = pbSig.bias;
-              phasebiasSat->Biases[ii].SignalIntegerIndicator = pbSig.integerIndicator;
-              phasebiasSat->Biases[ii].SignalsWideLaneIntegerIndicator =
-                  pbSig.wlIndicator;
-              phasebiasSat->Biases[ii].SignalDiscontinuityCounter =
-                  pbSig.discontinuityCounter;
-            }
-            else if (pbSig.type == "5Q") {
-              int ii = phasebiasSat->NumberOfPhaseBiases;
-              if (ii >= CLOCKORBIT_NUMBIAS)
-                break;
-              phasebiasSat->NumberOfPhaseBiases += 1;
-              phasebiasSat->Biases[ii].Type = CODETYPEQZSS_L5_Q;
-              phasebiasSat->Biases[ii].Bias = pbSig.bias;
-              phasebiasSat->Biases[ii].SignalIntegerIndicator = pbSig.integerIndicator;
-              phasebiasSat->Biases[ii].SignalsWideLaneIntegerIndicator =
-                  pbSig.wlIndicator;
-              phasebiasSat->Biases[ii].SignalDiscontinuityCounter =
-                  pbSig.discontinuityCounter;
-            }
-            else if (pbSig.type == "5X") {
-              int ii = phasebiasSat->NumberOfPhaseBiases;
-              if (ii >= CLOCKORBIT_NUMBIAS)
-                break;
-              phasebiasSat->NumberOfPhaseBiases += 1;
-              phasebiasSat->Biases[ii].Type = CODETYPEQZSS_L5_IQ;
-              phasebiasSat->Biases[ii].Bias = pbSig.bias;
-              phasebiasSat->Biases[ii].SignalIntegerIndicator = pbSig.integerIndicator;
-              phasebiasSat->Biases[ii].SignalsWideLaneIntegerIndicator =
-                  pbSig.wlIndicator;
-              phasebiasSat->Biases[ii].SignalDiscontinuityCounter =
-                  pbSig.discontinuityCounter;
-            }
-            else if (pbSig.type == "6S") {
-              int ii = phasebiasSat->NumberOfPhaseBiases;
-              if (ii >= CLOCKORBIT_NUMBIAS)
-                break;
-              phasebiasSat->NumberOfPhaseBiases += 1;
-              phasebiasSat->Biases[ii].Type = CODETYPEQZSS_L6_D;
-              phasebiasSat->Biases[ii].Bias = pbSig.bias;
-              phasebiasSat->Biases[ii].SignalIntegerIndicator = pbSig.integerIndicator;
-              phasebiasSat->Biases[ii].SignalsWideLaneIntegerIndicator =
-                  pbSig.wlIndicator;
-              phasebiasSat->Biases[ii].SignalDiscontinuityCounter =
-                  pbSig.discontinuityCounter;
-            }
-            else if (pbSig.type == "6L") {
-              int ii = phasebiasSat->NumberOfPhaseBiases;
-              if (ii >= CLOCKORBIT_NUMBIAS)
-                break;
-              phasebiasSat->NumberOfPhaseBiases += 1;
-              phasebiasSat->Biases[ii].Type = CODETYPEQZSS_L6_P;
-              phasebiasSat->Biases[ii].Bias = pbSig.bias;
-              phasebiasSat->Biases[ii].SignalIntegerIndicator = pbSig.integerIndicator;
-              phasebiasSat->Biases[ii].SignalsWideLaneIntegerIndicator =
-                  pbSig.wlIndicator;
-              phasebiasSat->Biases[ii].SignalDiscontinuityCounter =
-                  pbSig.discontinuityCounter;
-            }
-            else if (pbSig.type == "6X") {
-              int ii = phasebiasSat->NumberOfPhaseBiases;
-              if (ii >= CLOCKORBIT_NUMBIAS)
-                break;
-              phasebiasSat->NumberOfPhaseBiases += 1;
-              phasebiasSat->Biases[ii].Type = CODETYPEQZSS_L6_DP;
-              phasebiasSat->Biases[ii].Bias = pbSig.bias;
-              phasebiasSat->Biases[ii].SignalIntegerIndicator = pbSig.integerIndicator;
-              phasebiasSat->Biases[ii].SignalsWideLaneIntegerIndicator =
-                  pbSig.wlIndicator;
-              phasebiasSat->Biases[ii].SignalDiscontinuityCounter =
-                  pbSig.discontinuityCounter;
-            }
-            else if (pbSig.type == "1X") {
-              int ii = phasebiasSat->NumberOfPhaseBiases;
-              if (ii >= CLOCKORBIT_NUMBIAS)
-                break;
-              phasebiasSat->NumberOfPhaseBiases += 1;
-              phasebiasSat->Biases[ii].Type = CODETYPEQZSS_L1C_DP;
-              phasebiasSat->Biases[ii].Bias = pbSig.bias;
-              phasebiasSat->Biases[ii].SignalIntegerIndicator = pbSig.integerIndicator;
-              phasebiasSat->Biases[ii].SignalsWideLaneIntegerIndicator =
-                  pbSig.wlIndicator;
-              phasebiasSat->Biases[ii].SignalDiscontinuityCounter =
-                  pbSig.discontinuityCounter;
-            }
-            else if (pbSig.type == "1Z") {
-              int ii = phasebiasSat->NumberOfPhaseBiases;
-              if (ii >= CLOCKORBIT_NUMBIAS)
-                break;
-              phasebiasSat->NumberOfPhaseBiases += 1;
-              phasebiasSat->Biases[ii].Type = CODETYPEQZSS_L1_S;
-              phasebiasSat->Biases[ii].Bias = pbSig.bias;
-              phasebiasSat->Biases[ii].SignalIntegerIndicator = pbSig.integerIndicator;
-              phasebiasSat->Biases[ii].SignalsWideLaneIntegerIndicator =
-                  pbSig.wlIndicator;
-              phasebiasSat->Biases[ii].SignalDiscontinuityCounter =
-                  pbSig.discontinuityCounter;
-            }
-            else if (pbSig.type == "5D") {
-              int ii = phasebiasSat->NumberOfPhaseBiases;
-              if (ii >= CLOCKORBIT_NUMBIAS)
-                break;
-              phasebiasSat->NumberOfPhaseBiases += 1;
-              phasebiasSat->Biases[ii].Type = CODETYPEQZSS_L5_D;
-              phasebiasSat->Biases[ii].Bias = pbSig.bias;
-              phasebiasSat->Biases[ii].SignalIntegerIndicator = pbSig.integerIndicator;
-              phasebiasSat->Biases[ii].SignalsWideLaneIntegerIndicator =
-                  pbSig.wlIndicator;
-              phasebiasSat->Biases[ii].SignalDiscontinuityCounter =
-                  pbSig.discontinuityCounter;
-            }
-            else if (pbSig.type == "5P") {
-              int ii = phasebiasSat->NumberOfPhaseBiases;
-              if (ii >= CLOCKORBIT_NUMBIAS)
-                break;
-              phasebiasSat->NumberOfPhaseBiases += 1;
-              phasebiasSat->Biases[ii].Type = CODETYPEQZSS_L5_P;
-              phasebiasSat->Biases[ii].Bias = pbSig.bias;
-              phasebiasSat->Biases[ii].SignalIntegerIndicator = pbSig.integerIndicator;
-              phasebiasSat->Biases[ii].SignalsWideLaneIntegerIndicator =
-                  pbSig.wlIndicator;
-              phasebiasSat->Biases[ii].SignalDiscontinuityCounter =
-                  pbSig.discontinuityCounter;
-            }
-            else if (pbSig.type == "5D") {
-              int ii = phasebiasSat->NumberOfPhaseBiases;
-              if (ii >= CLOCKORBIT_NUMBIAS)
-                break;
-              phasebiasSat->NumberOfPhaseBiases += 1;
-              phasebiasSat->Biases[ii].Type = CODETYPEQZSS_L5_DP;
-              phasebiasSat->Biases[ii].Bias = pbSig.bias;
-              phasebiasSat->Biases[ii].SignalIntegerIndicator = pbSig.integerIndicator;
-              phasebiasSat->Biases[ii].SignalsWideLaneIntegerIndicator =
-                  pbSig.wlIndicator;
-              phasebiasSat->Biases[ii].SignalDiscontinuityCounter =
-                  pbSig.discontinuityCounter;
-            }
-            else if (pbSig.type == "6E") {
-              int ii = phasebiasSat->NumberOfPhaseBiases;
-              if (ii >= CLOCKORBIT_NUMBIAS)
-                break;
-              phasebiasSat->NumberOfPhaseBiases += 1;
-              phasebiasSat->Biases[ii].Type = CODETYPEQZSS_L6_E;
-              phasebiasSat->Biases[ii].Bias = pbSig.bias;
-              phasebiasSat->Biases[ii].SignalIntegerIndicator = pbSig.integerIndicator;
-              phasebiasSat->Biases[ii].SignalsWideLaneIntegerIndicator =
-                  pbSig.wlIndicator;
-              phasebiasSat->Biases[ii].SignalDiscontinuityCounter =
-                  pbSig.discontinuityCounter;
-            }
-            else if (pbSig.type == "6Z") {
-              int ii = phasebiasSat->NumberOfPhaseBiases;
-              if (ii >= CLOCKORBIT_NUMBIAS)
-                break;
-              phasebiasSat->NumberOfPhaseBiases += 1;
-              phasebiasSat->Biases[ii].Type = CODETYPEQZSS_L6_DE;
-              phasebiasSat->Biases[ii].Bias = pbSig.bias;
-              phasebiasSat->Biases[ii].SignalIntegerIndicator = pbSig.integerIndicator;
-              phasebiasSat->Biases[ii].SignalsWideLaneIntegerIndicator =
-                  pbSig.wlIndicator;
-              phasebiasSat->Biases[ii].SignalDiscontinuityCounter =
-                  pbSig.discontinuityCounter;
-            }
-          }
-        }
-        if (prn.system() == 'S') {
-          QListIterator<phaseBiasSignal> it(phaseBiasList);
-          while (it.hasNext()) {
-            const phaseBiasSignal &pbSig = it.next();
-            if (pbSig.type == "1C") {
-              int ii = phasebiasSat->NumberOfPhaseBiases;
-              if (ii >= CLOCKORBIT_NUMBIAS)
-                break;
-              phasebiasSat->NumberOfPhaseBiases += 1;
-              phasebiasSat->Biases[ii].Type = CODETYPE_SBAS_L1_CA;
-              phasebiasSat->Biases[ii].Bias = pbSig.bias;
-              phasebiasSat->Biases[ii].SignalIntegerIndicator = pbSig.integerIndicator;
-              phasebiasSat->Biases[ii].SignalsWideLaneIntegerIndicator =
-                  pbSig.wlIndicator;
-              phasebiasSat->Biases[ii].SignalDiscontinuityCounter =
-                  pbSig.discontinuityCounter;
-            }
-            else if (pbSig.type == "5I") {
-              int ii = phasebiasSat->NumberOfPhaseBiases;
-              if (ii >= CLOCKORBIT_NUMBIAS)
-                break;
-              phasebiasSat->NumberOfPhaseBiases += 1;
-              phasebiasSat->Biases[ii].Type = CODETYPE_SBAS_L5_I;
-              phasebiasSat->Biases[ii].Bias = pbSig.bias;
-              phasebiasSat->Biases[ii].SignalIntegerIndicator = pbSig.integerIndicator;
-              phasebiasSat->Biases[ii].SignalsWideLaneIntegerIndicator =
-                  pbSig.wlIndicator;
-              phasebiasSat->Biases[ii].SignalDiscontinuityCounter =
-                  pbSig.discontinuityCounter;
-            }
-            else if (pbSig.type == "5Q") {
-              int ii = phasebiasSat->NumberOfPhaseBiases;
-              if (ii >= CLOCKORBIT_NUMBIAS)
-                break;
-              phasebiasSat->NumberOfPhaseBiases += 1;
-              phasebiasSat->Biases[ii].Type = CODETYPE_SBAS_L5_Q;
-              phasebiasSat->Biases[ii].Bias = pbSig.bias;
-              phasebiasSat->Biases[ii].SignalIntegerIndicator = pbSig.integerIndicator;
-              phasebiasSat->Biases[ii].SignalsWideLaneIntegerIndicator =
-                  pbSig.wlIndicator;
-              phasebiasSat->Biases[ii].SignalDiscontinuityCounter =
-                  pbSig.discontinuityCounter;
-            }
-            else if (pbSig.type == "5X") {
-              int ii = phasebiasSat->NumberOfPhaseBiases;
-              if (ii >= CLOCKORBIT_NUMBIAS)
-                break;
-              phasebiasSat->NumberOfPhaseBiases += 1;
-              phasebiasSat->Biases[ii].Type = CODETYPE_SBAS_L5_IQ;
-              phasebiasSat->Biases[ii].Bias = pbSig.bias;
-              phasebiasSat->Biases[ii].SignalIntegerIndicator = pbSig.integerIndicator;
-              phasebiasSat->Biases[ii].SignalsWideLaneIntegerIndicator =
-                  pbSig.wlIndicator;
-              phasebiasSat->Biases[ii].SignalDiscontinuityCounter =
-                  pbSig.discontinuityCounter;
-            }
-          }
-        }
-        if (prn.system() == 'C') {
-          QListIterator<phaseBiasSignal> it(phaseBiasList);
-          while (it.hasNext()) {
-            const phaseBiasSignal &pbSig = it.next();
-            if (pbSig.type == "2I") {
-              int ii = phasebiasSat->NumberOfPhaseBiases;
-              if (ii >= CLOCKORBIT_NUMBIAS)
-                break;
-              phasebiasSat->NumberOfPhaseBiases += 1;
-              phasebiasSat->Biases[ii].Type = CODETYPE_BDS_B1_I;
-              phasebiasSat->Biases[ii].Bias = pbSig.bias;
-              phasebiasSat->Biases[ii].SignalIntegerIndicator = pbSig.integerIndicator;
-              phasebiasSat->Biases[ii].SignalsWideLaneIntegerIndicator =
-                  pbSig.wlIndicator;
-              phasebiasSat->Biases[ii].SignalDiscontinuityCounter =
-                  pbSig.discontinuityCounter;
-            }
-            else if (pbSig.type == "2Q") {
-              int ii = phasebiasSat->NumberOfPhaseBiases;
-              if (ii >= CLOCKORBIT_NUMBIAS)
-                break;
-              phasebiasSat->NumberOfPhaseBiases += 1;
-              phasebiasSat->Biases[ii].Type = CODETYPE_BDS_B1_Q;
-              phasebiasSat->Biases[ii].Bias = pbSig.bias;
-              phasebiasSat->Biases[ii].SignalIntegerIndicator = pbSig.integerIndicator;
-              phasebiasSat->Biases[ii].SignalsWideLaneIntegerIndicator =
-                  pbSig.wlIndicator;
-              phasebiasSat->Biases[ii].SignalDiscontinuityCounter =
-                  pbSig.discontinuityCounter;
-            }
-            else if (pbSig.type == "2X") {
-              int ii = phasebiasSat->NumberOfPhaseBiases;
-              if (ii >= CLOCKORBIT_NUMBIAS)
-                break;
-              phasebiasSat->NumberOfPhaseBiases += 1;
-              phasebiasSat->Biases[ii].Type = CODETYPE_BDS_B1_IQ;
-              phasebiasSat->Biases[ii].Bias = pbSig.bias;
-              phasebiasSat->Biases[ii].SignalIntegerIndicator = pbSig.integerIndicator;
-              phasebiasSat->Biases[ii].SignalsWideLaneIntegerIndicator =
-                  pbSig.wlIndicator;
-              phasebiasSat->Biases[ii].SignalDiscontinuityCounter =
-                  pbSig.discontinuityCounter;
-            }
-            else if (pbSig.type == "6I") {
-              int ii = phasebiasSat->NumberOfPhaseBiases;
-              if (ii >= CLOCKORBIT_NUMBIAS)
-                break;
-              phasebiasSat->NumberOfPhaseBiases += 1;
-              phasebiasSat->Biases[ii].Type = CODETYPE_BDS_B3_I;
-              phasebiasSat->Biases[ii].Bias = pbSig.bias;
-              phasebiasSat->Biases[ii].SignalIntegerIndicator = pbSig.integerIndicator;
-              phasebiasSat->Biases[ii].SignalsWideLaneIntegerIndicator =
-                  pbSig.wlIndicator;
-              phasebiasSat->Biases[ii].SignalDiscontinuityCounter =
-                  pbSig.discontinuityCounter;
-            }
-            else if (pbSig.type == "6Q") {
-              int ii = phasebiasSat->NumberOfPhaseBiases;
-              if (ii >= CLOCKORBIT_NUMBIAS)
-                break;
-              phasebiasSat->NumberOfPhaseBiases += 1;
-              phasebiasSat->Biases[ii].Type = CODETYPE_BDS_B3_Q;
-              phasebiasSat->Biases[ii].Bias = pbSig.bias;
-              phasebiasSat->Biases[ii].SignalIntegerIndicator = pbSig.integerIndicator;
-              phasebiasSat->Biases[ii].SignalsWideLaneIntegerIndicator =
-                  pbSig.wlIndicator;
-              phasebiasSat->Biases[ii].SignalDiscontinuityCounter =
-                  pbSig.discontinuityCounter;
-            }
-            else if (pbSig.type == "6X") {
-              int ii = phasebiasSat->NumberOfPhaseBiases;
-              if (ii >= CLOCKORBIT_NUMBIAS)
-                break;
-              phasebiasSat->NumberOfPhaseBiases += 1;
-              phasebiasSat->Biases[ii].Type = CODETYPE_BDS_B3_IQ;
-              phasebiasSat->Biases[ii].Bias = pbSig.bias;
-              phasebiasSat->Biases[ii].SignalIntegerIndicator = pbSig.integerIndicator;
-              phasebiasSat->Biases[ii].SignalsWideLaneIntegerIndicator =
-                  pbSig.wlIndicator;
-              phasebiasSat->Biases[ii].SignalDiscontinuityCounter =
-                  pbSig.discontinuityCounter;
-            }
-            else if (pbSig.type == "7I") {
-              int ii = phasebiasSat->NumberOfPhaseBiases;
-              if (ii >= CLOCKORBIT_NUMBIAS)
-                break;
-              phasebiasSat->NumberOfPhaseBiases += 1;
-              phasebiasSat->Biases[ii].Type = CODETYPE_BDS_B2_I;
-              phasebiasSat->Biases[ii].Bias = pbSig.bias;
-              phasebiasSat->Biases[ii].SignalIntegerIndicator = pbSig.integerIndicator;
-              phasebiasSat->Biases[ii].SignalsWideLaneIntegerIndicator =
-                  pbSig.wlIndicator;
-              phasebiasSat->Biases[ii].SignalDiscontinuityCounter =
-                  pbSig.discontinuityCounter;
-            }
-            else if (pbSig.type == "7Q") {
-              int ii = phasebiasSat->NumberOfPhaseBiases;
-              if (ii >= CLOCKORBIT_NUMBIAS)
-                break;
-              phasebiasSat->NumberOfPhaseBiases += 1;
-              phasebiasSat->Biases[ii].Type = CODETYPE_BDS_B2_Q;
-              phasebiasSat->Biases[ii].Bias = pbSig.bias;
-              phasebiasSat->Biases[ii].SignalIntegerIndicator = pbSig.integerIndicator;
-              phasebiasSat->Biases[ii].SignalsWideLaneIntegerIndicator =
-                  pbSig.wlIndicator;
-              phasebiasSat->Biases[ii].SignalDiscontinuityCounter =
-                  pbSig.discontinuityCounter;
-            }
-            else if (pbSig.type == "7X") {
-              int ii = phasebiasSat->NumberOfPhaseBiases;
-              if (ii >= CLOCKORBIT_NUMBIAS)
-                break;
-              phasebiasSat->NumberOfPhaseBiases += 1;
-              phasebiasSat->Biases[ii].Type = CODETYPE_BDS_B2_IQ;
-              phasebiasSat->Biases[ii].Bias = pbSig.bias;
-              phasebiasSat->Biases[ii].SignalIntegerIndicator = pbSig.integerIndicator;
-              phasebiasSat->Biases[ii].SignalsWideLaneIntegerIndicator =
-                  pbSig.wlIndicator;
-              phasebiasSat->Biases[ii].SignalDiscontinuityCounter =
-                  pbSig.discontinuityCounter;
-            }
+        QListIterator<phaseBiasSignal> it(phaseBiasList);
+        while (it.hasNext()) {
+          const phaseBiasSignal &pbSig = it.next();
+          CodeType type;
+          if (!t_ssrSignals::codeType(prn.system(), pbSig.type.toAscii().data(), type)) {
+            continue;
           }
+          int ii = phasebiasSat->NumberOfPhaseBiases;
+          if (ii >= CLOCKORBIT_NUMBIAS)
+            break;
+          phasebiasSat->NumberOfPhaseBiases += 1;
+          phasebiasSat->Biases[ii].Type = type;
+          phasebiasSat->Biases[ii].Bias = pbSig.bias;
+          phasebiasSat->Biases[ii].SignalIntegerIndicator = pbSig.integerIndicator;
+          phasebiasSat->Biases[ii].SignalsWideLaneIntegerIndicator = pbSig.wlIndicator;
+          phasebiasSat->Biases[ii].SignalDiscontinuityCounter = pbSig.discontinuityCounter;
         }
       }
     }
   }
 
+  // Orbit and clock corrections of all satellites
+  // ----------------------------------------------
+  processSatellites(epoTime);
+
   QByteArray hlpBufferCo;
 
   // Orbit and Clock Corrections together
@@ -2423,187 +874,210 @@ void bncRtnetUploadCaster::decodeRtnetStream(char* buffer, int bufLen) {
       + hlpBufferVtec;
 }
 
-//
+// Add a satellite to the epoch batch
+////////////////////////////////////////////////////////////////////////////
+void bncRtnetUploadCaster::t_epoSats::append(const t_eph* eph,
+    const QString& prn, struct ClockOrbit::SatData* sd, double ura,
+    const ColumnVector& xP, const ColumnVector& vP, const ColumnVector& CoM,
+    const ColumnVector& clk, const ColumnVector& clkSig) {
+
+  if (_num >= MAXSAT) {
+    return;
+  }
+  int iSat = _num++;
+  _eph[iSat] = eph;
+  _prn[iSat] = prn;
+  _sd[iSat]  = sd;
+  _ura[iSat] = ura;
+  for (int ii = 0; ii < 3; ii++) {
+    _xP[ii][iSat]     = xP[ii];
+    _vP[ii][iSat]     = vP[ii];
+    _CoM[ii][iSat]    = CoM[ii];
+    _clk[ii][iSat]    = clk[ii];
+    _clkSig[ii][iSat] = (ii < clkSig.size()) ? clkSig[ii] : 0.0;
+  }
+}
+
+// Orbit and clock corrections of all satellites of an epoch
 ////////////////////////////////////////////////////////////////////////////
-t_irc bncRtnetUploadCaster::processSatellite(const t_eph* eph, int GPSweek,
-    double GPSweeks, const QString& prn, const ColumnVector& rtnAPC,
-    double rtnUra, const ColumnVector& rtnClk, const ColumnVector& rtnVel,
-    const ColumnVector& rtnCoM, const ColumnVector& rtnClkSig,
-    struct ClockOrbit::SatData* sd, QString& outLine) {
+void bncRtnetUploadCaster::processSatellites(const bncTime& epoTime) {
+
+  t_epoSats& ss = *_epoSats;
+  const int nSat = ss._num;
 
   // Broadcast Position and Velocity
   // -------------------------------
   ColumnVector xB(6);
   ColumnVector vB(3);
-  t_irc irc = eph->getCrd(bncTime(GPSweek, GPSweeks), xB, vB, false);
-
-  if (irc != success) {
-    return irc;
+  for (int iSat = 0; iSat < nSat; iSat++) {
+    ss._ok[iSat] = (ss._eph[iSat]->getCrd(epoTime, xB, vB, false) == success);
+    if (!ss._ok[iSat]) {
+      xB.ReSize(6); xB = 0.0;
+      vB.ReSize(3); vB = 0.0;
+    }
+    for (int ii = 0; ii < 6; ii++) {
+      ss._xB[ii][iSat] = xB[ii];
+    }
+    for (int ii = 0; ii < 3; ii++) {
+      ss._vB[ii][iSat] = vB[ii];
+    }
   }
 
-  // Precise Position
-  // ----------------
-  ColumnVector xP = _CoM ? rtnCoM : rtnAPC;
-
-  if (xP.size() == 0) {
-    return failure;
+  // Precise Position in the target datum
+  // ------------------------------------
+  if (_doTrafo) {
+    crdTrafo(epoTime.gpsw());
   }
-
-  double dc = 0.0;
-  if (_crdTrafo != "IGS14") {
-    crdTrafo(GPSweek, xP, dc);
+  else {
+    for (int iSat = 0; iSat < nSat; iSat++) {
+      ss._dc[iSat] = 0.0;
+    }
   }
 
-  // Difference in xyz
-  // -----------------
-  ColumnVector dx = xB.Rows(1, 3) - xP;
-  ColumnVector dv = vB - rtnVel;
-
   // Difference in RSW
   // -----------------
-  ColumnVector rsw(3);
-  XYZ_to_RSW(xB.Rows(1, 3), vB, dx, rsw);
-
-  ColumnVector dotRsw(3);
-  XYZ_to_RSW(xB.Rows(1, 3), vB, dv, dotRsw);
+  for (int iSat = 0; iSat < nSat; iSat++) {
+    double rx = ss._xB[0][iSat], ry = ss._xB[1][iSat], rz = ss._xB[2][iSat];
+    double vx = ss._vB[0][iSat], vy = ss._vB[1][iSat], vz = ss._vB[2][iSat];
+
+    double vNorm = sqrt(vx*vx + vy*vy + vz*vz);
+    double ax = vx / vNorm, ay = vy / vNorm, az = vz / vNorm;
+
+    double cx = ry*vz - rz*vy, cy = rz*vx - rx*vz, cz = rx*vy - ry*vx;
+    double cNorm = sqrt(cx*cx + cy*cy + cz*cz);
+    cx /= cNorm; cy /= cNorm; cz /= cNorm;
+
+    double qx = ay*cz - az*cy, qy = az*cx - ax*cz, qz = ax*cy - ay*cx;
+
+    double dx = rx - ss._xP[0][iSat];
+    double dy = ry - ss._xP[1][iSat];
+    double dz = rz - ss._xP[2][iSat];
+    ss._rsw[0][iSat] = dx*qx + dy*qy + dz*qz;
+    ss._rsw[1][iSat] = dx*ax + dy*ay + dz*az;
+    ss._rsw[2][iSat] = dx*cx + dy*cy + dz*cz;
+
+    double dvx = vx - ss._vP[0][iSat];
+    double dvy = vy - ss._vP[1][iSat];
+    double dvz = vz - ss._vP[2][iSat];
+    ss._dotRsw[0][iSat] = dvx*qx + dvy*qy + dvz*qz;
+    ss._dotRsw[1][iSat] = dvx*ax + dvy*ay + dvz*az;
+    ss._dotRsw[2][iSat] = dvx*cx + dvy*cy + dvz*cz;
+  }
 
   // Clock Correction
   // ----------------
-  double dClkA0 = rtnClk(1) - (xB(4) - dc) * t_CST::c;
-  double dClkA1 = 0.0;
-  if (rtnClk(2)) {
-    dClkA1 = rtnClk(2) - xB(5) * t_CST::c;
-  }
-  double dClkA2 = 0.0;
-  if (rtnClk(3)) {
-    dClkA2 = rtnClk(3) - xB(6) * t_CST::c;
+  for (int iSat = 0; iSat < nSat; iSat++) {
+    ss._dClk[0][iSat] = ss._clk[0][iSat] - (ss._xB[3][iSat] - ss._dc[iSat]) * t_CST::c;
+    ss._dClk[1][iSat] = ss._clk[1][iSat] ? ss._clk[1][iSat] - ss._xB[4][iSat] * t_CST::c : 0.0;
+    ss._dClk[2][iSat] = ss._clk[2][iSat] ? ss._clk[2][iSat] - ss._xB[5][iSat] * t_CST::c : 0.0;
   }
 
-  if (sd) {
-    sd->ID = prn.mid(1).toInt();
-    sd->IOD = eph->IOD();
-    sd->Clock.DeltaA0 = dClkA0;
-    sd->Clock.DeltaA1 = dClkA1;
-    sd->Clock.DeltaA2 = dClkA2;
-    sd->UserRangeAccuracy = rtnUra;
-    sd->Orbit.DeltaRadial     = rsw(1);
-    sd->Orbit.DeltaAlongTrack = rsw(2);
-    sd->Orbit.DeltaCrossTrack = rsw(3);
-    sd->Orbit.DotDeltaRadial     = dotRsw(1);
-    sd->Orbit.DotDeltaAlongTrack = dotRsw(2);
-    sd->Orbit.DotDeltaCrossTrack = dotRsw(3);
+  // Fill the SSR message structure
+  // ------------------------------
+  for (int iSat = 0; iSat < nSat; iSat++) {
+    struct ClockOrbit::SatData* sd = ss._sd[iSat];
+    sd->ID  = ss._prn[iSat].mid(1).toInt(); // also prevents G00, R00 entries
+    sd->IOD = ss._eph[iSat]->IOD();
+    if (!ss._ok[iSat]) {
+      // very few cases: check states bad and unhealthy are excluded earlier
+      continue;
+    }
+    sd->Clock.DeltaA0 = ss._dClk[0][iSat];
+    sd->Clock.DeltaA1 = ss._dClk[1][iSat];
+    sd->Clock.DeltaA2 = ss._dClk[2][iSat];
+    sd->UserRangeAccuracy = ss._ura[iSat];
+    sd->Orbit.DeltaRadial        = ss._rsw[0][iSat];
+    sd->Orbit.DeltaAlongTrack    = ss._rsw[1][iSat];
+    sd->Orbit.DeltaCrossTrack    = ss._rsw[2][iSat];
+    sd->Orbit.DotDeltaRadial     = ss._dotRsw[0][iSat];
+    sd->Orbit.DotDeltaAlongTrack = ss._dotRsw[1][iSat];
+    sd->Orbit.DotDeltaCrossTrack = ss._dotRsw[2][iSat];
   }
 
-  outLine.sprintf("%d %.1f %s  %u  %10.3f %8.3f %8.3f  %8.3f %8.3f %8.3f\n", GPSweek,
-      GPSweeks, eph->prn().toString().c_str(), eph->IOD(), dClkA0, dClkA1, dClkA2,
-      rsw(1), rsw(2), rsw(3));
-
   // RTNET full clock for RINEX and SP3 file
   // ---------------------------------------
-  double relativity = -2.0 * DotProduct(xP, rtnVel) / t_CST::c;
-  double clkRnx     = (rtnClk[0] - relativity) / t_CST::c;  // [s]
-  double clkRnxRate = rtnClk[1] / t_CST::c;                 // [s/s = -]
-  double clkRnxAcc  = rtnClk[2] / t_CST::c;                 // [s/s² ) -/s]
-
-  if (_rnx) {
-    double clkRnxSig, clkRnxRateSig, clkRnxAccSig;
-    int s = rtnClkSig.size();
-    switch (s) {
-      case 1:
-        clkRnxSig     = rtnClkSig[0] / t_CST::c;    // [s]
-        clkRnxRateSig = 0.0;                        // [s/s = -]
-        clkRnxAccSig  = 0.0;                        // [s/s² ) -/s]
-        break;
-      case 2:
-        clkRnxSig     = rtnClkSig[0] / t_CST::c;     // [s]
-        clkRnxRateSig = rtnClkSig[1] / t_CST::c;     // [s/s = -]
-        clkRnxAccSig  = 0.0;                         // [s/s² ) -/s]
-        break;
-      case 3:
-        clkRnxSig     = rtnClkSig[0] / t_CST::c;     // [s]
-        clkRnxRateSig = rtnClkSig[1] / t_CST::c;     // [s/s = -]
-        clkRnxAccSig  = rtnClkSig[2] / t_CST::c;     // [s/s² ) -/s]
-        break;
-    }
-    _rnx->write(GPSweek, GPSweeks, prn, clkRnx, clkRnxRate, clkRnxAcc,
-                clkRnxSig, clkRnxRateSig, clkRnxAccSig);
+  if (!_rnx && !_sp3) {
+    return;
   }
-  if (_sp3) {
-    _sp3->write(GPSweek, GPSweeks, prn, rtnCoM, clkRnx, rtnVel, clkRnxRate);
+  int    GPSweek  = epoTime.gpsw();
+  double GPSweeks = epoTime.gpssec();
+  ColumnVector xCoM(3);
+  ColumnVector vel(3);
+  for (int iSat = 0; iSat < nSat; iSat++) {
+    if (!ss._ok[iSat]) {
+      continue;
+    }
+    double relativity = -2.0 * (ss._xP[0][iSat] * ss._vP[0][iSat] +
+                                ss._xP[1][iSat] * ss._vP[1][iSat] +
+                                ss._xP[2][iSat] * ss._vP[2][iSat]) / t_CST::c;
+    double clkRnx     = (ss._clk[0][iSat] - relativity) / t_CST::c;  // [s]
+    double clkRnxRate = ss._clk[1][iSat] / t_CST::c;                 // [s/s = -]
+    double clkRnxAcc  = ss._clk[2][iSat] / t_CST::c;                 // [s/s² ) -/s]
+
+    if (_rnx) {
+      _rnx->write(GPSweek, GPSweeks, ss._prn[iSat], clkRnx, clkRnxRate, clkRnxAcc,
+                  ss._clkSig[0][iSat] / t_CST::c,      // [s]
+                  ss._clkSig[1][iSat] / t_CST::c,      // [s/s = -]
+                  ss._clkSig[2][iSat] / t_CST::c);     // [s/s² ) -/s]
+    }
+    if (_sp3) {
+      for (int ii = 0; ii < 3; ii++) {
+        xCoM[ii] = ss._CoM[ii][iSat];
+        vel[ii]  = ss._vP[ii][iSat];
+      }
+      _sp3->write(GPSweek, GPSweeks, ss._prn[iSat], xCoM, clkRnx, vel, clkRnxRate);
+    }
   }
-  return success;
 }
 
-// Transform Coordinates
+// Transform Coordinates (Helmert parameters are updated once per GPS week)
 ////////////////////////////////////////////////////////////////////////////
-void bncRtnetUploadCaster::crdTrafo(int GPSWeek, ColumnVector& xyz,
-    double& dc) {
-
-  // Current epoch minus 2000.0 in years
-  // ------------------------------------
-  double dt = (GPSWeek - (1042.0 + 6.0 / 7.0)) / 365.2422 * 7.0 + 2000.0 - _t0;
+void bncRtnetUploadCaster::crdTrafo(int GPSWeek) {
 
-  ColumnVector dx(3);
+  if (_helmert._GPSWeek != GPSWeek) {
 
-  dx(1) = _dx + dt * _dxr;
-  dx(2) = _dy + dt * _dyr;
-  dx(3) = _dz + dt * _dzr;
+    // Current epoch minus 2000.0 in years
+    // ------------------------------------
+    double dt = (GPSWeek - (1042.0 + 6.0 / 7.0)) / 365.2422 * 7.0 + 2000.0 - _t0;
 
-  static const double arcSec = 180.0 * 3600.0 / M_PI;
+    static const double arcSec = 180.0 * 3600.0 / M_PI;
 
-  double ox = (_ox + dt * _oxr) / arcSec;
-  double oy = (_oy + dt * _oyr) / arcSec;
-  double oz = (_oz + dt * _ozr) / arcSec;
-
-  double sc = 1.0 + _sc * 1e-9 + dt * _scr * 1e-9;
-
-  // Specify approximate center of area
-  // ----------------------------------
-  ColumnVector meanSta(3);
-
-  if (_crdTrafo == "ETRF2000") {
-    meanSta(1) = 3661090.0;
-    meanSta(2) = 845230.0;
-    meanSta(3) = 5136850.0;
-  }
-  else if (_crdTrafo == "GDA2020") {
-    meanSta(1) = -4052050.0;
-    meanSta(2) = 4212840.0;
-    meanSta(3) = -2545110.0;
-  }
-  else if (_crdTrafo == "SIRGAS2000") {
-    meanSta(1) = 3740860.0;
-    meanSta(2) = -4964290.0;
-    meanSta(3) = -1425420.0;
-  }
-  else if (_crdTrafo == "DREF91") {
-    meanSta(1) = 3959579.0;
-    meanSta(2) = 721719.0;
-    meanSta(3) = 4931539.0;
-  }
-  else if (_crdTrafo == "Custom") {
-    meanSta(1) = 0.0; // TODO
-    meanSta(2) = 0.0; // TODO
-    meanSta(3) = 0.0; // TODO
+    _helmert._GPSWeek = GPSWeek;
+    _helmert._dx[0] = _dx + dt * _dxr;
+    _helmert._dx[1] = _dy + dt * _dyr;
+    _helmert._dx[2] = _dz + dt * _dzr;
+    _helmert._ox = (_ox + dt * _oxr) / arcSec;
+    _helmert._oy = (_oy + dt * _oyr) / arcSec;
+    _helmert._oz = (_oz + dt * _ozr) / arcSec;
+    _helmert._sc = 1.0 + _sc * 1e-9 + dt * _scr * 1e-9;
   }
 
-  // Clock correction proportional to topocentric distance to satellites
-  // -------------------------------------------------------------------
-  double rho = (xyz - meanSta).norm_Frobenius();
-  dc = rho * (sc - 1.0) / sc / t_CST::c;
-
-  Matrix rMat(3, 3);
-  rMat(1, 1) = 1.0;
-  rMat(1, 2) = -oz;
-  rMat(1, 3) = oy;
-  rMat(2, 1) = oz;
-  rMat(2, 2) = 1.0;
-  rMat(2, 3) = -ox;
-  rMat(3, 1) = -oy;
-  rMat(3, 2) = ox;
-  rMat(3, 3) = 1.0;
-
-  xyz = sc * rMat * xyz + dx;
+  const double tx = _helmert._dx[0];
+  const double ty = _helmert._dx[1];
+  const double tz = _helmert._dx[2];
+  const double ox = _helmert._ox;
+  const double oy = _helmert._oy;
+  const double oz = _helmert._oz;
+  const double sc = _helmert._sc;
+  const double dcFac = (sc - 1.0) / sc / t_CST::c;
+
+  t_epoSats& ss = *_epoSats;
+  for (int iSat = 0; iSat < ss._num; iSat++) {
+    double x = ss._xP[0][iSat];
+    double y = ss._xP[1][iSat];
+    double z = ss._xP[2][iSat];
+
+    // Clock correction proportional to topocentric distance to satellites
+    // -------------------------------------------------------------------
+    double mx = x - _meanSta[0];
+    double my = y - _meanSta[1];
+    double mz = z - _meanSta[2];
+    ss._dc[iSat] = sqrt(mx*mx + my*my + mz*mz) * dcFac;
+
+    ss._xP[0][iSat] = sc * (      x - oz * y + oy * z) + tx;
+    ss._xP[1][iSat] = sc * ( oz * x +      y - ox * z) + ty;
+    ss._xP[2][iSat] = sc * (-oy * x + ox * y +      z) + tz;
+  }
 }
 
 int bncRtnetUploadCaster::determineUpdateInd(double samplingRate) {
@@ -28,17 +28,52 @@ class bncRtnetUploadCaster : public bncUploadCaster {
  protected:
   virtual ~bncRtnetUploadCaster();
  private:
-  t_irc processSatellite(const t_eph* eph, int GPSweek,
-                        double GPSweeks, const QString& prn,
-                        const ColumnVector& rtnAPC,
-                        double ura,
-                        const ColumnVector& rtnClk,
-                        const ColumnVector& rtnVel,
-                        const ColumnVector& rtnCoM,
-                        const ColumnVector& rtnClkSig,
-                        struct ClockOrbit::SatData* sd,
-                        QString& outLine);
-  void crdTrafo(int GPSWeek, ColumnVector& xyz, double& dc);
+  // Satellites of one epoch as structure of arrays (component-major, the
+  // inner loops of the kernel run over contiguous satellite values)
+  // ----------------------------------------------------------------------
+  class t_epoSats {
+   public:
+    enum {MAXSAT = CLOCKORBIT_COUNTSAT};
+    t_epoSats() : _num(0) {}
+    void append(const t_eph* eph, const QString& prn,
+                struct ClockOrbit::SatData* sd, double ura,
+                const ColumnVector& xP, const ColumnVector& vP,
+                const ColumnVector& CoM, const ColumnVector& clk,
+                const ColumnVector& clkSig);
+    int                         _num;
+    const t_eph*                _eph[MAXSAT];
+    QString                     _prn[MAXSAT];
+    struct ClockOrbit::SatData* _sd[MAXSAT];
+    bool                        _ok[MAXSAT];       // broadcast state available
+    double                      _ura[MAXSAT];
+    double                      _xB[6][MAXSAT];    // broadcast position, clock
+    double                      _vB[3][MAXSAT];    // broadcast velocity
+    double                      _xP[3][MAXSAT];    // precise position (APC or CoM)
+    double                      _vP[3][MAXSAT];    // precise velocity
+    double                      _CoM[3][MAXSAT];   // center of mass (for SP3)
+    double                      _clk[3][MAXSAT];
+    double                      _clkSig[3][MAXSAT];
+    double                      _dc[MAXSAT];       // clock effect of datum scale
+    double                      _rsw[3][MAXSAT];
+    double                      _dotRsw[3][MAXSAT];
+    double                      _dClk[3][MAXSAT];
+  };
+
+  // Helmert parameters of the current GPS week
+  // ------------------------------------------
+  class t_helmert {
+   public:
+    t_helmert() : _GPSWeek(-1) {}
+    int    _GPSWeek;
+    double _dx[3];
+    double _ox;
+    double _oy;
+    double _oz;
+    double _sc;
+  };
+
+  void processSatellites(const bncTime& epoTime);
+  void crdTrafo(int GPSWeek);
 
   int determineUpdateInd(double samplingRate);
 
@@ -67,6 +102,10 @@ class bncRtnetUploadCaster : public bncUploadCaster {
   double         _sc;
   double         _scr;
   double         _t0;
+  bool           _doTrafo;
+  double         _meanSta[3];
+  t_helmert      _helmert;
+  t_epoSats*     _epoSats;
   bncClockRinex* _rnx;
   bncSP3*        _sp3;
   QMap<QString, const t_eph*>* _usedEph;
@@ -19,6 +19,7 @@
 #include "bncversion.h"
 #include "bnccore.h"
 #include "bnctableitem.h"
+#include "bncmetrics.h"
 
 using namespace std;
 
@@ -36,6 +37,7 @@ bncUploadCaster::bncUploadCaster(const QString& mountpoint,
   _sOpenTrial    = 0;
   _iRow          = iRow;
   _rate          = rate;
+  _paced         = false;
   if      (_rate < 0) {
     _rate = 0;
   }
@@ -44,6 +46,12 @@ bncUploadCaster::bncUploadCaster(const QString& mountpoint,
   }
   _isToBeDeleted = false;
 
+  QString mountLabel = bncMetrics::label("mountpoint", _mountpoint);
+  _metricBytes   = BNC_METRICS->counter("bnc_upload_bytes_total",
+                     "Bytes written to the broadcaster", mountLabel);
+  _metricBacklog = BNC_METRICS->gauge("bnc_upload_backlog_bytes",
+                     "Bytes not yet accepted by the broadcaster connection", mountLabel);
+
   connect(this, SIGNAL(newMessage(QByteArray,bool)),
           BNC_CORE, SLOT(slotMessage(const QByteArray,bool)));
 
@@ -72,6 +80,8 @@ bncUploadCaster::~bncUploadCaster() {
   if (_outSocket) {
     delete _outSocket;
   }
+  BNC_METRICS->release(_metricBytes);
+  BNC_METRICS->release(_metricBacklog);
 }
 
 // Endless Loop
@@ -84,12 +94,17 @@ void bncUploadCaster::run() {
       return;
     }
     open();
+    if (_paced && _rate > 0) {
+      writePaced();
+      continue;
+    }
     if (_outSocket && _outSocket->state() == QAbstractSocket::ConnectedState) {
       QMutexLocker locker(&_mutex);
       if (_outBuffer.size() > 0) {
         _outSocket->write(_outBuffer);
         _outSocket->flush();
         emit newBytes(_mountpoint.toAscii(), _outBuffer.size());
+        recordMetrics(_outBuffer.size());
       }
     }
     if (_rate == 0) {
@@ -105,6 +120,63 @@ void bncUploadCaster::run() {
   }
 }
 
+// Send the buffer message by message, spread over the sampling interval
+////////////////////////////////////////////////////////////////////////////
+void bncUploadCaster::writePaced() {
+
+  // Split the buffer into RTCM3 messages
+  // ------------------------------------
+  QList<QByteArray> frames;
+  {
+    QMutexLocker locker(&_mutex);
+    int pos = 0;
+    while (pos < _outBuffer.size()) {
+      int frameLen = _outBuffer.size() - pos;
+      if (frameLen >= 3 && (unsigned char) _outBuffer[pos] == 0xD3) {
+        int msgLen = (((unsigned char) _outBuffer[pos+1] & 0x03) << 8) |
+                       (unsigned char) _outBuffer[pos+2];
+        if (msgLen + 6 < frameLen) {
+          frameLen = msgLen + 6;
+        }
+      }
+      frames.append(_outBuffer.mid(pos, frameLen));
+      pos += frameLen;
+    }
+  }
+
+  int nFrames = frames.size();
+  int nSlices = qMin(nFrames, 10 * _rate);  // not more often than 10 Hz
+  if (nSlices == 0) {
+    sleep(_rate);
+    return;
+  }
+  unsigned long sliceMs = 1000UL * _rate / nSlices;
+
+  for (int iSlice = 0; iSlice < nSlices; iSlice++) {
+    if (_isToBeDeleted) {
+      return;
+    }
+    if (_outSocket && _outSocket->state() == QAbstractSocket::ConnectedState) {
+      QByteArray slice;
+      for (int ii = iSlice * nFrames / nSlices; ii < (iSlice + 1) * nFrames / nSlices; ii++) {
+        slice += frames[ii];
+      }
+      _outSocket->write(slice);
+      _outSocket->flush();
+      emit newBytes(_mountpoint.toAscii(), slice.size());
+      recordMetrics(slice.size());
+    }
+    msleep(sliceMs);
+  }
+}
+
+// Bytes sent and bytes still waiting in the socket
+////////////////////////////////////////////////////////////////////////////
+void bncUploadCaster::recordMetrics(int nBytes) {
+  _metricBytes->add(nBytes);
+  _metricBacklog->set(_outSocket->bytesToWrite());
+}
+
 // Start the Communication with NTRIP Caster
 ////////////////////////////////////////////////////////////////////////////
 void bncUploadCaster::open() {
@@ -3,6 +3,9 @@
 
 #include <QtNetwork>
 
+class bncMetricCounter;
+class bncMetricGauge;
+
 class bncUploadCaster : public QThread {
  Q_OBJECT
  public:
@@ -14,6 +17,7 @@ class bncUploadCaster : public QThread {
     QMutexLocker locker(&_mutex);
     _outBuffer = outBuffer;
   }
+  void setPaced(bool paced) {_paced = paced;}
 
  protected:
   virtual    ~bncUploadCaster();
@@ -26,8 +30,11 @@ class bncUploadCaster : public QThread {
 
  private:
   void         open();
+  void         writePaced();
+  void         recordMetrics(int nBytes);
   virtual void run();
   bool        _isToBeDeleted;
+  bool        _paced;
   QString     _mountpoint;
   QString     _outHost;
   int         _outPort;
@@ -37,6 +44,8 @@ class bncUploadCaster : public QThread {
   QDateTime   _outSocketOpenTime;
   int         _iRow;
   int         _rate;
+  bncMetricCounter* _metricBytes;
+  bncMetricGauge*   _metricBacklog;
 };
 
 #endif